@@ -3,12 +3,41 @@
 #include "Interfaces/ii2c_bus.h"
 #include "SensorBME280/bme280_sensor.h" // Include necessary sensor headers
 #include "NetworkMQTT/mqtt_publisher.h"
+#include "NetworkMQTT/loopback_broker.h"
+#include "Executor/work_stealing_executor.h"
+#include "Executor/sequenced_lane.h"
+#include "Executor/dispatch_queue.h"
+#include "Executor/token_bucket.h"
+#include "Metrics/deadline_tracker.h"
+#include "Metrics/latency_histogram.h"
+#include "Metrics/metrics_registry.h"
+#include "Encoding/payload_encoder.h"
+#include "Encoding/payload_pool.h"
+#include "Encoding/binary_codec.h"
+#include "Batching/publish_batcher.h"
+#include "StoreForward/segment_queue.h"
+#include "Sinks/mqtt_sink.h"
+#include "Sinks/sink_set.h"
+#include "Snapshot/snapshot_writer.h"
+#include "History/rollup_engine.h"
+#include "History/time_series_store.h"
+#include "LocalApi/history_api.h"
+#include "LocalApi/http_server.h"
+#include "LocalApi/live_feed.h"
+#include "Coro/scheduler.h"
+#include "Coro/task.h"
 #include <nlohmann/json_fwd.hpp> // Forward declare json for header
 #include <memory>
 #include <string>
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <array>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace SensorHub::Builder { class SensorBuilder; }
 
 namespace SensorHub::App {
 
@@ -20,7 +49,7 @@ struct SensorConfig {
     std::string type;
     bool enabled = false;
     std::string publish_topic_suffix;
-    std::chrono::seconds publish_interval{10}; // Default interval
+    std::chrono::milliseconds publish_interval{10000}; // Default interval
 
     // --- I2C Specific ---
     std::string i2c_bus;
@@ -78,35 +107,478 @@ private:
     void initMqtt(const nlohmann::json& config);
 
     /**
-     * @brief Performs one cycle of reading sensor data and publishing via MQTT.
+     * @brief Starts the worker pool based on the optional "executor" config section.
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid executor configuration.
+     */
+    void initExecutor(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "metrics" config section (timing report interval) and
+     * registers the process and executor metrics. Must run after initExecutor().
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid metrics configuration.
+     */
+    void initMetrics(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "wire_format" config section (JSON or binary frames).
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid wire format configuration.
+     */
+    void initWireFormat(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "batching" config section and creates the batcher.
+     * Must run after initWireFormat() (the batch layout follows the payload format).
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid batching configuration.
+     */
+    void initBatching(const nlohmann::json& config);
+
+    /**
+     * @brief A sensor's batch limits, stretched by batching.backpressure_factor while the
+     * MQTT in-flight window is more than half full.
+     */
+    SensorHub::Components::PublishBatcher::Limits pressuredBatchLimits(
+        const SensorHub::Components::PublishBatcher::Limits& limits) const;
+
+    /**
+     * @brief Reads the optional "store_forward" config section and opens the on-disk queue.
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration or if the queue cannot be opened.
+     */
+    void initStoreForward(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "sinks" config section: local outputs that get every message
+     * besides the MQTT broker (UDP multicast, Unix datagram socket, rotating file).
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration or if a sink cannot be opened.
+     */
+    void initSinks(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "snapshot" config section and creates the shared-memory
+     * region with the latest reading of each sensor.
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration or if the region cannot be created.
+     */
+    void initSnapshot(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "history" config section and opens the on-device
+     * time-series store of all readings. A store that cannot be opened is logged and left out.
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration.
+     */
+    void initHistory(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "rollups" config section: the aggregate windows of every
+     * sensor, published to <topic>/<window> and optionally stored in the history.
+     * Must run after initHistory().
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration.
+     */
+    void initRollups(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "reload" config section and sets up its triggers: a
+     * watch on the config file and a retained MQTT config topic. SIGHUP always reloads.
+     * Must run after initMqtt().
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration or if the file cannot be watched.
+     */
+    void initReload(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "http" config section and starts the local HTTP server,
+     * with the history queries when the history is enabled, the live feed and /metrics.
+     * Must run after initHistory().
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration or if the address cannot be bound.
+     */
+    void initHttp(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "priorities" (publish classes) and "rate_limits" config sections.
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration.
+     */
+    void initPriorities(const nlohmann::json& config);
+
+    /**
+     * @brief Reads the optional "publish_queue" config section and starts the publisher thread.
+     * Must run after initMqtt(), initStoreForward(), initSinks() and initPriorities().
+     * @param config The loaded JSON configuration object.
+     * @throws std::runtime_error on invalid configuration.
+     */
+    void initPublishQueue(const nlohmann::json& config);
+
+    /**
+     * @brief Batching limits for one sensor (device defaults merged with its override).
+     * @return The limits, or std::nullopt if the sensor publishes unbatched.
+     */
+    std::optional<SensorHub::Components::PublishBatcher::Limits> batchLimitsFor(const std::string& topic_suffix) const;
+
+    /**
+     * @brief Publish classes, highest priority first. Each one is a lane of the publish queue.
+     */
+    enum class PublishClass : size_t { Alerts, State, Telemetry };
+    static constexpr size_t PUBLISH_CLASS_COUNT = 3;
+
+    /**
+     * @brief How messages of one publish class are sent.
+     */
+    struct ClassPolicy {
+        int qos = 0;
+        bool retained = false;
+        unsigned weight = 1; // Share of the publisher thread with the "weighted" schedule
+        std::chrono::seconds expiry{0}; // MQTT 5 message expiry at the broker (0 = never)
+    };
+
+    /**
+     * @brief Per-sensor scheduling and pipeline state.
+     */
+    struct SensorSchedule {
+        explicit SensorSchedule(std::string name) : timing(std::move(name)) {}
+
+        std::chrono::steady_clock::time_point next_publish;
+        std::chrono::milliseconds interval{0}; // The sensor's interval until a config reload changes it
+        std::shared_ptr<SensorHub::Components::SequencedLane> publish_lane; // Shared by all sensors on the bus
+        std::atomic<bool> in_flight{false};                             // A sample is somewhere in the pipeline
+        SensorHub::Components::DeadlineTracker timing;                  // Start lag, durations, missed deadlines
+        // Owned by metrics_; a sensor rebuilt by a reload gets the same series back
+        SensorHub::Components::Counter* readings = nullptr;
+        SensorHub::Components::Counter* read_failures = nullptr;
+        SensorHub::Components::Histogram* cycle_seconds = nullptr;
+        SensorHub::Components::SensorChannel channel;                   // Precomputed topic and metadata fields
+        SensorHub::Components::BinaryChannel binary;                    // Schema state when sending binary frames
+        std::optional<SensorHub::Components::PublishBatcher::Limits> batch_limits; // Unset: publish each reading
+        std::string batch_topic;                                        // Sensor topic, or the device batch topic
+        std::string batch_tag;                                          // Sensor name on binary device-batch items
+        nlohmann::json batch_metadata;                                  // Static members of columnar batches
+        PublishClass publish_class = PublishClass::Telemetry;
+        // Only used on the publisher thread; shared with queued messages, which may outlive the schedule
+        std::shared_ptr<SensorHub::Components::TokenBucket> rate_limit;
+        std::string meta_topic;      // Retained metadata when mqtt.metadata is "retained" (JSON payloads)
+        bool meta_published = false; // Touched by the publish lane only
+        std::optional<uint32_t> snapshot_slot; // Shared-memory slot of the latest reading, if any
+        bool retired = false;   // Removed by a config reload; the sampling loop ends at its next slot
+        bool loop_done = false; // Sampling loop has returned (run() thread only, like retired)
+    };
+
+    /**
+     * @brief Creates a sensor's schedule and pipeline state and registers it in schedules_.
+     * @param first_read When the first reading is due.
+     */
+    void addSchedule(SensorHub::Interfaces::ISensor& sensor, std::chrono::steady_clock::time_point first_read);
+
+    /**
+     * @brief Applies the "sensors" array of a new configuration without a restart: only
+     * new or changed sensors are built (reusing bus managers), removed ones are retired,
+     * and sensors whose interval alone changed keep running on the new interval. Other
+     * sections are not applied; changes to them are logged. Runs on the run() thread.
+     * @param config The complete new configuration.
+     * @param source What triggered the reload, for the log.
+     */
+    void reloadSensors(const nlohmann::json& config, const std::string& source);
+
+    /**
+     * @brief Reloads if SIGHUP arrived, the config file changed or a config message came in.
+     */
+    void checkReloadTriggers();
+
+    /**
+     * @brief Stops sampling a running sensor: its loop ends at its next slot, and
+     * reapRetiredSensors() destroys it once nothing of its samples is left in the pipeline.
+     * @param topic_suffix The sensor's publish_topic_suffix; unknown suffixes are ignored.
+     */
+    void retireSensor(const std::string& topic_suffix);
+
+    /**
+     * @brief Destroys retired sensors once their sampling loop ended and no sample of theirs
+     * is left in the pipeline.
      */
-    void processSensors();
+    void reapRetiredSensors();
 
     /**
-     * @brief Static signal handler function to request shutdown.
+     * @brief Per-sensor coroutine: waits for each publish slot, reads the sensor on the
+     * scheduler thread and hands the sample to the encode/publish pipeline.
+     * @param sensor The sensor to sample.
+     * @param schedule The sensor's scheduling state (must outlive the executor tasks).
+     */
+    SensorHub::Coro::Task<void> samplingLoop(SensorHub::Interfaces::ISensor& sensor, SensorSchedule& schedule);
+
+    /**
+     * @brief Starts a sensor built by a config reload: waits until a retired sensor with the
+     * same suffix (the same chip, most likely) has finished its last sample, awaits the
+     * driver's initialization without blocking the other sensors, then runs samplingLoop().
+     * A sensor that fails to initialize is retired and rebuilt by the next reload.
+     */
+    SensorHub::Coro::Task<void> startRebuiltSensor(SensorHub::Interfaces::ISensor& sensor, SensorSchedule& schedule);
+
+    /**
+     * @brief Queues an already read sample through the encode/publish stages.
+     * @param sensor The sensor the sample belongs to.
+     * @param schedule The sensor's scheduling state (must outlive the executor tasks).
+     * @param ticket Publish-order ticket reserved before the read started.
+     * @param sensor_payload The sensor's JSON reading.
+     * @param timing Timestamps collected so far (scheduled slot and read).
+     */
+    void dispatchSample(SensorHub::Interfaces::ISensor& sensor, SensorSchedule& schedule,
+                        uint64_t ticket, nlohmann::json sensor_payload,
+                        SensorHub::Components::SampleTiming timing);
+
+    /**
+     * @brief Records a sample handed to the publisher (or a batch): schedule adherence and
+     * the cycle duration metric.
+     */
+    static void recordCycle(SensorSchedule& schedule, const SensorHub::Components::SampleTiming& timing);
+
+    /**
+     * @brief Copies the numeric members of a reading into the sensor's snapshot slot.
+     * Runs on the scheduler thread, the only writer of every slot.
+     */
+    void updateSnapshot(const SensorSchedule& schedule, const nlohmann::json& reading) const;
+
+    /**
+     * @brief Appends the numeric members of a reading to the history, as channel
+     * <topic suffix>, and adds them to the rollups. Runs on the scheduler thread.
+     */
+    void recordSample(const SensorHub::Interfaces::ISensor& sensor, const nlohmann::json& reading);
+
+    /**
+     * @brief Publishes a finished rollup window to <topic base>/<suffix>/<window> and stores
+     * it in the history as channel <suffix>/<window>. Runs on the scheduler thread.
+     */
+    void publishRollup(const SensorHub::Components::RollupEngine::Rollup& rollup);
+
+    /**
+     * @brief A pre-encoded message on its way to the publisher thread.
+     */
+    struct OutgoingMessage {
+        std::string topic;
+        SensorHub::Components::Payload payload;
+        PublishClass publish_class = PublishClass::Telemetry;
+        int qos = 0;
+        bool retained = false;
+        std::chrono::seconds expiry{0};
+        std::shared_ptr<SensorHub::Components::TokenBucket> sensor_rate_limit; // The sensor's, if any
+        std::chrono::steady_clock::time_point sampled{}; // End of the sensor read, for readings
+    };
+
+    /**
+     * @brief Queues the sensor's retained metadata message once, ahead of its first reading.
+     * Runs on the sensor's publish lane.
+     */
+    void publishMetadataOnce(SensorSchedule& schedule, const SensorHub::Interfaces::ISensor& sensor);
+
+    /**
+     * @brief A message with the QoS and retained flag of its publish class.
+     */
+    OutgoingMessage outgoing(const std::string& topic, SensorHub::Components::Payload payload,
+                             PublishClass publish_class, SensorSchedule* sensor = nullptr) const;
+
+    /**
+     * @brief Hands a message to its lane of the publisher thread without waiting for the MQTT client.
+     * @return false if the publish queue dropped it (full, or shutting down).
+     */
+    bool enqueuePublish(OutgoingMessage message);
+
+    /**
+     * @brief Takes a token from the message's sensor and topic rate limits (publisher thread).
+     * @return false if either is exhausted; nothing is taken then.
+     */
+    bool withinRateLimits(const OutgoingMessage& message);
+
+    /**
+     * @brief Publishes a message, or stores it for later while the broker is unreachable.
+     * Without a store-and-forward queue the message is logged and dropped instead.
+     * Telemetry leaves the top of the in-flight window to alerts and state messages.
+     * Runs on the publisher thread.
+     * @return true if the message was published or stored.
+     */
+    bool publishOrStore(const OutgoingMessage& message);
+
+    /**
+     * @brief Publishes completed batches (or stores them while the broker is unreachable).
+     */
+    void publishBatches(std::vector<SensorHub::Components::PublishBatcher::Batch> batches);
+
+    /**
+     * @brief Coroutine that flushes batches whose latency cap has passed.
+     */
+    SensorHub::Coro::Task<void> batchFlushLoop();
+
+    /**
+     * @brief Periodic work on the publisher thread: syncs the store-and-forward queue to
+     * disk on an interval and, while connected, drains it at the configured rate.
+     */
+    void serviceStoreForward();
+
+    /**
+     * @brief Periodic work on the publisher thread: writes aged history blocks and syncs
+     * the history to disk on an interval.
+     */
+    void serviceHistory();
+
+    /**
+     * @brief Coroutine for periodic housekeeping: executor stats and timing reports.
+     */
+    SensorHub::Coro::Task<void> maintenanceLoop();
+
+    /**
+     * @brief Logs per-stage queue depths of the executor.
+     */
+    void logExecutorStats() const;
+
+    /**
+     * @brief Logs the MQTT in-flight window (unacknowledged messages, rejections, ack latency),
+     * the publish queue per class, sample-to-client latency and, for a "loop://" broker,
+     * what it has received.
+     */
+    void logPublisherStats() const;
+
+    /**
+     * @brief Logs the messages received by the loopback broker (rate, bytes per message).
+     */
+    void logLoopbackStats() const;
+
+    /**
+     * @brief Logs per-sensor schedule adherence (percentiles, missed deadlines, skipped cycles).
+     */
+    void logTimingReport() const;
+
+    /**
+     * @brief Static signal handler function to request shutdown (or, on SIGHUP, a config reload).
      * @param signum Signal number received.
      */
     static void signalHandler(int signum);
 
     // --- Loaded Configuration ---
+    std::string config_path_;
+    nlohmann::json config_; // As loaded at startup; a reload only applies its "sensors" array
     std::string mqtt_broker_address_;
     std::string mqtt_client_id_base_;
     std::string mqtt_topic_base_;
-    std::chrono::seconds global_publish_interval_{10}; // <<< ADDED Declaration
+    std::chrono::milliseconds global_publish_interval_{10000}; // <<< ADDED Declaration
+    bool retained_metadata_ = false; // platform/sensor_type on <topic>/meta instead of in every payload
 
     // --- Active Components ---
     std::string platform_name_;
     std::string mqtt_client_id_;
+    // Before everything it instruments (bus managers, MQTT client); served on /metrics
+    SensorHub::Components::MetricsRegistry metrics_;
     // Sensor instances built by SensorBuilder
     std::vector<std::unique_ptr<SensorHub::Interfaces::ISensor>> sensors_; // <<< ADDED Declaration
+    // Kept for reloads: knows the running sensor configs and owns the bus managers
+    std::unique_ptr<SensorHub::Builder::SensorBuilder> sensor_builder_;
     std::unique_ptr<SensorHub::Components::MqttPublisher> mqtt_client_;
+    std::unique_ptr<SensorHub::Components::MqttSink> mqtt_sink_; // The broker; falls back to store_forward
+    SensorHub::Components::SinkSet local_sinks_;                  // Best effort, publisher thread only
+    std::unique_ptr<SensorHub::Components::SnapshotWriter> snapshot_; // Set when snapshot.enabled
+    std::unique_ptr<SensorHub::Components::PayloadEncoder> encoder_;
+    std::unique_ptr<SensorHub::Components::BinaryCodec> binary_codec_; // Set when wire_format.encoding is "binary"
+
+    // --- Batching ---
+    enum class BatchMode { Off, Sensor, Device };
+    BatchMode batch_mode_ = BatchMode::Off;
+    SensorHub::Components::PublishBatcher::Limits batch_defaults_;
+    std::map<std::string, nlohmann::json> batch_overrides_; // Per topic suffix
+    uint32_t batch_backpressure_factor_ = 4; // Count/age stretch while the in-flight window is half full
+    std::unique_ptr<SensorHub::Components::PublishBatcher> batcher_;
+    SensorHub::Components::PayloadPool payload_pool_; // Reusable buffers for encoded payloads
+
+    // --- Store and Forward ---
+    std::unique_ptr<SensorHub::Components::SegmentQueue> spool_; // Set when store_forward.enabled
+    double spool_drain_rate_ = 20.0;                              // Messages per second after a reconnect
+    std::chrono::milliseconds spool_sync_interval_{5000};
+    std::chrono::milliseconds spool_shutdown_deadline_{2000};
+    // Drain state, only touched on the publisher thread
+    std::optional<SensorHub::Components::TokenBucket> spool_bucket_;
+    uint64_t spool_drained_ = 0;
+    std::chrono::steady_clock::time_point spool_next_sync_;
+
+    // --- History ---
+    std::unique_ptr<SensorHub::Components::TimeSeriesStore> history_; // Set when history.enabled
+    std::chrono::milliseconds history_sync_interval_{10000};
+    std::chrono::steady_clock::time_point history_next_sync_; // Publisher thread only
+    std::vector<SensorHub::Components::TimeSeriesStore::Value> sample_values_; // Scratch, scheduler thread only
+
+    // --- Rollups (scheduler thread only) ---
+    std::unique_ptr<SensorHub::Components::RollupEngine> rollups_; // Set when rollups.enabled
+    SensorHub::Components::RollupEngine::Emit rollup_emit_;
+    bool rollups_publish_ = true;
+    bool rollups_store_ = false;
+    uint64_t rollups_emitted_ = 0;
+    SensorHub::Components::TimestampFormatter rollup_timestamps_;
+    std::string rollup_channel_;                                          // Scratch
+    std::vector<std::string> rollup_names_;                               // Scratch
+    std::vector<SensorHub::Components::TimeSeriesStore::Value> rollup_values_; // Scratch
+
+    // --- Local HTTP API (after the history: stopped before the store closes) ---
+    std::unique_ptr<SensorHub::Components::LiveFeed> live_feed_; // Set when http.live; outlives the server
+    std::unique_ptr<SensorHub::Components::HistoryApi> history_api_;
+    std::unique_ptr<SensorHub::Components::HttpServer> http_server_; // Set when http.enabled
+
+    // --- Priorities and Rate Limits ---
+    std::array<ClassPolicy, PUBLISH_CLASS_COUNT> class_policies_{
+        {{1, false, 8, std::chrono::seconds{0}}, {1, true, 4, std::chrono::seconds{0}}, {0, false, 1, std::chrono::seconds{0}}}};
+    SensorHub::Components::DispatchQueue<OutgoingMessage>::Schedule class_schedule_ =
+        SensorHub::Components::DispatchQueue<OutgoingMessage>::Schedule::Weighted;
+    std::map<std::string, PublishClass> sensor_classes_;                   // Per topic suffix; default telemetry
+    std::map<std::string, std::pair<double, double>> sensor_rate_limits_; // Per topic suffix: rate, burst
+    std::map<std::string, SensorHub::Components::TokenBucket> topic_rate_limits_; // Publisher thread only
+    std::atomic<uint64_t> rate_limited_{0};
+
+    // --- Publisher Thread ---
+    // Pipeline stages only push here; one thread talks to the MQTT client and the spool
+    std::unique_ptr<SensorHub::Components::DispatchQueue<OutgoingMessage>> publish_queue_;
+    // Sensor read to hand-over to the MQTT client; on a loopback broker that is arrival
+    SensorHub::Components::LatencyHistogram sample_latency_;
+
+    // --- Loopback Broker ---
+    // Set when broker_address is "loop://<name>": messages stay in-process and are recorded
+    std::shared_ptr<SensorHub::Components::LoopbackBroker> loopback_broker_;
+    std::string loopback_csv_; // Arrival log written at shutdown, if set
+
+    // --- Config Reload ---
+    int config_watch_fd_ = -1; // inotify on the config file's directory, if reload.watch_file
+    std::string config_topic_; // Retained MQTT config topic, if any
+    std::mutex remote_config_mutex_;
+    std::optional<std::string> remote_config_; // Latest config message, until the run() thread applies it
+    std::map<std::string, uint32_t> snapshot_slots_; // Per topic suffix, so a rebuilt sensor keeps its slot
 
     // --- Sensor Timing ---
-    // Map sensor pointer to its next publish time point
-    std::map<SensorHub::Interfaces::ISensor*, std::chrono::steady_clock::time_point> next_publish_times_; // <<< ADDED Declaration
+    // Map sensor pointer to its schedule and pipeline state
+    std::map<SensorHub::Interfaces::ISensor*, std::unique_ptr<SensorSchedule>> schedules_;
+    // Sensors removed by a reload whose sampling loop or pipeline may still use them
+    std::vector<std::pair<std::unique_ptr<SensorHub::Interfaces::ISensor>, std::unique_ptr<SensorSchedule>>> retired_sensors_;
+    // Publish ordering lanes, one per bus (key = bus id)
+    std::map<std::string, std::shared_ptr<SensorHub::Components::SequencedLane>> bus_lanes_;
+    std::chrono::seconds stats_log_interval_{60};
+    std::chrono::seconds timing_report_interval_{60};
+
+    // Drives the sampling coroutines on the run() thread
+    SensorHub::Coro::Scheduler scheduler_;
+
+    // Worker pool for the sample pipeline. Declared last so it is destroyed (drained) first.
+    std::unique_ptr<SensorHub::Components::WorkStealingExecutor> executor_;
+
+    // Upper bound on a single idle wait so shutdown stays responsive
+    static constexpr std::chrono::milliseconds MAX_IDLE_SLEEP{100};
+
+    // How often a rebuilt sensor checks whether the instance it replaces has finished
+    static constexpr std::chrono::milliseconds RETIRED_POLL_INTERVAL{10};
+
+    // In-flight window share telemetry may fill; the rest is kept for alerts and state messages
+    static constexpr double TELEMETRY_WINDOW_SHARE = 0.75;
 
-    // Static flag for signal handling
+    // Static flags for signal handling
     static std::atomic<bool> shutdown_requested_;
+    static std::atomic<bool> reload_requested_; // SIGHUP
 };
 
 } // namespace SensorHub::App
@@ -10,6 +10,10 @@
 #endif
 
 #include "Interfaces/sensor_config.h"
+#include "Metrics/process_metrics.h"
+#include "Sinks/rotating_file_sink.h"
+#include "Sinks/udp_multicast_sink.h"
+#include "Sinks/unix_datagram_sink.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <fstream>
@@ -20,7 +24,14 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <sys/inotify.h>
+#include <unistd.h>
 
 // No longer need conditional includes for I2C managers here
 // No longer need BME280 specific headers here (rely on ISensor)
@@ -37,24 +48,55 @@ using namespace std::chrono_literals;
 
 namespace SensorHub::App {
 
+namespace {
+
+// Config names of the publish classes, in App::PublishClass order
+constexpr std::array<const char*, 3> PUBLISH_CLASS_NAMES{"alerts", "state", "telemetry"};
+
+size_t publishClassIndex(const std::string& name) {
+    for (size_t i = 0; i < PUBLISH_CLASS_NAMES.size(); ++i) {
+        if (name == PUBLISH_CLASS_NAMES[i]) return i;
+    }
+    throw std::runtime_error("Unknown publish class '" + name + "' (expected \"alerts\", \"state\" or \"telemetry\").");
+}
+
+std::pair<double, double> parseRateLimit(const std::string& key, const json& entry) {
+    const double rate = entry.at("rate_per_sec").get<double>();
+    const double burst = entry.value("burst", std::max(1.0, rate));
+    if (!(rate > 0.0) || !(burst >= 1.0)) {
+        throw std::runtime_error("Rate limit for '" + key + "' needs rate_per_sec > 0 and burst >= 1.");
+    }
+    return {rate, burst};
+}
+
+// Clears a schedule's in_flight flag when the last step of its sample ends, however it ends;
+// a flag left set would make samplingLoop() skip the sensor for good
+class InFlightRelease {
+public:
+    explicit InFlightRelease(std::atomic<bool>& in_flight) : in_flight_(in_flight) {}
+    ~InFlightRelease() { in_flight_.store(false); }
+    InFlightRelease(const InFlightRelease&) = delete;
+    InFlightRelease& operator=(const InFlightRelease&) = delete;
+private:
+    std::atomic<bool>& in_flight_;
+};
+
+} // namespace
+
 // Initialize static member
 std::atomic<bool> App::shutdown_requested_ = false;
+std::atomic<bool> App::reload_requested_ = false;
 
 // Static Signal Handler
 void App::signalHandler(int signum) {
+    if (signum == SIGHUP) {
+        reload_requested_.store(true); // Picked up by the next maintenance tick
+        return;
+    }
     std::cout << "\nInterrupt signal (" << signum << ") received. Requesting shutdown..." << std::endl;
     shutdown_requested_.store(true);
 }
 
-// Helper: Get Timestamp (Free Function)
-std::string getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto itt = std::chrono::system_clock::to_time_t(now);
-    std::ostringstream ss;
-    ss << std::put_time(std::gmtime(&itt), "%FT%TZ");
-    return ss.str();
-}
-
 
 // --- Load Configuration Method ---
 // Now just parses the file and returns the json object
@@ -92,16 +134,68 @@ void App::initMqtt(const nlohmann::json& config) {
         mqtt_client_id_base_ = mqtt_config.at("client_id_base").get<std::string>();
         mqtt_topic_base_ = mqtt_config.at("topic_base").get<std::string>();
         // Load global interval (or keep default)
-        global_publish_interval_ = std::chrono::seconds(config.value("global_publish_interval_sec", 10));
+        global_publish_interval_ = Interfaces::SensorConfig::parseInterval(config, global_publish_interval_, "global_publish_interval");
 
 
         mqtt_client_id_ = mqtt_client_id_base_ + "_" + platform_name_;
         std::replace(mqtt_client_id_.begin(), mqtt_client_id_.end(), ' ', '_');
 
         std::cout << "Initializing MQTT client for broker " << mqtt_broker_address_ << " with ID " << mqtt_client_id_ << "..." << std::endl;
-        mqtt_client_ = std::make_unique<MqttPublisher>(mqtt_broker_address_, mqtt_client_id_);
+        MqttPublisher::Options mqtt_options;
+        if (mqtt_config.contains("reconnect")) {
+            const auto& reconnect = mqtt_config.at("reconnect");
+            auto& backoff = mqtt_options.backoff;
+            backoff.initial_delay = std::chrono::milliseconds(reconnect.value("initial_delay_ms", backoff.initial_delay.count()));
+            backoff.max_delay = std::chrono::milliseconds(reconnect.value("max_delay_ms", backoff.max_delay.count()));
+            backoff.multiplier = reconnect.value("multiplier", backoff.multiplier);
+            backoff.jitter = reconnect.value("jitter", backoff.jitter);
+            mqtt_options.connect_timeout = std::chrono::milliseconds(
+                reconnect.value("connect_timeout_ms", mqtt_options.connect_timeout.count()));
+        }
+        if (mqtt_config.contains("v5")) {
+            const auto& v5 = mqtt_config.at("v5");
+            mqtt_options.mqtt5 = v5.value("enabled", true);
+            mqtt_options.topic_aliases = v5.value("topic_aliases", mqtt_options.topic_aliases);
+        }
+        if (mqtt_config.contains("client")) {
+            const auto client = mqtt_config.at("client").get<std::string>();
+            const auto backend = MqttPublisher::parseBackend(client);
+            if (!backend) {
+                throw std::runtime_error("Unknown or unavailable mqtt.client '" + client + "' (expected \"paho\" or \"epoll\").");
+            }
+            mqtt_options.backend = *backend;
+        }
+        const auto metadata = mqtt_config.value("metadata", std::string("payload"));
+        if (metadata == "retained") {
+            retained_metadata_ = true;
+        } else if (metadata != "payload") {
+            throw std::runtime_error("Unknown mqtt.metadata '" + metadata + "' (expected \"payload\" or \"retained\").");
+        }
+        if (mqtt_config.contains("inflight")) {
+            const auto& inflight = mqtt_config.at("inflight");
+            mqtt_options.inflight.max_messages = inflight.value("max_messages", mqtt_options.inflight.max_messages);
+            mqtt_options.inflight.max_bytes = inflight.value("max_bytes", mqtt_options.inflight.max_bytes);
+        }
+        mqtt_options.metrics = &metrics_;
+        mqtt_client_ = std::make_unique<MqttPublisher>(mqtt_broker_address_, mqtt_client_id_, mqtt_options);
+        mqtt_sink_ = std::make_unique<MqttSink>(*mqtt_client_);
         std::cout << "MQTT client initialized." << std::endl;
-        std::cout << "Global publish interval: " << global_publish_interval_.count() << "s" << std::endl;
+        loopback_broker_ = LoopbackBroker::forAddress(mqtt_broker_address_);
+        if (loopback_broker_) {
+            loopback_csv_ = mqtt_config.value("loopback_csv", std::string());
+            std::cout << "Loopback broker: messages stay in-process"
+                      << (loopback_csv_.empty() ? "" : ", arrivals logged to " + loopback_csv_) << "." << std::endl;
+        }
+
+        PayloadEncoder::Options encoder_options;
+        encoder_options.topic_base = mqtt_topic_base_;
+        encoder_options.platform = platform_name_;
+        encoder_options.static_metadata = !retained_metadata_;
+        if (mqtt_config.value("timestamp_millis", false)) {
+            encoder_options.timestamp_precision = TimestampFormatter::Precision::Milliseconds;
+        }
+        encoder_ = std::make_unique<PayloadEncoder>(std::move(encoder_options));
+        std::cout << "Global publish interval: " << global_publish_interval_.count() << "ms" << std::endl;
 
     } catch (const json::out_of_range& e) { throw std::runtime_error("Missing required MQTT configuration key: " + std::string(e.what())); }
       catch (const json::type_error& e)   { throw std::runtime_error("Incorrect type for MQTT configuration key: " + std::string(e.what())); }
@@ -109,12 +203,620 @@ void App::initMqtt(const nlohmann::json& config) {
 }
 
 
+// --- Initialize Executor ---
+void App::initExecutor(const nlohmann::json& config) {
+    size_t workers = std::min<size_t>(4, std::max(1u, std::thread::hardware_concurrency()));
+    try {
+        if (config.contains("executor")) {
+            const auto& exec_config = config.at("executor");
+            workers = exec_config.value("worker_threads", workers);
+            stats_log_interval_ = std::chrono::seconds(exec_config.value("stats_interval_sec", 60));
+        }
+    } catch (const json::type_error& e) {
+        throw std::runtime_error("Incorrect type for executor configuration key: " + std::string(e.what()));
+    }
+    executor_ = std::make_unique<WorkStealingExecutor>(workers);
+}
+
+// --- Initialize Metrics ---
+void App::initMetrics(const nlohmann::json& config) {
+    try {
+        if (config.contains("metrics")) {
+            const auto& metrics_config = config.at("metrics");
+            timing_report_interval_ = std::chrono::seconds(metrics_config.value("report_interval_sec", 60));
+        }
+    } catch (const json::type_error& e) {
+        throw std::runtime_error("Incorrect type for metrics configuration key: " + std::string(e.what()));
+    }
+    if (timing_report_interval_.count() <= 0) {
+        throw std::runtime_error("metrics.report_interval_sec must be positive.");
+    }
+    registerProcessMetrics(metrics_);
+    for (size_t i = 0; i < static_cast<size_t>(Stage::Count); ++i) {
+        const auto& counters = executor_->counters(static_cast<Stage>(i));
+        metrics_.callback("sensorhub_executor_queued_tasks", "Pipeline tasks waiting for a worker, by stage.",
+                          MetricsRegistry::Type::Gauge, {{"stage", stageName(static_cast<Stage>(i))}},
+                          [&counters] { return static_cast<double>(counters.queued.load(std::memory_order_relaxed)); });
+    }
+}
+
+// --- Initialize Wire Format ---
+void App::initWireFormat(const nlohmann::json& config) {
+    if (!config.contains("wire_format")) return;
+    try {
+        const auto& wire_config = config.at("wire_format");
+        const auto encoding = wire_config.value("encoding", std::string("json"));
+        if (encoding == "json") return;
+        if (encoding != "binary") {
+            throw std::runtime_error("Unknown wire_format.encoding '" + encoding + "' (expected \"json\" or \"binary\").");
+        }
+
+        BinaryCodec::Options options;
+        options.default_scale = wire_config.value("default_scale", options.default_scale);
+        if (wire_config.contains("scales")) {
+            options.scales = wire_config.at("scales").get<std::map<std::string, double>>();
+        }
+        if (wire_config.contains("units")) {
+            options.units = wire_config.at("units").get<std::map<std::string, std::string>>();
+        }
+        binary_codec_ = std::make_unique<BinaryCodec>(std::move(options));
+        std::cout << "Wire format: binary frames with retained schemas on <topic>/schema" << std::endl;
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect wire_format configuration: " + std::string(e.what()));
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error("Incorrect wire_format configuration: " + std::string(e.what()));
+    }
+}
+
+// --- Initialize Batching ---
+void App::initBatching(const nlohmann::json& config) {
+    if (!config.contains("batching")) return;
+    std::optional<TimeSeriesEncoder::Options> columnar; // Set for gorilla compression
+    try {
+        const auto& batch_config = config.at("batching");
+        const auto mode = batch_config.value("mode", std::string("off"));
+        if (mode == "off") return;
+        if (mode == "sensor") {
+            batch_mode_ = BatchMode::Sensor;
+        } else if (mode == "device") {
+            batch_mode_ = BatchMode::Device;
+        } else {
+            throw std::runtime_error("Unknown batching.mode '" + mode + "' (expected \"off\", \"sensor\" or \"device\").");
+        }
+
+        batch_defaults_.max_count = batch_config.value("max_count", batch_defaults_.max_count);
+        batch_defaults_.max_bytes = batch_config.value("max_bytes", batch_defaults_.max_bytes);
+        batch_defaults_.max_age = std::chrono::milliseconds(batch_config.value("max_age_ms", batch_defaults_.max_age.count()));
+        batch_backpressure_factor_ = batch_config.value("backpressure_factor", batch_backpressure_factor_);
+        if (batch_config.contains("sensors")) {
+            for (const auto& [suffix, entry] : batch_config.at("sensors").items()) {
+                batch_overrides_[suffix] = entry;
+            }
+        }
+
+        const auto compression = batch_config.value("compression", std::string("none"));
+        if (compression == "gorilla") {
+            if (batch_mode_ != BatchMode::Sensor) {
+                throw std::runtime_error("batching.compression \"gorilla\" needs batching.mode \"sensor\".");
+            }
+            columnar = TimeSeriesEncoder::Options{};
+            const auto values = batch_config.value("value_encoding", std::string("xor"));
+            if (values == "fixed") {
+                columnar->values = TimeSeriesEncoder::ValueEncoding::Fixed;
+            } else if (values != "xor") {
+                throw std::runtime_error("Unknown batching.value_encoding '" + values + "' (expected \"xor\" or \"fixed\").");
+            }
+            columnar->default_scale = batch_config.value("default_scale", columnar->default_scale);
+            if (batch_config.contains("scales")) {
+                columnar->scales = batch_config.at("scales").get<std::map<std::string, double>>();
+            }
+        } else if (compression != "none") {
+            throw std::runtime_error("Unknown batching.compression '" + compression + "' (expected \"none\" or \"gorilla\").");
+        }
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect batching configuration: " + std::string(e.what()));
+    }
+    if (batch_defaults_.max_count == 0 || batch_defaults_.max_bytes == 0 || batch_defaults_.max_age.count() <= 0) {
+        throw std::runtime_error("batching limits (max_count, max_bytes, max_age_ms) must be positive.");
+    }
+    if (batch_backpressure_factor_ == 0) {
+        throw std::runtime_error("batching.backpressure_factor must be at least 1.");
+    }
+    if (columnar) {
+        const bool bad_scale = columnar->default_scale <= 0.0 ||
+            std::any_of(columnar->scales.begin(), columnar->scales.end(), [](const auto& entry) { return entry.second <= 0.0; });
+        if (bad_scale) throw std::runtime_error("batching scales must be positive.");
+    }
+
+    if (columnar) {
+        batcher_ = std::make_unique<PublishBatcher>(payload_pool_, PublishBatcher::Format::Columnar, std::move(*columnar));
+    } else {
+        batcher_ = std::make_unique<PublishBatcher>(
+            payload_pool_, binary_codec_ ? PublishBatcher::Format::Binary : PublishBatcher::Format::Json);
+    }
+    std::cout << "Batching per " << (batch_mode_ == BatchMode::Device ? "device" : "sensor")
+              << ": up to " << batch_defaults_.max_count << " readings / " << batch_defaults_.max_bytes
+              << " bytes / " << batch_defaults_.max_age.count() << "ms"
+              << (batcher_->format() == PublishBatcher::Format::Columnar ? ", gorilla-compressed" : "") << std::endl;
+}
+
+// --- Initialize Store and Forward ---
+void App::initStoreForward(const nlohmann::json& config) {
+    if (!config.contains("store_forward")) return;
+    SegmentQueue::Options options;
+    try {
+        const auto& spool_config = config.at("store_forward");
+        if (!spool_config.value("enabled", true)) return;
+        options.directory = spool_config.value("directory", options.directory.string());
+        options.segment_bytes = spool_config.value("segment_bytes", options.segment_bytes);
+        options.max_bytes = spool_config.value("max_bytes", options.max_bytes);
+        spool_drain_rate_ = spool_config.value("drain_rate_per_sec", spool_drain_rate_);
+        spool_sync_interval_ = std::chrono::milliseconds(spool_config.value("sync_interval_ms", spool_sync_interval_.count()));
+        spool_shutdown_deadline_ = std::chrono::milliseconds(
+            spool_config.value("shutdown_flush_ms", spool_shutdown_deadline_.count()));
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect store_forward configuration: " + std::string(e.what()));
+    }
+    if (!(spool_drain_rate_ > 0.0) || spool_sync_interval_.count() <= 0 || spool_shutdown_deadline_.count() < 0) {
+        throw std::runtime_error("store_forward drain_rate_per_sec and sync_interval_ms must be positive.");
+    }
+    try {
+        spool_ = std::make_unique<SegmentQueue>(std::move(options));
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error("Incorrect store_forward configuration: " + std::string(e.what()));
+    }
+    std::cout << "Store and forward: up to " << spool_->options().max_bytes << " bytes in "
+              << spool_->options().directory.string() << ", drained at " << spool_drain_rate_ << " messages/s"
+              << std::endl;
+    // Backlog records are popped once the publisher accepts them; like live QoS 1/2 readings,
+    // those the broker never acknowledges come back here instead of being lost with the connection
+    mqtt_client_->setUnackedHandler([this](std::vector<MqttPublisher::UnackedMessage> messages) {
+        for (const auto& message : messages) {
+            if (!spool_->push(message.topic, message.payload, message.qos, message.retained)) {
+                std::cerr << "Failed to store unacknowledged message for " << message.topic << "." << std::endl;
+            }
+        }
+        std::cout << "Stored " << messages.size() << " unacknowledged messages (" << spool_->size() << " pending)."
+                  << std::endl;
+    });
+}
+
+// --- Initialize Local Sinks ---
+void App::initSinks(const nlohmann::json& config) {
+    if (!config.contains("sinks")) return;
+    try {
+        for (const auto& sink_config : config.at("sinks")) {
+            if (!sink_config.value("enabled", true)) continue;
+            const auto type = sink_config.at("type").get<std::string>();
+            if (type == "udp_multicast") {
+                UdpMulticastSink::Options options;
+                options.group = sink_config.at("group").get<std::string>();
+                options.port = sink_config.at("port").get<uint16_t>();
+                options.ttl = sink_config.value("ttl", options.ttl);
+                options.interface_address = sink_config.value("interface", options.interface_address);
+                options.loopback = sink_config.value("loopback", options.loopback);
+                local_sinks_.add(std::make_unique<UdpMulticastSink>(std::move(options)));
+            } else if (type == "unix_datagram") {
+                local_sinks_.add(std::make_unique<UnixDatagramSink>(sink_config.at("path").get<std::string>()));
+            } else if (type == "file") {
+                RotatingFileSink::Options options;
+                options.path = sink_config.at("path").get<std::string>();
+                options.max_bytes = sink_config.value("max_bytes", options.max_bytes);
+                options.max_files = sink_config.value("max_files", options.max_files);
+                local_sinks_.add(std::make_unique<RotatingFileSink>(std::move(options)));
+            } else {
+                throw std::runtime_error("Unknown sink type '" + type +
+                                         "' (expected \"udp_multicast\", \"unix_datagram\" or \"file\").");
+            }
+        }
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect sinks configuration: " + std::string(e.what()));
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error("Incorrect sinks configuration: " + std::string(e.what()));
+    }
+    for (size_t i = 0; i < local_sinks_.size(); ++i) {
+        std::cout << "Sink: " << local_sinks_.sink(i).type() << " " << local_sinks_.sink(i).describe() << std::endl;
+    }
+}
+
+// --- Initialize Shared-Memory Snapshot ---
+void App::initSnapshot(const nlohmann::json& config) {
+    if (!config.contains("snapshot")) return;
+    SnapshotWriter::Options options;
+    try {
+        const auto& snapshot_config = config.at("snapshot");
+        if (!snapshot_config.value("enabled", true)) return;
+        options.name = snapshot_config.value("name", options.name);
+        options.slots = snapshot_config.value("slots", options.slots);
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect snapshot configuration: " + std::string(e.what()));
+    }
+    try {
+        snapshot_ = std::make_unique<SnapshotWriter>(std::move(options));
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error("Incorrect snapshot configuration: " + std::string(e.what()));
+    }
+    std::cout << "Snapshot: latest readings in shared memory " << snapshot_->name() << std::endl;
+}
+
+void App::updateSnapshot(const SensorSchedule& schedule, const json& reading) const {
+    std::array<SnapshotWriter::Value, SnapshotLayout::MAX_FIELDS> values;
+    size_t count = 0;
+    for (const auto& [key, value] : reading.items()) {
+        if (!value.is_number()) continue;
+        values[count++] = {key, value.get<double>()};
+        if (count == values.size()) break;
+    }
+    snapshot_->update(*schedule.snapshot_slot, std::chrono::system_clock::now(),
+                      std::span<const SnapshotWriter::Value>(values.data(), count));
+}
+
+// --- Initialize History ---
+void App::initHistory(const nlohmann::json& config) {
+    if (!config.contains("history")) return;
+    TimeSeriesStore::Options options;
+    try {
+        const auto& history_config = config.at("history");
+        if (!history_config.value("enabled", true)) return;
+        options.directory = history_config.value("directory", options.directory.string());
+        options.segment_window = std::chrono::seconds(history_config.value("segment_window_sec", options.segment_window.count()));
+        options.segment_bytes = history_config.value("segment_bytes", options.segment_bytes);
+        options.max_bytes = history_config.value("max_bytes", options.max_bytes);
+        options.max_age = std::chrono::seconds(
+            static_cast<int64_t>(history_config.value("max_age_days", 0.0) * 86400.0));
+        options.block_points = history_config.value("block_points", options.block_points);
+        options.block_age = std::chrono::seconds(history_config.value("block_age_sec", options.block_age.count()));
+        history_sync_interval_ = std::chrono::milliseconds(
+            history_config.value("sync_interval_ms", history_sync_interval_.count()));
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect history configuration: " + std::string(e.what()));
+    }
+    try {
+        history_ = std::make_unique<TimeSeriesStore>(std::move(options));
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error("Incorrect history configuration: " + std::string(e.what()));
+    } catch (const std::runtime_error& e) {
+        // Unreadable storage: the hub still samples and publishes, only without a local history
+        std::cerr << "History disabled: " << e.what() << std::endl;
+        return;
+    }
+    std::cout << "History: readings stored in " << history_->options().directory.string() << " (up to "
+              << history_->options().max_bytes << " bytes, synced every " << history_sync_interval_.count()
+              << "ms)" << std::endl;
+}
+
+// --- Initialize Rollups ---
+void App::initRollups(const nlohmann::json& config) {
+    if (!config.contains("rollups")) return;
+    std::vector<RollupEngine::Window> windows;
+    try {
+        const auto& rollup_config = config.at("rollups");
+        if (!rollup_config.value("enabled", true)) return;
+        for (const auto& window : rollup_config.value("windows", json::array({"1m", "1h"}))) {
+            windows.push_back(RollupEngine::parseWindow(window.get<std::string>()));
+        }
+        rollups_publish_ = rollup_config.value("publish", rollups_publish_);
+        rollups_store_ = rollup_config.value("store", history_ != nullptr);
+        rollups_ = std::make_unique<RollupEngine>(std::move(windows));
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect rollups configuration: " + std::string(e.what()));
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error("Incorrect rollups configuration: " + std::string(e.what()));
+    }
+    if (rollups_store_ && !history_) {
+        throw std::runtime_error("Incorrect rollups configuration: \"store\" needs the history section enabled.");
+    }
+    rollup_emit_ = [this](const RollupEngine::Rollup& rollup) { publishRollup(rollup); };
+
+    std::cout << "Rollups: windows";
+    for (const auto& window : rollups_->windows()) std::cout << " " << window.name;
+    std::cout << (rollups_publish_ ? ", published to <topic>/<window>" : ", not published")
+              << (rollups_store_ ? ", stored in the history as <suffix>/<window>" : "") << std::endl;
+}
+
+void App::recordSample(const ISensor& sensor, const json& reading) {
+    sample_values_.clear();
+    for (const auto& [key, value] : reading.items()) {
+        if (value.is_number()) sample_values_.push_back({key, value.get<double>()});
+    }
+    const auto now = std::chrono::system_clock::now();
+    if (history_) history_->append(sensor.getTopicSuffix(), now, sample_values_);
+    if (rollups_) rollups_->add(sensor.getTopicSuffix(), now, sample_values_, rollup_emit_);
+}
+
+void App::publishRollup(const RollupEngine::Rollup& rollup) {
+    ++rollups_emitted_;
+    if (rollups_store_) {
+        RollupEngine::toValues(rollup, rollup_names_, rollup_values_);
+        rollup_channel_.assign(rollup.channel).append("/").append(rollup.window->name);
+        history_->append(rollup_channel_, rollup.start, rollup_values_);
+    }
+    if (!rollups_publish_) return;
+
+    json fields = json::object();
+    for (size_t i = 0; i < rollup.fields.size(); ++i) {
+        const auto& aggregate = rollup.aggregates[i];
+        if (aggregate.count == 0) {
+            fields[rollup.fields[i]] = {{"count", 0}};
+            continue;
+        }
+        fields[rollup.fields[i]] = {{"count", aggregate.count}, {"mean", aggregate.mean()},
+                                    {"stddev", std::sqrt(aggregate.variance())}, {"min", aggregate.min},
+                                    {"max", aggregate.max}, {"sum", aggregate.sum},
+                                    {"sum_squares", aggregate.sum_squares}, {"first", aggregate.first},
+                                    {"last", aggregate.last}};
+    }
+    std::string start;
+    std::string end;
+    rollup_timestamps_.append(rollup.start, TimestampFormatter::Precision::Seconds, start);
+    rollup_timestamps_.append(rollup.start + rollup.window->length, TimestampFormatter::Precision::Seconds, end);
+    const std::string suffix(rollup.channel);
+    const auto class_it = sensor_classes_.find(suffix);
+
+    Payload payload = payload_pool_.acquire();
+    PayloadEncoder::appendJson(json{{"window", rollup.window->name}, {"start", start}, {"timestamp", end},
+                                    {"platform", platform_name_}, {"topic_suffix", suffix}, {"fields", fields}},
+                               payload.buffer());
+    const std::string topic = mqtt_topic_base_ + "/" + suffix + "/" + rollup.window->name;
+    std::cout << "Publishing rollup to " << topic << ": " << payload.str() << std::endl;
+    enqueuePublish(outgoing(topic, std::move(payload),
+                            class_it != sensor_classes_.end() ? class_it->second : PublishClass::Telemetry));
+}
+
+PublishBatcher::Limits App::pressuredBatchLimits(const PublishBatcher::Limits& limits) const {
+    // Past half of the in-flight window, fill batches longer instead of sending more, smaller messages
+    if (mqtt_client_->window().utilisation() < 0.5) return limits;
+    PublishBatcher::Limits pressured = limits;
+    pressured.max_count *= batch_backpressure_factor_;
+    pressured.max_age *= batch_backpressure_factor_;
+    return pressured;
+}
+
+// --- Initialize Priorities and Rate Limits ---
+void App::initPriorities(const nlohmann::json& config) {
+    try {
+        if (config.contains("priorities")) {
+            const auto& priorities = config.at("priorities");
+            const auto schedule = priorities.value("schedule", std::string("weighted"));
+            if (schedule == "strict") {
+                class_schedule_ = DispatchQueue<OutgoingMessage>::Schedule::Strict;
+            } else if (schedule != "weighted") {
+                throw std::runtime_error("Unknown priorities.schedule '" + schedule + "' (expected \"weighted\" or \"strict\").");
+            }
+            if (priorities.contains("classes")) {
+                for (const auto& [name, entry] : priorities.at("classes").items()) {
+                    auto& policy = class_policies_[publishClassIndex(name)];
+                    policy.qos = entry.value("qos", policy.qos);
+                    policy.retained = entry.value("retained", policy.retained);
+                    policy.weight = entry.value("weight", policy.weight);
+                    policy.expiry = std::chrono::seconds(entry.value("expiry_sec", policy.expiry.count()));
+                    if (policy.qos < 0 || policy.qos > 2 || policy.weight == 0 || policy.expiry.count() < 0) {
+                        throw std::runtime_error("Publish class '" + name + "' needs qos 0-2, a positive weight and expiry_sec >= 0.");
+                    }
+                }
+            }
+            if (priorities.contains("sensors")) {
+                for (const auto& [suffix, name] : priorities.at("sensors").items()) {
+                    sensor_classes_[suffix] = static_cast<PublishClass>(publishClassIndex(name.get<std::string>()));
+                }
+            }
+        }
+        if (config.contains("rate_limits")) {
+            const auto& limits = config.at("rate_limits");
+            if (limits.contains("sensors")) {
+                for (const auto& [suffix, entry] : limits.at("sensors").items()) {
+                    sensor_rate_limits_[suffix] = parseRateLimit(suffix, entry);
+                }
+            }
+            if (limits.contains("topics")) {
+                for (const auto& [topic, entry] : limits.at("topics").items()) {
+                    const auto [rate, burst] = parseRateLimit(topic, entry);
+                    topic_rate_limits_.emplace(topic, TokenBucket(rate, burst));
+                }
+            }
+        }
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect priorities/rate_limits configuration: " + std::string(e.what()));
+    }
+    std::cout << "Publish classes (" << (class_schedule_ == DispatchQueue<OutgoingMessage>::Schedule::Strict ? "strict" : "weighted")
+              << "):";
+    for (size_t i = 0; i < PUBLISH_CLASS_COUNT; ++i) {
+        const auto& policy = class_policies_[i];
+        std::cout << " " << PUBLISH_CLASS_NAMES[i] << "[qos=" << policy.qos << (policy.retained ? " retained" : "")
+                  << " weight=" << policy.weight;
+        if (policy.expiry.count() > 0) std::cout << " expiry=" << policy.expiry.count() << "s";
+        std::cout << "]";
+    }
+    std::cout << "; " << sensor_rate_limits_.size() << " sensor and " << topic_rate_limits_.size()
+              << " topic rate limits" << std::endl;
+}
+
+// --- Initialize Publisher Thread ---
+void App::initPublishQueue(const nlohmann::json& config) {
+    DispatchQueue<OutgoingMessage>::Options options;
+    try {
+        if (config.contains("publish_queue")) {
+            const auto& queue_config = config.at("publish_queue");
+            options.capacity = queue_config.value("capacity", options.capacity);
+            options.block_timeout = std::chrono::milliseconds(
+                queue_config.value("block_timeout_ms", options.block_timeout.count()));
+            const auto overflow = queue_config.value("overflow", std::string("drop"));
+            if (overflow == "block") {
+                options.overflow = DispatchQueue<OutgoingMessage>::Overflow::Block;
+            } else if (overflow != "drop") {
+                throw std::runtime_error("Unknown publish_queue.overflow '" + overflow + "' (expected \"drop\" or \"block\").");
+            }
+        }
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect publish_queue configuration: " + std::string(e.what()));
+    }
+    if (options.capacity == 0 || options.block_timeout.count() < 0) {
+        throw std::runtime_error("publish_queue.capacity must be positive.");
+    }
+    options.tick_interval = MAX_IDLE_SLEEP;
+    options.schedule = class_schedule_;
+    options.lane_weights.clear();
+    for (const auto& policy : class_policies_) options.lane_weights.push_back(policy.weight);
+    DispatchQueue<OutgoingMessage>::TickHandler on_tick;
+    if (spool_ || history_) {
+        on_tick = [this] {
+            if (spool_) serviceStoreForward();
+            if (history_) serviceHistory();
+        };
+    }
+    publish_queue_ = std::make_unique<DispatchQueue<OutgoingMessage>>(
+        options,
+        [this](OutgoingMessage& message) {
+            // Local sinks first and unthrottled: the same buffer, microseconds after encoding
+            if (!local_sinks_.empty()) {
+                local_sinks_.send(SinkMessage{message.topic, message.payload, message.qos, message.retained, message.expiry});
+            }
+            if (!withinRateLimits(message)) {
+                rate_limited_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            publishOrStore(message);
+        },
+        std::move(on_tick));
+    for (size_t i = 0; i < PUBLISH_CLASS_COUNT; ++i) {
+        const MetricsRegistry::Labels labels{{"class", PUBLISH_CLASS_NAMES[i]}};
+        metrics_.callback("sensorhub_publish_queue_depth", "Messages waiting for the publisher thread, by class.",
+                          MetricsRegistry::Type::Gauge, labels,
+                          [this, i] { return static_cast<double>(publish_queue_->stats(i).depth); });
+        metrics_.callback("sensorhub_publish_queue_dropped_total", "Messages dropped by a full publish queue, by class.",
+                          MetricsRegistry::Type::Counter, labels,
+                          [this, i] { return static_cast<double>(publish_queue_->stats(i).dropped); });
+    }
+    std::cout << "Publish queue: " << publish_queue_->capacity() << " messages per class, "
+              << (options.overflow == DispatchQueue<OutgoingMessage>::Overflow::Block ? "block" : "drop")
+              << " when full" << std::endl;
+}
+
+// --- Initialize Local HTTP API ---
+void App::initHttp(const nlohmann::json& config) {
+    if (!config.contains("http")) return;
+    HttpServer::Options options;
+    bool live = true;
+    bool metrics = true;
+    std::string dashboard = "dashboard.html";
+    try {
+        const auto& http_config = config.at("http");
+        if (!http_config.value("enabled", true)) return;
+        live = http_config.value("live", live);
+        metrics = http_config.value("metrics", metrics);
+        dashboard = http_config.value("dashboard", dashboard);
+        options.listen = http_config.value("listen", options.listen);
+        options.max_connections = http_config.value("max_connections", options.max_connections);
+        options.idle_timeout = std::chrono::milliseconds(
+            http_config.value("idle_timeout_ms", options.idle_timeout.count()));
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect http configuration: " + std::string(e.what()));
+    }
+    try {
+        http_server_ = std::make_unique<HttpServer>(std::move(options));
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Incorrect http configuration: " + std::string(e.what()));
+    }
+    if (history_) {
+        history_api_ = std::make_unique<HistoryApi>(*history_);
+        history_api_->attach(*http_server_);
+    }
+    if (live) {
+        live_feed_ = std::make_unique<LiveFeed>(platform_name_);
+        live_feed_->attach(*http_server_);
+    }
+    if (!dashboard.empty()) {
+        // Read per request, so an edited dashboard shows up on the next reload of the page
+        const auto serve_dashboard = [dashboard](const HttpServer::Request&, HttpServer::Response& response) {
+            std::ifstream file(dashboard, std::ios::binary);
+            if (!file) {
+                response.status = 404;
+                response.body = R"({"error":"Dashboard not found"})";
+                return;
+            }
+            response.content_type = "text/html; charset=utf-8";
+            response.body.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        };
+        http_server_->route("/", serve_dashboard);
+        http_server_->route("/dashboard.html", serve_dashboard);
+    }
+    if (metrics) {
+        http_server_->route("/metrics", [this](const HttpServer::Request&, HttpServer::Response& response) {
+            response.content_type = MetricsRegistry::CONTENT_TYPE;
+            metrics_.writeText(response.body);
+        });
+    }
+    http_server_->start();
+    std::cout << "HTTP API: listening on " << http_server_->address()
+              << (history_ ? " (history queries under /api)" : "") << (live ? " (live feed on /live)" : "")
+              << (metrics ? " (metrics on /metrics)" : "") << std::endl;
+}
+
+// --- Initialize Config Reload ---
+void App::initReload(const nlohmann::json& config) {
+    bool watch_file = false;
+    try {
+        if (config.contains("reload")) {
+            const auto& reload_config = config.at("reload");
+            watch_file = reload_config.value("watch_file", false);
+            config_topic_ = reload_config.value("mqtt_topic", std::string());
+        }
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect reload configuration: " + std::string(e.what()));
+    }
+
+    if (watch_file) {
+        // Watch the directory: editors often save by renaming a new file over the old one
+        std::string dir = std::filesystem::path(config_path_).parent_path().string();
+        if (dir.empty()) dir = ".";
+        config_watch_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (config_watch_fd_ < 0 || inotify_add_watch(config_watch_fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            const std::string error = std::strerror(errno);
+            if (config_watch_fd_ >= 0) close(config_watch_fd_);
+            config_watch_fd_ = -1;
+            throw std::runtime_error("Incorrect reload configuration: cannot watch " + dir + ": " + error);
+        }
+    }
+    if (!config_topic_.empty()) {
+        // Runs on an MQTT thread; the run() thread applies it with the next maintenance tick
+        mqtt_client_->subscribe(config_topic_, 1, [this](std::string_view, std::string_view payload, bool) {
+            if (payload.empty()) return; // Retained config cleared
+            std::lock_guard<std::mutex> lock(remote_config_mutex_);
+            remote_config_ = std::string(payload);
+        });
+    }
+    std::cout << "Config reload: SIGHUP" << (watch_file ? ", changes to " + config_path_ : std::string())
+              << (config_topic_.empty() ? std::string() : ", MQTT topic " + config_topic_) << std::endl;
+}
+
+std::optional<PublishBatcher::Limits> App::batchLimitsFor(const std::string& topic_suffix) const {
+    if (!batcher_) return std::nullopt;
+    PublishBatcher::Limits limits = batch_defaults_;
+    const auto it = batch_overrides_.find(topic_suffix);
+    if (it == batch_overrides_.end()) return limits;
+
+    try {
+        const auto& entry = it->second;
+        if (!entry.value("enabled", true)) return std::nullopt;
+        limits.max_count = entry.value("max_count", limits.max_count);
+        limits.max_bytes = entry.value("max_bytes", limits.max_bytes);
+        limits.max_age = std::chrono::milliseconds(entry.value("max_age_ms", limits.max_age.count()));
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Incorrect batching override for '" + topic_suffix + "': " + e.what());
+    }
+    if (limits.max_count == 0 || limits.max_bytes == 0 || limits.max_age.count() <= 0) {
+        throw std::runtime_error("Batching limits for '" + topic_suffix + "' must be positive.");
+    }
+    return limits;
+}
+
 // --- Constructor ---
 App::App(const std::string& config_path) {
     std::cout << "Constructing App..." << std::endl;
     try {
         // Load the entire config
         json config = loadConfig(config_path);
+        config_path_ = config_path;
 
         // Initialize MQTT client first (needs mqtt section)
         initMqtt(config);
@@ -122,17 +824,31 @@ App::App(const std::string& config_path) {
     
         // --- Build with Real Sensors via SensorBuilder ---
         std::cout << "Initializing with SensorBuilder (BUILD_WITH_MOCKS not defined)..." << std::endl;
-        SensorBuilder builder; // Create builder locally
-        sensors_ = builder.buildSensors(config.at("sensors")); // Use builder
+        sensor_builder_ = std::make_unique<SensorBuilder>(&metrics_); // Kept for config reloads
+        sensors_ = sensor_builder_->buildSensors(config.at("sensors"));
 
         if (sensors_.empty()) {
              std::cerr << "Warning: No sensors were successfully created by the builder." << std::endl;
         }
-        // Initialize sensor timing map
-        auto now = std::chrono::steady_clock::now();
-        for(const auto& sensor : sensors_) {
-            next_publish_times_[sensor.get()] = now; // Schedule immediate first read
+        // Start the worker pool and assign each sensor to its bus lane
+        initExecutor(config);
+        initMetrics(config);
+        initWireFormat(config);
+        initBatching(config);
+        initStoreForward(config);
+        initSinks(config);
+        initSnapshot(config);
+        initHistory(config);
+        initRollups(config);
+        initPriorities(config);
+        initPublishQueue(config);
+        initReload(config);
+        initHttp(config);
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto& sensor : sensors_) {
+            addSchedule(*sensor, now); // Immediate first read
         }
+        config_ = std::move(config);
 
     } catch (const std::exception& e) {
         throw std::runtime_error("Application construction failed: " + std::string(e.what()));
@@ -140,76 +856,674 @@ App::App(const std::string& config_path) {
     std::cout << "App construction complete." << std::endl;
 }
 
+void App::addSchedule(ISensor& sensor, std::chrono::steady_clock::time_point first_read) {
+    auto schedule = std::make_unique<SensorSchedule>(sensor.getTopicSuffix());
+    schedule->next_publish = first_read;
+    schedule->interval = sensor.getPublishInterval();
+    const MetricsRegistry::Labels sensor_label{{"sensor", sensor.getTopicSuffix()}};
+    schedule->readings = &metrics_.counter("sensorhub_sensor_readings_total", "Valid readings per sensor.", sensor_label);
+    schedule->read_failures = &metrics_.counter("sensorhub_sensor_read_failures_total",
+                                                "Reads that failed or returned no data, per sensor.", sensor_label);
+    // 1 ms .. ~8 s: from the start of the read to the hand-over to the publisher thread
+    schedule->cycle_seconds = &metrics_.histogram("sensorhub_sample_cycle_seconds",
+                                                  "Time from the start of a read to its hand-over for publishing.",
+                                                  Histogram::exponentialBounds(0.001, 2, 14), sensor_label);
+
+    // Sensors without a shared bus get a lane of their own
+    std::string bus_key = sensor.getBusId();
+    if (bus_key.empty()) bus_key = "sensor:" + sensor.getTopicSuffix();
+    auto& lane = bus_lanes_[bus_key];
+    if (!lane) lane = std::make_shared<SequencedLane>(&executor_->counters(Stage::Publish));
+    schedule->publish_lane = lane;
+
+    schedule->channel = encoder_->makeChannel(sensor.getType(), sensor.getTopicSuffix());
+    if (binary_codec_) {
+        schedule->binary = binary_codec_->makeChannel(schedule->channel.topic, platform_name_,
+                                                      sensor.getType(), sensor.getTopicSuffix());
+    }
+    if (const auto it = sensor_classes_.find(sensor.getTopicSuffix()); it != sensor_classes_.end()) {
+        schedule->publish_class = it->second;
+    }
+    if (const auto it = sensor_rate_limits_.find(sensor.getTopicSuffix()); it != sensor_rate_limits_.end()) {
+        schedule->rate_limit = std::make_shared<TokenBucket>(it->second.first, it->second.second);
+    }
+    // Batches go out as telemetry; alerts and state readings are sent one by one, right away
+    if (schedule->publish_class == PublishClass::Telemetry) {
+        schedule->batch_limits = batchLimitsFor(sensor.getTopicSuffix());
+    }
+    schedule->batch_topic = batch_mode_ == BatchMode::Device ? mqtt_topic_base_ + "/batch"
+                                                             : schedule->channel.topic;
+    // Binary frames already take their metadata from the retained schema
+    if (retained_metadata_ && !binary_codec_) schedule->meta_topic = schedule->channel.topic + "/meta";
+    if (mqtt_client_->isMqtt5()) {
+        mqtt_client_->addTopicAlias(schedule->channel.topic);
+        if (schedule->batch_limits) mqtt_client_->addTopicAlias(schedule->batch_topic);
+    }
+    // JSON payloads carry topic_suffix already; binary frames in a device batch need a tag
+    if (batch_mode_ == BatchMode::Device && binary_codec_) schedule->batch_tag = sensor.getTopicSuffix();
+    if (batcher_ && batcher_->format() == PublishBatcher::Format::Columnar) {
+        schedule->batch_metadata = {{"platform", platform_name_}, {"sensor_type", sensor.getType()},
+                                    {"topic_suffix", sensor.getTopicSuffix()}};
+    }
+
+    if (snapshot_) {
+        // A sensor rebuilt by a reload writes to its old slot; slots are never given back
+        if (const auto it = snapshot_slots_.find(sensor.getTopicSuffix()); it != snapshot_slots_.end()) {
+            schedule->snapshot_slot = it->second;
+        } else {
+            schedule->snapshot_slot = snapshot_->addChannel(sensor.getTopicSuffix());
+            if (schedule->snapshot_slot) snapshot_slots_.emplace(sensor.getTopicSuffix(), *schedule->snapshot_slot);
+        }
+        if (!schedule->snapshot_slot) {
+            std::cerr << "Warning: snapshot.slots exhausted; " << sensor.getTopicSuffix()
+                      << " is not in the shared-memory snapshot." << std::endl;
+        }
+    }
+
+    schedules_.emplace(&sensor, std::move(schedule));
+}
+
 // --- Destructor ---
 App::~App() { 
     std::cout << "Destroying App..." << std::endl;
-    // Disconnect MQTT client if connected
-    if (mqtt_client_ && mqtt_client_->isConnected()) {
-        mqtt_client_->disconnect();
+    // No more local queries or scrapes; they read the history, the executor and the queues
+    http_server_.reset();
+    // Drain in-flight samples first; their tasks reference sensors and the MQTT client
+    if (executor_) {
+        executor_.reset();
     }
-    // unique_ptrs for sensors_ and mqtt_client_ handle their own cleanup
+    if (config_watch_fd_ >= 0) {
+        close(config_watch_fd_);
+    }
+    // Send whatever is still waiting in batches
+    if (batcher_ && mqtt_client_) {
+        publishBatches(batcher_->flushAll());
+    }
+    // Let the publisher thread work off what is queued (publishing, or storing for later)
+    if (publish_queue_) {
+        publish_queue_->stop();
+    }
+    // Write what the history still buffers; nothing appends or syncs any more
+    if (history_ && !history_->sync(std::chrono::system_clock::now(), true)) {
+        std::cerr << "History not fully synced." << std::endl;
+    }
+    // Everything has reached the loopback broker by now
+    if (loopback_broker_) {
+        logLoopbackStats();
+        if (!loopback_csv_.empty() && !loopback_broker_->writeCsv(loopback_csv_)) {
+            std::cerr << "Failed to write loopback arrivals to " << loopback_csv_ << "." << std::endl;
+        }
+    }
+    // Disconnect MQTT: what the broker has not acknowledged by now goes back to the store-and-forward
+    // queue. Destroyed here rather than after the queue, so no late transport callback can reach it
+    mqtt_sink_.reset();
+    mqtt_client_.reset();
+    // Everything that could not be sent is in the store-and-forward queue now; get it onto the disk in time
+    if (spool_) {
+        const auto start = std::chrono::steady_clock::now();
+        const bool synced = spool_->flush(start + spool_shutdown_deadline_);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "Store-and-forward queue " << (synced ? "synced" : "NOT fully synced") << " in "
+                  << elapsed.count() << "ms with " << spool_->size() << " messages pending." << std::endl;
+    }
+    // Final schedule adherence summary, now that every sample has been accounted for
+    logTimingReport();
+    // unique_ptrs for sensors_ handle their own cleanup
     std::cout << "Application cleanup complete." << std::endl;
  }
 
-// --- Process Sensors Cycle ---
-void App::processSensors() {
-    if (!mqtt_client_) return; // Should not happen if constructor succeeded
+// --- Sampling Coroutine ---
+// read (coroutine, run() thread) -> encode (stealable) -> publish (in read order per bus)
+Coro::Task<void> App::samplingLoop(ISensor& sensor, SensorSchedule& schedule) {
+    auto& next_pub_time = schedule.next_publish;
+    while (!shutdown_requested_.load() && !schedule.retired) {
+        co_await Coro::at(next_pub_time);
+        if (schedule.retired) break; // Removed by a config reload while waiting for this slot
+        const auto interval = schedule.interval;
 
-    auto now = std::chrono::steady_clock::now();
+        if (schedule.in_flight.load()) {
+            // Previous sample is still in the pipeline; don't queue reads behind it
+            std::cerr << "Sensor '" << sensor.getTopicSuffix()
+                      << "' is still busy with its previous sample, skipping this cycle." << std::endl;
+            schedule.timing.recordSkipped();
+        } else {
+            schedule.in_flight.store(true);
+            const uint64_t ticket = schedule.publish_lane->reserve();
 
-    // Iterate through all created sensors
-    for (const auto& sensor : sensors_) {
-        if (!sensor->isEnabled()) continue; // Skip disabled sensors
+            SampleTiming timing;
+            timing.scheduled = next_pub_time;
+            timing.interval = interval;
+
+            // Conversion waits inside the driver suspend here instead of blocking the thread
+            timing.read_start = std::chrono::steady_clock::now();
+            json sensor_payload;
+            try {
+                sensor_payload = co_await sensor.readDataJsonAsync();
+            } catch (const std::exception& e) {
+                sensor_payload = json{{"error", e.what()}};
+            }
+            timing.read_end = std::chrono::steady_clock::now();
+            schedule.timing.recordRead(timing);
+
+            dispatchSample(sensor, schedule, ticket, std::move(sensor_payload), timing);
+        }
+
+        // Schedule next publish time on a fixed grid so sub-second intervals don't drift
+        const auto now = std::chrono::steady_clock::now();
+        next_pub_time += interval;
+        if (next_pub_time <= now) {
+            // Fell behind by a whole interval (slow read or stall): skip the missed slots
+            schedule.timing.recordSkipped(static_cast<uint64_t>((now - next_pub_time) / interval) + 1);
+            next_pub_time = now + interval;
+        }
+    }
+    schedule.loop_done = true;
+}
 
-        // Check if it's time to publish for this sensor
-        auto& next_pub_time = next_publish_times_[sensor.get()];
-        if (now >= next_pub_time) {
+// --- Rebuilt Sensor Start ---
+Coro::Task<void> App::startRebuiltSensor(ISensor& sensor, SensorSchedule& schedule) {
+    const std::string suffix = sensor.getTopicSuffix();
+    // A rebuilt driver resets the chip while initializing; the old instance may still be mid-conversion
+    const auto predecessorBusy = [&] {
+        return std::any_of(retired_sensors_.begin(), retired_sensors_.end(), [&](const auto& retired) {
+            return retired.second.get() != &schedule && retired.first->getTopicSuffix() == suffix &&
+                   (!retired.second->loop_done || retired.second->in_flight.load());
+        });
+    };
+    while (!shutdown_requested_.load() && !schedule.retired && predecessorBusy()) {
+        co_await Coro::after(RETIRED_POLL_INTERVAL);
+    }
+    if (shutdown_requested_.load() || schedule.retired) {
+        schedule.loop_done = true;
+        co_return;
+    }
 
-            // Read sensor data into a JSON object
-            json sensor_payload = sensor->readDataJson();
+    // Conversion and settle delays suspend here, so the other sensors keep sampling
+    bool initialized = true;
+    try {
+        co_await sensor.initializeAsync();
+    } catch (const std::exception& e) {
+        std::cerr << "Sensor '" << suffix << "' failed to initialize after the config reload, not started: "
+                  << e.what() << std::endl;
+        initialized = false;
+    }
+    if (!initialized) {
+        // Unless a reload already retired it (and may have built the suffix anew)
+        if (!schedule.retired) {
+            retireSensor(suffix);
+            sensor_builder_->forgetSensor(suffix); // So the next reload tries it again
+        }
+        schedule.loop_done = true;
+        co_return;
+    }
+    std::cout << "Sensor '" << suffix << "' initialized." << std::endl;
 
-            if (!sensor_payload.is_null() && !sensor_payload.empty() && !sensor_payload.contains("error")) {
-                // Create the final JSON payload to publish
-                json final_payload = sensor_payload; // Copy sensor data
-                final_payload["timestamp"] = getCurrentTimestamp();
-                final_payload["platform"] = platform_name_;
-                final_payload["sensor_type"] = sensor->getType();
-                final_payload["topic_suffix"] = sensor->getTopicSuffix();
+    // The first slot was set when the reload built it; don't count the wait as missed slots
+    schedule.next_publish = std::max(schedule.next_publish, std::chrono::steady_clock::now());
+    co_await samplingLoop(sensor, schedule);
+}
 
-                std::string payload_str = final_payload.dump();
-                std::string full_topic = mqtt_topic_base_ + "/" + sensor->getTopicSuffix();
+// --- Sample Pipeline ---
+void App::dispatchSample(ISensor& sensor, SensorSchedule& schedule, uint64_t ticket, json sensor_payload,
+                         SampleTiming timing) {
+    if (sensor_payload.is_null() || sensor_payload.empty() || sensor_payload.contains("error")) {
+        std::cerr << "Failed to read valid data from sensor type '" << sensor.getType()
+                  << "' with suffix '" << sensor.getTopicSuffix() << "'." << std::endl;
+        if (sensor_payload.contains("error")) {
+            std::cerr << "  Error reported: " << sensor_payload.at("error").get<std::string>() << std::endl;
+        }
+        schedule.read_failures->inc();
+        schedule.publish_lane->complete(ticket, {});
+        schedule.in_flight.store(false);
+        return;
+    }
+    schedule.readings->inc();
+    // Local readers see the value before it is even encoded
+    if (schedule.snapshot_slot) updateSnapshot(schedule, sensor_payload);
+    if (live_feed_) {
+        live_feed_->update(sensor.getTopicSuffix(), sensor.getType(), std::chrono::system_clock::now(), sensor_payload);
+    }
+    if (history_ || rollups_) recordSample(sensor, sensor_payload);
 
-                std::cout << "Publishing to " << full_topic << ": " << payload_str << std::endl;
+    executor_->submit(Stage::Encode, [this, &sensor, &schedule, ticket, timing,
+                                      sensor_payload = std::move(sensor_payload)]() mutable {
+        if (schedule.batch_limits && batcher_->format() == PublishBatcher::Format::Columnar) {
+            // Columnar batches take the reading itself; it is packed column-wise as it joins the batch
+            const auto now = std::chrono::system_clock::now();
+            timing.encode_end = std::chrono::steady_clock::now();
+            schedule.publish_lane->complete(ticket, [this, &schedule, timing, now,
+                                                     sensor_payload = std::move(sensor_payload)]() mutable {
+                InFlightRelease release(schedule.in_flight);
+                timing.publish_start = std::chrono::steady_clock::now();
+                try {
+                    publishBatches(batcher_->addReading(schedule.batch_topic, sensor_payload, schedule.batch_metadata,
+                                                        now, pressuredBatchLimits(*schedule.batch_limits),
+                                                        std::chrono::steady_clock::now()));
+                } catch (const std::exception& e) {
+                    std::cerr << "Failed to batch reading for " << schedule.batch_topic << ": " << e.what() << std::endl;
+                }
+                timing.publish_end = std::chrono::steady_clock::now();
+                recordCycle(schedule, timing);
+            });
+            return;
+        }
 
-                // Publish data via MQTT if connected
-                if (mqtt_client_->isConnected()) {
-                     if(!mqtt_client_->publish(full_topic, payload_str)) {
-                          std::cerr << "Failed to publish data to MQTT topic: " << full_topic << std::endl;
-                     }
-                } else {
-                     std::cerr << "MQTT client disconnected. Cannot publish data for " << full_topic << "." << std::endl;
-                     // Attempt to reconnect if disconnected (might be better handled centrally)
-                     // std::cout << "Attempting MQTT reconnect..." << std::endl;
-                     // mqtt_client_->connect();
+        // Encode straight into a pooled buffer: no copy of the reading, no per-sample topic
+        Payload payload = payload_pool_.acquire();
+        Payload schema_payload; // Only set when the binary schema has to be (re)published
+        try {
+            const auto now = std::chrono::system_clock::now();
+            if (binary_codec_) {
+                binary_codec_->encode(schedule.binary, sensor_payload, now, payload.buffer());
+                if (!schedule.binary.schema_published) {
+                    schema_payload = payload_pool_.acquire();
+                    BinaryCodec::appendSchemaMessage(schedule.binary, schema_payload.buffer());
                 }
             } else {
-                 std::cerr << "Failed to read valid data from sensor type '" << sensor->getType()
-                           << "' with suffix '" << sensor->getTopicSuffix() << "'." << std::endl;
-                 if(sensor_payload.contains("error")) {
-                     std::cerr << "  Error reported: " << sensor_payload.at("error").get<std::string>() << std::endl;
-                 }
+                encoder_->encode(schedule.channel, sensor_payload, now, payload.buffer());
             }
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to encode payload for " << schedule.channel.topic << ": " << e.what() << std::endl;
+            schedule.publish_lane->complete(ticket, {});
+            schedule.in_flight.store(false);
+            return;
+        }
 
-             // Schedule next publish time for this sensor
-             next_pub_time = now + sensor->getPublishInterval();
+        timing.encode_end = std::chrono::steady_clock::now();
+        schedule.publish_lane->complete(ticket, [this, &schedule, &sensor, timing, payload = std::move(payload),
+                                                 schema_payload = std::move(schema_payload)]() mutable {
+            InFlightRelease release(schedule.in_flight);
+            const std::string& full_topic = schedule.channel.topic;
+            try {
+                if (!schedule.meta_published && !schedule.meta_topic.empty()) publishMetadataOnce(schedule, sensor);
+                const std::string& payload_str = payload.str();
+                timing.publish_start = std::chrono::steady_clock::now();
+                if (BinaryCodec::isFrame(payload_str)) {
+                    std::cout << "Publishing to " << full_topic << ": " << payload_str.size()
+                              << " byte frame (schema " << schedule.binary.schema->id << ")" << std::endl;
+                } else {
+                    std::cout << "Publishing to " << full_topic << ": " << payload_str << std::endl;
+                }
 
-        } // end if time to publish
-    } // end for loop sensors_
+                // The schema goes out (retained) before the first frame that refers to it: same lane, queued first
+                if (schema_payload && (spool_ || mqtt_client_->isConnected())) {
+                    auto schema = outgoing(schedule.binary.schema_topic, std::move(schema_payload),
+                                           schedule.publish_class);
+                    schema.qos = std::max(1, class_policies_[static_cast<size_t>(PublishClass::State)].qos);
+                    schema.retained = true;
+                    schema.expiry = std::chrono::seconds{0};
+                    schedule.binary.schema_published = enqueuePublish(std::move(schema));
+                }
+
+                if (schedule.batch_limits) {
+                    publishBatches(batcher_->add(schedule.batch_topic, schedule.batch_tag, payload,
+                                                 pressuredBatchLimits(*schedule.batch_limits),
+                                                 std::chrono::steady_clock::now()));
+                    timing.publish_end = std::chrono::steady_clock::now();
+                    recordCycle(schedule, timing);
+                    return;
+                }
+
+                // The publisher thread sends it (or keeps it for later); this lane never waits on the network
+                auto message = outgoing(full_topic, std::move(payload), schedule.publish_class, &schedule);
+                message.sampled = timing.read_end;
+                if (enqueuePublish(std::move(message))) {
+                    timing.publish_end = std::chrono::steady_clock::now();
+                    recordCycle(schedule, timing);
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Failed to publish reading for " << full_topic << ": " << e.what() << std::endl;
+            }
+        });
+    });
+}
 
-    // Reconnect MQTT if needed (central check)
-    if (!mqtt_client_->isConnected()) {
-        std::cout << "Attempting MQTT reconnect..." << std::endl;
-        mqtt_client_->connect();
+void App::recordCycle(SensorSchedule& schedule, const SampleTiming& timing) {
+    schedule.timing.recordPublished(timing);
+    schedule.cycle_seconds->observe(timing.publish_end - timing.read_start);
+}
+
+// --- Publishing ---
+App::OutgoingMessage App::outgoing(const std::string& topic, Payload payload, PublishClass publish_class,
+                                   SensorSchedule* sensor) const {
+    const auto& policy = class_policies_[static_cast<size_t>(publish_class)];
+    return OutgoingMessage{topic, std::move(payload), publish_class, policy.qos, policy.retained, policy.expiry,
+                           sensor ? sensor->rate_limit : nullptr};
+}
+
+void App::publishMetadataOnce(SensorSchedule& schedule, const ISensor& sensor) {
+    if (!spool_ && !mqtt_client_->isConnected()) return; // Try again with the next reading
+    Payload payload = payload_pool_.acquire();
+    PayloadEncoder::appendJson(json{{"platform", platform_name_}, {"sensor_type", sensor.getType()},
+                                    {"topic_suffix", sensor.getTopicSuffix()}},
+                               payload.buffer());
+    auto meta = outgoing(schedule.meta_topic, std::move(payload), schedule.publish_class);
+    meta.qos = std::max(1, class_policies_[static_cast<size_t>(PublishClass::State)].qos);
+    meta.retained = true;
+    meta.expiry = std::chrono::seconds{0};
+    schedule.meta_published = enqueuePublish(std::move(meta));
+}
+
+bool App::enqueuePublish(OutgoingMessage message) {
+    const size_t lane = static_cast<size_t>(message.publish_class);
+    const std::string topic = message.topic;
+    if (publish_queue_->push(std::move(message), lane)) return true;
+    std::cerr << "Publish queue full (" << PUBLISH_CLASS_NAMES[lane] << "). Dropped message for " << topic << "." << std::endl;
+    return false;
+}
+
+bool App::withinRateLimits(const OutgoingMessage& message) {
+    const auto now = std::chrono::steady_clock::now();
+    TokenBucket* sensor_bucket = message.sensor_rate_limit.get();
+    const auto topic_it = topic_rate_limits_.find(message.topic);
+    TokenBucket* topic_bucket = topic_it != topic_rate_limits_.end() ? &topic_it->second : nullptr;
+    // Check both before taking from either, so a message refused by one doesn't use up the other
+    if ((sensor_bucket && sensor_bucket->available(now) < 1.0) || (topic_bucket && topic_bucket->available(now) < 1.0)) {
+        return false;
+    }
+    if (sensor_bucket) sensor_bucket->tryTake(now);
+    if (topic_bucket) topic_bucket->tryTake(now);
+    return true;
+}
+
+bool App::publishOrStore(const OutgoingMessage& message) {
+    const std::string& topic = message.topic;
+    const std::string& payload = message.payload.str();
+    const char* reason = "MQTT client disconnected";
+    if (message.publish_class == PublishClass::Telemetry &&
+        mqtt_client_->window().utilisation() >= TELEMETRY_WINDOW_SHARE) {
+        reason = "MQTT in-flight window full for telemetry";
+    } else if (mqtt_client_->isConnected()) {
+        switch (mqtt_sink_->send(SinkMessage{topic, message.payload, message.qos, message.retained, message.expiry})) {
+            case ISink::Result::Sent:
+                if (message.sampled != std::chrono::steady_clock::time_point{}) {
+                    sample_latency_.record(std::chrono::steady_clock::now() - message.sampled);
+                }
+                return true;
+            case ISink::Result::Busy:
+                reason = "MQTT in-flight window full";
+                break;
+            case ISink::Result::Unavailable:
+                break;
+            case ISink::Result::Failed:
+                reason = "MQTT publish failed";
+                break;
+        }
+    }
+    if (!spool_) {
+        std::cerr << reason << ". Cannot publish data for " << topic << "." << std::endl;
+        return false;
+    }
+    if (!spool_->push(topic, payload, message.qos, message.retained)) {
+        std::cerr << "Failed to store message for " << topic << " (" << payload.size() << " bytes)." << std::endl;
+        return false;
+    }
+    std::cout << reason << ", stored message for " << topic << " (" << spool_->size() << " pending)." << std::endl;
+    return true;
+}
+
+// --- Batching ---
+void App::publishBatches(std::vector<PublishBatcher::Batch> batches) {
+    for (auto& batch : batches) {
+        std::cout << "Publishing batch of " << batch.count << " readings (" << batch.payload.size()
+                  << " bytes) to " << batch.topic << std::endl;
+        enqueuePublish(outgoing(batch.topic, std::move(batch.payload), PublishClass::Telemetry));
+    }
+}
+
+Coro::Task<void> App::batchFlushLoop() {
+    while (!shutdown_requested_.load()) {
+        // Never sleep past the shortest latency cap, so a batch opened just after we went to sleep is on time
+        // (recomputed each time: a config reload can add sensors)
+        auto max_sleep = std::min<std::chrono::steady_clock::duration>(MAX_IDLE_SLEEP, batch_defaults_.max_age);
+        for (const auto& [sensor, schedule] : schedules_) {
+            if (schedule->batch_limits) max_sleep = std::min<std::chrono::steady_clock::duration>(max_sleep, schedule->batch_limits->max_age);
+        }
+        auto wake = std::chrono::steady_clock::now() + max_sleep;
+        if (auto deadline = batcher_->nextDeadline()) wake = std::min(wake, *deadline);
+        co_await Coro::at(wake);
+        publishBatches(batcher_->flushDue(std::chrono::steady_clock::now()));
+    }
+}
+
+// --- Store and Forward Service ---
+void App::serviceStoreForward() {
+    const auto now = std::chrono::steady_clock::now();
+    if (!spool_bucket_) {
+        const double burst = std::max(1.0, spool_drain_rate_ * std::chrono::duration<double>(MAX_IDLE_SLEEP).count());
+        spool_bucket_.emplace(spool_drain_rate_, burst, now);
+        spool_next_sync_ = now + spool_sync_interval_;
+    }
+
+    if (mqtt_client_->isConnected()) {
+        // The backlog only uses the lower half of the in-flight window; live readings keep the rest
+        while (mqtt_client_->window().utilisation() < 0.5 && spool_bucket_->available(now) >= 1.0) {
+            const auto record = spool_->front();
+            if (!record) break;
+            if (!mqtt_client_->publish(record->topic, record->payload, record->qos, record->retained)) break;
+            spool_->pop(); // If the broker never acknowledges it, the unacked handler stores it again
+            spool_bucket_->tryTake(now);
+            ++spool_drained_;
+        }
+        if (spool_drained_ > 0 && spool_->empty()) {
+            std::cout << "Store-and-forward backlog delivered (" << spool_drained_ << " messages)." << std::endl;
+            spool_drained_ = 0;
+        }
+    } else {
+        // A reconnect starts with an empty bucket, so the backlog trickles out at drain_rate_per_sec
+        // instead of arriving at the broker all at once
+        spool_bucket_->clear(now);
+    }
+
+    // Appends and the read position reach the SD card once per interval, not once per message
+    if (now >= spool_next_sync_) {
+        spool_->flush();
+        spool_next_sync_ = now + spool_sync_interval_;
+    }
+}
+
+// --- Config Reload ---
+void App::checkReloadTriggers() {
+    std::string source;
+    if (reload_requested_.exchange(false)) source = "SIGHUP";
+    if (config_watch_fd_ >= 0) {
+        const std::string file_name = std::filesystem::path(config_path_).filename().string();
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length = 0;
+        while ((length = read(config_watch_fd_, buffer, sizeof(buffer))) > 0) {
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if (event->len > 0 && file_name == event->name) source = "file change";
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+    }
+    if (!source.empty()) {
+        try {
+            reloadSensors(loadConfig(config_path_), source);
+        } catch (const std::exception& e) {
+            std::cerr << "Config reload (" << source << ") failed, sensors unchanged: " << e.what() << std::endl;
+        }
+    }
+
+    std::optional<std::string> remote_config;
+    {
+        std::lock_guard<std::mutex> lock(remote_config_mutex_);
+        remote_config.swap(remote_config_);
+    }
+    if (remote_config) {
+        try {
+            reloadSensors(json::parse(*remote_config), "MQTT " + config_topic_);
+        } catch (const std::exception& e) {
+            std::cerr << "Config reload (MQTT " << config_topic_ << ") failed, sensors unchanged: " << e.what() << std::endl;
+        }
+    }
+}
+
+void App::reloadSensors(const json& config, const std::string& source) {
+    if (!config.is_object() || !config.contains("sensors")) {
+        throw std::runtime_error("the configuration has no \"sensors\" array.");
+    }
+    std::string restart_sections;
+    for (const auto& [key, value] : config.items()) {
+        if (key == "sensors" || (config_.contains(key) && config_.at(key) == value)) continue;
+        restart_sections += (restart_sections.empty() ? "" : ", ") + key;
+    }
+    if (!restart_sections.empty()) {
+        std::cerr << "Config reload (" << source << "): changes to " << restart_sections
+                  << " take effect after a restart." << std::endl;
+    }
+
+    auto diff = sensor_builder_->rebuildSensors(config.at("sensors"));
+    if (diff.empty()) {
+        std::cout << "Config reload (" << source << "): sensors unchanged." << std::endl;
+        return;
+    }
+
+    // Sampling loops end at their next slot; the sensors go once nothing of theirs is in the pipeline
+    for (const auto& suffix : diff.removed) retireSensor(suffix);
+    // Takes effect after the slot the sampling loop is already waiting for
+    for (const auto& [suffix, interval] : diff.rescheduled) {
+        for (const auto& [sensor, schedule] : schedules_) {
+            if (sensor->getTopicSuffix() == suffix) schedule->interval = interval;
+        }
+    }
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& sensor : diff.added) {
+        addSchedule(*sensor, now);
+        scheduler_.spawn(startRebuiltSensor(*sensor, *schedules_.at(sensor.get())));
+        sensors_.push_back(std::move(sensor));
+    }
+    std::cout << "Config reload (" << source << "): " << diff.added.size() << " sensors started, "
+              << diff.removed.size() << " stopped, " << diff.rescheduled.size() << " rescheduled, "
+              << diff.unchanged << " unchanged." << std::endl;
+}
+
+void App::retireSensor(const std::string& topic_suffix) {
+    const auto it = std::find_if(sensors_.begin(), sensors_.end(),
+                                 [&](const auto& sensor) { return sensor->getTopicSuffix() == topic_suffix; });
+    if (it == sensors_.end()) return;
+    auto schedule = schedules_.extract(it->get());
+    schedule.mapped()->retired = true;
+    retired_sensors_.emplace_back(std::move(*it), std::move(schedule.mapped()));
+    sensors_.erase(it);
+}
+
+void App::reapRetiredSensors() {
+    std::erase_if(retired_sensors_, [this](const auto& retired) {
+        if (!retired.second->loop_done || retired.second->in_flight.load()) return false;
+        // A sensor that was rebuilt under the same suffix keeps its place in the live feed
+        const auto& suffix = retired.first->getTopicSuffix();
+        if (live_feed_ && std::none_of(sensors_.begin(), sensors_.end(),
+                                       [&](const auto& sensor) { return sensor->getTopicSuffix() == suffix; })) {
+            live_feed_->remove(suffix);
+        }
+        return true;
+    });
+}
+
+// --- History Service ---
+void App::serviceHistory() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < history_next_sync_) return;
+    // Blocks reach the SD card once per interval, however many readings they hold
+    history_->sync();
+    history_next_sync_ = now + history_sync_interval_;
+}
+
+// --- Housekeeping Coroutine ---
+Coro::Task<void> App::maintenanceLoop() {
+    auto next_stats_log = std::chrono::steady_clock::now() + stats_log_interval_;
+    auto next_timing_report = std::chrono::steady_clock::now() + timing_report_interval_;
+    while (!shutdown_requested_.load()) {
+        co_await Coro::after(MAX_IDLE_SLEEP);
+        checkReloadTriggers();
+        if (!retired_sensors_.empty()) reapRetiredSensors();
+        if (rollups_) rollups_->flush(std::chrono::system_clock::now(), rollup_emit_);
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= next_stats_log) {
+            logExecutorStats();
+            logPublisherStats();
+            next_stats_log = now + stats_log_interval_;
+        }
+        if (now >= next_timing_report) {
+            logTimingReport();
+            next_timing_report = now + timing_report_interval_;
+        }
+    }
+}
+
+void App::logExecutorStats() const {
+    const auto stats = executor_->stats();
+    std::cout << "Executor stats (" << executor_->workerCount() << " workers, "
+              << executor_->stealCount() << " steals):";
+    for (size_t i = 0; i < stats.size(); ++i) {
+        std::cout << " " << stageName(static_cast<Stage>(i))
+                  << "[queued=" << stats[i].queued << " running=" << stats[i].running
+                  << " max=" << stats[i].max_queued << " done=" << stats[i].completed << "]";
+    }
+    std::cout << std::endl;
+}
+
+void App::logPublisherStats() const {
+    const auto& window = mqtt_client_->window();
+    const auto stats = window.stats();
+    const auto latency = window.ackLatency().summary();
+    std::cout << std::fixed << std::setprecision(2)
+              << "MQTT in-flight: messages=" << stats.messages << " bytes=" << stats.bytes
+              << " peak=" << stats.peak_messages << " acked=" << stats.acked << " failed=" << stats.failed
+              << " rejected=" << stats.rejected << " ack_latency(ms)[p50=" << static_cast<double>(latency.p50) / 1000.0
+              << " p99=" << static_cast<double>(latency.p99) / 1000.0
+              << " max=" << static_cast<double>(latency.max) / 1000.0 << "]" << std::defaultfloat << std::endl;
+    std::cout << "Publish queue (capacity " << publish_queue_->capacity() << " per class):";
+    for (size_t i = 0; i < PUBLISH_CLASS_COUNT; ++i) {
+        const auto queue = publish_queue_->stats(i);
+        std::cout << " " << PUBLISH_CLASS_NAMES[i] << "[depth=" << queue.depth << " high_water=" << queue.high_water
+                  << " pushed=" << queue.pushed << " dispatched=" << queue.dispatched << " dropped=" << queue.dropped
+                  << " blocked=" << queue.blocked << "]";
+    }
+    std::cout << " rate_limited=" << rate_limited_.load(std::memory_order_relaxed) << std::endl;
+    if (sample_latency_.count() > 0) {
+        const auto sample = sample_latency_.summary();
+        std::cout << std::fixed << std::setprecision(2) << "Sample to MQTT client latency(ms)[p50="
+                  << static_cast<double>(sample.p50) / 1000.0 << " p99=" << static_cast<double>(sample.p99) / 1000.0
+                  << " max=" << static_cast<double>(sample.max) / 1000.0 << "] samples=" << sample_latency_.count()
+                  << std::defaultfloat << std::endl;
+    }
+    for (size_t i = 0; i < local_sinks_.size(); ++i) {
+        const auto sink = local_sinks_.stats(i);
+        std::cout << "Sink " << local_sinks_.sink(i).type() << " " << local_sinks_.sink(i).describe() << ": sent=" << sink.sent
+                  << " busy=" << sink.busy << " unavailable=" << sink.unavailable << " failed=" << sink.failed << std::endl;
+    }
+    if (history_) {
+        const auto history = history_->stats();
+        std::cout << "History: points=" << history.points << " blocks=" << history.blocks << " segments="
+                  << history.segments << " disk_bytes=" << history.disk_bytes << " dropped_segments="
+                  << history.dropped_segments << " dropped_points=" << history.dropped_points << std::endl;
+    }
+    if (rollups_) std::cout << "Rollups: windows emitted=" << rollups_emitted_ << std::endl;
+    if (http_server_) {
+        const auto http = http_server_->stats();
+        std::cout << "HTTP API: connections=" << http.connections << " open=" << http.open << " rejected="
+                  << http.rejected << " requests=" << http.requests << " errors=" << http.errors
+                  << " websockets=" << http.websockets << " messages=" << http.messages << std::endl;
+    }
+    if (loopback_broker_) logLoopbackStats();
+}
+
+void App::logLoopbackStats() const {
+    const auto stats = loopback_broker_->stats();
+    std::cout << std::fixed << std::setprecision(1) << "Loopback broker: messages=" << stats.messages
+              << " msgs/s=" << stats.messagesPerSecond() << " bytes/msg=" << stats.bytesPerMessage()
+              << " bytes=" << stats.bytes << std::defaultfloat << std::endl;
+}
+
+void App::logTimingReport() const {
+    for (const auto& sensor : sensors_) {
+        const auto it = schedules_.find(sensor.get());
+        if (it == schedules_.end()) continue;
+        std::cout << "Timing " << it->second->timing.report() << std::endl;
     }
 }
 
@@ -218,22 +1532,25 @@ int App::run() {
     std::cout << "Starting application run loop..." << std::endl;
     signal(SIGINT, App::signalHandler);
     signal(SIGTERM, App::signalHandler);
+    signal(SIGHUP, App::signalHandler);
 
     if (!mqtt_client_) {
          std::cerr << "Critical Error: MQTT Client not initialized before run loop." << std::endl;
          return 1;
     }
-    if (!mqtt_client_->isConnected()) {
-         std::cerr << "Warning: Failed to connect to MQTT broker initially. Will retry in loop." << std::endl;
-    }
+    // Connects (and reconnects with backoff) on its own thread; sampling never waits for the broker
+    mqtt_client_->start();
 
-    // Main loop now just checks time and processes sensors
-    while (!shutdown_requested_.load()) {
-        processSensors();
-        // Sleep for a short duration to avoid busy-waiting
-        // The actual publish interval is handled within processSensors
-        std::this_thread::sleep_for(100ms);
+    // One coroutine per sensor; their publish slots and driver waits all interleave on this thread
+    for (const auto& sensor : sensors_) {
+        if (!sensor->isEnabled()) continue; // Skip disabled sensors
+        scheduler_.spawn(samplingLoop(*sensor, *schedules_.at(sensor.get())));
     }
+    scheduler_.spawn(maintenanceLoop());
+    if (batcher_) scheduler_.spawn(batchFlushLoop());
+
+    // Sleeps until the next timer is due (capped at MAX_IDLE_SLEEP) so shutdown stays responsive
+    scheduler_.runUntil([] { return shutdown_requested_.load(); }, MAX_IDLE_SLEEP);
 
     std::cout << "Shutdown requested. Exiting run loop." << std::endl;
     return 0;
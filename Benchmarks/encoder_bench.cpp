@@ -0,0 +1,123 @@
+// Payload encoding benchmark: time and heap allocations per publish for the previous
+// json-copy + dump() path versus PayloadEncoder writing into pooled buffers. That both
+// produce the same bytes is checked by Test-Encoding (Test-payload_encoder.cpp).
+//
+// Usage: encoder_bench [iterations]
+
+#include "Encoding/payload_encoder.h"
+#include "Encoding/payload_pool.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+using namespace SensorHub::Components;
+
+// --- Allocation counting ---
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+const std::string TOPIC_BASE = "rpisensor/data";
+const std::string PLATFORM = "Linux_RPi";
+
+// The encode step as it was before PayloadEncoder
+std::string legacyTimestamp(std::chrono::system_clock::time_point now) {
+    auto itt = std::chrono::system_clock::to_time_t(now);
+    std::ostringstream ss;
+    ss << std::put_time(std::gmtime(&itt), "%FT%TZ");
+    return ss.str();
+}
+
+void legacyEncode(const json& sensor_payload, const std::string& type, const std::string& suffix,
+                  std::chrono::system_clock::time_point now, std::string& topic, std::string& payload) {
+    json final_payload = sensor_payload;
+    final_payload["timestamp"] = legacyTimestamp(now);
+    final_payload["platform"] = PLATFORM;
+    final_payload["sensor_type"] = type;
+    final_payload["topic_suffix"] = suffix;
+    payload = final_payload.dump();
+    topic = TOPIC_BASE + "/" + suffix;
+}
+
+struct Case {
+    std::string type;
+    std::string suffix;
+    json reading;
+};
+
+struct Result {
+    double ns_per_publish;
+    double allocations_per_publish;
+};
+
+template <typename Fn>
+Result measure(size_t iterations, Fn&& fn) {
+    const uint64_t allocations_before = g_allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) fn(i);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const uint64_t allocations = g_allocations.load() - allocations_before;
+    return {static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                static_cast<double>(iterations),
+            static_cast<double>(allocations) / static_cast<double>(iterations)};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    const std::vector<Case> cases = {
+        {"BME280", "bme280", json{{"temperature_celsius", 21.53}, {"pressure_hpa", 1013.2512},
+                                  {"humidity_percent", 45.000000001}}},
+        {"LPS25HB", "lps25hb_pressure", json{{"pressure_hpa", 1009.5}, {"temperature_celsius", -3.25e-5}}},
+        {"Dummy", "dummy_test", json{{"counter", 42}, {"random_value", 38.3}, {"status", "OK\t\"q\""}}},
+    };
+
+    PayloadEncoder encoder({TOPIC_BASE, PLATFORM, TimestampFormatter::Precision::Seconds});
+    std::vector<SensorChannel> channels;
+    for (const auto& c : cases) channels.push_back(encoder.makeChannel(c.type, c.suffix));
+    PayloadPool pool;
+
+    std::string topic, payload;
+    const Result legacy = measure(iterations, [&](size_t i) {
+        const auto& c = cases[i % cases.size()];
+        legacyEncode(c.reading, c.type, c.suffix, std::chrono::system_clock::now(), topic, payload);
+    });
+
+    size_t total_bytes = 0;
+    const Result pooled = measure(iterations, [&](size_t i) {
+        const size_t index = i % cases.size();
+        Payload out = pool.acquire();
+        encoder.encode(channels[index], cases[index].reading, std::chrono::system_clock::now(), out.buffer());
+        total_bytes += out.size() + channels[index].topic.size();
+    });
+
+    std::printf("%-22s %12s %18s\n", "path", "ns/publish", "allocs/publish");
+    std::printf("%-22s %12.1f %18.2f\n", "json copy + dump()", legacy.ns_per_publish, legacy.allocations_per_publish);
+    std::printf("%-22s %12.1f %18.2f\n", "PayloadEncoder + pool", pooled.ns_per_publish, pooled.allocations_per_publish);
+    std::printf("(%zu iterations, %zu bytes encoded)\n", iterations, total_bytes);
+    return 0;
+}
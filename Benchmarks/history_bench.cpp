@@ -0,0 +1,113 @@
+// History store benchmark: cost of TimeSeriesStore::append() for a BME280-like reading,
+// bytes on disk per point against the raw values, and range scan speed over a long
+// history (a year of one-minute points by default) from the mapped segments, whole and
+// in short parts the way /api/range streams it.
+//
+// Usage: history_bench [points] [directory]
+
+#include "History/time_series_store.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+using namespace SensorHub::Components;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t points = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 525600;
+    const std::filesystem::path directory =
+        argc > 2 ? std::filesystem::path(argv[2])
+                 : std::filesystem::temp_directory_path() / ("history_bench_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(directory);
+
+    TimeSeriesStore::Options options;
+    options.directory = directory;
+    options.segment_window = std::chrono::hours(24);
+    options.max_bytes = size_t{1} << 30;
+    const auto first = TimeSeriesStore::Clock::time_point(std::chrono::seconds(1700000000));
+    const auto step = std::chrono::minutes(1);
+
+    {
+        TimeSeriesStore store(options);
+        const auto start = Clock::now();
+        for (size_t i = 0; i < points; ++i) {
+            const double t = static_cast<double>(i);
+            const TimeSeriesStore::Value values[] = {
+                {"humidity_percent", 40.0 + 5.0 * std::sin(t / 600.0)},
+                {"pressure_hpa", 1013.25 + 0.01 * static_cast<double>(i % 100)},
+                {"temperature_celsius", 21.5 + std::sin(t / 1440.0)}};
+            store.append("bme280", first + step * static_cast<int64_t>(i), values);
+        }
+        const double append_seconds = secondsSince(start);
+        const auto sync_start = Clock::now();
+        store.sync(TimeSeriesStore::Clock::now(), true);
+        const double sync_seconds = secondsSince(sync_start);
+
+        const auto stats = store.stats();
+        const double raw_bytes = static_cast<double>(points) * 4 * 8; // Timestamp and three doubles
+        std::printf("append   %10zu points  %7.1f ns/point   sync %.1f ms\n", points,
+                    append_seconds * 1e9 / static_cast<double>(points), sync_seconds * 1e3);
+        std::printf("disk     %10zu bytes   %7.2f bytes/point   %.3fx the raw values, %zu blocks in %zu segments\n",
+                    stats.disk_bytes, static_cast<double>(stats.disk_bytes) / static_cast<double>(points),
+                    static_cast<double>(stats.disk_bytes) / raw_bytes, static_cast<size_t>(stats.blocks), stats.segments);
+    }
+
+    // Reopen: the index is rebuilt from the segments, then scans read the mapped columns
+    const auto open_start = Clock::now();
+    TimeSeriesStore store(options);
+    std::printf("reopen   %7.1f ms\n", secondsSince(open_start) * 1e3);
+
+    const auto scan = [&](const char* name, TimeSeriesStore::Clock::time_point from, TimeSeriesStore::Clock::time_point to,
+                          int repeats) {
+        double sum = 0.0;
+        size_t visited = 0;
+        const auto start = Clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            visited = store.scan("bme280", from, to, [&](const TimeSeriesStore::BlockView& view) {
+                for (const double value : view.column(2)) sum += value;
+                return true;
+            });
+        }
+        const double seconds = secondsSince(start) / repeats;
+        std::printf("%-8s %10zu points  %9.3f ms   %7.1f M points/s   (mean %.3f)\n", name, visited, seconds * 1e3,
+                    static_cast<double>(visited) / seconds / 1e6, visited ? sum / static_cast<double>(visited * static_cast<size_t>(repeats)) : 0.0);
+    };
+    const auto last = first + step * static_cast<int64_t>(points);
+    scan("all", first, last, 5);
+    scan("day", last - std::chrono::hours(24), last, 200);
+    scan("hour", last - std::chrono::hours(1), last, 2000);
+
+    // The whole range again, a few blocks per scan, each resuming after the last point seen
+    size_t parts = 0;
+    size_t visited = 0;
+    const auto parts_start = Clock::now();
+    for (auto next = first;;) {
+        size_t views = 0;
+        const size_t part = store.scan("bme280", next, last, [&](const TimeSeriesStore::BlockView& view) {
+            next = TimeSeriesStore::Clock::time_point(std::chrono::nanoseconds(view.timestamps_ns.back() + 1));
+            return ++views < 8;
+        });
+        if (part == 0) break;
+        visited += part;
+        ++parts;
+    }
+    const double parts_seconds = secondsSince(parts_start);
+    std::printf("parts    %10zu points  %9.3f ms   %zu scans, %.1f us each\n", visited, parts_seconds * 1e3, parts,
+                parts ? parts_seconds * 1e6 / static_cast<double>(parts) : 0.0);
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
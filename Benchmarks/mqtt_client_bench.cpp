@@ -0,0 +1,146 @@
+// MQTT client benchmark: throughput, ack latency, heap allocations and memory footprint
+// of one MqttPublisher backend against a running broker (e.g. a local mosquitto).
+// Run once per backend and compare.
+//
+// Usage: mqtt_client_bench <paho|epoll> [broker_address] [messages] [qos]
+//
+// broker_address "local" starts an in-process LoopbackBroker on a free TCP port, so no
+// external broker is needed (its threads and memory count towards the footprint).
+// "loop://<name>" skips the socket altogether and measures the publisher alone.
+
+#include "NetworkMQTT/loopback_broker.h"
+#include "NetworkMQTT/mqtt_publisher.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+
+using namespace SensorHub::Components;
+
+// --- Allocation counting ---
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Footprint {
+    long rss_kb = 0;      // VmRSS
+    long peak_rss_kb = 0; // VmHWM
+    long threads = 0;
+};
+
+Footprint footprint() {
+    Footprint result;
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    long value = 0;
+    while (status >> key) {
+        if (key == "VmRSS:" && status >> value) result.rss_kb = value;
+        else if (key == "VmHWM:" && status >> value) result.peak_rss_kb = value;
+        else if (key == "Threads:" && status >> value) result.threads = value;
+        status.ignore(256, '\n');
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <paho|epoll> [broker_address] [messages] [qos]\n", argv[0]);
+        return 2;
+    }
+    const auto backend = MqttPublisher::parseBackend(argv[1]);
+    if (!backend) {
+        std::fprintf(stderr, "Unknown or unavailable backend '%s'\n", argv[1]);
+        return 2;
+    }
+    std::string address = argc > 2 ? argv[2] : "tcp://127.0.0.1:1883";
+    const size_t messages = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100000;
+    const int qos = argc > 4 ? std::atoi(argv[4]) : 1;
+
+    std::shared_ptr<LoopbackBroker> broker = LoopbackBroker::forAddress(address);
+    if (address == "local") {
+        broker = std::make_shared<LoopbackBroker>();
+        broker->listen();
+        address = broker->tcpAddress();
+    }
+
+    const Footprint before = footprint();
+    MqttPublisher::Options options;
+    options.backend = *backend;
+    MqttPublisher publisher(address, "mqtt_client_bench", options);
+    if (!publisher.connect(5000)) {
+        std::fprintf(stderr, "Could not connect to %s\n", address.c_str());
+        return 1;
+    }
+    const Footprint connected = footprint();
+
+    // A typical JSON reading
+    const std::string topic = "bench/dummy_test";
+    const std::string payload =
+        R"({"counter":42,"random_value":38.3,"status":"OK","timestamp":"2025-01-31T12:00:05Z",)"
+        R"("platform":"Linux_RPi","sensor_type":"Dummy","topic_suffix":"dummy_test"})";
+
+    size_t window_full = 0;
+    const uint64_t allocations_before = g_allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages;) {
+        switch (publisher.tryPublish(topic, payload, qos)) {
+            case MqttPublisher::PublishResult::Accepted:
+                ++i;
+                break;
+            case MqttPublisher::PublishResult::WindowFull:
+                ++window_full;
+                std::this_thread::yield();
+                break;
+            default:
+                std::fprintf(stderr, "Publish failed after %zu messages\n", i);
+                return 1;
+        }
+    }
+    while (publisher.window().stats().messages > 0) std::this_thread::sleep_for(std::chrono::microseconds(100));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const uint64_t allocations = g_allocations.load() - allocations_before;
+    const Footprint loaded = footprint();
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const auto latency = publisher.window().ackLatency().summary();
+    const auto stats = publisher.window().stats();
+    std::printf("backend %s, %zu messages of %zu bytes at QoS %d to %s\n",
+                publisher.backendName(), messages, payload.size(), qos, address.c_str());
+    std::printf("%-24s %12.0f\n", "msgs/s", static_cast<double>(messages) / seconds);
+    std::printf("%-24s %12.2f\n", "allocs/publish", static_cast<double>(allocations) / static_cast<double>(messages));
+    std::printf("%-24s %12llu / %llu / %llu / %llu\n", "ack latency us p50/p90/p99/max",
+                static_cast<unsigned long long>(latency.p50), static_cast<unsigned long long>(latency.p90),
+                static_cast<unsigned long long>(latency.p99), static_cast<unsigned long long>(latency.max));
+    std::printf("%-24s %12zu (failed %llu)\n", "window full (retries)", window_full,
+                static_cast<unsigned long long>(stats.failed));
+    std::printf("%-24s %12ld -> %ld -> %ld (peak %ld)\n", "RSS kB idle/conn/loaded",
+                before.rss_kb, connected.rss_kb, loaded.rss_kb, loaded.peak_rss_kb);
+    std::printf("%-24s %12ld -> %ld\n", "threads idle/connected", before.threads, connected.threads);
+    if (broker) {
+        const auto received = broker->stats();
+        std::printf("%-24s %12.0f (%llu messages, %.1f bytes/msg)\n", "broker arrivals/s", received.messagesPerSecond(),
+                    static_cast<unsigned long long>(received.messages), received.bytesPerMessage());
+    }
+    publisher.disconnect();
+    return 0;
+}
@@ -0,0 +1,237 @@
+// Google Benchmark suite for the per-sample hot path: driver math, the JSON reading and
+// its payload, timestamps, I2C_Manager calls and metric updates. Compare commits with
+//
+//   SensorHub_bench --benchmark_format=json --benchmark_out=before.json
+//   <change, rebuild>
+//   SensorHub_bench --benchmark_format=json --benchmark_out=after.json
+//   compare.py benchmarks before.json after.json   (tools/ of Google Benchmark)
+
+#include "Encoding/payload_encoder.h"
+#include "Encoding/timestamp_formatter.h"
+#include "Interfaces/ii2c_bus.h"
+#include "Interfaces/sensor_config.h"
+#include "LinuxI2C_Manager/linux_i2c_manager.h"
+#include "Metrics/metrics_registry.h"
+#include "SensorBME280/bme280_defs.h"
+#include "SensorLPS25HB/lps25hb_defs.h"
+#include "SensorLPS25HB/sensor_lps25hb.h"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+using namespace SensorHub::Components;
+using namespace SensorHub::Interfaces;
+
+namespace {
+
+const std::string TOPIC_BASE = "rpisensor/data";
+const std::string PLATFORM = "Linux_RPi";
+
+// In-memory register file standing in for the devices on a bus: no syscalls, no delays
+class SimulatedBus : public II2C_Bus {
+public:
+    bool writeByteData(uint8_t, uint8_t reg, uint8_t value) override {
+        registers_[reg] = value;
+        return true;
+    }
+    std::optional<uint8_t> readByteData(uint8_t, uint8_t reg) override { return registers_[reg]; }
+    std::optional<std::vector<uint8_t>> readBlockData(uint8_t, uint8_t start_reg, size_t count) override {
+        std::vector<uint8_t> data(count);
+        for (size_t i = 0; i < count; ++i) data[i] = registers_[(start_reg + i) & 0xFF];
+        return data;
+    }
+    bool writeBlockData(uint8_t, uint8_t start_reg, const std::vector<uint8_t>& data) override {
+        for (size_t i = 0; i < data.size(); ++i) registers_[(start_reg + i) & 0xFF] = data[i];
+        return true;
+    }
+    bool probeDevice(uint8_t) override { return true; }
+    const std::string& getBusPath() const override { return path_; }
+
+    std::array<uint8_t, 256> registers_{};
+
+private:
+    std::string path_ = "simulated";
+};
+
+// An LPS25HB at ~1013 hPa / ~22.5 C on a SimulatedBus (registers read with AUTO_INCREMENT)
+std::unique_ptr<ISensor> makeLps25hb() {
+    auto bus = std::make_shared<SimulatedBus>();
+    bus->registers_[LPS25HB::WHO_AM_I] = 0xBD;
+    const uint8_t pressure[3] = {0x66, 0x46, 0x3F};
+    const uint8_t temperature[2] = {0x80, 0xDA};
+    for (size_t i = 0; i < 3; ++i) bus->registers_[(LPS25HB::PRESS_OUT_XL | LPS25HB::AUTO_INCREMENT) + i] = pressure[i];
+    for (size_t i = 0; i < 2; ++i) bus->registers_[(LPS25HB::TEMP_OUT_L | LPS25HB::AUTO_INCREMENT) + i] = temperature[i];
+    SensorConfig config;
+    config.type = "LPS25HB";
+    config.enabled = true;
+    config.publish_topic_suffix = "lps25hb";
+    config.i2c_bus = bus->getBusPath();
+    config.i2c_address = LPS25HB::DEFAULT_ADDRESS;
+    return SensorLPS25HB::create(config, bus);
+}
+
+// The timestamp helper of the original publish loop (App::getCurrentTimestamp)
+std::string legacyTimestamp(std::chrono::system_clock::time_point now) {
+    auto itt = std::chrono::system_clock::to_time_t(now);
+    std::ostringstream ss;
+    ss << std::put_time(std::gmtime(&itt), "%FT%TZ");
+    return ss.str();
+}
+
+// --- Sensor drivers ---
+
+void BM_Bme280Compensate(benchmark::State& state) {
+    // Datasheet example trimming values
+    BME280::Calibration calib;
+    calib.dig_T1 = 27504; calib.dig_T2 = 26435; calib.dig_T3 = -1000;
+    calib.dig_P1 = 36477; calib.dig_P2 = -10685; calib.dig_P3 = 3024; calib.dig_P4 = 2855; calib.dig_P5 = 140;
+    calib.dig_P6 = -7; calib.dig_P7 = 15500; calib.dig_P8 = -14600; calib.dig_P9 = 6000;
+    calib.dig_H1 = 75; calib.dig_H2 = 362; calib.dig_H3 = 0; calib.dig_H4 = 313; calib.dig_H5 = 50; calib.dig_H6 = 30;
+    int32_t adc_T = 519888, adc_P = 415148, adc_H = 30000;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(adc_T);
+        benchmark::DoNotOptimize(adc_P);
+        benchmark::DoNotOptimize(adc_H);
+        benchmark::DoNotOptimize(BME280::compensate(calib, adc_T, adc_P, adc_H));
+    }
+}
+BENCHMARK(BM_Bme280Compensate);
+
+void BM_Lps25hbDecode(benchmark::State& state) {
+    uint8_t pressure[3] = {0x66, 0x46, 0x3F};
+    uint8_t temperature[2] = {0x80, 0xDA};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pressure);
+        benchmark::DoNotOptimize(temperature);
+        benchmark::DoNotOptimize(LPS25HB::decodePressure(pressure));
+        benchmark::DoNotOptimize(LPS25HB::decodeTemperature(temperature));
+    }
+}
+BENCHMARK(BM_Lps25hbDecode);
+
+// Two block reads, decoding and the JSON object, on a bus without I/O cost
+void BM_Lps25hbReadDataJson(benchmark::State& state) {
+    auto sensor = makeLps25hb();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sensor->readDataJson());
+    }
+}
+BENCHMARK(BM_Lps25hbReadDataJson);
+
+// --- Payload ---
+
+// Read, copy the reading, add timestamp and metadata, dump(): the original publish loop
+void BM_ReadAndDumpPayload(benchmark::State& state) {
+    auto sensor = makeLps25hb();
+    for (auto _ : state) {
+        json payload = sensor->readDataJson();
+        payload["timestamp"] = legacyTimestamp(std::chrono::system_clock::now());
+        payload["platform"] = PLATFORM;
+        payload["sensor_type"] = sensor->getType();
+        payload["topic_suffix"] = sensor->getTopicSuffix();
+        std::string text = payload.dump();
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+BENCHMARK(BM_ReadAndDumpPayload);
+
+// Read, then PayloadEncoder into a reused buffer: the current encode stage
+void BM_ReadAndEncodePayload(benchmark::State& state) {
+    auto sensor = makeLps25hb();
+    PayloadEncoder::Options options;
+    options.topic_base = TOPIC_BASE;
+    options.platform = PLATFORM;
+    const PayloadEncoder encoder(std::move(options));
+    const auto channel = encoder.makeChannel(sensor->getType(), sensor->getTopicSuffix());
+    std::string buffer;
+    for (auto _ : state) {
+        buffer.clear();
+        encoder.encode(channel, sensor->readDataJson(), std::chrono::system_clock::now(), buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+BENCHMARK(BM_ReadAndEncodePayload);
+
+void BM_TimestampPutTime(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacyTimestamp(std::chrono::system_clock::now()));
+    }
+}
+BENCHMARK(BM_TimestampPutTime);
+
+void BM_TimestampFormatter(benchmark::State& state) {
+    TimestampFormatter formatter;
+    char out[TimestampFormatter::MAX_LENGTH];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(formatter.format(std::chrono::system_clock::now(),
+                                                  TimestampFormatter::Precision::Milliseconds, out));
+    }
+}
+BENCHMARK(BM_TimestampFormatter);
+
+// --- I2C_Manager ---
+// On /dev/zero with device address 0: the manager's address cache starts at 0, so no
+// I2C_SLAVE ioctl is issued, and every call is its lock, metrics and the read()/write()
+// syscalls. Argument: 1 = with a MetricsRegistry, 0 = without.
+
+void BM_I2CManagerReadByte(benchmark::State& state) {
+    MetricsRegistry metrics;
+    I2C_Manager bus("/dev/zero", state.range(0) ? &metrics : nullptr);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bus.readByteData(0x00, 0xD0));
+    }
+}
+BENCHMARK(BM_I2CManagerReadByte)->Arg(0)->Arg(1);
+
+void BM_I2CManagerReadBlock(benchmark::State& state) {
+    MetricsRegistry metrics;
+    I2C_Manager bus("/dev/zero", state.range(0) ? &metrics : nullptr);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bus.readBlockData(0x00, BME280::REG_PRESS_MSB, 8));
+    }
+}
+BENCHMARK(BM_I2CManagerReadBlock)->Arg(0)->Arg(1);
+
+void BM_I2CManagerWriteByte(benchmark::State& state) {
+    MetricsRegistry metrics;
+    I2C_Manager bus("/dev/null", state.range(0) ? &metrics : nullptr);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bus.writeByteData(0x00, BME280::REG_CTRL_MEAS, BME280::CTRL_MEAS_FORCED));
+    }
+}
+BENCHMARK(BM_I2CManagerWriteByte)->Arg(0)->Arg(1);
+
+// --- Metrics ---
+// Instrumented code pays one of these per event; threads > 1 share one counter (worst case)
+
+void BM_CounterInc(benchmark::State& state) {
+    static MetricsRegistry metrics;
+    Counter& counter = metrics.counter("bench_events_total", "Events.");
+    for (auto _ : state) {
+        counter.inc();
+    }
+}
+BENCHMARK(BM_CounterInc)->Threads(1)->Threads(4);
+
+void BM_HistogramObserve(benchmark::State& state) {
+    static MetricsRegistry metrics;
+    Histogram& histogram = metrics.histogram("bench_seconds", "Durations.", Histogram::exponentialBounds(50e-6, 2, 12));
+    double value = 0.0007;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        histogram.observe(value);
+    }
+}
+BENCHMARK(BM_HistogramObserve)->Threads(1)->Threads(4);
+
+} // namespace
+
+BENCHMARK_MAIN();
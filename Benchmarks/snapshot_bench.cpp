@@ -0,0 +1,114 @@
+// Shared-memory snapshot benchmark: latency of SnapshotWriter::update() and of
+// SnapshotReader::read() on separate threads, plus how often a read collided with a
+// write and had to be retried. The writer runs flat out (the worst case for readers)
+// unless writer_hz paces it like a real sensor.
+//
+// Usage: snapshot_bench [readers] [seconds] [writer_hz]
+
+#include "Snapshot/snapshot_reader.h"
+#include "Snapshot/snapshot_writer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace SensorHub::Components;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Every 64th operation is timed on its own; the clock reads are included in the figures
+constexpr uint64_t SAMPLE_EVERY = 64;
+
+struct Result {
+    uint64_t operations = 0;
+    uint64_t retries = 0;
+    std::vector<uint32_t> samples_ns;
+};
+
+void printRow(const char* name, Result& result, double seconds) {
+    auto& samples = result.samples_ns;
+    std::sort(samples.begin(), samples.end());
+    const auto at = [&](double quantile) {
+        return samples.empty() ? 0u : samples[static_cast<size_t>(quantile * static_cast<double>(samples.size() - 1))];
+    };
+    std::printf("%-8s %12.0f ops/s   ns p50/p99/p99.9/max %5u / %5u / %5u / %6u", name,
+                static_cast<double>(result.operations) / seconds, at(0.5), at(0.99), at(0.999), at(1.0));
+    if (result.retries) {
+        std::printf("   retried %.4f%%", 100.0 * static_cast<double>(result.retries) / static_cast<double>(result.operations));
+    }
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned readers = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 2;
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 2.0;
+    const double writer_hz = argc > 3 ? std::atof(argv[3]) : 0.0;
+
+    SnapshotWriter::Options options;
+    options.name = "/sensorhub_bench_" + std::to_string(::getpid());
+    options.slots = 8;
+    SnapshotWriter writer(options);
+    const uint32_t slot = *writer.addChannel("bme280");
+
+    std::atomic<bool> stop{false};
+    Result written;
+    std::thread writer_thread([&] {
+        // A BME280 reading
+        const SnapshotWriter::Value values[] = {{"temperature", 21.5}, {"humidity", 40.2}, {"pressure", 1013.25}};
+        const auto period = writer_hz > 0 ? std::chrono::duration_cast<Clock::duration>(
+                                                std::chrono::duration<double>(1.0 / writer_hz))
+                                          : Clock::duration::zero();
+        auto next = Clock::now();
+        for (uint64_t n = 0; !stop.load(std::memory_order_relaxed); ++n) {
+            if (period.count() > 0) {
+                next += period;
+                std::this_thread::sleep_until(next);
+            }
+            if (period.count() > 0 || n % SAMPLE_EVERY == 0) {
+                const auto start = Clock::now();
+                writer.update(slot, std::chrono::system_clock::time_point{}, values);
+                written.samples_ns.push_back(static_cast<uint32_t>((Clock::now() - start).count()));
+            } else {
+                writer.update(slot, std::chrono::system_clock::time_point{}, values);
+            }
+            ++written.operations;
+        }
+    });
+
+    std::vector<Result> read(readers);
+    std::vector<std::thread> reader_threads;
+    for (unsigned r = 0; r < readers; ++r) {
+        reader_threads.emplace_back([&, r] {
+            SnapshotReader reader(options.name);
+            SnapshotReader::Reading reading;
+            Result& result = read[r];
+            for (uint64_t n = 0; !stop.load(std::memory_order_relaxed); ++n) {
+                const bool timed = n % SAMPLE_EVERY == 0;
+                const auto start = timed ? Clock::now() : Clock::time_point{};
+                while (!reader.tryRead(slot, reading)) ++result.retries;
+                if (timed) result.samples_ns.push_back(static_cast<uint32_t>((Clock::now() - start).count()));
+                ++result.operations;
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    writer_thread.join();
+    for (auto& thread : reader_threads) thread.join();
+
+    std::printf("%u reader(s) and one writer (%s) on the same slot for %.1fs\n", readers,
+                writer_hz > 0 ? (std::to_string(writer_hz) + " Hz").c_str() : "flat out", seconds);
+    printRow("update", written, seconds);
+    for (unsigned r = 0; r < readers; ++r) printRow(("read " + std::to_string(r)).c_str(), read[r], seconds);
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include "Batching/publish_batcher.h"
+#include "gtest/gtest.h"
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using namespace std::chrono_literals;
+using json = nlohmann::json;
+using Clock = PublishBatcher::Clock;
+
+Payload payload(PayloadPool& pool, const std::string& text) {
+    Payload out = pool.acquire();
+    out.buffer() = text;
+    return out;
+}
+
+PublishBatcher::Limits limits(size_t max_count, size_t max_bytes = 8192,
+                              std::chrono::milliseconds max_age = std::chrono::milliseconds(2000)) {
+    return {max_count, max_bytes, max_age};
+}
+
+} // namespace
+
+TEST(PublishBatcherTest, FlushesJsonArraysAtMaxCount) {
+    PayloadPool pool;
+    PublishBatcher batcher(pool, PublishBatcher::Format::Json);
+    const auto now = Clock::now();
+
+    EXPECT_TRUE(batcher.add("t/a", "", payload(pool, "{\"n\":1}"), limits(3), now).empty());
+    EXPECT_TRUE(batcher.add("t/b", "", payload(pool, "{\"m\":1}"), limits(3), now).empty());
+    EXPECT_TRUE(batcher.add("t/a", "", payload(pool, "{\"n\":2}"), limits(3), now).empty());
+    EXPECT_EQ(batcher.pendingItems(), 3u);
+
+    const auto ready = batcher.add("t/a", "", payload(pool, "{\"n\":3}"), limits(3), now);
+    ASSERT_EQ(ready.size(), 1u);
+    EXPECT_EQ(ready[0].topic, "t/a");
+    EXPECT_EQ(ready[0].count, 3u);
+    EXPECT_EQ(ready[0].payload.str(), "[{\"n\":1},{\"n\":2},{\"n\":3}]");
+    EXPECT_EQ(json::parse(ready[0].payload.str()).size(), 3u);
+    EXPECT_EQ(batcher.pendingItems(), 1u);
+    EXPECT_EQ(batcher.format(), PublishBatcher::Format::Json);
+}
+
+TEST(PublishBatcherTest, FlushesBeforeAnItemWouldExceedMaxBytes) {
+    PayloadPool pool;
+    PublishBatcher batcher(pool, PublishBatcher::Format::Json);
+    const auto now = Clock::now();
+    const std::string item(10, 'x'); // 11 bytes in a batch with its separator
+
+    EXPECT_TRUE(batcher.add("t", "", payload(pool, item), limits(10, 25), now).empty()); // "[x" = 11
+    EXPECT_TRUE(batcher.add("t", "", payload(pool, item), limits(10, 25), now).empty()); // ",x" = 22
+    auto ready = batcher.add("t", "", payload(pool, item), limits(10, 25), now);         // 33 > 25
+    ASSERT_EQ(ready.size(), 1u);
+    EXPECT_EQ(ready[0].count, 2u);
+    EXPECT_EQ(ready[0].payload.size(), 23u);
+    EXPECT_EQ(batcher.pendingItems(), 1u); // The third item opened a new batch
+
+    // An item that fills a batch on its own goes out at once
+    ready = batcher.add("big", "", payload(pool, std::string(30, 'y')), limits(10, 25), now);
+    ASSERT_EQ(ready.size(), 1u);
+    EXPECT_EQ(ready[0].count, 1u);
+}
+
+TEST(PublishBatcherTest, FlushesAtTheEarliestLatencyCap) {
+    PayloadPool pool;
+    PublishBatcher batcher(pool, PublishBatcher::Format::Json);
+    const auto t0 = Clock::now();
+    EXPECT_FALSE(batcher.nextDeadline().has_value());
+
+    batcher.add("slow", "", payload(pool, "1"), limits(10, 8192, 100ms), t0);
+    batcher.add("fast", "", payload(pool, "2"), limits(10, 8192, 20ms), t0 + 50ms);
+    EXPECT_EQ(batcher.nextDeadline(), t0 + 70ms);
+    // A later item with a tighter cap pulls its batch's deadline in
+    batcher.add("slow", "", payload(pool, "3"), limits(10, 8192, 10ms), t0 + 55ms);
+    EXPECT_EQ(batcher.nextDeadline(), t0 + 65ms);
+
+    EXPECT_TRUE(batcher.flushDue(t0 + 64ms).empty());
+    auto ready = batcher.flushDue(t0 + 65ms);
+    ASSERT_EQ(ready.size(), 1u);
+    EXPECT_EQ(ready[0].topic, "slow");
+    EXPECT_EQ(ready[0].payload.str(), "[1,3]");
+    EXPECT_EQ(batcher.nextDeadline(), t0 + 70ms);
+
+    ready = batcher.flushDue(t0 + 1s);
+    ASSERT_EQ(ready.size(), 1u);
+    EXPECT_EQ(ready[0].topic, "fast");
+    EXPECT_FALSE(batcher.nextDeadline().has_value());
+
+    // A zero cap sends the item straight away
+    EXPECT_EQ(batcher.add("now", "", payload(pool, "4"), limits(10, 8192, 0ms), t0).size(), 1u);
+}
+
+TEST(PublishBatcherTest, PrefixesBinaryItemsWithSuffixAndLength) {
+    PayloadPool pool;
+    PublishBatcher batcher(pool, PublishBatcher::Format::Binary);
+    const auto now = Clock::now();
+    const std::string frame(200, '\xB1');
+
+    batcher.add("device", "bme280", payload(pool, frame), limits(10), now);
+    batcher.add("device", "", payload(pool, "\x01\x02"), limits(10), now);
+    const auto ready = batcher.flushAll();
+    ASSERT_EQ(ready.size(), 1u);
+    EXPECT_EQ(ready[0].count, 2u);
+
+    std::string expected;
+    expected += static_cast<char>(PublishBatcher::BINARY_BATCH_MAGIC);
+    expected += '\x06';
+    expected += "bme280";
+    expected += "\xC8\x01"; // 200 as varint
+    expected += frame;
+    expected += '\x00';
+    expected += '\x02';
+    expected += "\x01\x02";
+    EXPECT_EQ(ready[0].payload.str(), expected);
+    EXPECT_EQ(batcher.pendingItems(), 0u);
+}
+
+TEST(PublishBatcherTest, BuildsColumnarBlocksOfOneFieldLayout) {
+    PayloadPool pool;
+    PublishBatcher batcher(pool, PublishBatcher::Format::Columnar);
+    const json metadata = {{"platform", "Linux_RPi"}, {"sensor_type", "BME280"}};
+    const auto now = Clock::now();
+    const auto wall = std::chrono::system_clock::time_point(std::chrono::seconds(1760000000));
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(batcher.addReading("t", {{"temperature_celsius", 21.5 + i}}, metadata, wall + i * 10s,
+                                       limits(10), now).empty());
+    }
+    // Another field layout cannot share the block: the open one goes out first
+    const auto ready = batcher.addReading("t", {{"pressure_hpa", 1013.25}}, metadata, wall + 30s, limits(10), now);
+    ASSERT_EQ(ready.size(), 1u);
+    EXPECT_EQ(ready[0].count, 3u);
+    ASSERT_TRUE(TimeSeriesEncoder::isBlock(ready[0].payload.view()));
+    const auto block = TimeSeriesDecoder::decode(ready[0].payload.view());
+    ASSERT_TRUE(block.has_value());
+    EXPECT_EQ(block->metadata, metadata);
+    ASSERT_EQ(block->timestamps_ms.size(), 3u);
+    EXPECT_EQ(block->timestamps_ms[2], 1760000020000);
+    ASSERT_EQ(block->columns.size(), 1u);
+    EXPECT_EQ(block->columns[0].values, (std::vector<json>{21.5, 22.5, 23.5}));
+    EXPECT_EQ(batcher.pendingItems(), 1u);
+
+    // Count limit applies to readings as well
+    EXPECT_EQ(batcher.addReading("u", {{"a", 1}}, metadata, wall, limits(1), now).size(), 1u);
+
+    PublishBatcher json_batcher(pool, PublishBatcher::Format::Json);
+    EXPECT_THROW(json_batcher.addReading("t", {{"a", 1}}, metadata, wall, limits(10), now), std::logic_error);
+}
+
+TEST(PublishBatcherTest, FlushesAColumnarBlockBeforeTheNextRowWouldExceedMaxBytes) {
+    PayloadPool pool;
+    PublishBatcher batcher(pool, PublishBatcher::Format::Columnar);
+    const json metadata = {{"sensor_type", "BME280"}};
+    const auto now = Clock::now();
+    const auto wall = std::chrono::system_clock::time_point(std::chrono::seconds(1760000000));
+
+    TimeSeriesEncoder probe(TimeSeriesEncoder::Options{}, metadata);
+    probe.append({{"temperature_celsius", 21.5}}, wall);
+    const size_t max_bytes = probe.size() + 3; // Room for a small row, not for an unrelated value
+
+    EXPECT_TRUE(batcher.addReading("t", {{"temperature_celsius", 21.5}}, metadata, wall,
+                                   limits(10, max_bytes), now).empty());
+    const auto ready = batcher.addReading("t", {{"temperature_celsius", -1.0e300}}, metadata, wall + 10s,
+                                          limits(10, max_bytes), now);
+    ASSERT_EQ(ready.size(), 1u);
+    EXPECT_EQ(ready[0].count, 1u);
+    EXPECT_LE(ready[0].payload.size(), max_bytes);
+    EXPECT_EQ(batcher.pendingItems(), 1u);
+}
+
+TEST(PublishBatcherTest, RejectedReadingLeavesNoEmptyColumnarBatch) {
+    PayloadPool pool;
+    PublishBatcher batcher(pool, PublishBatcher::Format::Columnar);
+    const auto now = Clock::now();
+    const auto wall = std::chrono::system_clock::time_point(std::chrono::seconds(1760000000));
+
+    EXPECT_THROW(batcher.addReading("t", json::array({1, 2}), json::object(), wall, limits(10), now),
+                 std::invalid_argument);
+    EXPECT_TRUE(batcher.flushDue(now + 1h).empty());
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Encoding/payload_pool.h"
+#include "Encoding/time_series_codec.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Collects encoded payloads into one MQTT message per topic.
+ *
+ * A batch is flushed when it reaches its count or byte limit, or when its oldest reading
+ * has waited max_age (the latency cap). Batch layout depends on the payload format:
+ *  - JSON:   "[<payload>,<payload>,...]" (each payload unchanged)
+ *  - Binary: u8 0xB2, then per item: varint suffix length, suffix, varint frame length, frame.
+ *            The suffix names the sensor in device-wide batches and is empty otherwise.
+ *  - Columnar: one TimeSeriesEncoder block (0xB3) of raw readings, added with addReading().
+ *            A reading whose fields differ from the open block's closes the batch early.
+ * Thread-safe.
+ */
+class PublishBatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint8_t BINARY_BATCH_MAGIC = 0xB2;
+
+    enum class Format { Json, Binary, Columnar };
+
+    struct Limits {
+        size_t max_count = 10;
+        size_t max_bytes = 8192;
+        std::chrono::milliseconds max_age{2000};
+    };
+
+    struct Batch {
+        std::string topic;
+        Payload payload;
+        size_t count = 0;
+    };
+
+    /**
+     * @param pool Pool for batch buffers (must outlive the batcher).
+     * @param format Layout of the batched messages.
+     * @param columnar Column encodings of Columnar batches.
+     */
+    PublishBatcher(PayloadPool& pool, Format format, TimeSeriesEncoder::Options columnar = {});
+
+    Format format() const { return format_; }
+
+    /**
+     * @brief Adds one encoded payload to the batch for topic.
+     * @param topic Topic the batch is published on.
+     * @param suffix Sensor name stored with binary items (empty for per-sensor batches).
+     * @param item The encoded payload.
+     * @param limits Count/byte limits for the batch and this item's latency cap.
+     * @param now Current time.
+     * @return Batches that are complete and should be published now (usually none).
+     */
+    std::vector<Batch> add(const std::string& topic, std::string_view suffix, const Payload& item,
+                           const Limits& limits, Clock::time_point now);
+
+    /**
+     * @brief Adds one raw reading to the columnar batch for topic (Format::Columnar only).
+     * The size of an encoded row is only known once it went in, so the batch is flushed first
+     * if the previous row's size would take it past max_bytes, and checked again afterwards.
+     * @param topic Topic the batch is published on.
+     * @param reading The sensor's JSON reading.
+     * @param metadata Static string members stored once per batch (platform, sensor_type, ...).
+     * @param timestamp Time of the reading.
+     * @param limits Count/byte limits for the batch and this item's latency cap.
+     * @param now Current time.
+     * @return Batches that are complete and should be published now (usually none).
+     * @throws std::invalid_argument if reading is not a JSON object.
+     */
+    std::vector<Batch> addReading(const std::string& topic, const nlohmann::json& reading,
+                                  const nlohmann::json& metadata, std::chrono::system_clock::time_point timestamp,
+                                  const Limits& limits, Clock::time_point now);
+
+    /**
+     * @brief Removes and returns every batch whose latency cap has passed.
+     */
+    std::vector<Batch> flushDue(Clock::time_point now);
+
+    /**
+     * @brief Removes and returns every pending batch (shutdown).
+     */
+    std::vector<Batch> flushAll();
+
+    /**
+     * @brief Earliest latency cap of the pending batches, if any.
+     */
+    std::optional<Clock::time_point> nextDeadline() const;
+
+    /**
+     * @brief Number of readings waiting in batches.
+     */
+    size_t pendingItems() const;
+
+    // Delete copy/move operations
+    PublishBatcher(const PublishBatcher&) = delete;
+    PublishBatcher& operator=(const PublishBatcher&) = delete;
+    PublishBatcher(PublishBatcher&&) = delete;
+    PublishBatcher& operator=(PublishBatcher&&) = delete;
+
+private:
+    struct Pending {
+        Payload buffer;
+        size_t count = 0;
+        Clock::time_point deadline;
+        std::unique_ptr<TimeSeriesEncoder> series; // Columnar only
+        size_t row_bytes = 0;                      // Columnar: growth of the last row, the next one's estimate
+    };
+
+    size_t itemSize(std::string_view suffix, const Payload& item) const;
+    void append(Pending& pending, std::string_view suffix, const Payload& item) const;
+    Batch close(const std::string& topic, Pending& pending) const;
+
+    PayloadPool& pool_;
+    const Format format_;
+    const TimeSeriesEncoder::Options columnar_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Pending> pending_; // Keyed by topic
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,153 @@
+#include "Batching/publish_batcher.h"
+#include "Encoding/wire_primitives.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace SensorHub::Components {
+
+using wire::putVarint;
+using wire::varintSize;
+
+PublishBatcher::PublishBatcher(PayloadPool& pool, Format format, TimeSeriesEncoder::Options columnar)
+    : pool_(pool), format_(format), columnar_(std::move(columnar)) {}
+
+size_t PublishBatcher::itemSize(std::string_view suffix, const Payload& item) const {
+    if (format_ == Format::Json) return item.size() + 1; // Payload plus ',' or ']'
+    return varintSize(suffix.size()) + suffix.size() + varintSize(item.size()) + item.size();
+}
+
+void PublishBatcher::append(Pending& pending, std::string_view suffix, const Payload& item) const {
+    std::string& out = pending.buffer.buffer();
+    if (format_ == Format::Json) {
+        out += pending.count == 0 ? '[' : ',';
+        out += item.view();
+    } else {
+        if (pending.count == 0) out += static_cast<char>(BINARY_BATCH_MAGIC);
+        putVarint(suffix.size(), out);
+        out += suffix;
+        putVarint(item.size(), out);
+        out += item.view();
+    }
+    ++pending.count;
+}
+
+PublishBatcher::Batch PublishBatcher::close(const std::string& topic, Pending& pending) const {
+    if (format_ == Format::Json) pending.buffer.buffer() += ']';
+    if (pending.series) pending.series->finish(pending.buffer.buffer());
+    Batch batch{topic, std::move(pending.buffer), pending.count};
+    pending.count = 0;
+    return batch;
+}
+
+std::vector<PublishBatcher::Batch> PublishBatcher::add(const std::string& topic, std::string_view suffix,
+                                                       const Payload& item, const Limits& limits,
+                                                       Clock::time_point now) {
+    std::vector<Batch> ready;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = pending_.find(topic);
+    if (it != pending_.end() && it->second.buffer.size() + itemSize(suffix, item) > limits.max_bytes) {
+        // Would overflow: send what we have and start over with this item
+        ready.push_back(close(it->first, it->second));
+        pending_.erase(it);
+        it = pending_.end();
+    }
+    if (it == pending_.end()) {
+        it = pending_.emplace(topic, Pending{pool_.acquire(), 0, now + limits.max_age, nullptr}).first;
+    }
+
+    Pending& pending = it->second;
+    append(pending, suffix, item);
+    pending.deadline = std::min(pending.deadline, now + limits.max_age);
+
+    if (pending.count >= limits.max_count || pending.buffer.size() >= limits.max_bytes || pending.deadline <= now) {
+        ready.push_back(close(it->first, pending));
+        pending_.erase(it);
+    }
+    return ready;
+}
+
+std::vector<PublishBatcher::Batch> PublishBatcher::addReading(const std::string& topic, const nlohmann::json& reading,
+                                                              const nlohmann::json& metadata,
+                                                              std::chrono::system_clock::time_point timestamp,
+                                                              const Limits& limits, Clock::time_point now) {
+    if (format_ != Format::Columnar) throw std::logic_error("addReading() needs a columnar batcher");
+    std::vector<Batch> ready;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = pending_.find(topic);
+    if (it != pending_.end() && (!it->second.series->accepts(reading) ||
+                                 it->second.series->size() + it->second.row_bytes > limits.max_bytes)) {
+        // Field layout changed (a block holds one layout) or a row like the last would
+        // overflow: send what we have and start over with this reading
+        ready.push_back(close(it->first, it->second));
+        pending_.erase(it);
+        it = pending_.end();
+    }
+    const bool created = it == pending_.end();
+    if (created) {
+        it = pending_.emplace(topic, Pending{pool_.acquire(), 0, now + limits.max_age,
+                                             std::make_unique<TimeSeriesEncoder>(columnar_, metadata)}).first;
+    }
+
+    Pending& pending = it->second;
+    const size_t size_before = pending.series->size();
+    try {
+        pending.series->append(reading, timestamp);
+    } catch (...) {
+        if (created) pending_.erase(it); // Don't leave an empty batch behind
+        throw;
+    }
+    pending.row_bytes = std::max<size_t>(pending.series->size() - size_before, 1); // Rows can be under a byte
+    ++pending.count;
+    pending.deadline = std::min(pending.deadline, now + limits.max_age);
+
+    if (pending.count >= limits.max_count || pending.series->size() >= limits.max_bytes || pending.deadline <= now) {
+        ready.push_back(close(it->first, pending));
+        pending_.erase(it);
+    }
+    return ready;
+}
+
+std::vector<PublishBatcher::Batch> PublishBatcher::flushDue(Clock::time_point now) {
+    std::vector<Batch> ready;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->second.deadline <= now) {
+            ready.push_back(close(it->first, it->second));
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return ready;
+}
+
+std::vector<PublishBatcher::Batch> PublishBatcher::flushAll() {
+    std::vector<Batch> ready;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [topic, pending] : pending_) {
+        ready.push_back(close(topic, pending));
+    }
+    pending_.clear();
+    return ready;
+}
+
+std::optional<PublishBatcher::Clock::time_point> PublishBatcher::nextDeadline() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::optional<Clock::time_point> earliest;
+    for (const auto& [topic, pending] : pending_) {
+        if (!earliest || pending.deadline < *earliest) earliest = pending.deadline;
+    }
+    return earliest;
+}
+
+size_t PublishBatcher::pendingItems() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t items = 0;
+    for (const auto& [topic, pending] : pending_) items += pending.count;
+    return items;
+}
+
+} // namespace SensorHub::Components
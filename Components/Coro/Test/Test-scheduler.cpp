@@ -0,0 +1,132 @@
+#include "Coro/scheduler.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace SensorHub::Coro {
+
+using namespace std::chrono_literals;
+using Clock = Scheduler::Clock;
+
+namespace {
+
+Task<void> wakeAt(Clock::time_point when, std::string name, std::vector<std::string>& order) {
+    co_await at(when);
+    order.push_back(std::move(name));
+}
+
+Task<void> sleepFor(Clock::duration delay, Clock::duration& slept, Scheduler*& seen) {
+    seen = Scheduler::current();
+    const auto start = Clock::now();
+    co_await after(delay);
+    slept = Clock::now() - start;
+}
+
+Task<void> throwNow() {
+    throw std::runtime_error("spawned failure");
+    co_return;
+}
+
+Task<void> countTicks(int& ticks) {
+    for (;;) {
+        co_await after(1ms);
+        ++ticks;
+    }
+}
+
+struct SetOnDestroy {
+    bool& destroyed;
+    ~SetOnDestroy() { destroyed = true; }
+};
+
+Task<void> sleepForever(bool& destroyed) {
+    SetOnDestroy guard{destroyed};
+    co_await after(1h);
+}
+
+} // namespace
+
+TEST(SchedulerTest, ResumesTimersInDeadlineOrder) {
+    std::vector<std::string> order;
+    Scheduler scheduler;
+    const auto base = Clock::now();
+    scheduler.spawn(wakeAt(base + 30ms, "third", order));
+    scheduler.spawn(wakeAt(base + 10ms, "first", order));
+    scheduler.spawn(wakeAt(base + 20ms, "second-a", order));
+    scheduler.spawn(wakeAt(base + 20ms, "second-b", order)); // Equal deadlines stay FIFO
+    scheduler.spawn(wakeAt(base - 1s, "past", order));       // Ready at once, no timer
+    EXPECT_EQ(scheduler.activeTasks(), 5u);
+    scheduler.run();
+
+    EXPECT_EQ(order, (std::vector<std::string>{"past", "first", "second-a", "second-b", "third"}));
+    EXPECT_EQ(scheduler.activeTasks(), 0u);
+    EXPECT_GE(Clock::now() - base, 30ms);
+}
+
+TEST(SchedulerTest, AfterSleepsWithoutBlockingOtherTasks) {
+    Clock::duration slept_a{}, slept_b{};
+    Scheduler* seen_a = nullptr;
+    Scheduler* seen_b = nullptr;
+    Scheduler scheduler;
+    const auto start = Clock::now();
+    scheduler.spawn(sleepFor(40ms, slept_a, seen_a));
+    scheduler.spawn(sleepFor(40ms, slept_b, seen_b));
+    scheduler.run();
+
+    EXPECT_GE(slept_a, 40ms);
+    EXPECT_GE(slept_b, 40ms);
+    EXPECT_LT(Clock::now() - start, 75ms); // Both waited at the same time on one thread
+    EXPECT_EQ(seen_a, &scheduler);
+    EXPECT_EQ(seen_b, &scheduler);
+    EXPECT_EQ(Scheduler::current(), nullptr);
+}
+
+TEST(SchedulerTest, SwallowsExceptionsOfSpawnedTasks) {
+    std::vector<std::string> order;
+    Scheduler scheduler;
+    scheduler.spawn(throwNow());
+    scheduler.spawn(wakeAt(Clock::now() + 1ms, "survivor", order));
+    scheduler.run();
+    EXPECT_EQ(order, std::vector<std::string>{"survivor"});
+    EXPECT_EQ(scheduler.activeTasks(), 0u);
+}
+
+TEST(SchedulerTest, RunUntilStopsOnThePredicate) {
+    int ticks = 0;
+    Scheduler scheduler;
+    scheduler.spawn(countTicks(ticks));
+    scheduler.runUntil([&] { return ticks >= 5; }, 1ms);
+    EXPECT_GE(ticks, 5);
+    EXPECT_EQ(scheduler.activeTasks(), 1u);
+}
+
+TEST(SchedulerTest, DestroysUnfinishedTasks) {
+    bool destroyed = false;
+    {
+        Scheduler scheduler;
+        scheduler.spawn(sleepForever(destroyed));
+        int checks = 0;
+        scheduler.runUntil([&] { return ++checks > 1; }, 1ms); // One step: the task starts and sleeps
+        EXPECT_FALSE(destroyed);
+    }
+    EXPECT_TRUE(destroyed);
+}
+
+TEST(SchedulerTest, SleepUntilIsReadyForPastDeadlines) {
+    EXPECT_TRUE(at(Clock::now() - 1ms).await_ready());
+    EXPECT_FALSE(after(1h).await_ready());
+}
+
+TEST(SchedulerTest, SyncWaitRunsOnAPrivateScheduler) {
+    Clock::duration slept{};
+    Scheduler* seen = nullptr;
+    syncWait(sleepFor(5ms, slept, seen));
+    EXPECT_GE(slept, 5ms);
+    EXPECT_NE(seen, nullptr);
+    EXPECT_EQ(Scheduler::current(), nullptr);
+    EXPECT_THROW(syncWait(throwNow()), std::runtime_error);
+}
+
+} // namespace SensorHub::Coro
@@ -0,0 +1,88 @@
+#include "Coro/scheduler.h"
+#include "Coro/task.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace SensorHub::Coro {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<int> readRegister(int value, bool suspend) {
+    if (suspend) co_await after(1ms);
+    co_return value;
+}
+
+Task<int> sumOfReads() {
+    const int first = co_await readRegister(20, true);
+    const int second = co_await readRegister(22, false);
+    co_return first + second;
+}
+
+Task<std::unique_ptr<std::string>> makeOwned() {
+    co_await after(1ms);
+    co_return std::make_unique<std::string>("moved out");
+}
+
+Task<int> failAfterDelay() {
+    co_await after(1ms);
+    throw std::runtime_error("bus error");
+    co_return 0;
+}
+
+Task<std::string> catchInner() {
+    try {
+        co_await failAfterDelay();
+    } catch (const std::runtime_error& e) {
+        co_return std::string("caught ") + e.what();
+    }
+    co_return "not thrown";
+}
+
+Task<void> setFlag(bool& flag) {
+    flag = true;
+    co_return;
+}
+
+} // namespace
+
+TEST(TaskTest, ReturnsResultsThroughNestedAwaits) {
+    EXPECT_EQ(syncWait(sumOfReads()), 42);
+    EXPECT_EQ(*syncWait(makeOwned()), "moved out");
+}
+
+TEST(TaskTest, RethrowsAtTheAwaitSite) {
+    EXPECT_EQ(syncWait(catchInner()), "caught bus error");
+    EXPECT_THROW(syncWait(failAfterDelay()), std::runtime_error);
+}
+
+TEST(TaskTest, StartsOnlyWhenAwaited) {
+    bool started = false;
+    {
+        Task<void> task = setFlag(started);
+        EXPECT_FALSE(started);
+        EXPECT_FALSE(task.done());
+    } // Destroying an unstarted task never runs it
+    EXPECT_FALSE(started);
+
+    Task<void> task = setFlag(started);
+    syncWait(std::move(task));
+    EXPECT_TRUE(started);
+    EXPECT_TRUE(Task<void>().done());
+}
+
+TEST(TaskTest, BoolResultCanBeTestedAfterASuspendingAwait) {
+    // Await into a local first: GCC 12 miscompiles a suspending co_await inside a condition
+    const auto check = []() -> Task<bool> {
+        const bool ok = co_await readRegister(1, true) == 1;
+        if (!ok) co_return false;
+        co_return true;
+    };
+    EXPECT_TRUE(syncWait(check()));
+}
+
+} // namespace SensorHub::Coro
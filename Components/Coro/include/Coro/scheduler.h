@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Coro/task.h"
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <unordered_set>
+#include <vector>
+
+namespace SensorHub::Coro {
+
+/**
+ * @brief Single-threaded cooperative scheduler for Task coroutines.
+ *
+ * Keeps a FIFO of ready coroutines and a min-heap of timers. All resumption happens on
+ * the thread calling run()/runUntil(), so drivers waiting on conversion delays only
+ * occupy a heap entry instead of a thread.
+ */
+class Scheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Scheduler() = default;
+
+    /**
+     * @brief Destroys any spawned tasks that have not finished yet.
+     */
+    ~Scheduler();
+
+    /**
+     * @brief Takes ownership of a task and starts it on the next run iteration.
+     * Exceptions escaping the task are logged and swallowed.
+     */
+    void spawn(Task<void> task);
+
+    /**
+     * @brief Queues a suspended coroutine to be resumed.
+     */
+    void schedule(std::coroutine_handle<> handle);
+
+    /**
+     * @brief Queues a suspended coroutine to be resumed at (or after) a time point.
+     */
+    void scheduleAt(Clock::time_point when, std::coroutine_handle<> handle);
+
+    /**
+     * @brief Runs until every spawned task has finished.
+     */
+    void run();
+
+    /**
+     * @brief Runs until the predicate returns true. Checked at least every max_sleep.
+     */
+    void runUntil(const std::function<bool()>& stop,
+                  Clock::duration max_sleep = std::chrono::milliseconds(100));
+
+    /**
+     * @brief Number of spawned tasks that have not finished yet.
+     */
+    size_t activeTasks() const { return roots_.size(); }
+
+    /**
+     * @brief The scheduler currently running on this thread, or nullptr.
+     */
+    static Scheduler* current();
+
+    // Delete copy/move operations
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    Scheduler(Scheduler&&) = delete;
+    Scheduler& operator=(Scheduler&&) = delete;
+
+private:
+    struct Timer {
+        Clock::time_point when;
+        uint64_t sequence; // FIFO among equal deadlines
+        std::coroutine_handle<> handle;
+        bool operator>(const Timer& other) const {
+            return when != other.when ? when > other.when : sequence > other.sequence;
+        }
+    };
+
+    friend struct RootPromise;
+    void rootFinished(std::coroutine_handle<> root);
+
+    /**
+     * @brief Resumes everything ready and every expired timer once.
+     * @return The next timer deadline, if any.
+     */
+    std::optional<Clock::time_point> step();
+
+    std::deque<std::coroutine_handle<>> ready_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers_;
+    std::unordered_set<void*> roots_; // Addresses of spawned, unfinished root frames
+    uint64_t timer_sequence_ = 0;
+};
+
+/**
+ * @brief Awaitable that resumes the coroutine at a given time point.
+ * Outside a running scheduler it falls back to blocking until the deadline.
+ */
+struct SleepUntil {
+    Scheduler::Clock::time_point when;
+
+    bool await_ready() const noexcept { return Scheduler::Clock::now() >= when; }
+    bool await_suspend(std::coroutine_handle<> handle) const;
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief co_await at(tp): resume at a steady_clock time point.
+ */
+inline SleepUntil at(Scheduler::Clock::time_point when) { return SleepUntil{when}; }
+
+/**
+ * @brief co_await after(5ms): resume after a delay without blocking the thread.
+ */
+template <typename Rep, typename Period>
+SleepUntil after(std::chrono::duration<Rep, Period> delay) {
+    return SleepUntil{Scheduler::Clock::now() +
+                      std::chrono::duration_cast<Scheduler::Clock::duration>(delay)};
+}
+
+/**
+ * @brief Runs a task to completion on a private scheduler and returns its result.
+ * Lets synchronous callers (constructors, blocking APIs) reuse coroutine code paths.
+ */
+template <typename T>
+T syncWait(Task<T> task) {
+    std::optional<T> result;
+    std::exception_ptr error;
+    {
+        Scheduler scheduler;
+        scheduler.spawn([](Task<T> inner, std::optional<T>& out, std::exception_ptr& err) -> Task<void> {
+            try {
+                out.emplace(co_await std::move(inner));
+            } catch (...) {
+                err = std::current_exception();
+            }
+        }(std::move(task), result, error));
+        scheduler.run();
+    }
+    if (error) std::rethrow_exception(error);
+    return std::move(*result);
+}
+
+/**
+ * @brief syncWait for tasks without a result.
+ */
+void syncWait(Task<void> task);
+
+} // namespace SensorHub::Coro
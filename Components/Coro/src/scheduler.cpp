@@ -0,0 +1,167 @@
+#include "Coro/scheduler.h"
+#include <iostream>
+#include <thread>
+
+namespace SensorHub::Coro {
+
+namespace {
+thread_local Scheduler* tls_current = nullptr;
+
+// Makes a scheduler current on this thread for the duration of a run
+class CurrentGuard {
+public:
+    explicit CurrentGuard(Scheduler* scheduler) : previous_(tls_current) { tls_current = scheduler; }
+    ~CurrentGuard() { tls_current = previous_; }
+    CurrentGuard(const CurrentGuard&) = delete;
+    CurrentGuard& operator=(const CurrentGuard&) = delete;
+private:
+    Scheduler* previous_;
+};
+} // namespace
+
+// --- Root Coroutine (owns a spawned Task and reports completion) ---
+
+struct RootPromise;
+
+struct RootTask {
+    using promise_type = RootPromise;
+    std::coroutine_handle<RootPromise> handle;
+};
+
+struct RootPromise {
+    Scheduler* scheduler = nullptr;
+
+    RootTask get_return_object() noexcept {
+        return RootTask{std::coroutine_handle<RootPromise>::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        void await_suspend(std::coroutine_handle<RootPromise> handle) noexcept {
+            Scheduler* owner = handle.promise().scheduler;
+            owner->rootFinished(handle);
+            handle.destroy();
+        }
+        void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {}
+};
+
+namespace {
+RootTask makeRoot(Task<void> task) {
+    try {
+        co_await std::move(task);
+    } catch (const std::exception& e) {
+        std::cerr << "Coro Scheduler Error: Uncaught exception in spawned task: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Coro Scheduler Error: Unknown exception in spawned task." << std::endl;
+    }
+}
+} // namespace
+
+// --- Scheduler ---
+
+Scheduler::~Scheduler() {
+    // Destroying a root frame destroys the Task it owns and everything that Task awaits
+    for (void* address : roots_) {
+        std::coroutine_handle<>::from_address(address).destroy();
+    }
+    roots_.clear();
+}
+
+Scheduler* Scheduler::current() {
+    return tls_current;
+}
+
+void Scheduler::spawn(Task<void> task) {
+    RootTask root = makeRoot(std::move(task));
+    root.handle.promise().scheduler = this;
+    roots_.insert(root.handle.address());
+    schedule(root.handle);
+}
+
+void Scheduler::schedule(std::coroutine_handle<> handle) {
+    ready_.push_back(handle);
+}
+
+void Scheduler::scheduleAt(Clock::time_point when, std::coroutine_handle<> handle) {
+    timers_.push(Timer{when, timer_sequence_++, handle});
+}
+
+void Scheduler::rootFinished(std::coroutine_handle<> root) {
+    roots_.erase(root.address());
+}
+
+std::optional<Scheduler::Clock::time_point> Scheduler::step() {
+    const auto now = Clock::now();
+    while (!timers_.empty() && timers_.top().when <= now) {
+        ready_.push_back(timers_.top().handle);
+        timers_.pop();
+    }
+    while (!ready_.empty()) {
+        auto handle = ready_.front();
+        ready_.pop_front();
+        handle.resume();
+    }
+    if (timers_.empty()) return std::nullopt;
+    return timers_.top().when;
+}
+
+void Scheduler::run() {
+    CurrentGuard guard(this);
+    while (!roots_.empty()) {
+        auto next_timer = step();
+        if (roots_.empty() || !ready_.empty()) continue;
+        if (!next_timer) {
+            std::cerr << "Coro Scheduler Warning: " << roots_.size()
+                      << " task(s) suspended with nothing left to resume them." << std::endl;
+            break;
+        }
+        std::this_thread::sleep_until(*next_timer);
+    }
+}
+
+void Scheduler::runUntil(const std::function<bool()>& stop, Clock::duration max_sleep) {
+    CurrentGuard guard(this);
+    while (!stop()) {
+        auto next_timer = step();
+        if (!ready_.empty()) continue;
+        auto wake = Clock::now() + max_sleep;
+        if (next_timer && *next_timer < wake) wake = *next_timer;
+        std::this_thread::sleep_until(wake);
+    }
+}
+
+// --- Awaitables / Helpers ---
+
+bool SleepUntil::await_suspend(std::coroutine_handle<> handle) const {
+    if (Scheduler* scheduler = Scheduler::current()) {
+        scheduler->scheduleAt(when, handle);
+        return true;
+    }
+    // No scheduler on this thread: behave like a blocking sleep
+    std::this_thread::sleep_until(when);
+    return false;
+}
+
+void syncWait(Task<void> task) {
+    std::exception_ptr error;
+    {
+        Scheduler scheduler;
+        scheduler.spawn([](Task<void> inner, std::exception_ptr& err) -> Task<void> {
+            try {
+                co_await std::move(inner);
+            } catch (...) {
+                err = std::current_exception();
+            }
+        }(std::move(task), error));
+        scheduler.run();
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace SensorHub::Coro
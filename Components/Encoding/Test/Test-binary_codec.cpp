@@ -0,0 +1,173 @@
+#include "Encoding/binary_codec.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <string>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using json = nlohmann::json;
+using Clock = std::chrono::system_clock;
+
+Clock::time_point at(int64_t millis) {
+    return Clock::time_point(std::chrono::milliseconds(millis));
+}
+
+std::string bytes(std::initializer_list<uint8_t> values) {
+    std::string out;
+    for (const uint8_t value : values) out += static_cast<char>(value);
+    return out;
+}
+
+// FNV-1a over name, type, scale and unit of every field, folded to 16 bits: the id
+// retained schemas are published under, so it must not change between releases
+uint16_t referenceId(const std::vector<WireField>& fields) {
+    uint32_t hash = 2166136261u;
+    const auto mix = [&hash](const void* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<const unsigned char*>(data)[i];
+            hash *= 16777619u;
+        }
+    };
+    for (const auto& field : fields) {
+        mix(field.name.c_str(), field.name.size() + 1);
+        const auto type = static_cast<uint8_t>(field.type);
+        mix(&type, 1);
+        mix(&field.scale, sizeof(field.scale));
+        mix(field.unit.c_str(), field.unit.size() + 1);
+    }
+    const auto id = static_cast<uint16_t>((hash >> 16) ^ (hash & 0xFFFF));
+    return id ? id : 1;
+}
+
+} // namespace
+
+TEST(BinaryCodecTest, WritesTheDocumentedFrameLayout) {
+    const BinaryCodec codec({});
+    BinaryChannel channel = codec.makeChannel("rpisensor/data/dummy", "Linux_RPi", "Dummy", "dummy");
+    std::string frame;
+    EXPECT_TRUE(codec.encode(channel, {{"t_celsius", -1.5}, {"ok", true}, {"count", 5}}, at(1000), frame));
+
+    // Fields sorted by name; integers keep scale 1, doubles get the default 0.01
+    const auto& schema = *channel.schema;
+    ASSERT_EQ(schema.fields.size(), 3u);
+    EXPECT_EQ(schema.fields[0], (WireField{"count", WireField::Type::Quantized, 1.0, ""}));
+    EXPECT_EQ(schema.fields[1], (WireField{"ok", WireField::Type::Boolean, 1.0, ""}));
+    EXPECT_EQ(schema.fields[2], (WireField{"t_celsius", WireField::Type::Quantized, 0.01, "°C"}));
+    EXPECT_EQ(schema.id, referenceId(schema.fields));
+
+    const std::string expected = bytes({BinaryCodec::FRAME_MAGIC, static_cast<uint8_t>(schema.id & 0xFF),
+                                        static_cast<uint8_t>(schema.id >> 8),
+                                        0xE8, 0x07,  // 1000 ms as varint
+                                        0x07,        // Presence mask: all three fields
+                                        0x0A,        // count 5, zigzag 10
+                                        0x01,        // ok
+                                        0xAB, 0x02}); // t_celsius -150 steps, zigzag 299
+    EXPECT_EQ(frame, expected);
+    EXPECT_TRUE(BinaryCodec::isFrame(frame));
+    EXPECT_FALSE(BinaryCodec::isFrame("{\"count\":5}"));
+    EXPECT_FALSE(BinaryCodec::isFrame(""));
+}
+
+TEST(BinaryCodecTest, RoundTripsReadings) {
+    BinaryCodec::Options options;
+    options.scales["pressure_hpa"] = 0.0001;
+    options.units["humidity_percent"] = "%RH";
+    const BinaryCodec codec(std::move(options));
+    BinaryChannel channel = codec.makeChannel("rpisensor/data/bme280", "Linux_RPi", "BME280", "bme280");
+
+    const json reading = {{"temperature_celsius", 21.53}, {"pressure_hpa", 1013.2512}, {"humidity_percent", 45.0},
+                          {"status", "OK \"q\""}, {"heater", false}, {"raw", -123456789}, {"nested", {{"a", 1}}}};
+    std::string frame;
+    codec.encode(channel, reading, at(1760000000123), frame);
+    EXPECT_LT(frame.size(), 40u);
+
+    const auto decoded = BinaryCodec::decode(*channel.schema, frame);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(*decoded, (json{{"temperature_celsius", 21.53}, {"pressure_hpa", 1013.2512}, {"humidity_percent", 45.0},
+                              {"status", "OK \"q\""}, {"heater", false}, {"raw", -123456789},
+                              {"timestamp", "2025-10-09T08:53:20.123Z"}}));
+
+    // The schema document carries units, scales and the channel's metadata
+    std::string message;
+    BinaryCodec::appendSchemaMessage(channel, message);
+    const json document = json::parse(message);
+    EXPECT_EQ(channel.schema_topic, "rpisensor/data/bme280/schema");
+    EXPECT_EQ(document["encoding"], WireSchema::ENCODING_NAME);
+    EXPECT_EQ(document["schema_id"], channel.schema->id);
+    EXPECT_EQ(document["sensor_type"], "BME280");
+    const auto parsed = WireSchema::fromJson(document);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->id, channel.schema->id);
+    EXPECT_EQ(parsed->fields, channel.schema->fields);
+    EXPECT_EQ(parsed->fields[1].name, "humidity_percent");
+    EXPECT_EQ(parsed->fields[1].unit, "%RH");
+}
+
+TEST(BinaryCodecTest, ExtendsTheSchemaOnlyForNewMembers) {
+    const BinaryCodec codec({});
+    BinaryChannel channel = codec.makeChannel("t", "p", "Dummy", "dummy");
+    std::string frame;
+    EXPECT_TRUE(codec.encode(channel, {{"a", 1.0}, {"b", 2.0}}, at(0), frame));
+    channel.schema_published = true;
+    const uint16_t first_id = channel.schema->id;
+
+    // A reading with a member missing keeps the schema and leaves its presence bit clear
+    frame.clear();
+    EXPECT_FALSE(codec.encode(channel, {{"b", 3.0}}, at(0), frame));
+    EXPECT_TRUE(channel.schema_published);
+    EXPECT_EQ(static_cast<uint8_t>(frame[4]), 0x02);
+    EXPECT_EQ(*BinaryCodec::decode(*channel.schema, frame), (json{{"b", 3.0}, {"timestamp", "1970-01-01T00:00:00.000Z"}}));
+
+    // A new member (or a changed type) extends the layout, and the schema has to go out again
+    frame.clear();
+    EXPECT_TRUE(codec.encode(channel, {{"c", true}}, at(0), frame));
+    EXPECT_FALSE(channel.schema_published);
+    EXPECT_NE(channel.schema->id, first_id);
+    EXPECT_EQ(channel.schema->fields.size(), 3u);
+    EXPECT_FALSE(BinaryCodec::decode(WireSchema{first_id, {}}, frame).has_value()); // Old schema no longer matches
+}
+
+TEST(BinaryCodecTest, SchemaIdDependsOnTheWholeLayout) {
+    const std::vector<WireField> fields = {{"pressure_hpa", WireField::Type::Quantized, 0.01, "hPa"},
+                                           {"temperature_celsius", WireField::Type::Quantized, 0.01, "°C"}};
+    EXPECT_EQ(WireSchema::computeId(fields), referenceId(fields));
+    EXPECT_NE(WireSchema::computeId(fields), 0);
+
+    auto changed = fields;
+    changed[0].scale = 0.1;
+    EXPECT_NE(WireSchema::computeId(changed), WireSchema::computeId(fields));
+    changed = fields;
+    changed[1].unit = "K";
+    EXPECT_NE(WireSchema::computeId(changed), WireSchema::computeId(fields));
+    changed = fields;
+    changed[1].type = WireField::Type::String;
+    EXPECT_NE(WireSchema::computeId(changed), WireSchema::computeId(fields));
+}
+
+TEST(BinaryCodecTest, RejectsMalformedInput) {
+    const BinaryCodec codec({});
+    BinaryChannel channel = codec.makeChannel("t", "p", "Dummy", "dummy");
+    std::string frame;
+    codec.encode(channel, {{"name", "abc"}, {"value", 1.5}}, at(5), frame);
+    const WireSchema& schema = *channel.schema;
+    ASSERT_TRUE(BinaryCodec::decode(schema, frame).has_value());
+
+    for (size_t length = 0; length < frame.size(); ++length) {
+        EXPECT_FALSE(BinaryCodec::decode(schema, frame.substr(0, length)).has_value()) << length;
+    }
+    EXPECT_FALSE(BinaryCodec::decode(schema, frame + '\0').has_value());
+    std::string bad_magic = frame;
+    bad_magic[0] = '{';
+    EXPECT_FALSE(BinaryCodec::decode(schema, bad_magic).has_value());
+
+    EXPECT_THROW(codec.encode(channel, json::array(), at(0), frame), std::invalid_argument);
+    EXPECT_THROW(BinaryCodec({0.0, {}, {}}), std::invalid_argument);
+    EXPECT_FALSE(WireSchema::fromJson({{"encoding", "other/1"}, {"schema_id", 1}, {"fields", json::array()}}));
+    EXPECT_FALSE(WireSchema::fromJson({{"encoding", WireSchema::ENCODING_NAME}, {"schema_id", 1},
+                                       {"fields", {{{"name", "x"}, {"type", "z"}}}}}));
+    EXPECT_FALSE(WireSchema::fromJson({{"encoding", WireSchema::ENCODING_NAME}}));
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,137 @@
+#include "Encoding/payload_encoder.h"
+#include "gtest/gtest.h"
+#include <nlohmann/json.hpp>
+#include <bit>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using json = nlohmann::json;
+using Clock = std::chrono::system_clock;
+
+const std::string TOPIC_BASE = "rpisensor/data";
+const std::string PLATFORM = "Linux_RPi";
+
+// The publish step before PayloadEncoder: copy the reading, add the metadata, dump()
+std::string legacyPayload(const json& reading, const std::string& type, const std::string& suffix,
+                          Clock::time_point now, bool static_metadata = true) {
+    const auto itt = Clock::to_time_t(now);
+    std::ostringstream timestamp;
+    timestamp << std::put_time(std::gmtime(&itt), "%FT%TZ");
+
+    json payload = reading;
+    payload["timestamp"] = timestamp.str();
+    if (static_metadata) {
+        payload["platform"] = PLATFORM;
+        payload["sensor_type"] = type;
+    }
+    payload["topic_suffix"] = suffix;
+    return payload.dump();
+}
+
+std::string encoded(const json& reading, const std::string& type, const std::string& suffix, Clock::time_point now,
+                    bool static_metadata = true) {
+    PayloadEncoder::Options options;
+    options.topic_base = TOPIC_BASE;
+    options.platform = PLATFORM;
+    options.static_metadata = static_metadata;
+    const PayloadEncoder encoder(std::move(options));
+    std::string out;
+    encoder.encode(encoder.makeChannel(type, suffix), reading, now, out);
+    return out;
+}
+
+std::string appended(const json& value) {
+    std::string out;
+    PayloadEncoder::appendJson(value, out);
+    return out;
+}
+
+} // namespace
+
+// PayloadEncoder formats doubles with nlohmann::detail::to_chars, the library's internal
+// dtoa. These tests keep it byte-identical to dump() across json version bumps.
+
+TEST(PayloadEncoderTest, MatchesLegacyDumpForSensorReadings) {
+    const auto now = Clock::time_point(std::chrono::seconds(1760000000));
+    const std::vector<std::tuple<std::string, std::string, json>> cases = {
+        {"BME280", "bme280",
+         json{{"temperature_celsius", 21.53}, {"pressure_hpa", 1013.2512}, {"humidity_percent", 45.000000001}}},
+        {"LPS25HB", "lps25hb_pressure", json{{"pressure_hpa", 1009.5}, {"temperature_celsius", -3.25e-5}}},
+        {"Dummy", "dummy_test", json{{"counter", 42}, {"random_value", 38.3}, {"status", "OK\t\"q\""}}},
+    };
+    for (const auto& [type, suffix, reading] : cases) {
+        EXPECT_EQ(encoded(reading, type, suffix, now), legacyPayload(reading, type, suffix, now)) << type;
+        EXPECT_EQ(encoded(reading, type, suffix, now, false), legacyPayload(reading, type, suffix, now, false))
+            << type;
+    }
+    const PayloadEncoder encoder({TOPIC_BASE, PLATFORM});
+    EXPECT_EQ(encoder.makeChannel("BME280", "bme280").topic, "rpisensor/data/bme280");
+}
+
+TEST(PayloadEncoderTest, MergesReadingKeysAroundMetadataInKeyOrder) {
+    const auto now = Clock::time_point(std::chrono::seconds(0));
+    // Keys before, between and after the metadata keys, and two that collide with them
+    const json reading = {{"a_first", 1},        {"pressure", 2},    {"platform", "sensor's own"},
+                          {"status", "ok"},      {"timestamp", 5},   {"topic_suffix_extra", true},
+                          {"zz_last", nullptr},  {"nested", {{"b", {1, 2.5, "x"}}, {"a", json::object()}}}};
+    const std::string out = encoded(reading, "Dummy", "dummy", now);
+    EXPECT_EQ(out, legacyPayload(reading, "Dummy", "dummy", now));
+    EXPECT_EQ(out, "{\"a_first\":1,\"nested\":{\"a\":{},\"b\":[1,2.5,\"x\"]},\"platform\":\"Linux_RPi\","
+                   "\"pressure\":2,\"sensor_type\":\"Dummy\",\"status\":\"ok\",\"timestamp\":\"1970-01-01T00:00:00Z\","
+                   "\"topic_suffix\":\"dummy\",\"topic_suffix_extra\":true,\"zz_last\":null}");
+    EXPECT_THROW(encoded(json::array({1}), "Dummy", "dummy", now), std::invalid_argument);
+}
+
+TEST(PayloadEncoderTest, FormatsDoublesLikeDump) {
+    const double special[] = {0.0, -0.0, 1.0, -1.0, 0.1, 1.5, 100.0, 1e15, 1e16, 1e17, 123456789012345680.0,
+                              1e-4, 1e-5, 1.5e-7, 1e21, 1e22, 1e300, 5e-324, 2.2250738585072014e-308,
+                              std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                              std::numeric_limits<double>::epsilon(), 0.30000000000000004, 1013.25, -40.0};
+    for (const double value : special) {
+        EXPECT_EQ(appended(json(value)), json(value).dump()) << value;
+    }
+
+    // Random bit patterns cover every exponent; random "sensor-like" values cover short decimals
+    std::mt19937_64 rng(1234);
+    std::uniform_real_distribution<double> sensor(-100.0, 1200.0);
+    for (int i = 0; i < 100000; ++i) {
+        const double bits = std::bit_cast<double>(rng());
+        if (std::isfinite(bits)) {
+            ASSERT_EQ(appended(json(bits)), json(bits).dump());
+        }
+        const double reading = std::round(sensor(rng) * 100.0) / 100.0;
+        ASSERT_EQ(appended(json(reading)), json(reading).dump());
+    }
+}
+
+TEST(PayloadEncoderTest, WritesNonFiniteNumbersAsNull) {
+    for (const double value : {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+                               -std::numeric_limits<double>::infinity()}) {
+        EXPECT_EQ(appended(json(value)), "null");
+        EXPECT_EQ(appended(json(value)), json(value).dump());
+    }
+}
+
+TEST(PayloadEncoderTest, FormatsOtherValuesLikeDump) {
+    const json values[] = {json(std::numeric_limits<int64_t>::min()), json(std::numeric_limits<uint64_t>::max()),
+                           json(0), json(false), json(nullptr), json("ctrl\x01\x1f\b\f\n\r\\/"),
+                           json("temp\xC2\xB0" "C"), json::array(), json::array({json::object(), json::array()})};
+    for (const auto& value : values) {
+        EXPECT_EQ(appended(value), value.dump()) << value.dump();
+    }
+    // Invalid UTF-8 is rejected the same way dump() rejects it
+    EXPECT_THROW(appended(json("\xFF")), json::type_error);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,273 @@
+#include "Encoding/bit_stream.h"
+#include "Encoding/payload_encoder.h"
+#include "Encoding/time_series_codec.h"
+#include "gtest/gtest.h"
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+using json = nlohmann::json;
+
+Clock::time_point at(int64_t millis) {
+    return Clock::time_point(std::chrono::milliseconds(millis));
+}
+
+TimeSeriesBlock roundTrip(TimeSeriesEncoder& encoder) {
+    const size_t expected_size = encoder.size();
+    std::string out;
+    encoder.finish(out);
+    EXPECT_EQ(out.size(), expected_size);
+    auto block = TimeSeriesDecoder::decode(out);
+    EXPECT_TRUE(block.has_value());
+    return block.value_or(TimeSeriesBlock{});
+}
+
+uint64_t bitsOf(double value) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Slow-moving indoor climate, sampled every 10 s with a few ms of jitter
+std::vector<std::pair<int64_t, json>> bme280Series(size_t rows) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> noise(0.0, 0.004);
+    std::uniform_int_distribution<int> jitter(-3, 3);
+    std::vector<std::pair<int64_t, json>> series;
+    for (size_t i = 0; i < rows; ++i) {
+        const double t = static_cast<double>(i);
+        series.emplace_back(1'760'000'000'000 + static_cast<int64_t>(i) * 10'000 + jitter(rng),
+                            json{{"temperature_celsius", std::round((21.5 + 0.002 * t + noise(rng)) * 100) / 100},
+                                 {"pressure_hpa", std::round((1013.25 - 0.001 * t + noise(rng)) * 1000) / 1000},
+                                 {"humidity_percent", std::round((45.0 + noise(rng) * 10) * 100) / 100}});
+    }
+    return series;
+}
+
+} // namespace
+
+TEST(BitStreamTest, RoundTripsFieldsOfEveryWidth) {
+    BitWriter writer;
+    for (unsigned bits = 0; bits <= 64; ++bits) writer.write(~uint64_t{0} - bits, bits);
+    writer.writeBit(true);
+
+    BitReader reader(writer.bytes());
+    for (unsigned bits = 0; bits <= 64; ++bits) {
+        uint64_t value = 0;
+        ASSERT_TRUE(reader.read(bits, value));
+        const uint64_t mask = bits == 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+        EXPECT_EQ(value, (~uint64_t{0} - bits) & mask) << "width " << bits;
+    }
+    bool bit = false;
+    ASSERT_TRUE(reader.readBit(bit));
+    EXPECT_TRUE(bit);
+    EXPECT_LT(reader.bitsLeft(), 8u);
+    uint64_t value = 0;
+    EXPECT_FALSE(reader.read(8, value));
+}
+
+TEST(BitStreamTest, AppendsUnalignedStreams) {
+    BitWriter head, tail;
+    head.write(0b101, 3);
+    tail.write(0xABCD, 16);
+    tail.write(0b11, 2);
+    head.append(tail);
+    EXPECT_EQ(head.bitCount(), 21u);
+
+    BitReader reader(head.bytes());
+    uint64_t a = 0, b = 0, c = 0;
+    ASSERT_TRUE(reader.read(3, a) && reader.read(16, b) && reader.read(2, c));
+    EXPECT_EQ(a, 0b101u);
+    EXPECT_EQ(b, 0xABCDu);
+    EXPECT_EQ(c, 0b11u);
+}
+
+TEST(TimeSeriesCodecTest, SteadyIntervalCostsOneBitPerTimestamp) {
+    TimeSeriesEncoder encoder({});
+    for (int64_t i = 0; i < 1000; ++i) encoder.append(json{{"v", true}}, at(1'760'000'000'000 + i * 2000));
+    // 64 bits + first delta (68 bits) + 998 one-bit deltas-of-delta, plus one bit per boolean
+    EXPECT_LE(encoder.size(), 12 + (64 + 68 + 998 + 1000 + 7) / 8);
+
+    const auto block = roundTrip(encoder);
+    ASSERT_EQ(block.timestamps_ms.size(), 1000u);
+    for (int64_t i = 0; i < 1000; ++i) EXPECT_EQ(block.timestamps_ms[i], 1'760'000'000'000 + i * 2000);
+}
+
+TEST(TimeSeriesCodecTest, IrregularAndExtremeTimestampsRoundTrip) {
+    const std::vector<int64_t> timestamps = {
+        0, 1, 1, 3, 1000, 999, 5'000'000'000, -42, std::numeric_limits<int64_t>::max() / 1'000'000,
+        std::numeric_limits<int64_t>::min() / 1'000'000, 7, 7 + 63, 7 + 63 + 63 + 64, 7 + 63 + 63 + 64 + 300};
+    TimeSeriesEncoder encoder({});
+    for (const auto t : timestamps) encoder.append(json{{"v", 1}}, at(t));
+
+    const auto block = roundTrip(encoder);
+    EXPECT_EQ(block.timestamps_ms, timestamps);
+}
+
+TEST(TimeSeriesCodecTest, XorFloatsAreBitExact) {
+    std::vector<double> values = {21.53, 21.53, 21.54, -0.0, 0.0, std::numeric_limits<double>::infinity(),
+                                  -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::denorm_min(),
+                                  std::numeric_limits<double>::max(), std::numeric_limits<double>::quiet_NaN(),
+                                  1e-300, 1013.2512};
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> drift(-0.05, 0.05);
+    double walk = 1000.0;
+    for (int i = 0; i < 500; ++i) values.push_back(walk += drift(rng));
+    for (int i = 0; i < 100; ++i) values.push_back(std::bit_cast<double>(rng() & 0x7FEF'FFFF'FFFF'FFFFull));
+
+    TimeSeriesEncoder encoder({});
+    for (size_t i = 0; i < values.size(); ++i) encoder.append(json{{"x", values[i]}}, at(static_cast<int64_t>(i)));
+
+    const auto block = roundTrip(encoder);
+    ASSERT_EQ(block.columns.size(), 1u);
+    EXPECT_EQ(block.columns[0].kind, TimeSeriesColumn::Kind::Float);
+    ASSERT_EQ(block.columns[0].values.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(bitsOf(block.columns[0].values[i].get<double>()), bitsOf(values[i])) << "row " << i;
+    }
+}
+
+TEST(TimeSeriesCodecTest, FixedPointStaysWithinHalfAStep) {
+    TimeSeriesEncoder::Options options;
+    options.values = TimeSeriesEncoder::ValueEncoding::Fixed;
+    options.default_scale = 0.01;
+    options.scales = {{"pressure_hpa", 0.001}};
+    TimeSeriesEncoder encoder(options);
+
+    const auto series = bme280Series(300);
+    for (const auto& [t, reading] : series) encoder.append(reading, at(t));
+
+    const auto block = roundTrip(encoder);
+    ASSERT_EQ(block.columns.size(), 3u);
+    for (const auto& column : block.columns) {
+        EXPECT_EQ(column.kind, TimeSeriesColumn::Kind::Fixed);
+        for (size_t row = 0; row < series.size(); ++row) {
+            EXPECT_NEAR(column.values[row].get<double>(), series[row].second.at(column.name).get<double>(),
+                        column.scale / 2 + 1e-9);
+        }
+    }
+    // Values already on the grid come back exactly (no 2153 * 0.01 artefacts)
+    EXPECT_EQ(block.columns[2].name, "temperature_celsius");
+    EXPECT_EQ(block.columns[2].values[0].dump(), series[0].second.at("temperature_celsius").dump());
+}
+
+TEST(TimeSeriesCodecTest, IntegersBooleansAndStringsRoundTrip) {
+    const std::vector<json> rows = {
+        {{"counter", 0}, {"ok", true}, {"status", "OK"}},
+        {{"counter", 1}, {"ok", true}, {"status", "OK"}},
+        {{"counter", std::numeric_limits<int64_t>::max()}, {"ok", false}, {"status", ""}},
+        {{"counter", std::numeric_limits<int64_t>::min()}, {"ok", false}, {"status", "tab\t\"quoted\" ünïcode"}},
+        {{"counter", -5}, {"ok", true}, {"status", std::string(5000, 'x')}},
+    };
+    TimeSeriesEncoder encoder({});
+    for (size_t i = 0; i < rows.size(); ++i) encoder.append(rows[i], at(static_cast<int64_t>(i) * 1000));
+
+    const auto block = roundTrip(encoder);
+    const auto readings = block.readings();
+    ASSERT_EQ(readings.size(), rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        json expected = rows[i];
+        expected["timestamp"] = readings[i].at("timestamp");
+        EXPECT_EQ(readings[i], expected) << "row " << i;
+    }
+    EXPECT_EQ(readings[1].at("timestamp"), "1970-01-01T00:00:01.000Z");
+}
+
+TEST(TimeSeriesCodecTest, MetadataAndReadingsMatchJsonPayloadShape) {
+    TimeSeriesEncoder encoder({}, json{{"platform", "Linux_RPi"}, {"sensor_type", "BME280"},
+                                       {"topic_suffix", "bme280"}, {"ignored", 3}});
+    encoder.append(json{{"temperature_celsius", 21.53}, {"nested", {{"a", 1}}}, {"missing", nullptr}},
+                   at(1'760'000'000'123));
+
+    const auto block = roundTrip(encoder);
+    EXPECT_EQ(block.metadata, (json{{"platform", "Linux_RPi"}, {"sensor_type", "BME280"}, {"topic_suffix", "bme280"}}));
+    EXPECT_EQ(block.readings(), json::array({{{"platform", "Linux_RPi"}, {"sensor_type", "BME280"},
+                                              {"topic_suffix", "bme280"}, {"temperature_celsius", 21.53},
+                                              {"timestamp", "2025-10-09T08:53:20.123Z"}}}));
+}
+
+TEST(TimeSeriesCodecTest, BlockHoldsOneFieldLayout) {
+    TimeSeriesEncoder encoder({});
+    EXPECT_FALSE(encoder.accepts(json::array()));
+    EXPECT_TRUE(encoder.accepts(json{{"a", 1.5}}));
+    encoder.append(json{{"a", 1.5}, {"b", "x"}}, at(0));
+
+    EXPECT_TRUE(encoder.accepts(json{{"a", 2.5}, {"b", "y"}}));
+    EXPECT_TRUE(encoder.accepts(json{{"a", 2.5}, {"b", "y"}, {"ignored", nullptr}}));
+    EXPECT_FALSE(encoder.accepts(json{{"a", 2.5}}));                          // Field missing
+    EXPECT_FALSE(encoder.accepts(json{{"a", 2.5}, {"b", "y"}, {"c", true}})); // Field added
+    EXPECT_FALSE(encoder.accepts(json{{"a", 2}, {"b", "y"}}));                // Kind changed
+    EXPECT_THROW(encoder.append(json{{"a", 2}}, at(1)), std::invalid_argument);
+
+    // finish() starts over with a fresh layout
+    std::string first;
+    encoder.finish(first);
+    EXPECT_EQ(encoder.rows(), 0u);
+    EXPECT_EQ(encoder.size(), 0u);
+    encoder.append(json{{"c", true}}, at(5));
+    const auto block = roundTrip(encoder);
+    ASSERT_EQ(block.columns.size(), 1u);
+    EXPECT_EQ(block.columns[0].name, "c");
+    EXPECT_EQ(block.timestamps_ms, std::vector<int64_t>{5});
+}
+
+TEST(TimeSeriesCodecTest, RejectsTruncatedAndCorruptBlocks) {
+    TimeSeriesEncoder encoder({}, json{{"sensor_type", "Dummy"}});
+    std::mt19937_64 rng(3);
+    for (int i = 0; i < 20; ++i) {
+        encoder.append(json{{"counter", i}, {"random_value", static_cast<double>(rng() % 1000) / 7}, {"status", "OK"}},
+                       at(i * 1000));
+    }
+    std::string block;
+    encoder.finish(block);
+    ASSERT_TRUE(TimeSeriesDecoder::decode(block));
+
+    EXPECT_FALSE(TimeSeriesDecoder::decode(""));
+    EXPECT_FALSE(TimeSeriesDecoder::decode("{\"a\":1}"));
+    for (size_t length = 0; length < block.size(); ++length) {
+        EXPECT_FALSE(TimeSeriesDecoder::decode(std::string_view(block).substr(0, length))) << "length " << length;
+    }
+    EXPECT_FALSE(TimeSeriesDecoder::decode(block + std::string(1, '\0')));
+
+    // Flipped bits must never crash the decoder (they may still decode to other values)
+    for (size_t i = 0; i < block.size() * 8; ++i) {
+        std::string corrupt = block;
+        corrupt[i / 8] = static_cast<char>(corrupt[i / 8] ^ (1 << (i % 8)));
+        (void)TimeSeriesDecoder::decode(corrupt);
+    }
+}
+
+TEST(TimeSeriesCodecTest, SlowMovingSensorsCompressTenfoldAgainstJson) {
+    const auto series = bme280Series(60);
+    PayloadEncoder json_encoder({"rpisensor/data", "Linux_RPi", TimestampFormatter::Precision::Seconds});
+    auto channel = json_encoder.makeChannel("BME280", "bme280");
+    size_t json_bytes = 0;
+    for (const auto& [t, reading] : series) {
+        std::string payload;
+        json_encoder.encode(channel, reading, at(t), payload);
+        json_bytes += payload.size();
+    }
+
+    const json metadata = {{"platform", "Linux_RPi"}, {"sensor_type", "BME280"}, {"topic_suffix", "bme280"}};
+    TimeSeriesEncoder::Options fixed;
+    fixed.values = TimeSeriesEncoder::ValueEncoding::Fixed;
+    fixed.scales = {{"pressure_hpa", 0.001}};
+    TimeSeriesEncoder fixed_encoder(fixed, metadata);
+    TimeSeriesEncoder xor_encoder({}, metadata);
+    for (const auto& [t, reading] : series) {
+        fixed_encoder.append(reading, at(t));
+        xor_encoder.append(reading, at(t));
+    }
+
+    EXPECT_GE(json_bytes, 10 * fixed_encoder.size()) << json_bytes << " vs " << fixed_encoder.size();
+    EXPECT_LT(xor_encoder.size(), json_bytes / 2);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief One member of a sensor's binary schema.
+ */
+struct WireField {
+    enum class Type : uint8_t {
+        Quantized, // Number sent as round(value / scale), zigzag varint
+        Boolean,   // One byte
+        String     // Varint length + UTF-8 bytes
+    };
+
+    std::string name;
+    Type type = Type::Quantized;
+    double scale = 1.0;
+    std::string unit;
+
+    bool operator==(const WireField&) const = default;
+};
+
+/**
+ * @brief Field layout that binary frames of one sensor refer to by id.
+ *
+ * Published once (retained) as JSON on "<sensor topic>/schema"; the id is a hash of the
+ * layout, so it stays the same across restarts for an unchanged sensor.
+ */
+struct WireSchema {
+    static constexpr const char* ENCODING_NAME = "sensorhub-binary/1";
+
+    uint16_t id = 0;
+    std::vector<WireField> fields; // Sorted by name; frames use this order
+
+    /**
+     * @brief Schema document ("encoding", "schema_id", "fields").
+     */
+    nlohmann::json toJson() const;
+
+    /**
+     * @brief Parses a schema document.
+     * @return The schema, or std::nullopt if it is malformed or of another encoding.
+     */
+    static std::optional<WireSchema> fromJson(const nlohmann::json& document);
+
+    /**
+     * @brief Computes the layout hash used as id.
+     */
+    static uint16_t computeId(const std::vector<WireField>& fields);
+};
+
+/**
+ * @brief Per-sensor state of the binary encoding. Accessed by one sample at a time.
+ */
+struct BinaryChannel {
+    std::string schema_topic;
+    nlohmann::json metadata = nlohmann::json::object(); // Static members sent with the schema
+    std::shared_ptr<const WireSchema> schema;
+    bool schema_published = false; // Set once the current schema reached the broker
+};
+
+/**
+ * @brief Compact positional encoding of sensor readings.
+ *
+ * Frame layout (integers little-endian):
+ *   u8 magic 0xB1 | u16 schema id | varint unix time in ms | presence bitmask
+ *   (one bit per schema field, LSB first) | values of present fields in schema order.
+ * A BME280 reading shrinks from about 200 bytes of JSON to under 20 bytes.
+ */
+class BinaryCodec {
+public:
+    static constexpr uint8_t FRAME_MAGIC = 0xB1;
+
+    struct Options {
+        double default_scale = 0.01;              // Quantisation step for floating-point fields
+        std::map<std::string, double> scales;     // Per-field overrides
+        std::map<std::string, std::string> units; // Per-field overrides of the inferred unit
+    };
+
+    explicit BinaryCodec(Options options);
+
+    /**
+     * @brief Prepares a sensor's channel (schema topic and static metadata).
+     */
+    BinaryChannel makeChannel(const std::string& sensor_topic, const std::string& platform,
+                              const std::string& sensor_type, const std::string& topic_suffix) const;
+
+    /**
+     * @brief Appends a frame for one reading, extending the channel's schema first if the
+     * reading has members the current schema cannot carry.
+     * @return True if the schema changed and has to be (re)published.
+     * @throws std::invalid_argument if reading is not a JSON object.
+     */
+    bool encode(BinaryChannel& channel, const nlohmann::json& reading,
+                std::chrono::system_clock::time_point timestamp, std::string& out) const;
+
+    /**
+     * @brief Appends the retained schema message for a channel.
+     */
+    static void appendSchemaMessage(const BinaryChannel& channel, std::string& out);
+
+    /**
+     * @brief Turns a frame back into a reading with a "timestamp" member.
+     * @return The reading, or std::nullopt if the frame is malformed or uses another schema.
+     */
+    static std::optional<nlohmann::json> decode(const WireSchema& schema, std::string_view frame);
+
+    /**
+     * @brief True if the payload starts like a binary frame (JSON payloads start with '{').
+     */
+    static bool isFrame(std::string_view payload) {
+        return !payload.empty() && static_cast<uint8_t>(payload.front()) == FRAME_MAGIC;
+    }
+
+private:
+    std::optional<WireField> fieldFor(const std::string& name, const nlohmann::json& value) const;
+    std::shared_ptr<const WireSchema> extend(const WireSchema* current, const nlohmann::json& reading) const;
+
+    Options options_;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Appends bit fields to a byte buffer, most significant bit first.
+ *
+ * The final byte is padded with zero bits; bitCount() tells how many are meaningful.
+ */
+class BitWriter {
+public:
+    /**
+     * @brief Appends the low bits of value.
+     * @param value Bits to write; anything above the low `bits` bits is ignored.
+     * @param bits Field width, 0 to 64.
+     */
+    void write(uint64_t value, unsigned bits);
+
+    void writeBit(bool bit) { write(bit ? 1 : 0, 1); }
+
+    /**
+     * @brief Appends every meaningful bit of another writer.
+     */
+    void append(const BitWriter& other);
+
+    size_t bitCount() const { return bit_count_; }
+    const std::string& bytes() const { return bytes_; }
+
+    void clear();
+
+private:
+    std::string bytes_;
+    size_t bit_count_ = 0;
+};
+
+/**
+ * @brief Reads bit fields written by BitWriter. Does not own the bytes.
+ */
+class BitReader {
+public:
+    explicit BitReader(std::string_view bytes) : bytes_(bytes) {}
+
+    /**
+     * @brief Reads a field of `bits` bits (0 to 64).
+     * @return False if fewer bits are left; value is unspecified then.
+     */
+    bool read(unsigned bits, uint64_t& value);
+
+    bool readBit(bool& bit);
+
+    size_t bitsLeft() const { return bytes_.size() * 8 - bit_pos_; }
+
+private:
+    std::string_view bytes_;
+    size_t bit_pos_ = 0;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Encoding/timestamp_formatter.h"
+#include <chrono>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Everything about a sensor's publications that does not change per sample:
+ * the full topic and the pre-rendered metadata fields.
+ */
+struct SensorChannel {
+    /**
+     * @brief One metadata member of the payload object.
+     */
+    struct Field {
+        std::string key;          // Raw key, used for ordering against sensor keys
+        std::string rendered;     // "\"key\":value" ready to append; empty for the timestamp
+        bool is_timestamp = false;
+    };
+
+    std::string topic;
+    std::vector<Field> fields; // Sorted by key
+};
+
+/**
+ * @brief Writes sensor payloads directly into a caller-provided buffer.
+ *
+ * Produces exactly the bytes of the previous path (copy the reading, add "timestamp",
+ * "platform", "sensor_type" and "topic_suffix", then json::dump()): members in key order,
+ * no whitespace, and numbers and strings formatted the way nlohmann::json does. The
+ * reading is not copied, the metadata is rendered once per sensor and the timestamp
+ * comes from a per-thread TimestampFormatter.
+ */
+class PayloadEncoder {
+public:
+    struct Options {
+        std::string topic_base;
+        std::string platform;
+        TimestampFormatter::Precision timestamp_precision = TimestampFormatter::Precision::Seconds;
+        bool static_metadata = true; // false: leave "platform" and "sensor_type" to a retained metadata message
+    };
+
+    explicit PayloadEncoder(Options options);
+
+    /**
+     * @brief Precomputes the topic and metadata fields for a sensor.
+     */
+    SensorChannel makeChannel(const std::string& sensor_type, const std::string& topic_suffix) const;
+
+    /**
+     * @brief Appends the payload for one reading to out. Thread-safe.
+     * @param channel The sensor's precomputed channel.
+     * @param reading The sensor's JSON object (metadata keys in it are overridden).
+     * @param timestamp Wall-clock time to stamp the payload with.
+     * @param out Destination buffer (appended to).
+     * @throws std::invalid_argument if reading is not a JSON object.
+     */
+    void encode(const SensorChannel& channel, const nlohmann::json& reading,
+                std::chrono::system_clock::time_point timestamp, std::string& out) const;
+
+    /**
+     * @brief Appends value exactly as value.dump() would.
+     */
+    static void appendJson(const nlohmann::json& value, std::string& out);
+
+    /**
+     * @brief Appends a quoted, escaped JSON string exactly as dump() would.
+     */
+    static void appendString(std::string_view value, std::string& out);
+
+private:
+    Options options_;
+};
+
+} // namespace SensorHub::Components
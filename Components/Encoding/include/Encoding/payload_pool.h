@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+namespace detail {
+struct PayloadPoolState;
+
+/**
+ * @brief Pooled payload storage with an intrusive reference count.
+ */
+struct PayloadBlock {
+    std::string data;
+    std::atomic<uint32_t> refs{0};
+    std::shared_ptr<PayloadPoolState> pool; // Set while the block is handed out
+};
+} // namespace detail
+
+/**
+ * @brief Shared, reference-counted handle to an encoded payload.
+ *
+ * Copies share one buffer (one atomic increment, no allocation), so a payload can be
+ * captured by several pipeline stages or sinks without copying bytes. When the last
+ * handle goes away the buffer returns to its PayloadPool with its capacity intact.
+ */
+class Payload {
+public:
+    Payload() = default;
+    Payload(const Payload& other) noexcept;
+    Payload& operator=(const Payload& other) noexcept;
+    Payload(Payload&& other) noexcept;
+    Payload& operator=(Payload&& other) noexcept;
+    ~Payload();
+
+    /**
+     * @brief The payload bytes (empty for a default-constructed handle).
+     */
+    const std::string& str() const;
+    std::string_view view() const { return str(); }
+    size_t size() const { return str().size(); }
+
+    /**
+     * @brief Writable buffer. Only valid while this is the sole handle (i.e. while encoding).
+     */
+    std::string& buffer();
+
+    explicit operator bool() const { return block_ != nullptr; }
+
+    /**
+     * @brief Number of handles sharing the buffer (0 for an empty handle).
+     */
+    uint32_t useCount() const;
+
+private:
+    friend class PayloadPool;
+    explicit Payload(detail::PayloadBlock* block) : block_(block) {}
+    void release();
+
+    detail::PayloadBlock* block_ = nullptr;
+};
+
+/**
+ * @brief Free list of reusable payload buffers.
+ *
+ * acquire() returns a cleared buffer that keeps the capacity of earlier payloads, so in
+ * steady state encoding does not allocate. Payloads may outlive the pool; their buffers
+ * are then freed instead of recycled. Thread-safe.
+ */
+class PayloadPool {
+public:
+    /**
+     * @param max_free Maximum number of idle buffers kept for reuse.
+     * @param max_capacity Buffers that grew beyond this are freed instead of recycled.
+     */
+    explicit PayloadPool(size_t max_free = 64, size_t max_capacity = 64 * 1024);
+    ~PayloadPool();
+
+    /**
+     * @brief Returns an empty, uniquely owned payload.
+     */
+    Payload acquire();
+
+    /**
+     * @brief Number of idle buffers currently pooled.
+     */
+    size_t freeCount() const;
+
+    // Delete copy/move operations
+    PayloadPool(const PayloadPool&) = delete;
+    PayloadPool& operator=(const PayloadPool&) = delete;
+    PayloadPool(PayloadPool&&) = delete;
+    PayloadPool& operator=(PayloadPool&&) = delete;
+
+private:
+    std::shared_ptr<detail::PayloadPoolState> state_;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "Encoding/bit_stream.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief One field of a time-series block, with a value per row.
+ */
+struct TimeSeriesColumn {
+    enum class Kind : uint8_t {
+        Float,   // IEEE double, XOR with the previous value
+        Fixed,   // round(value / scale), delta with the previous value
+        Integer, // Delta with the previous value
+        Boolean, // One bit per row
+        String   // One bit per row while unchanged, else length and bytes
+    };
+
+    std::string name;
+    Kind kind = Kind::Float;
+    double scale = 1.0;                 // Quantisation step (Fixed only)
+    std::vector<nlohmann::json> values; // One per row
+};
+
+/**
+ * @brief Decoded time-series block: readings of one sensor stored column by column.
+ */
+struct TimeSeriesBlock {
+    nlohmann::json metadata = nlohmann::json::object(); // Static members (platform, sensor_type, ...)
+    std::vector<int64_t> timestamps_ms;                  // Unix time in ms, one per row
+    std::vector<TimeSeriesColumn> columns;               // Sorted by name
+
+    /**
+     * @brief The rows in the shape of JSON payloads: metadata, fields and an ISO 8601 "timestamp".
+     */
+    nlohmann::json readings() const;
+};
+
+/**
+ * @brief Columnar encoder for runs of readings from one sensor, after Facebook's Gorilla.
+ *
+ * Timestamps are stored as delta-of-delta, so a steady publish interval costs one bit per
+ * row. Floating-point fields are either XOR-ed with the previous value (lossless) or
+ * quantised and delta-encoded (Fixed); integers are delta-encoded. Deltas and
+ * deltas-of-delta use the control codes '0' (zero), '10' + 7 bits, '110' + 9 bits,
+ * '1110' + 12 bits and '1111' + 64 bits (zigzag).
+ *
+ * Block layout:
+ *   u8 magic 0xB3 | varint rows | varint metadata count, (varint length, key, varint length,
+ *   value) per entry | varint column count, (varint length, name, u8 kind[, f64 LE scale])
+ *   per column | bit stream: timestamps, then each column in order, zero-padded to a byte.
+ *
+ * A block holds readings with identical fields; accepts() tells when a reading needs a
+ * new block. Slow-moving BME280 readings take about 4 bytes per row in fixed point
+ * (about 17 bytes with XOR) against about 180 bytes of JSON.
+ */
+class TimeSeriesEncoder {
+public:
+    static constexpr uint8_t BLOCK_MAGIC = 0xB3;
+
+    enum class ValueEncoding {
+        Xor,  // Floating-point fields bit-exact
+        Fixed // Floating-point fields quantised (smaller for slow-moving values)
+    };
+
+    struct Options {
+        ValueEncoding values = ValueEncoding::Xor;
+        double default_scale = 0.01;          // Fixed: quantisation step for floating-point fields
+        std::map<std::string, double> scales; // Per-field steps (also quantise integers and under Xor)
+    };
+
+    /**
+     * @param options Column encodings.
+     * @param metadata String members stored once per block (other members are ignored).
+     */
+    explicit TimeSeriesEncoder(Options options, nlohmann::json metadata = nlohmann::json::object());
+
+    /**
+     * @brief True if the open block is empty or has exactly this reading's fields and kinds.
+     */
+    bool accepts(const nlohmann::json& reading) const;
+
+    /**
+     * @brief Adds a row. Numbers, booleans and strings are stored; other members are ignored.
+     * @throws std::invalid_argument if reading is not a JSON object or !accepts(reading).
+     */
+    void append(const nlohmann::json& reading, std::chrono::system_clock::time_point timestamp);
+
+    size_t rows() const { return rows_; }
+
+    /**
+     * @brief Size of the block if it were finished now, in bytes.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Appends the block to out and starts a new, empty one.
+     */
+    void finish(std::string& out);
+
+    /**
+     * @brief True if the payload starts like a time-series block.
+     */
+    static bool isBlock(std::string_view payload) {
+        return !payload.empty() && static_cast<uint8_t>(payload.front()) == BLOCK_MAGIC;
+    }
+
+private:
+    struct Column {
+        std::string name;
+        TimeSeriesColumn::Kind kind = TimeSeriesColumn::Kind::Float;
+        double scale = 1.0;
+        BitWriter bits;
+        uint64_t previous_bits = 0;  // Float: last value
+        unsigned window_leading = 0; // Float: last XOR window, reused while the next one fits
+        unsigned window_length = 0;  // 0 = no window yet
+        int64_t previous_value = 0;  // Fixed/Integer
+        std::string previous_string;
+    };
+
+    std::optional<TimeSeriesColumn::Kind> kindFor(const std::string& name, const nlohmann::json& value,
+                                                  double& scale) const;
+    void startColumns(const nlohmann::json& reading);
+    void appendValue(Column& column, const nlohmann::json& value);
+
+    Options options_;
+    std::string metadata_header_; // Encoded metadata section
+    std::string column_header_;   // Encoded column section of the open block
+    std::vector<Column> columns_;
+    BitWriter timestamps_;
+    int64_t previous_timestamp_ = 0;
+    int64_t previous_delta_ = 0;
+    size_t rows_ = 0;
+};
+
+/**
+ * @brief Reads blocks written by TimeSeriesEncoder.
+ */
+class TimeSeriesDecoder {
+public:
+    /**
+     * @return The block, or std::nullopt if it is malformed or truncated.
+     */
+    static std::optional<TimeSeriesBlock> decode(std::string_view block);
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief ISO-8601 UTC timestamp formatter ("2025-01-31T12:00:05Z").
+ *
+ * The date/time part is formatted once per second and cached; within the same second
+ * only the optional ".mmm" fraction is filled in. No locale, stream or gmtime() use.
+ * Not thread-safe: keep one instance per thread.
+ */
+class TimestampFormatter {
+public:
+    enum class Precision {
+        Seconds,      // "%FT%TZ", identical to std::put_time output
+        Milliseconds  // "%FT%T.mmmZ"
+    };
+
+    static constexpr size_t MAX_LENGTH = 24; // "YYYY-MM-DDTHH:MM:SS.mmmZ"
+
+    /**
+     * @brief Writes the timestamp into out (at least MAX_LENGTH bytes).
+     * @return Number of bytes written.
+     */
+    size_t format(std::chrono::system_clock::time_point tp, Precision precision, char* out);
+
+    /**
+     * @brief Appends the timestamp to a string.
+     */
+    void append(std::chrono::system_clock::time_point tp, Precision precision, std::string& out);
+
+private:
+    static constexpr size_t SECONDS_LENGTH = 19; // "YYYY-MM-DDTHH:MM:SS"
+
+    int64_t cached_second_ = INT64_MIN;
+    std::array<char, SECONDS_LENGTH> cached_{};
+};
+
+} // namespace SensorHub::Components
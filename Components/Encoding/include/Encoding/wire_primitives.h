@@ -0,0 +1,74 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Integer and fixed-point helpers shared by the binary encodings (frames, columnar blocks
+// and binary batches).
+namespace SensorHub::Components::wire {
+
+inline size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+inline void putVarint(uint64_t value, std::string& out) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+inline bool getVarint(std::string_view in, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) return false;
+        const auto byte = static_cast<uint8_t>(in[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Quantised integer for a numeric member, or nullopt if it cannot be represented
+inline std::optional<int64_t> quantize(const nlohmann::json& value, double scale) {
+    if (value.is_number_integer() && scale == 1.0) {
+        if (value.is_number_unsigned() && value.get<uint64_t>() > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            return std::nullopt;
+        }
+        return value.get<int64_t>();
+    }
+    const double scaled = value.get<double>() / scale;
+    if (!std::isfinite(scaled) || std::fabs(scaled) >= 9.2e18) return std::nullopt;
+    return std::llround(scaled);
+}
+
+inline nlohmann::json dequantize(int64_t q, double scale) {
+    if (scale == 1.0) return q;
+    // Divide by the integral inverse when there is one: 2153 / 100.0 == 21.53, 2153 * 0.01 != 21.53
+    const double inverse = std::round(1.0 / scale);
+    if (inverse >= 1.0 && std::fabs(inverse * scale - 1.0) < 1e-12) {
+        return static_cast<double>(q) / inverse;
+    }
+    return static_cast<double>(q) * scale;
+}
+
+} // namespace SensorHub::Components::wire
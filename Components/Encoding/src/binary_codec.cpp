@@ -0,0 +1,280 @@
+#include "Encoding/binary_codec.h"
+#include "Encoding/timestamp_formatter.h"
+#include "Encoding/wire_primitives.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace SensorHub::Components {
+
+using namespace wire;
+
+namespace {
+
+const char* typeCode(WireField::Type type) {
+    switch (type) {
+        case WireField::Type::Quantized: return "q";
+        case WireField::Type::Boolean:   return "b";
+        case WireField::Type::String:    return "s";
+    }
+    return "?";
+}
+
+std::optional<WireField::Type> typeFromCode(const std::string& code) {
+    if (code == "q") return WireField::Type::Quantized;
+    if (code == "b") return WireField::Type::Boolean;
+    if (code == "s") return WireField::Type::String;
+    return std::nullopt;
+}
+
+// Unit from the naming convention used by the drivers ("temperature_celsius", ...)
+std::string inferUnit(const std::string& name) {
+    static const std::pair<const char*, const char*> SUFFIXES[] = {
+        {"_celsius", "°C"}, {"_hpa", "hPa"}, {"_percent", "%"}, {"_pa", "Pa"}, {"_ms", "ms"},
+    };
+    for (const auto& [suffix, unit] : SUFFIXES) {
+        const size_t length = std::strlen(suffix);
+        if (name.size() > length && name.compare(name.size() - length, length, suffix) == 0) return unit;
+    }
+    return "";
+}
+
+} // namespace
+
+// --- WireSchema ---
+
+nlohmann::json WireSchema::toJson() const {
+    nlohmann::json fields_json = nlohmann::json::array();
+    for (const auto& field : fields) {
+        fields_json.push_back({{"name", field.name}, {"type", typeCode(field.type)},
+                               {"scale", field.scale}, {"unit", field.unit}});
+    }
+    return {{"encoding", ENCODING_NAME}, {"schema_id", id}, {"fields", std::move(fields_json)}};
+}
+
+std::optional<WireSchema> WireSchema::fromJson(const nlohmann::json& document) {
+    try {
+        if (document.value("encoding", std::string{}) != ENCODING_NAME) return std::nullopt;
+        WireSchema schema;
+        schema.id = document.at("schema_id").get<uint16_t>();
+        for (const auto& entry : document.at("fields")) {
+            WireField field;
+            field.name = entry.at("name").get<std::string>();
+            auto type = typeFromCode(entry.at("type").get<std::string>());
+            if (!type) return std::nullopt;
+            field.type = *type;
+            field.scale = entry.value("scale", 1.0);
+            field.unit = entry.value("unit", std::string{});
+            schema.fields.push_back(std::move(field));
+        }
+        return schema;
+    } catch (const nlohmann::json::exception&) {
+        return std::nullopt;
+    }
+}
+
+uint16_t WireSchema::computeId(const std::vector<WireField>& fields) {
+    // FNV-1a over the layout, folded to 16 bits (0 is reserved)
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+    };
+    for (const auto& field : fields) {
+        mix(field.name.data(), field.name.size() + 1);
+        mix(&field.type, sizeof(field.type));
+        mix(&field.scale, sizeof(field.scale));
+        mix(field.unit.data(), field.unit.size() + 1);
+    }
+    const auto id = static_cast<uint16_t>((hash >> 16) ^ (hash & 0xFFFF));
+    return id ? id : 1;
+}
+
+// --- BinaryCodec ---
+
+BinaryCodec::BinaryCodec(Options options) : options_(std::move(options)) {
+    if (!(options_.default_scale > 0.0)) {
+        throw std::invalid_argument("BinaryCodec: default_scale must be positive.");
+    }
+    for (const auto& [name, scale] : options_.scales) {
+        if (!(scale > 0.0)) throw std::invalid_argument("BinaryCodec: scale for '" + name + "' must be positive.");
+    }
+}
+
+BinaryChannel BinaryCodec::makeChannel(const std::string& sensor_topic, const std::string& platform,
+                                       const std::string& sensor_type, const std::string& topic_suffix) const {
+    BinaryChannel channel;
+    channel.schema_topic = sensor_topic + "/schema";
+    channel.metadata = {{"platform", platform}, {"sensor_type", sensor_type}, {"topic_suffix", topic_suffix}};
+    return channel;
+}
+
+std::optional<WireField> BinaryCodec::fieldFor(const std::string& name, const nlohmann::json& value) const {
+    WireField field;
+    field.name = name;
+    if (value.is_number()) {
+        field.type = WireField::Type::Quantized;
+        const auto it = options_.scales.find(name);
+        field.scale = it != options_.scales.end() ? it->second
+                    : value.is_number_float() ? options_.default_scale : 1.0;
+    } else if (value.is_boolean()) {
+        field.type = WireField::Type::Boolean;
+    } else if (value.is_string()) {
+        field.type = WireField::Type::String;
+    } else {
+        return std::nullopt; // Nested values are not carried in frames
+    }
+    if (field.type == WireField::Type::Quantized) {
+        const auto unit = options_.units.find(name);
+        field.unit = unit != options_.units.end() ? unit->second : inferUnit(name);
+    }
+    return field;
+}
+
+std::shared_ptr<const WireSchema> BinaryCodec::extend(const WireSchema* current, const nlohmann::json& reading) const {
+    // Union of the known layout and this reading's members, keyed (and so ordered) by name
+    std::map<std::string, WireField> fields;
+    if (current) {
+        for (const auto& field : current->fields) fields.emplace(field.name, field);
+    }
+    for (const auto& [name, value] : reading.items()) {
+        if (auto field = fieldFor(name, value)) fields.insert_or_assign(name, std::move(*field));
+    }
+
+    auto schema = std::make_shared<WireSchema>();
+    for (auto& entry : fields) schema->fields.push_back(std::move(entry.second));
+    schema->id = WireSchema::computeId(schema->fields);
+    return schema;
+}
+
+bool BinaryCodec::encode(BinaryChannel& channel, const nlohmann::json& reading,
+                         std::chrono::system_clock::time_point timestamp, std::string& out) const {
+    if (!reading.is_object()) {
+        throw std::invalid_argument("BinaryCodec: sensor reading must be a JSON object.");
+    }
+
+    // Does the current layout carry every member of this reading?
+    bool fits = channel.schema != nullptr;
+    if (fits) {
+        for (const auto& [name, value] : reading.items()) {
+            const auto field = fieldFor(name, value);
+            if (!field) continue;
+            const auto& known = channel.schema->fields;
+            const auto it = std::find_if(known.begin(), known.end(), [&](const auto& f) { return f.name == name; });
+            if (it == known.end() || it->type != field->type) {
+                fits = false;
+                break;
+            }
+        }
+    }
+    bool changed = false;
+    if (!fits) {
+        auto schema = extend(channel.schema.get(), reading);
+        changed = !channel.schema || channel.schema->id != schema->id || channel.schema->fields != schema->fields;
+        channel.schema = std::move(schema);
+        if (changed) channel.schema_published = false;
+    }
+    const WireSchema& schema = *channel.schema;
+
+    out += static_cast<char>(FRAME_MAGIC);
+    out += static_cast<char>(schema.id & 0xFF);
+    out += static_cast<char>(schema.id >> 8);
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count();
+    putVarint(static_cast<uint64_t>(std::max<int64_t>(millis, 0)), out);
+
+    const size_t mask_offset = out.size();
+    out.append((schema.fields.size() + 7) / 8, '\0');
+    for (size_t i = 0; i < schema.fields.size(); ++i) {
+        const auto& field = schema.fields[i];
+        const auto it = reading.find(field.name);
+        if (it == reading.end()) continue;
+
+        bool present = false;
+        switch (field.type) {
+            case WireField::Type::Quantized:
+                if (it->is_number()) {
+                    if (auto q = quantize(*it, field.scale)) {
+                        putVarint(zigzag(*q), out);
+                        present = true;
+                    }
+                }
+                break;
+            case WireField::Type::Boolean:
+                if (it->is_boolean()) {
+                    out += static_cast<char>(it->get<bool>() ? 1 : 0);
+                    present = true;
+                }
+                break;
+            case WireField::Type::String:
+                if (it->is_string()) {
+                    const auto& text = it->get_ref<const std::string&>();
+                    putVarint(text.size(), out);
+                    out += text;
+                    present = true;
+                }
+                break;
+        }
+        if (present) out[mask_offset + i / 8] = static_cast<char>(out[mask_offset + i / 8] | (1 << (i % 8)));
+    }
+    return changed;
+}
+
+void BinaryCodec::appendSchemaMessage(const BinaryChannel& channel, std::string& out) {
+    nlohmann::json document = channel.schema ? channel.schema->toJson() : nlohmann::json::object();
+    for (const auto& [key, value] : channel.metadata.items()) document[key] = value;
+    out += document.dump();
+}
+
+std::optional<nlohmann::json> BinaryCodec::decode(const WireSchema& schema, std::string_view frame) {
+    size_t pos = 0;
+    if (frame.size() < 3 || static_cast<uint8_t>(frame[0]) != FRAME_MAGIC) return std::nullopt;
+    const auto id = static_cast<uint16_t>(static_cast<uint8_t>(frame[1]) | (static_cast<uint8_t>(frame[2]) << 8));
+    if (id != schema.id) return std::nullopt;
+    pos = 3;
+
+    uint64_t millis = 0;
+    if (!getVarint(frame, pos, millis)) return std::nullopt;
+    const size_t mask_size = (schema.fields.size() + 7) / 8;
+    if (frame.size() - pos < mask_size) return std::nullopt;
+    const std::string_view mask = frame.substr(pos, mask_size);
+    pos += mask_size;
+
+    nlohmann::json reading = nlohmann::json::object();
+    for (size_t i = 0; i < schema.fields.size(); ++i) {
+        if (!(static_cast<uint8_t>(mask[i / 8]) & (1 << (i % 8)))) continue;
+        const auto& field = schema.fields[i];
+        switch (field.type) {
+            case WireField::Type::Quantized: {
+                uint64_t raw = 0;
+                if (!getVarint(frame, pos, raw)) return std::nullopt;
+                reading[field.name] = dequantize(unzigzag(raw), field.scale);
+                break;
+            }
+            case WireField::Type::Boolean:
+                if (pos >= frame.size()) return std::nullopt;
+                reading[field.name] = frame[pos++] != 0;
+                break;
+            case WireField::Type::String: {
+                uint64_t length = 0;
+                if (!getVarint(frame, pos, length) || frame.size() - pos < length) return std::nullopt;
+                reading[field.name] = std::string(frame.substr(pos, length));
+                pos += length;
+                break;
+            }
+        }
+    }
+    if (pos != frame.size()) return std::nullopt;
+
+    TimestampFormatter formatter;
+    std::string timestamp;
+    formatter.append(std::chrono::system_clock::time_point(std::chrono::milliseconds(millis)),
+                     TimestampFormatter::Precision::Milliseconds, timestamp);
+    reading["timestamp"] = std::move(timestamp);
+    return reading;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,65 @@
+#include "Encoding/bit_stream.h"
+#include <algorithm>
+
+namespace SensorHub::Components {
+
+// --- BitWriter ---
+
+void BitWriter::write(uint64_t value, unsigned bits) {
+    while (bits > 0) {
+        const unsigned used = bit_count_ % 8;
+        if (used == 0) bytes_ += '\0';
+        const unsigned free = 8 - used;
+        const unsigned take = std::min(free, bits);
+        const auto chunk = static_cast<unsigned>((value >> (bits - take)) & ((1u << take) - 1));
+        bytes_.back() = static_cast<char>(static_cast<uint8_t>(bytes_.back()) | (chunk << (free - take)));
+        bits -= take;
+        bit_count_ += take;
+    }
+}
+
+void BitWriter::append(const BitWriter& other) {
+    const size_t whole_bytes = other.bit_count_ / 8;
+    if (bit_count_ % 8 == 0) {
+        // Byte-aligned: plain copy
+        bytes_.append(other.bytes_, 0, whole_bytes);
+        bit_count_ += whole_bytes * 8;
+    } else {
+        for (size_t i = 0; i < whole_bytes; ++i) write(static_cast<uint8_t>(other.bytes_[i]), 8);
+    }
+    if (const unsigned rest = other.bit_count_ % 8) {
+        write(static_cast<uint8_t>(other.bytes_[whole_bytes]) >> (8 - rest), rest);
+    }
+}
+
+void BitWriter::clear() {
+    bytes_.clear();
+    bit_count_ = 0;
+}
+
+// --- BitReader ---
+
+bool BitReader::read(unsigned bits, uint64_t& value) {
+    if (bits > bitsLeft()) return false;
+    value = 0;
+    while (bits > 0) {
+        const unsigned used = bit_pos_ % 8;
+        const unsigned available = 8 - used;
+        const unsigned take = std::min(available, bits);
+        const auto byte = static_cast<uint8_t>(bytes_[bit_pos_ / 8]);
+        const auto chunk = static_cast<uint64_t>((byte >> (available - take)) & ((1u << take) - 1));
+        value = (value << take) | chunk;
+        bits -= take;
+        bit_pos_ += take;
+    }
+    return true;
+}
+
+bool BitReader::readBit(bool& bit) {
+    uint64_t value = 0;
+    if (!read(1, value)) return false;
+    bit = value != 0;
+    return true;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,196 @@
+#include "Encoding/payload_encoder.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace SensorHub::Components {
+
+// appendDouble() uses nlohmann::detail::to_chars, the library's internal dtoa, so that
+// doubles come out exactly as dump() writes them. It is not public API: json is pinned in
+// Externals/CMakeLists.txt and Test-payload_encoder.cpp compares the output with dump().
+static_assert(NLOHMANN_JSON_VERSION_MAJOR == 3, "PayloadEncoder: check appendDouble() against the new json release");
+
+namespace {
+
+template <typename Integer>
+void appendInteger(Integer value, std::string& out) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendDouble(double value, std::string& out) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    // Same shortest round-trip formatting (and ".0" / exponent rules) that dump() uses
+    char buffer[64];
+    char* end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, end);
+}
+
+} // namespace
+
+PayloadEncoder::PayloadEncoder(Options options) : options_(std::move(options)) {}
+
+SensorChannel PayloadEncoder::makeChannel(const std::string& sensor_type, const std::string& topic_suffix) const {
+    SensorChannel channel;
+    channel.topic = options_.topic_base + "/" + topic_suffix;
+
+    auto add = [&channel](std::string key, const std::string* value) {
+        SensorChannel::Field field;
+        field.key = std::move(key);
+        field.is_timestamp = (value == nullptr);
+        if (value) {
+            appendString(field.key, field.rendered);
+            field.rendered += ':';
+            appendString(*value, field.rendered);
+        }
+        channel.fields.push_back(std::move(field));
+    };
+    if (options_.static_metadata) {
+        add("platform", &options_.platform);
+        add("sensor_type", &sensor_type);
+    }
+    add("timestamp", nullptr);
+    add("topic_suffix", &topic_suffix);
+    std::sort(channel.fields.begin(), channel.fields.end(),
+              [](const auto& a, const auto& b) { return a.key < b.key; });
+    return channel;
+}
+
+void PayloadEncoder::encode(const SensorChannel& channel, const nlohmann::json& reading,
+                            std::chrono::system_clock::time_point timestamp, std::string& out) const {
+    if (!reading.is_object()) {
+        throw std::invalid_argument("PayloadEncoder: sensor reading must be a JSON object.");
+    }
+    thread_local TimestampFormatter formatter;
+
+    bool first = true;
+    auto separator = [&] {
+        if (!first) out += ',';
+        first = false;
+    };
+    auto appendField = [&](const SensorChannel::Field& field) {
+        separator();
+        if (field.is_timestamp) {
+            appendString(field.key, out);
+            out += ":\"";
+            formatter.append(timestamp, options_.timestamp_precision, out);
+            out += '"';
+        } else {
+            out += field.rendered;
+        }
+    };
+
+    // Merge the (already sorted) reading members with the sorted metadata fields
+    out += '{';
+    auto field = channel.fields.begin();
+    for (const auto& [key, value] : reading.items()) {
+        while (field != channel.fields.end() && field->key < key) {
+            appendField(*field++);
+        }
+        if (field != channel.fields.end() && field->key == key) {
+            continue; // Metadata overrides a sensor member with the same name
+        }
+        separator();
+        appendString(key, out);
+        out += ':';
+        appendJson(value, out);
+    }
+    while (field != channel.fields.end()) {
+        appendField(*field++);
+    }
+    out += '}';
+}
+
+void PayloadEncoder::appendJson(const nlohmann::json& value, std::string& out) {
+    using value_t = nlohmann::json::value_t;
+    switch (value.type()) {
+        case value_t::object: {
+            out += '{';
+            bool first = true;
+            for (const auto& [key, member] : value.items()) {
+                if (!first) out += ',';
+                first = false;
+                appendString(key, out);
+                out += ':';
+                appendJson(member, out);
+            }
+            out += '}';
+            return;
+        }
+        case value_t::array: {
+            out += '[';
+            bool first = true;
+            for (const auto& element : value) {
+                if (!first) out += ',';
+                first = false;
+                appendJson(element, out);
+            }
+            out += ']';
+            return;
+        }
+        case value_t::string:
+            appendString(value.get_ref<const std::string&>(), out);
+            return;
+        case value_t::boolean:
+            out += value.get<bool>() ? "true" : "false";
+            return;
+        case value_t::number_integer:
+            appendInteger(value.get<int64_t>(), out);
+            return;
+        case value_t::number_unsigned:
+            appendInteger(value.get<uint64_t>(), out);
+            return;
+        case value_t::number_float:
+            appendDouble(value.get<double>(), out);
+            return;
+        case value_t::null:
+            out += "null";
+            return;
+        case value_t::binary:
+        case value_t::discarded:
+            break;
+    }
+    out += value.dump(); // Rare types: defer to the library
+}
+
+void PayloadEncoder::appendString(std::string_view value, std::string& out) {
+    // Non-ASCII input needs UTF-8 validation; let the library handle (and reject) it
+    const bool ascii = std::none_of(value.begin(), value.end(),
+                                    [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+    if (!ascii) {
+        out += nlohmann::json(std::string(value)).dump();
+        return;
+    }
+
+    static constexpr char HEX[] = "0123456789abcdef";
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '\b': out += "\\b"; break;
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\f': out += "\\f"; break;
+            case '\r': out += "\\r"; break;
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            default:
+                if (static_cast<unsigned char>(c) <= 0x1F) {
+                    out += "\\u00";
+                    out += HEX[(c >> 4) & 0x0F];
+                    out += HEX[c & 0x0F];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+} // namespace SensorHub::Components
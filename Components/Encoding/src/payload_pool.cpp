@@ -0,0 +1,115 @@
+#include "Encoding/payload_pool.h"
+#include <utility>
+
+namespace SensorHub::Components {
+
+namespace detail {
+
+struct PayloadPoolState {
+    PayloadPoolState(size_t free_limit, size_t capacity_limit)
+        : max_free(free_limit), max_capacity(capacity_limit) {
+        free.reserve(max_free);
+    }
+
+    ~PayloadPoolState() {
+        for (auto* block : free) delete block;
+    }
+
+    void recycle(PayloadBlock* block) {
+        if (block->data.capacity() <= max_capacity) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (free.size() < max_free) {
+                free.push_back(block);
+                return;
+            }
+        }
+        delete block;
+    }
+
+    std::mutex mutex;
+    std::vector<PayloadBlock*> free;
+    const size_t max_free;
+    const size_t max_capacity;
+};
+
+} // namespace detail
+
+// --- Payload ---
+
+Payload::Payload(const Payload& other) noexcept : block_(other.block_) {
+    if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+Payload& Payload::operator=(const Payload& other) noexcept {
+    if (this != &other) {
+        Payload copy(other);
+        std::swap(block_, copy.block_);
+    }
+    return *this;
+}
+
+Payload::Payload(Payload&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+
+Payload& Payload::operator=(Payload&& other) noexcept {
+    if (this != &other) {
+        release();
+        block_ = std::exchange(other.block_, nullptr);
+    }
+    return *this;
+}
+
+Payload::~Payload() {
+    release();
+}
+
+void Payload::release() {
+    auto* block = std::exchange(block_, nullptr);
+    if (!block || block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    // Last handle: hand the buffer back (or free it if the pool is gone)
+    auto pool = std::move(block->pool);
+    block->data.clear();
+    pool->recycle(block);
+}
+
+const std::string& Payload::str() const {
+    static const std::string empty;
+    return block_ ? block_->data : empty;
+}
+
+std::string& Payload::buffer() {
+    return block_->data;
+}
+
+uint32_t Payload::useCount() const {
+    return block_ ? block_->refs.load(std::memory_order_relaxed) : 0;
+}
+
+// --- PayloadPool ---
+
+PayloadPool::PayloadPool(size_t max_free, size_t max_capacity)
+    : state_(std::make_shared<detail::PayloadPoolState>(max_free, max_capacity)) {}
+
+PayloadPool::~PayloadPool() = default;
+
+Payload PayloadPool::acquire() {
+    detail::PayloadBlock* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (!state_->free.empty()) {
+            block = state_->free.back();
+            state_->free.pop_back();
+        }
+    }
+    if (!block) block = new detail::PayloadBlock();
+    block->refs.store(1, std::memory_order_relaxed);
+    block->pool = state_;
+    return Payload(block);
+}
+
+size_t PayloadPool::freeCount() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->free.size();
+}
+
+} // namespace SensorHub::Components
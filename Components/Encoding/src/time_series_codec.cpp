@@ -0,0 +1,415 @@
+#include "Encoding/time_series_codec.h"
+#include "Encoding/timestamp_formatter.h"
+#include "Encoding/wire_primitives.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace SensorHub::Components {
+
+using namespace wire;
+using Kind = TimeSeriesColumn::Kind;
+
+namespace {
+
+// Payload widths after the '10', '110', '1110' and '1111' control codes
+constexpr unsigned BUCKET_WIDTHS[] = {0, 7, 9, 12, 64};
+
+// Two's complement difference; deltas of extreme values wrap and unwrap consistently
+int64_t wrappingSub(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+}
+
+int64_t wrappingAdd(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+void writeBucketed(BitWriter& out, int64_t value) {
+    if (value == 0) {
+        out.write(0b0, 1);
+        return;
+    }
+    const uint64_t raw = zigzag(value);
+    if (raw < (uint64_t{1} << 7)) {
+        out.write(0b10, 2);
+        out.write(raw, 7);
+    } else if (raw < (uint64_t{1} << 9)) {
+        out.write(0b110, 3);
+        out.write(raw, 9);
+    } else if (raw < (uint64_t{1} << 12)) {
+        out.write(0b1110, 4);
+        out.write(raw, 12);
+    } else {
+        out.write(0b1111, 4);
+        out.write(raw, 64);
+    }
+}
+
+bool readBucketed(BitReader& in, int64_t& value) {
+    unsigned ones = 0;
+    for (bool bit = true; ones < 4; ++ones) {
+        if (!in.readBit(bit)) return false;
+        if (!bit) break;
+    }
+    if (ones == 0) {
+        value = 0;
+        return true;
+    }
+    uint64_t raw = 0;
+    if (!in.read(BUCKET_WIDTHS[ones], raw)) return false;
+    value = unzigzag(raw);
+    return true;
+}
+
+void putString(std::string_view text, std::string& out) {
+    putVarint(text.size(), out);
+    out += text;
+}
+
+bool getString(std::string_view in, size_t& pos, std::string& text) {
+    uint64_t length = 0;
+    if (!getVarint(in, pos, length) || in.size() - pos < length) return false;
+    text.assign(in.substr(pos, length));
+    pos += length;
+    return true;
+}
+
+} // namespace
+
+// --- TimeSeriesBlock ---
+
+nlohmann::json TimeSeriesBlock::readings() const {
+    nlohmann::json rows = nlohmann::json::array();
+    TimestampFormatter formatter;
+    for (size_t row = 0; row < timestamps_ms.size(); ++row) {
+        nlohmann::json reading = metadata;
+        for (const auto& column : columns) reading[column.name] = column.values[row];
+        std::string timestamp;
+        formatter.append(std::chrono::system_clock::time_point(std::chrono::milliseconds(timestamps_ms[row])),
+                         TimestampFormatter::Precision::Milliseconds, timestamp);
+        reading["timestamp"] = std::move(timestamp);
+        rows.push_back(std::move(reading));
+    }
+    return rows;
+}
+
+// --- TimeSeriesEncoder ---
+
+TimeSeriesEncoder::TimeSeriesEncoder(Options options, nlohmann::json metadata) : options_(std::move(options)) {
+    size_t count = 0;
+    std::string entries;
+    for (const auto& [key, value] : metadata.items()) {
+        if (!value.is_string()) continue;
+        putString(key, entries);
+        putString(value.get_ref<const std::string&>(), entries);
+        ++count;
+    }
+    putVarint(count, metadata_header_);
+    metadata_header_ += entries;
+}
+
+std::optional<Kind> TimeSeriesEncoder::kindFor(const std::string& name, const nlohmann::json& value,
+                                               double& scale) const {
+    scale = 1.0;
+    if (value.is_boolean()) return Kind::Boolean;
+    if (value.is_string()) return Kind::String;
+    if (!value.is_number()) return std::nullopt; // Nested values and nulls are not carried
+
+    // Values that do not fit the fixed-point range fall back to XOR (and so to a block of their own)
+    if (const auto it = options_.scales.find(name); it != options_.scales.end()) {
+        scale = it->second;
+        if (quantize(value, scale)) return Kind::Fixed;
+    } else if (value.is_number_integer()) {
+        if (quantize(value, 1.0)) return Kind::Integer;
+    } else if (options_.values == ValueEncoding::Fixed) {
+        scale = options_.default_scale;
+        if (quantize(value, scale)) return Kind::Fixed;
+    }
+    scale = 1.0;
+    return Kind::Float;
+}
+
+bool TimeSeriesEncoder::accepts(const nlohmann::json& reading) const {
+    if (!reading.is_object()) return false;
+    if (rows_ == 0) return true;
+
+    size_t index = 0;
+    for (const auto& [name, value] : reading.items()) {
+        double scale = 1.0;
+        const auto kind = kindFor(name, value, scale);
+        if (!kind) continue;
+        if (index >= columns_.size()) return false;
+        const Column& column = columns_[index++];
+        if (column.name != name || column.kind != *kind || column.scale != scale) return false;
+    }
+    return index == columns_.size();
+}
+
+void TimeSeriesEncoder::startColumns(const nlohmann::json& reading) {
+    std::string entries;
+    for (const auto& [name, value] : reading.items()) {
+        double scale = 1.0;
+        const auto kind = kindFor(name, value, scale);
+        if (!kind) continue;
+        Column column;
+        column.name = name;
+        column.kind = *kind;
+        column.scale = scale;
+        putString(name, entries);
+        entries += static_cast<char>(column.kind);
+        if (column.kind == Kind::Fixed) {
+            const auto bits = std::bit_cast<uint64_t>(scale);
+            for (unsigned shift = 0; shift < 64; shift += 8) entries += static_cast<char>((bits >> shift) & 0xFF);
+        }
+        columns_.push_back(std::move(column));
+    }
+    column_header_.clear();
+    putVarint(columns_.size(), column_header_);
+    column_header_ += entries;
+}
+
+void TimeSeriesEncoder::appendValue(Column& column, const nlohmann::json& value) {
+    BitWriter& out = column.bits;
+    switch (column.kind) {
+        case Kind::Float: {
+            const auto bits = std::bit_cast<uint64_t>(value.get<double>());
+            if (rows_ == 0) {
+                out.write(bits, 64);
+                column.previous_bits = bits;
+                break;
+            }
+            const uint64_t x = bits ^ column.previous_bits;
+            column.previous_bits = bits;
+            if (x == 0) {
+                out.write(0b0, 1);
+                break;
+            }
+            const auto leading = std::min(static_cast<unsigned>(std::countl_zero(x)), 31u);
+            const auto trailing = static_cast<unsigned>(std::countr_zero(x));
+            if (column.window_length > 0 && leading >= column.window_leading &&
+                trailing >= 64 - column.window_leading - column.window_length) {
+                // Meaningful bits fit the previous window: '10' + the window
+                out.write(0b10, 2);
+                out.write(x >> (64 - column.window_leading - column.window_length), column.window_length);
+            } else {
+                // '11' + 5 bits leading zeros + 6 bits length (0 = 64) + the meaningful bits
+                const unsigned length = 64 - leading - trailing;
+                out.write(0b11, 2);
+                out.write(leading, 5);
+                out.write(length == 64 ? 0 : length, 6);
+                out.write(x >> trailing, length);
+                column.window_leading = leading;
+                column.window_length = length;
+            }
+            break;
+        }
+        case Kind::Fixed:
+        case Kind::Integer: {
+            const int64_t q = column.kind == Kind::Fixed ? *quantize(value, column.scale) : value.get<int64_t>();
+            writeBucketed(out, wrappingSub(q, column.previous_value));
+            column.previous_value = q;
+            break;
+        }
+        case Kind::Boolean:
+            out.writeBit(value.get<bool>());
+            break;
+        case Kind::String: {
+            const auto& text = value.get_ref<const std::string&>();
+            if (rows_ > 0 && text == column.previous_string) {
+                out.write(0b0, 1);
+                break;
+            }
+            out.write(0b1, 1);
+            writeBucketed(out, static_cast<int64_t>(text.size()));
+            for (const char c : text) out.write(static_cast<uint8_t>(c), 8);
+            column.previous_string = text;
+            break;
+        }
+    }
+}
+
+void TimeSeriesEncoder::append(const nlohmann::json& reading, std::chrono::system_clock::time_point timestamp) {
+    if (!reading.is_object()) throw std::invalid_argument("Time-series rows must be JSON objects");
+    if (!accepts(reading)) throw std::invalid_argument("Reading does not match the fields of the open block");
+    if (rows_ == 0) startColumns(reading);
+
+    const int64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count();
+    if (rows_ == 0) {
+        timestamps_.write(static_cast<uint64_t>(millis), 64);
+    } else {
+        const int64_t delta = wrappingSub(millis, previous_timestamp_);
+        writeBucketed(timestamps_, wrappingSub(delta, previous_delta_));
+        previous_delta_ = delta;
+    }
+    previous_timestamp_ = millis;
+
+    size_t index = 0;
+    for (const auto& [name, value] : reading.items()) {
+        double scale = 1.0;
+        if (kindFor(name, value, scale)) appendValue(columns_[index++], value);
+    }
+    ++rows_;
+}
+
+size_t TimeSeriesEncoder::size() const {
+    if (rows_ == 0) return 0;
+    size_t bits = timestamps_.bitCount();
+    for (const auto& column : columns_) bits += column.bits.bitCount();
+    return 1 + varintSize(rows_) + metadata_header_.size() + column_header_.size() + (bits + 7) / 8;
+}
+
+void TimeSeriesEncoder::finish(std::string& out) {
+    if (rows_ == 0) return;
+    out += static_cast<char>(BLOCK_MAGIC);
+    putVarint(rows_, out);
+    out += metadata_header_;
+    out += column_header_;
+
+    BitWriter stream = std::move(timestamps_);
+    for (const auto& column : columns_) stream.append(column.bits);
+    out += stream.bytes();
+
+    columns_.clear();
+    column_header_.clear();
+    timestamps_.clear();
+    previous_timestamp_ = 0;
+    previous_delta_ = 0;
+    rows_ = 0;
+}
+
+// --- TimeSeriesDecoder ---
+
+std::optional<TimeSeriesBlock> TimeSeriesDecoder::decode(std::string_view block) {
+    if (!TimeSeriesEncoder::isBlock(block)) return std::nullopt;
+    size_t pos = 1;
+    TimeSeriesBlock result;
+
+    uint64_t rows = 0;
+    uint64_t count = 0;
+    if (!getVarint(block, pos, rows) || !getVarint(block, pos, count)) return std::nullopt;
+    for (uint64_t i = 0; i < count; ++i) {
+        std::string key, value;
+        if (!getString(block, pos, key) || !getString(block, pos, value)) return std::nullopt;
+        result.metadata[key] = std::move(value);
+    }
+
+    if (!getVarint(block, pos, count) || count > block.size()) return std::nullopt;
+    for (uint64_t i = 0; i < count; ++i) {
+        TimeSeriesColumn column;
+        if (!getString(block, pos, column.name) || pos >= block.size()) return std::nullopt;
+        const auto kind = static_cast<uint8_t>(block[pos++]);
+        if (kind > static_cast<uint8_t>(Kind::String)) return std::nullopt;
+        column.kind = static_cast<Kind>(kind);
+        if (column.kind == Kind::Fixed) {
+            if (block.size() - pos < 8) return std::nullopt;
+            uint64_t bits = 0;
+            for (unsigned shift = 0; shift < 64; shift += 8) {
+                bits |= static_cast<uint64_t>(static_cast<uint8_t>(block[pos++])) << shift;
+            }
+            column.scale = std::bit_cast<double>(bits);
+            if (!std::isfinite(column.scale) || column.scale <= 0.0) return std::nullopt;
+        }
+        result.columns.push_back(std::move(column));
+    }
+
+    BitReader in(block.substr(pos));
+    // Every row takes at least one bit per stream; rejects absurd counts before allocating
+    if (rows > in.bitsLeft() / (result.columns.size() + 1)) return std::nullopt;
+
+    result.timestamps_ms.reserve(rows);
+    int64_t timestamp = 0;
+    int64_t delta = 0;
+    for (uint64_t row = 0; row < rows; ++row) {
+        if (row == 0) {
+            uint64_t raw = 0;
+            if (!in.read(64, raw)) return std::nullopt;
+            timestamp = static_cast<int64_t>(raw);
+        } else {
+            int64_t delta_of_delta = 0;
+            if (!readBucketed(in, delta_of_delta)) return std::nullopt;
+            delta = wrappingAdd(delta, delta_of_delta);
+            timestamp = wrappingAdd(timestamp, delta);
+        }
+        result.timestamps_ms.push_back(timestamp);
+    }
+
+    for (auto& column : result.columns) {
+        column.values.reserve(rows);
+        uint64_t previous_bits = 0;
+        unsigned window_leading = 0;
+        unsigned window_length = 0;
+        int64_t previous_value = 0;
+        std::string previous_string;
+
+        for (uint64_t row = 0; row < rows; ++row) {
+            switch (column.kind) {
+                case Kind::Float: {
+                    bool changed = false;
+                    if (row == 0) {
+                        if (!in.read(64, previous_bits)) return std::nullopt;
+                    } else if (!in.readBit(changed)) {
+                        return std::nullopt;
+                    } else if (changed) {
+                        bool new_window = false;
+                        if (!in.readBit(new_window)) return std::nullopt;
+                        if (new_window) {
+                            uint64_t leading = 0, length = 0;
+                            if (!in.read(5, leading) || !in.read(6, length)) return std::nullopt;
+                            window_leading = static_cast<unsigned>(leading);
+                            window_length = length == 0 ? 64 : static_cast<unsigned>(length);
+                            if (window_leading + window_length > 64) return std::nullopt;
+                        } else if (window_length == 0) {
+                            return std::nullopt;
+                        }
+                        uint64_t meaningful = 0;
+                        if (!in.read(window_length, meaningful)) return std::nullopt;
+                        previous_bits ^= meaningful << (64 - window_leading - window_length);
+                    }
+                    column.values.emplace_back(std::bit_cast<double>(previous_bits));
+                    break;
+                }
+                case Kind::Fixed:
+                case Kind::Integer: {
+                    int64_t difference = 0;
+                    if (!readBucketed(in, difference)) return std::nullopt;
+                    previous_value = wrappingAdd(previous_value, difference);
+                    column.values.push_back(column.kind == Kind::Fixed ? dequantize(previous_value, column.scale)
+                                                                       : nlohmann::json(previous_value));
+                    break;
+                }
+                case Kind::Boolean: {
+                    bool bit = false;
+                    if (!in.readBit(bit)) return std::nullopt;
+                    column.values.emplace_back(bit);
+                    break;
+                }
+                case Kind::String: {
+                    bool changed = false;
+                    if (!in.readBit(changed)) return std::nullopt;
+                    if (changed) {
+                        int64_t length = 0;
+                        if (!readBucketed(in, length) || length < 0 ||
+                            static_cast<uint64_t>(length) > in.bitsLeft() / 8) {
+                            return std::nullopt;
+                        }
+                        previous_string.resize(static_cast<size_t>(length));
+                        for (auto& c : previous_string) {
+                            uint64_t byte = 0;
+                            in.read(8, byte);
+                            c = static_cast<char>(byte);
+                        }
+                    }
+                    column.values.emplace_back(previous_string);
+                    break;
+                }
+            }
+        }
+    }
+    // Only the zero padding of the last byte may remain
+    if (in.bitsLeft() >= 8) return std::nullopt;
+    return result;
+}
+
+} // namespace SensorHub::Components
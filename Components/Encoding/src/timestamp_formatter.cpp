@@ -0,0 +1,60 @@
+#include "Encoding/timestamp_formatter.h"
+#include <cstring>
+
+namespace SensorHub::Components {
+
+namespace {
+
+void writeDigits(char* out, unsigned value, size_t width) {
+    for (size_t i = width; i-- > 0;) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // namespace
+
+size_t TimestampFormatter::format(std::chrono::system_clock::time_point tp, Precision precision, char* out) {
+    using namespace std::chrono;
+    const auto second = floor<seconds>(tp);
+    const int64_t second_count = second.time_since_epoch().count();
+
+    if (second_count != cached_second_) {
+        // Civil date from the calendar library instead of gmtime()
+        const auto day = floor<days>(second);
+        const year_month_day ymd{day};
+        const hh_mm_ss<seconds> time{second - day};
+
+        char* p = cached_.data();
+        writeDigits(p, static_cast<unsigned>(static_cast<int>(ymd.year())), 4);
+        p[4] = '-';
+        writeDigits(p + 5, static_cast<unsigned>(ymd.month()), 2);
+        p[7] = '-';
+        writeDigits(p + 8, static_cast<unsigned>(ymd.day()), 2);
+        p[10] = 'T';
+        writeDigits(p + 11, static_cast<unsigned>(time.hours().count()), 2);
+        p[13] = ':';
+        writeDigits(p + 14, static_cast<unsigned>(time.minutes().count()), 2);
+        p[16] = ':';
+        writeDigits(p + 17, static_cast<unsigned>(time.seconds().count()), 2);
+        cached_second_ = second_count;
+    }
+
+    std::memcpy(out, cached_.data(), SECONDS_LENGTH);
+    size_t length = SECONDS_LENGTH;
+    if (precision == Precision::Milliseconds) {
+        const auto millis = duration_cast<milliseconds>(tp - second).count();
+        out[length++] = '.';
+        writeDigits(out + length, static_cast<unsigned>(millis), 3);
+        length += 3;
+    }
+    out[length++] = 'Z';
+    return length;
+}
+
+void TimestampFormatter::append(std::chrono::system_clock::time_point tp, Precision precision, std::string& out) {
+    char buffer[MAX_LENGTH];
+    out.append(buffer, format(tp, precision, buffer));
+}
+
+} // namespace SensorHub::Components
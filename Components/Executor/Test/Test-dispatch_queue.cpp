@@ -0,0 +1,184 @@
+#include "Executor/dispatch_queue.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace SensorHub::Components {
+
+using namespace std::chrono_literals;
+
+TEST(DispatchQueueTest, DispatchesEverythingOnOneThread) {
+    std::vector<int> seen;
+    std::thread::id dispatch_thread;
+    bool one_thread = true;
+    {
+        DispatchQueue<int> queue({}, [&](int& item) {
+            if (dispatch_thread == std::thread::id{}) dispatch_thread = std::this_thread::get_id();
+            one_thread = one_thread && dispatch_thread == std::this_thread::get_id();
+            seen.push_back(item);
+        });
+        for (int i = 0; i < 100; ++i) EXPECT_TRUE(queue.push(int{i}));
+        queue.stop();
+        EXPECT_EQ(queue.stats().dispatched, 100u);
+        EXPECT_EQ(queue.stats().depth, 0u);
+    }
+    ASSERT_EQ(seen.size(), 100u);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(seen[static_cast<size_t>(i)], i);
+    EXPECT_TRUE(one_thread);
+    EXPECT_NE(dispatch_thread, std::this_thread::get_id());
+}
+
+TEST(DispatchQueueTest, DropsWhenFull) {
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    DispatchQueue<int> queue({4, DispatchQueue<int>::Overflow::Drop}, [gate](int&) { gate.wait(); });
+
+    int accepted = 0;
+    for (int i = 0; i < 20; ++i) accepted += queue.push(int{i}) ? 1 : 0;
+    // Four in the ring plus the one the dispatch thread may already hold
+    EXPECT_GE(accepted, 4);
+    EXPECT_LE(accepted, 5);
+    EXPECT_EQ(queue.stats().dropped, static_cast<uint64_t>(20 - accepted));
+    EXPECT_EQ(queue.stats().high_water, 4u);
+
+    release.set_value();
+    queue.stop();
+    EXPECT_EQ(queue.stats().dispatched, static_cast<uint64_t>(accepted));
+}
+
+TEST(DispatchQueueTest, BlockWaitsForASlot) {
+    std::atomic<int> handled{0};
+    DispatchQueue<int> queue({2, DispatchQueue<int>::Overflow::Block, 5000ms},
+                             [&](int&) { std::this_thread::sleep_for(1ms); ++handled; });
+    for (int i = 0; i < 30; ++i) EXPECT_TRUE(queue.push(int{i}));
+    queue.stop();
+    EXPECT_EQ(handled.load(), 30);
+    EXPECT_EQ(queue.stats().dropped, 0u);
+    EXPECT_GT(queue.stats().blocked, 0u);
+}
+
+TEST(DispatchQueueTest, TicksWhileIdleAndRefusesAfterStop) {
+    std::atomic<int> ticks{0};
+    DispatchQueue<int> queue({16, DispatchQueue<int>::Overflow::Drop, 1000ms, 5ms}, [](int&) {}, [&] { ++ticks; });
+    std::this_thread::sleep_for(60ms);
+    EXPECT_GE(ticks.load(), 3);
+
+    queue.stop();
+    EXPECT_FALSE(queue.push(1));
+    EXPECT_EQ(queue.stats().dropped, 1u);
+}
+
+TEST(DispatchQueueTest, AcceptedItemsAreDispatchedWhenStopRacesWithPushes) {
+    constexpr int PRODUCERS = 4;
+    std::atomic<uint64_t> handled{0};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> refused{0};
+    DispatchQueue<int> queue({64, DispatchQueue<int>::Overflow::Drop}, [&](int&) { ++handled; });
+    std::atomic<bool> stopped{false};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&] {
+            // Keeps pushing through stop(); the last push comes after it
+            int i = 0;
+            do {
+                (queue.push(int{i++}) ? accepted : refused)++;
+            } while (!stopped.load());
+        });
+    }
+    std::this_thread::sleep_for(2ms);
+    queue.stop();
+    stopped.store(true);
+    for (auto& producer : producers) producer.join();
+
+    EXPECT_GT(refused.load(), 0u);
+    EXPECT_EQ(handled.load(), accepted.load());
+    EXPECT_EQ(queue.stats().dispatched, accepted.load());
+    EXPECT_EQ(queue.stats().dropped, refused.load());
+}
+
+TEST(DispatchQueueTest, SurvivesThrowingHandlers) {
+    std::atomic<int> handled{0};
+    std::atomic<int> ticks{0};
+    DispatchQueue<int> queue({16, DispatchQueue<int>::Overflow::Drop, 1000ms, 5ms},
+                             [&](int& item) {
+                                 ++handled;
+                                 if (item == 1) throw std::runtime_error("publish failed");
+                                 if (item == 2) throw 42;
+                             },
+                             [&] {
+                                 if (++ticks == 1) throw std::runtime_error("tick failed");
+                             });
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.push(int{i}));
+    std::this_thread::sleep_for(30ms);
+    queue.stop();
+    EXPECT_EQ(handled.load(), 4);
+    EXPECT_GE(ticks.load(), 2);
+}
+
+TEST(DispatchQueueTest, StrictScheduleEmptiesHigherLanesFirst) {
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    std::promise<void> holding;
+    std::vector<int> seen;
+    DispatchQueue<int>::Options options;
+    options.lane_weights = {1, 1};
+    options.schedule = DispatchQueue<int>::Schedule::Strict;
+    DispatchQueue<int> queue(options, [&](int& item) {
+        if (item < 0) {
+            holding.set_value();
+            gate.wait();
+            return;
+        }
+        seen.push_back(item);
+    });
+    queue.push(-1, 1);
+    holding.get_future().wait(); // The dispatch thread is busy; everything below queues up
+
+    for (int i = 0; i < 3; ++i) queue.push(int{100 + i}, 1);
+    for (int i = 0; i < 3; ++i) queue.push(int{i}, 0);
+    release.set_value();
+    queue.stop();
+    EXPECT_EQ(seen, (std::vector<int>{0, 1, 2, 100, 101, 102}));
+    EXPECT_EQ(queue.stats(0).dispatched, 3u);
+    EXPECT_EQ(queue.stats(1).dispatched, 4u);
+}
+
+TEST(DispatchQueueTest, WeightedScheduleSharesByWeight) {
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    std::promise<void> holding;
+    std::vector<int> seen;
+    DispatchQueue<int>::Options options;
+    options.lane_weights = {2, 1};
+    DispatchQueue<int> queue(options, [&](int& item) {
+        if (item < 0) {
+            holding.set_value();
+            gate.wait();
+            return;
+        }
+        seen.push_back(item);
+    });
+    queue.push(-1, 0); // Uses one of lane 0's two turns
+    holding.get_future().wait();
+
+    for (int i = 0; i < 4; ++i) queue.push(int{i}, 0);
+    for (int i = 0; i < 4; ++i) queue.push(int{100 + i}, 1);
+    queue.push(200, 7); // Out of range: goes to the last lane
+    release.set_value();
+    queue.stop();
+    EXPECT_EQ(seen, (std::vector<int>{0, 100, 1, 2, 101, 3, 102, 103, 200}));
+    EXPECT_EQ(queue.laneCount(), 2u);
+}
+
+TEST(DispatchQueueTest, RejectsBadLanes) {
+    DispatchQueue<int>::Options options;
+    options.lane_weights = {};
+    EXPECT_THROW(DispatchQueue<int>(options, [](int&) {}), std::invalid_argument);
+    options.lane_weights = {1, 0};
+    EXPECT_THROW(DispatchQueue<int>(options, [](int&) {}), std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,93 @@
+#include "Executor/mpsc_ring.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace SensorHub::Components {
+
+TEST(MpscRingTest, IsFifoAndBounded) {
+    MpscRing<int> ring(3); // Rounded up to 4
+    EXPECT_EQ(ring.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.tryPush(int{i}));
+    EXPECT_FALSE(ring.tryPush(99));
+    EXPECT_EQ(ring.size(), 4u);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.tryPop(value));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(MpscRingTest, WrapsAround) {
+    MpscRing<int> ring(2);
+    int value = 0;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(ring.tryPush(int{i}));
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(MpscRingTest, MovesValuesAndReleasesSlots) {
+    MpscRing<std::shared_ptr<int>> ring(2);
+    auto shared = std::make_shared<int>(7);
+    std::shared_ptr<int> copy = shared;
+    ASSERT_TRUE(ring.tryPush(std::move(copy)));
+    EXPECT_EQ(shared.use_count(), 2);
+
+    std::shared_ptr<int> out;
+    ASSERT_TRUE(ring.tryPop(out));
+    out.reset();
+    EXPECT_EQ(shared.use_count(), 1); // Nothing left behind in the ring
+
+    // A rejected value stays with the caller
+    ASSERT_TRUE(ring.tryPush(std::make_shared<int>(1)));
+    ASSERT_TRUE(ring.tryPush(std::make_shared<int>(2)));
+    auto rejected = std::make_shared<int>(3);
+    EXPECT_FALSE(ring.tryPush(std::move(rejected)));
+    ASSERT_TRUE(rejected);
+    EXPECT_EQ(*rejected, 3);
+}
+
+TEST(MpscRingTest, KeepsEveryProducersOrder) {
+    constexpr uint64_t PRODUCERS = 4;
+    constexpr uint64_t PER_PRODUCER = 100000;
+    MpscRing<uint64_t> ring(64);
+
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (uint64_t i = 0; i < PER_PRODUCER; ++i) {
+                while (!ring.tryPush(p << 32 | i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<uint64_t> next(PRODUCERS, 0);
+    uint64_t received = 0;
+    uint64_t value = 0;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (!ring.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const uint64_t producer = value >> 32;
+        ASSERT_LT(producer, PRODUCERS);
+        ASSERT_EQ(value & 0xFFFFFFFFu, next[producer]);
+        ++next[producer];
+        ++received;
+    }
+    for (auto& producer : producers) producer.join();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(MpscRingTest, RejectsZeroCapacity) {
+    EXPECT_THROW(MpscRing<int>(0), std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,39 @@
+#include "Executor/token_bucket.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+using namespace std::chrono_literals;
+
+TEST(TokenBucketTest, AllowsABurstThenTheRate) {
+    const auto start = TokenBucket::Clock::now();
+    TokenBucket bucket(10.0, 3.0, start);
+    EXPECT_TRUE(bucket.tryTake(start));
+    EXPECT_TRUE(bucket.tryTake(start));
+    EXPECT_TRUE(bucket.tryTake(start));
+    EXPECT_FALSE(bucket.tryTake(start));
+
+    EXPECT_FALSE(bucket.tryTake(start + 50ms)); // Half a token
+    EXPECT_TRUE(bucket.tryTake(start + 100ms));
+    EXPECT_FALSE(bucket.tryTake(start + 100ms));
+
+    // Idle time refills no further than the burst
+    EXPECT_DOUBLE_EQ(bucket.available(start + 10s), 3.0);
+}
+
+TEST(TokenBucketTest, ClearStartsEmpty) {
+    const auto start = TokenBucket::Clock::now();
+    TokenBucket bucket(2.0, 4.0, start);
+    bucket.clear(start);
+    EXPECT_FALSE(bucket.tryTake(start));
+    EXPECT_TRUE(bucket.tryTake(start + 500ms));
+    EXPECT_FALSE(bucket.tryTake(start + 500ms));
+}
+
+TEST(TokenBucketTest, RejectsBadParameters) {
+    EXPECT_THROW(TokenBucket(0.0, 1.0), std::invalid_argument);
+    EXPECT_THROW(TokenBucket(1.0, 0.5), std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
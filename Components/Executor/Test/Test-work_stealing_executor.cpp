@@ -0,0 +1,108 @@
+#include "Executor/work_stealing_executor.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace SensorHub::Components {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Polls until the condition holds or a generous timeout expires
+template <typename Condition>
+bool eventually(Condition condition) {
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(WorkStealingExecutorTest, IdleWorkersStealFromABusyWorker) {
+    constexpr int CHILDREN = 8;
+    WorkStealingExecutor executor(4);
+    std::atomic<int> done{0};
+    std::mutex mutex;
+    std::vector<std::thread::id> child_threads;
+    std::promise<std::thread::id> parent;
+
+    executor.submit(Stage::Encode, [&] {
+        // Submitted from a worker: the children land on this worker's own deque. It then
+        // stays busy until they are done, so every one of them has to be stolen.
+        for (int i = 0; i < CHILDREN; ++i) {
+            executor.submit(Stage::Encode, [&] {
+                std::this_thread::sleep_for(2ms);
+                const std::lock_guard lock(mutex);
+                child_threads.push_back(std::this_thread::get_id());
+                ++done;
+            });
+        }
+        parent.set_value(std::this_thread::get_id());
+        ASSERT_TRUE(eventually([&] { return done.load() == CHILDREN; }));
+    });
+
+    const auto parent_thread = parent.get_future().get();
+    ASSERT_TRUE(eventually([&] { return done.load() == CHILDREN; }));
+    EXPECT_EQ(executor.stealCount(), static_cast<uint64_t>(CHILDREN));
+    const std::lock_guard lock(mutex);
+    for (const auto& id : child_threads) EXPECT_NE(id, parent_thread);
+}
+
+TEST(WorkStealingExecutorTest, DrainsQueuedAndFollowUpTasksOnShutdown) {
+    std::atomic<int> ran{0};
+    {
+        WorkStealingExecutor executor(2);
+        for (int i = 0; i < 100; ++i) {
+            executor.submit(Stage::Encode, [&] {
+                std::this_thread::sleep_for(50us);
+                ++ran;
+                executor.submit(Stage::Publish, [&] { ++ran; });
+            });
+            executor.submit(Stage::Publish, [&] { ++ran; });
+        }
+    } // Destructor returns only once nothing is queued or running
+    EXPECT_EQ(ran.load(), 300);
+}
+
+TEST(WorkStealingExecutorTest, ReportsStageStatsAndSurvivesThrowingTasks) {
+    WorkStealingExecutor executor(1);
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+
+    executor.submit(Stage::Encode, [gate] { gate.wait(); });
+    executor.submit(Stage::Encode, [] { throw std::runtime_error("encode failure"); });
+    executor.submit(Stage::Encode, [] { throw 42; });
+
+    // The first task blocks the only worker, so the other two wait behind it
+    ASSERT_TRUE(eventually([&] {
+        const auto stats = executor.stats()[static_cast<size_t>(Stage::Encode)];
+        return stats.running == 1 && stats.queued == 2;
+    }));
+    EXPECT_GE(executor.stats()[static_cast<size_t>(Stage::Encode)].max_queued, 2u);
+
+    release.set_value();
+    ASSERT_TRUE(eventually([&] { return executor.stats()[static_cast<size_t>(Stage::Encode)].completed == 3; }));
+    const auto encode = executor.stats()[static_cast<size_t>(Stage::Encode)];
+    EXPECT_EQ(encode.queued, 0u);
+    EXPECT_EQ(encode.running, 0u);
+    EXPECT_EQ(executor.stats()[static_cast<size_t>(Stage::Publish)].completed, 0u);
+}
+
+TEST(WorkStealingExecutorTest, ReportsWorkersAndStageNames) {
+    WorkStealingExecutor executor(3);
+    EXPECT_EQ(executor.workerCount(), 3u);
+    EXPECT_STREQ(stageName(Stage::Encode), "encode");
+    EXPECT_STREQ(stageName(Stage::Publish), "publish");
+    EXPECT_EQ(WorkStealingExecutor(0).workerCount(), 1u);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,328 @@
+#pragma once
+
+#include "Executor/mpsc_ring.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Hands items from any number of threads to one dispatch thread through MpscRings.
+ *
+ * Items go into one of several lanes (one ring each). The dispatch thread takes lane 0
+ * first and lower lanes only when the ones above are empty (Schedule::Strict), or serves
+ * the lanes round robin, up to lane_weights[i] items from lane i per round
+ * (Schedule::Weighted), so a busy lane cannot starve the others.
+ *
+ * push() never takes a lock while the dispatch thread is busy; only when it sleeps with
+ * every ring empty does the producer briefly lock to wake it. A full ring either drops the
+ * item (Overflow::Drop) or makes the producer wait for a slot up to block_timeout before
+ * dropping it (Overflow::Block). Besides the items, the dispatch thread runs on_tick about
+ * every tick_interval, busy or not, for periodic work that belongs on the same thread.
+ * Exceptions from either are logged and do not stop the thread.
+ */
+template <typename T>
+class DispatchQueue {
+public:
+    enum class Overflow { Drop, Block };
+
+    enum class Schedule { Strict, Weighted };
+
+    struct Options {
+        size_t capacity = 1024;                        // Per lane
+        Overflow overflow = Overflow::Drop;
+        std::chrono::milliseconds block_timeout{1000}; // Block: longest wait for a slot
+        std::chrono::milliseconds tick_interval{100};
+        std::vector<unsigned> lane_weights{1};         // One entry per lane, highest priority first
+        Schedule schedule = Schedule::Weighted;
+    };
+
+    struct Stats {
+        size_t depth = 0;         // Queued now
+        size_t high_water = 0;    // Most queued at once (in one lane)
+        uint64_t pushed = 0;
+        uint64_t dispatched = 0;
+        uint64_t dropped = 0;     // Ring full (after waiting, with Overflow::Block) or stopped
+        uint64_t blocked = 0;     // Pushes that had to wait for a slot
+    };
+
+    using Handler = std::function<void(T&)>;
+    using TickHandler = std::function<void()>;
+
+    /**
+     * @brief Starts the dispatch thread.
+     * @param options Lanes, ring size and overflow policy.
+     * @param handler Called on the dispatch thread for each item, in push order per producer and lane.
+     * @param on_tick Optional periodic work on the dispatch thread.
+     * @throws std::invalid_argument if the capacity is 0, there are no lanes or a weight is 0.
+     */
+    DispatchQueue(Options options, Handler handler, TickHandler on_tick = {})
+        : options_(std::move(options)), handler_(std::move(handler)), on_tick_(std::move(on_tick)) {
+        if (options_.lane_weights.empty()) throw std::invalid_argument("DispatchQueue needs at least one lane");
+        for (const unsigned weight : options_.lane_weights) {
+            if (weight == 0) throw std::invalid_argument("DispatchQueue lane weights must be positive");
+            lanes_.push_back(std::make_unique<Lane>(options_.capacity));
+        }
+        credit_ = options_.lane_weights.front();
+        thread_ = std::thread(&DispatchQueue::dispatchLoop, this);
+    }
+
+    /**
+     * @brief Dispatches what is still queued, then joins the thread.
+     */
+    ~DispatchQueue() { stop(); }
+
+    /**
+     * @brief Queues an item for the dispatch thread.
+     * @param lane Lane index, reduced to the last lane if out of range.
+     * @return false if the item was dropped.
+     */
+    bool push(T&& item, size_t lane = 0) {
+        Lane& target = *lanes_[std::min(lane, lanes_.size() - 1)];
+        // stop() drains only after every push() that got past this check has returned, so an
+        // accepted item is always dispatched
+        ProducerScope producer(producers_);
+        if (stopping_.load()) {
+            target.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (!target.ring.tryPush(std::move(item))) {
+            if (options_.overflow == Overflow::Drop || !waitForSlot(target, item)) {
+                target.dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        target.pushed.fetch_add(1, std::memory_order_relaxed);
+        const size_t depth = target.ring.size();
+        size_t high_water = target.high_water.load(std::memory_order_relaxed);
+        while (depth > high_water &&
+               !target.high_water.compare_exchange_weak(high_water, depth, std::memory_order_relaxed)) {
+        }
+
+        // Pairs with the fence in dispatchLoop: either it sees the item or we see it asleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_ = true;
+            wake_cv_.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stops accepting items, dispatches the queued ones and joins the thread.
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stopping_.store(true);
+            wake_ = true;
+        }
+        wake_cv_.notify_one();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    /**
+     * @brief Counters of one lane.
+     */
+    Stats stats(size_t lane) const {
+        const Lane& source = *lanes_.at(lane);
+        Stats stats;
+        stats.depth = source.ring.size();
+        stats.high_water = source.high_water.load(std::memory_order_relaxed);
+        stats.pushed = source.pushed.load(std::memory_order_relaxed);
+        stats.dispatched = source.dispatched.load(std::memory_order_relaxed);
+        stats.dropped = source.dropped.load(std::memory_order_relaxed);
+        stats.blocked = source.blocked.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /**
+     * @brief Counters summed over all lanes (high_water is the largest of the lanes').
+     */
+    Stats stats() const {
+        Stats total;
+        for (size_t lane = 0; lane < lanes_.size(); ++lane) {
+            const Stats one = stats(lane);
+            total.depth += one.depth;
+            total.high_water = std::max(total.high_water, one.high_water);
+            total.pushed += one.pushed;
+            total.dispatched += one.dispatched;
+            total.dropped += one.dropped;
+            total.blocked += one.blocked;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Slots per lane.
+     */
+    size_t capacity() const { return lanes_.front()->ring.capacity(); }
+
+    size_t laneCount() const { return lanes_.size(); }
+
+    // Delete copy/move operations (the dispatch thread refers to this object)
+    DispatchQueue(const DispatchQueue&) = delete;
+    DispatchQueue& operator=(const DispatchQueue&) = delete;
+    DispatchQueue(DispatchQueue&&) = delete;
+    DispatchQueue& operator=(DispatchQueue&&) = delete;
+
+private:
+    struct Lane {
+        explicit Lane(size_t capacity) : ring(capacity) {}
+
+        MpscRing<T> ring;
+        std::atomic<size_t> high_water{0};
+        std::atomic<uint64_t> pushed{0};
+        std::atomic<uint64_t> dispatched{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> blocked{0};
+    };
+
+    // Counts a push() in progress; stop() waits for the count to drop to 0
+    class ProducerScope {
+    public:
+        explicit ProducerScope(std::atomic<size_t>& producers) : producers_(producers) { producers_.fetch_add(1); }
+        ~ProducerScope() { producers_.fetch_sub(1, std::memory_order_release); }
+        ProducerScope(const ProducerScope&) = delete;
+        ProducerScope& operator=(const ProducerScope&) = delete;
+    private:
+        std::atomic<size_t>& producers_;
+    };
+
+    bool waitForSlot(Lane& lane, T& item) {
+        lane.blocked.fetch_add(1, std::memory_order_relaxed);
+        const auto deadline = std::chrono::steady_clock::now() + options_.block_timeout;
+        while (!lane.ring.tryPush(std::move(item))) {
+            if (stopping_.load(std::memory_order_acquire) || std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Takes the next item by the lane schedule (dispatch thread only).
+     */
+    bool popNext(T& item) {
+        if (options_.schedule == Schedule::Strict) {
+            for (auto& lane : lanes_) {
+                if (lane->ring.tryPop(item)) {
+                    lane->dispatched.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+        // Weighted round robin: the current lane keeps the turn while it has credit and items
+        for (size_t visited = 0; visited <= lanes_.size(); ++visited) {
+            Lane& lane = *lanes_[current_];
+            if (credit_ > 0 && lane.ring.tryPop(item)) {
+                --credit_;
+                lane.dispatched.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            current_ = (current_ + 1) % lanes_.size();
+            credit_ = options_.lane_weights[current_];
+        }
+        return false;
+    }
+
+    bool allEmpty() const {
+        for (const auto& lane : lanes_) {
+            if (!lane->ring.empty()) return false;
+        }
+        return true;
+    }
+
+    void dispatch(T& item) {
+        try {
+            handler_(item);
+        } catch (const std::exception& e) {
+            std::cerr << "DispatchQueue Error: Uncaught exception in handler: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "DispatchQueue Error: Unknown exception in handler." << std::endl;
+        }
+    }
+
+    void tick() {
+        try {
+            on_tick_();
+        } catch (const std::exception& e) {
+            std::cerr << "DispatchQueue Error: Uncaught exception in tick: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "DispatchQueue Error: Unknown exception in tick." << std::endl;
+        }
+    }
+
+    void dispatchLoop() {
+        auto next_tick = std::chrono::steady_clock::now() + options_.tick_interval;
+        for (;;) {
+            for (;;) {
+                T item;
+                if (!popNext(item)) break;
+                dispatch(item);
+                if (on_tick_ && std::chrono::steady_clock::now() >= next_tick) break; // Don't starve the tick
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (on_tick_ && now >= next_tick) {
+                tick();
+                next_tick = now + options_.tick_interval;
+            }
+            if (stopping_.load()) {
+                // push() refuses new items now. Drain those that made it in, until no push()
+                // that started before the refusal is left to add one more
+                for (;;) {
+                    const bool quiet = producers_.load(std::memory_order_acquire) == 0;
+                    T item;
+                    while (popNext(item)) {
+                        dispatch(item);
+                        item = T{};
+                    }
+                    if (quiet) return;
+                    std::this_thread::yield();
+                }
+            }
+
+            sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (allEmpty()) {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_cv_.wait_until(lock, next_tick, [this] { return wake_; });
+                wake_ = false;
+            }
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    const Options options_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    Handler handler_;
+    TickHandler on_tick_;
+    size_t current_ = 0;  // Weighted: lane whose turn it is (dispatch thread only)
+    unsigned credit_ = 0; // Weighted: items the current lane may still take this round
+
+    std::atomic<bool> stopping_{false};
+    std::atomic<size_t> producers_{0}; // push() calls in progress
+    std::atomic<bool> sleeping_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    bool wake_ = false; // Guarded by wake_mutex_
+
+    std::thread thread_; // Last: starts after everything above is initialised
+};
+
+} // namespace SensorHub::Components
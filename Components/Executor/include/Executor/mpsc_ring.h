@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Bounded lock-free queue for many producers and one consumer.
+ *
+ * A ring of slots, each with a sequence number (after Dmitry Vyukov's bounded queue):
+ * a producer claims a slot with one compare-and-swap on the tail, moves its value in and
+ * publishes it by bumping the slot's sequence; the consumer takes slots in order without
+ * any read-modify-write. Neither side ever blocks or allocates. Slot values are default
+ * constructed up front and moved from, so T must be default constructible and movable.
+ */
+template <typename T>
+class MpscRing {
+public:
+    /**
+     * @param capacity Number of slots, rounded up to a power of two (at least 2).
+     * @throws std::invalid_argument if capacity is 0.
+     */
+    explicit MpscRing(size_t capacity) {
+        if (capacity == 0) throw std::invalid_argument("MpscRing capacity must be positive");
+        size_t slots = 2;
+        while (slots < capacity) slots <<= 1;
+        mask_ = slots - 1;
+        slots_ = std::make_unique<Slot[]>(slots);
+        for (size_t i = 0; i < slots; ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Appends a value. Safe from any number of threads.
+     * @return false if the ring is full; value is then left untouched.
+     */
+    bool tryPush(T&& value) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[position & mask_];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false; // The consumer has not freed this slot yet
+            } else {
+                position = tail_.load(std::memory_order_relaxed); // Another producer took it
+            }
+        }
+    }
+
+    /**
+     * @brief Takes the oldest value. Only one thread may call this.
+     * @return false if the ring is empty (or the oldest slot is still being written).
+     */
+    bool tryPop(T& out) {
+        const size_t position = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[position & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) return false;
+        out = std::move(slot.value);
+        slot.value = T{}; // Let go of anything the moved-from value still holds
+        slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+        head_.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Number of queued values; a snapshot that may be stale while others push or pop.
+     */
+    size_t size() const {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        return tail > head ? std::min(tail - head, capacity()) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Delete copy/move operations
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+    MpscRing(MpscRing&&) = delete;
+    MpscRing& operator=(MpscRing&&) = delete;
+
+private:
+    // Producers and the consumer touch different cache lines except for the slot they share
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0}; // Next slot to claim (producers)
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0}; // Next slot to take (consumer)
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Executor/work_stealing_executor.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Runs completions in reservation order even when the work producing them
+ * finishes out of order on different threads.
+ *
+ * A producer reserves a ticket when a sample enters the pipeline and later calls
+ * complete() with the final step. Whichever thread completes the oldest outstanding
+ * ticket runs it plus any later tickets that are already waiting.
+ */
+class SequencedLane {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param counters Stage counters updated while completions wait or run (may be null).
+     */
+    explicit SequencedLane(StageCounters* counters = nullptr);
+
+    /**
+     * @brief Reserves the next ticket. Must be called in the order results should be released.
+     */
+    uint64_t reserve();
+
+    /**
+     * @brief Provides the final step for a ticket. An empty task just releases the slot.
+     */
+    void complete(uint64_t ticket, Task task);
+
+    /**
+     * @brief Number of completions waiting for an earlier ticket.
+     */
+    size_t waiting() const;
+
+    // Delete copy/move operations
+    SequencedLane(const SequencedLane&) = delete;
+    SequencedLane& operator=(const SequencedLane&) = delete;
+    SequencedLane(SequencedLane&&) = delete;
+    SequencedLane& operator=(SequencedLane&&) = delete;
+
+private:
+    mutable std::mutex mutex_;
+    std::map<uint64_t, Task> ready_;
+    uint64_t next_reserve_ = 0;
+    uint64_t next_release_ = 0;
+    bool draining_ = false;
+    StageCounters* counters_;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Token-bucket rate limiter: on average rate_per_sec events, in bursts of up to burst.
+ *
+ * The bucket refills continuously at rate_per_sec up to burst tokens; each event takes one.
+ * The caller passes the time in, so the bucket does no clock reads of its own and tests can
+ * drive it. Not thread-safe.
+ */
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param rate_per_sec Refill rate.
+     * @param burst Bucket size; also the number of tokens it starts with.
+     * @param now Start of the refill clock.
+     * @throws std::invalid_argument if rate_per_sec is not positive or burst < 1.
+     */
+    TokenBucket(double rate_per_sec, double burst, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Takes one token if there is one.
+     * @return false if the event is over the rate.
+     */
+    bool tryTake(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Tokens available at now (refills first).
+     */
+    double available(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Empties the bucket; it refills from now on.
+     */
+    void clear(Clock::time_point now = Clock::now());
+
+    double rate() const { return rate_; }
+
+    double burst() const { return burst_; }
+
+private:
+    void refill(Clock::time_point now);
+
+    double rate_;
+    double burst_;
+    double tokens_;
+    Clock::time_point last_;
+};
+
+} // namespace SensorHub::Components
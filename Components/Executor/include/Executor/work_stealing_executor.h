@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Pipeline stages a task can belong to. Used only for queue depth accounting.
+ */
+enum class Stage : uint8_t {
+    Encode = 0, // Payload building and serialization (stealable)
+    Publish,    // Hand-off to the network client (ordered per bus)
+    Count
+};
+
+/**
+ * @brief Returns a short printable name for a stage ("encode", "publish").
+ */
+const char* stageName(Stage stage);
+
+/**
+ * @brief Live counters for one pipeline stage. All fields are updated lock-free.
+ */
+struct StageCounters {
+    std::atomic<size_t> queued{0};      // Tasks waiting to run
+    std::atomic<size_t> running{0};     // Tasks currently executing
+    std::atomic<uint64_t> completed{0}; // Tasks finished since start
+    std::atomic<size_t> max_queued{0};  // High-water mark of 'queued'
+
+    void onQueued();
+    void onStarted();
+    void onFinished();
+};
+
+/**
+ * @brief Point-in-time copy of StageCounters for reporting.
+ */
+struct StageStats {
+    size_t queued = 0;
+    size_t running = 0;
+    uint64_t completed = 0;
+    size_t max_queued = 0;
+};
+
+/**
+ * @brief Small work-stealing thread pool for the per-sample pipeline.
+ *
+ * Each worker owns a stealable deque. Workers pop their own deque LIFO and steal from
+ * the front of other workers' deques when idle. Tasks submitted from outside the pool
+ * go to a shared injection queue. Sensor reads do not run here: they are coroutines on
+ * the Coro::Scheduler, which suspend through conversion delays instead of holding a worker.
+ */
+class WorkStealingExecutor {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Starts the worker threads.
+     * @param num_workers Number of worker threads (at least 1).
+     */
+    explicit WorkStealingExecutor(size_t num_workers);
+
+    /**
+     * @brief Runs all queued tasks (including ones they submit) and joins the workers.
+     */
+    ~WorkStealingExecutor();
+
+    /**
+     * @brief Submits a stealable task. From a worker thread the task goes to that
+     * worker's own deque, otherwise to the injection queue.
+     */
+    void submit(Stage stage, Task task);
+
+    /**
+     * @brief Number of worker threads.
+     */
+    size_t workerCount() const { return workers_.size(); }
+
+    /**
+     * @brief Counters for a stage; also used by SequencedLane to report publish depth.
+     */
+    StageCounters& counters(Stage stage) { return counters_[static_cast<size_t>(stage)]; }
+
+    /**
+     * @brief Snapshot of all stage counters, indexed by Stage.
+     */
+    std::array<StageStats, static_cast<size_t>(Stage::Count)> stats() const;
+
+    /**
+     * @brief Number of tasks stolen from another worker's deque since start.
+     */
+    uint64_t stealCount() const { return steals_.load(std::memory_order_relaxed); }
+
+    // Delete copy/move operations
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor(WorkStealingExecutor&&) = delete;
+    WorkStealingExecutor& operator=(WorkStealingExecutor&&) = delete;
+
+private:
+    struct Item {
+        Stage stage;
+        Task task;
+    };
+
+    struct Worker {
+        std::mutex mutex;          // Guards the queue below
+        std::deque<Item> local;    // Owner pops back, thieves pop front
+        std::thread thread;
+    };
+
+    void workerLoop(size_t index);
+    bool tryPop(size_t index, Item& out);
+    void enqueued(Stage stage);
+    void run(Item& item);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex inject_mutex_;
+    std::deque<Item> inject_;
+
+    // Sleep/wake for idle workers
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+    std::atomic<size_t> pending_{0}; // Queued + running tasks across all queues
+    std::atomic<bool> stopping_{false};
+
+    std::array<StageCounters, static_cast<size_t>(Stage::Count)> counters_;
+    std::atomic<uint64_t> steals_{0};
+};
+
+} // namespace SensorHub::Components
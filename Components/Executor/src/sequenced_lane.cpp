@@ -0,0 +1,68 @@
+#include "Executor/sequenced_lane.h"
+#include <iostream>
+#include <exception>
+
+namespace SensorHub::Components {
+
+namespace {
+// Owns the draining flag for one release loop and clears it on every way out, so a
+// throw cannot leave the lane waiting for a releaser that is gone
+class DrainingGuard {
+public:
+    DrainingGuard(std::unique_lock<std::mutex>& lock, bool& draining) : lock_(lock), draining_(draining) {
+        draining_ = true;
+    }
+    ~DrainingGuard() {
+        if (!lock_.owns_lock()) lock_.lock();
+        draining_ = false;
+    }
+    DrainingGuard(const DrainingGuard&) = delete;
+    DrainingGuard& operator=(const DrainingGuard&) = delete;
+private:
+    std::unique_lock<std::mutex>& lock_;
+    bool& draining_;
+};
+} // namespace
+
+SequencedLane::SequencedLane(StageCounters* counters)
+    : counters_(counters) {}
+
+uint64_t SequencedLane::reserve() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_reserve_++;
+}
+
+void SequencedLane::complete(uint64_t ticket, Task task) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (counters_) counters_->onQueued();
+    ready_.emplace(ticket, std::move(task));
+
+    // Another thread is already releasing this lane; it will pick our entry up
+    if (draining_) return;
+    DrainingGuard guard(lock, draining_);
+
+    for (auto it = ready_.find(next_release_); it != ready_.end(); it = ready_.find(next_release_)) {
+        Task next = std::move(it->second);
+        ready_.erase(it);
+        ++next_release_;
+
+        lock.unlock();
+        if (counters_) counters_->onStarted();
+        try {
+            if (next) next();
+        } catch (const std::exception& e) {
+            std::cerr << "SequencedLane Error: Uncaught exception in completion: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "SequencedLane Error: Unknown exception in completion." << std::endl;
+        }
+        if (counters_) counters_->onFinished();
+        lock.lock();
+    }
+}
+
+size_t SequencedLane::waiting() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ready_.size();
+}
+
+} // namespace SensorHub::Components
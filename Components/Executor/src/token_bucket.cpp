@@ -0,0 +1,37 @@
+#include "Executor/token_bucket.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+TokenBucket::TokenBucket(double rate_per_sec, double burst, Clock::time_point now)
+    : rate_(rate_per_sec), burst_(burst), tokens_(burst), last_(now) {
+    if (!(rate_per_sec > 0.0)) throw std::invalid_argument("TokenBucket rate must be positive");
+    if (!(burst >= 1.0)) throw std::invalid_argument("TokenBucket burst must be at least 1");
+}
+
+bool TokenBucket::tryTake(Clock::time_point now) {
+    refill(now);
+    if (tokens_ < 1.0) return false;
+    tokens_ -= 1.0;
+    return true;
+}
+
+double TokenBucket::available(Clock::time_point now) {
+    refill(now);
+    return tokens_;
+}
+
+void TokenBucket::clear(Clock::time_point now) {
+    tokens_ = 0.0;
+    last_ = now;
+}
+
+void TokenBucket::refill(Clock::time_point now) {
+    if (now <= last_) return;
+    const double elapsed = std::chrono::duration<double>(now - last_).count();
+    tokens_ = std::min(burst_, tokens_ + elapsed * rate_);
+    last_ = now;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,186 @@
+#include "Executor/work_stealing_executor.h"
+#include <iostream>
+#include <exception>
+#include <algorithm>
+#include <chrono>
+
+namespace SensorHub::Components {
+
+namespace {
+// Identifies the executor/worker the current thread belongs to (if any)
+thread_local const WorkStealingExecutor* tls_executor = nullptr;
+thread_local size_t tls_worker_index = 0;
+} // namespace
+
+const char* stageName(Stage stage) {
+    switch (stage) {
+        case Stage::Encode:  return "encode";
+        case Stage::Publish: return "publish";
+        default:             return "unknown";
+    }
+}
+
+// --- StageCounters ---
+
+void StageCounters::onQueued() {
+    size_t depth = queued.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t prev_max = max_queued.load(std::memory_order_relaxed);
+    while (depth > prev_max &&
+           !max_queued.compare_exchange_weak(prev_max, depth, std::memory_order_relaxed)) {
+    }
+}
+
+void StageCounters::onStarted() {
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    running.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StageCounters::onFinished() {
+    running.fetch_sub(1, std::memory_order_relaxed);
+    completed.fetch_add(1, std::memory_order_relaxed);
+}
+
+// --- Constructor / Destructor ---
+
+WorkStealingExecutor::WorkStealingExecutor(size_t num_workers) {
+    num_workers = std::max<size_t>(1, num_workers);
+    workers_.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Start threads only after all workers exist, since they steal from each other
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers_[i]->thread = std::thread([this, i] { workerLoop(i); });
+    }
+    std::cout << "Executor: Started " << num_workers << " worker thread(s)." << std::endl;
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        stopping_.store(true);
+    }
+    idle_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    std::cout << "Executor: Stopped (" << steals_.load() << " steals)." << std::endl;
+}
+
+// --- Public Methods ---
+
+void WorkStealingExecutor::submit(Stage stage, Task task) {
+    counters(stage).onQueued();
+    pending_.fetch_add(1);
+    if (tls_executor == this) {
+        Worker& self = *workers_[tls_worker_index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        self.local.push_back(Item{stage, std::move(task)});
+    } else {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        inject_.push_back(Item{stage, std::move(task)});
+    }
+    enqueued(stage);
+}
+
+std::array<StageStats, static_cast<size_t>(Stage::Count)> WorkStealingExecutor::stats() const {
+    std::array<StageStats, static_cast<size_t>(Stage::Count)> out{};
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i].queued = counters_[i].queued.load(std::memory_order_relaxed);
+        out[i].running = counters_[i].running.load(std::memory_order_relaxed);
+        out[i].completed = counters_[i].completed.load(std::memory_order_relaxed);
+        out[i].max_queued = counters_[i].max_queued.load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+// --- Private Helpers ---
+
+void WorkStealingExecutor::enqueued([[maybe_unused]] Stage stage) {
+    {
+        // Taking the lock orders this wake-up with a worker that is about to sleep
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+    }
+    // Any worker can run it (or steal it)
+    idle_cv_.notify_one();
+}
+
+bool WorkStealingExecutor::tryPop(size_t index, Item& out) {
+    // 1. Own deque (LIFO, cache-warm)
+    {
+        Worker& self = *workers_[index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (!self.local.empty()) {
+            out = std::move(self.local.back());
+            self.local.pop_back();
+            return true;
+        }
+    }
+    // 2. Tasks submitted from outside the pool
+    {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        if (!inject_.empty()) {
+            out = std::move(inject_.front());
+            inject_.pop_front();
+            return true;
+        }
+    }
+    // 3. Steal the oldest stealable task from another worker
+    for (size_t k = 1; k < workers_.size(); ++k) {
+        Worker& victim = *workers_[(index + k) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.local.empty()) {
+            out = std::move(victim.local.front());
+            victim.local.pop_front();
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingExecutor::run(Item& item) {
+    StageCounters& stage_counters = counters(item.stage);
+    stage_counters.onStarted();
+    try {
+        item.task();
+    } catch (const std::exception& e) {
+        std::cerr << "Executor Error: Uncaught exception in " << stageName(item.stage)
+                  << " task: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Executor Error: Unknown exception in " << stageName(item.stage) << " task." << std::endl;
+    }
+    stage_counters.onFinished();
+
+    if (pending_.fetch_sub(1) == 1 && stopping_.load()) {
+        // Last task during shutdown: let sleeping workers observe the drained state
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        idle_cv_.notify_all();
+    }
+}
+
+void WorkStealingExecutor::workerLoop(size_t index) {
+    tls_executor = this;
+    tls_worker_index = index;
+
+    while (true) {
+        Item item;
+        if (tryPop(index, item)) {
+            run(item);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        if (stopping_.load() && pending_.load() == 0) {
+            break;
+        }
+        // Re-check the queues periodically: a steal opportunity does not notify us
+        idle_cv_.wait_for(lock, std::chrono::milliseconds(5));
+    }
+
+    tls_executor = nullptr;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,135 @@
+#include "History/rollup_engine.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using Clock = RollupEngine::Clock;
+using namespace std::chrono_literals;
+
+const Clock::time_point BASE{std::chrono::seconds(1699999200)}; // On a one-hour boundary
+
+struct Emitted {
+    std::string channel;
+    std::string window;
+    int64_t start = 0; // Seconds after BASE
+    std::vector<std::string> fields;
+    std::vector<RollupEngine::Aggregate> aggregates;
+};
+
+class RollupEngineTest : public testing::Test {
+protected:
+    RollupEngineTest() : engine_({RollupEngine::parseWindow("1m"), RollupEngine::parseWindow("1h")}) {}
+
+    void add(Clock::time_point time, double temperature, std::string_view channel = "bme280") {
+        const TimeSeriesStore::Value values[] = {{"temperature", temperature}};
+        engine_.add(channel, time, values, emit_);
+    }
+
+    RollupEngine engine_;
+    std::vector<Emitted> emitted_;
+    RollupEngine::Emit emit_ = [this](const RollupEngine::Rollup& rollup) {
+        emitted_.push_back({std::string(rollup.channel), rollup.window->name,
+                            std::chrono::duration_cast<std::chrono::seconds>(rollup.start - BASE).count(),
+                            {rollup.fields.begin(), rollup.fields.end()},
+                            {rollup.aggregates.begin(), rollup.aggregates.end()}});
+    };
+};
+
+} // namespace
+
+TEST_F(RollupEngineTest, AggregatesWithinAlignedWindows) {
+    for (int i = 0; i < 6; ++i) add(BASE + 10s * i, i + 1); // 1..6 within the first minute
+    EXPECT_TRUE(emitted_.empty());
+
+    add(BASE + 61s, 100);
+    ASSERT_EQ(emitted_.size(), 1u);
+    const auto& minute = emitted_[0];
+    EXPECT_EQ(minute.channel, "bme280");
+    EXPECT_EQ(minute.window, "1m");
+    EXPECT_EQ(minute.start, 0);
+    ASSERT_EQ(minute.fields, std::vector<std::string>{"temperature"});
+    const auto& aggregate = minute.aggregates[0];
+    EXPECT_EQ(aggregate.count, 6u);
+    EXPECT_DOUBLE_EQ(aggregate.min, 1);
+    EXPECT_DOUBLE_EQ(aggregate.max, 6);
+    EXPECT_DOUBLE_EQ(aggregate.sum, 21);
+    EXPECT_DOUBLE_EQ(aggregate.sum_squares, 91);
+    EXPECT_DOUBLE_EQ(aggregate.first, 1);
+    EXPECT_DOUBLE_EQ(aggregate.last, 6);
+    EXPECT_DOUBLE_EQ(aggregate.mean(), 3.5);
+    EXPECT_NEAR(aggregate.variance(), 35.0 / 12.0, 1e-12);
+}
+
+TEST_F(RollupEngineTest, FlushEmitsEndedWindowsOnly) {
+    add(BASE + 30s, 1);
+    add(BASE + 30s, 2, "other");
+    EXPECT_EQ(engine_.flush(BASE + 59s, emit_), 0u);
+    EXPECT_EQ(engine_.flush(BASE + 60s, emit_), 2u); // The minutes of both channels
+    EXPECT_EQ(engine_.flush(BASE + 120s, emit_), 0u);
+    EXPECT_EQ(engine_.flush(BASE + 1h, emit_), 2u);  // Then their hours
+    ASSERT_EQ(emitted_.size(), 4u);
+    EXPECT_EQ(emitted_[0].window, "1m");
+    EXPECT_EQ(emitted_[3].window, "1h");
+    EXPECT_EQ(emitted_[3].aggregates[0].count, 1u);
+
+    // Nothing is emitted twice; the next sample opens fresh windows
+    add(BASE + 1h + 5s, 7);
+    EXPECT_EQ(engine_.flush(BASE + 2h, emit_), 2u);
+    EXPECT_EQ(emitted_.back().start, 3600);
+    EXPECT_DOUBLE_EQ(emitted_.back().aggregates[0].first, 7);
+}
+
+TEST_F(RollupEngineTest, ChangedFieldsEmitOpenWindows) {
+    add(BASE, 1);
+    const TimeSeriesStore::Value two[] = {{"humidity", 50}, {"temperature", 2}};
+    engine_.add("bme280", BASE + 1s, two, emit_);
+    ASSERT_EQ(emitted_.size(), 2u); // Minute and hour under the old fields
+    EXPECT_EQ(emitted_[0].fields.size(), 1u);
+
+    engine_.flush(BASE + 1h, emit_);
+    ASSERT_EQ(emitted_.size(), 4u);
+    EXPECT_EQ(emitted_[2].fields, (std::vector<std::string>{"humidity", "temperature"}));
+    EXPECT_DOUBLE_EQ(emitted_[2].aggregates[0].sum, 50);
+}
+
+TEST_F(RollupEngineTest, SkipsNonFiniteValues) {
+    add(BASE, 1);
+    add(BASE + 1s, std::numeric_limits<double>::quiet_NaN());
+    add(BASE + 2s, std::numeric_limits<double>::infinity());
+    engine_.flush(BASE + 60s, emit_);
+    ASSERT_EQ(emitted_.size(), 1u);
+    EXPECT_EQ(emitted_[0].aggregates[0].count, 1u);
+    EXPECT_DOUBLE_EQ(emitted_[0].aggregates[0].sum, 1);
+}
+
+TEST_F(RollupEngineTest, FlattensIntoHistoryValues) {
+    add(BASE, 2);
+    add(BASE + 1s, 4);
+    std::vector<std::string> names;
+    std::vector<TimeSeriesStore::Value> values;
+    engine_.flush(BASE + 60s, [&](const RollupEngine::Rollup& rollup) { RollupEngine::toValues(rollup, names, values); });
+    ASSERT_EQ(values.size(), std::size(RollupEngine::STATISTICS));
+    EXPECT_EQ(values[0].name, "temperature.count");
+    EXPECT_DOUBLE_EQ(values[0].value, 2);
+    EXPECT_EQ(values[4].name, "temperature.sum_squares");
+    EXPECT_DOUBLE_EQ(values[4].value, 20);
+}
+
+TEST(RollupEngineWindows, ParsesAndValidates) {
+    EXPECT_EQ(RollupEngine::parseWindow("30s").length, 30s);
+    EXPECT_EQ(RollupEngine::parseWindow("15m").length, 15min);
+    EXPECT_EQ(RollupEngine::parseWindow("1d").length, 24h);
+    EXPECT_EQ(RollupEngine::parseWindow("1h").name, "1h");
+    for (const char* text : {"", "m", "0m", "-1m", "1w", "1 m", "1mm"}) {
+        EXPECT_THROW(RollupEngine::parseWindow(text), std::invalid_argument) << text;
+    }
+    EXPECT_THROW(RollupEngine({}), std::invalid_argument);
+    EXPECT_THROW(RollupEngine({RollupEngine::parseWindow("1m"), RollupEngine::parseWindow("1m")}), std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,256 @@
+#include "History/time_series_store.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <sys/resource.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using Clock = TimeSeriesStore::Clock;
+using namespace std::chrono_literals;
+
+const Clock::time_point BASE{std::chrono::seconds(1700000000)}; // On a segment window boundary
+
+class TimeSeriesStoreTest : public testing::Test {
+protected:
+    void SetUp() override {
+        const auto* test = testing::UnitTest::GetInstance()->current_test_info();
+        options_.directory = std::filesystem::temp_directory_path() / ("time_series_store_" + std::string(test->name()));
+        std::filesystem::remove_all(options_.directory);
+        options_.segment_bytes = 64 * 1024;
+        options_.max_bytes = 8 * 64 * 1024;
+        options_.block_points = 4;
+    }
+
+    void TearDown() override { std::filesystem::remove_all(options_.directory); }
+
+    static void appendReading(TimeSeriesStore& store, Clock::time_point time, double value) {
+        const TimeSeriesStore::Value values[] = {{"humidity", 2 * value}, {"temperature", value}};
+        store.append("bme280", time, values);
+    }
+
+    // Timestamps (seconds after BASE) and temperatures of a scan
+    static std::vector<std::pair<int64_t, double>> points(const TimeSeriesStore& store, Clock::time_point from,
+                                                          Clock::time_point to) {
+        std::vector<std::pair<int64_t, double>> result;
+        store.scan("bme280", from, to, [&](const TimeSeriesStore::BlockView& view) {
+            EXPECT_EQ(view.channel, "bme280");
+            EXPECT_EQ(view.fields.size(), 2u);
+            for (size_t i = 0; i < view.timestamps_ns.size(); ++i) {
+                const auto offset = Clock::time_point(std::chrono::nanoseconds(view.timestamps_ns[i])) - BASE;
+                EXPECT_DOUBLE_EQ(view.column(0)[i], 2 * view.column(1)[i]);
+                result.emplace_back(std::chrono::duration_cast<std::chrono::seconds>(offset).count(), view.column(1)[i]);
+            }
+            return true;
+        });
+        return result;
+    }
+
+    size_t segmentFiles() const {
+        size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(options_.directory)) {
+            if (entry.path().extension() == ".tss") ++count;
+        }
+        return count;
+    }
+
+    TimeSeriesStore::Options options_;
+};
+
+} // namespace
+
+TEST_F(TimeSeriesStoreTest, ScansWrittenAndBufferedPointsInRange) {
+    TimeSeriesStore store(options_);
+    for (int i = 0; i < 10; ++i) appendReading(store, BASE + std::chrono::seconds(i), i);
+    EXPECT_EQ(store.stats().points, 10u);
+    EXPECT_EQ(store.stats().blocks, 2u); // The last two points are still buffered
+
+    const auto all = points(store, BASE, BASE + 1h);
+    ASSERT_EQ(all.size(), 10u);
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(all[i], std::make_pair(int64_t{i}, double(i)));
+
+    EXPECT_EQ(points(store, BASE + 3s, BASE + 8s),
+              (std::vector<std::pair<int64_t, double>>{{3, 3}, {4, 4}, {5, 5}, {6, 6}, {7, 7}, {8, 8}}));
+    EXPECT_TRUE(points(store, BASE + 20s, BASE + 1h).empty());
+    EXPECT_TRUE(points(store, BASE - 1h, BASE - 1s).empty());
+
+    size_t views = 0;
+    EXPECT_EQ(store.scan("bme280", BASE + 1s, BASE + 1h, [&](const TimeSeriesStore::BlockView&) { return ++views < 2; }), 7u);
+    EXPECT_EQ(views, 2u);
+    EXPECT_EQ(store.scan("other", BASE, BASE + 1h, [](const TimeSeriesStore::BlockView&) { return true; }), 0u);
+}
+
+TEST_F(TimeSeriesStoreTest, StartsANewBlockWhenFieldsChange) {
+    TimeSeriesStore store(options_);
+    const TimeSeriesStore::Value one[] = {{"a", 1}};
+    const TimeSeriesStore::Value two[] = {{"a", 2}, {"b", 3}};
+    store.append("dummy", BASE, one);
+    store.append("dummy", BASE + 1s, two);
+    store.append("dummy", BASE + 2s, {}); // Nothing numeric: ignored
+    EXPECT_EQ(store.stats().blocks, 1u);
+
+    std::vector<size_t> field_counts;
+    store.scan("dummy", BASE, BASE + 1h, [&](const TimeSeriesStore::BlockView& view) {
+        field_counts.push_back(view.fields.size());
+        EXPECT_EQ(view.column(0)[0], field_counts.size());
+        return true;
+    });
+    EXPECT_EQ(field_counts, (std::vector<size_t>{1, 2}));
+}
+
+TEST_F(TimeSeriesStoreTest, ReopensSegmentsReadOnly) {
+    {
+        TimeSeriesStore store(options_);
+        for (int i = 0; i < 6; ++i) appendReading(store, BASE + std::chrono::seconds(i), i);
+        EXPECT_TRUE(store.sync(BASE + 10s, true));
+    }
+    // Truncated to its data when closed
+    EXPECT_LT(std::filesystem::file_size(options_.directory / "0000000000000000.tss"), options_.segment_bytes);
+
+    TimeSeriesStore store(options_);
+    EXPECT_EQ(points(store, BASE, BASE + 1h).size(), 6u);
+    appendReading(store, BASE + 6s, 6);
+    EXPECT_TRUE(store.sync(BASE + 10s, true));
+    EXPECT_EQ(points(store, BASE, BASE + 1h).size(), 7u);
+    EXPECT_EQ(store.stats().segments, 2u);
+    EXPECT_EQ(segmentFiles(), 2u);
+}
+
+TEST_F(TimeSeriesStoreTest, StopsAtATornRecord) {
+    {
+        TimeSeriesStore store(options_);
+        for (int i = 0; i < 8; ++i) appendReading(store, BASE + std::chrono::seconds(i), i);
+    }
+    {
+        // Flip the last value of the second block
+        const auto path = options_.directory / "0000000000000000.tss";
+        const auto size = std::filesystem::file_size(path);
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(size) - 1);
+        file.put('\x55');
+    }
+    TimeSeriesStore store(options_);
+    EXPECT_EQ(points(store, BASE, BASE + 1h).size(), 4u);
+}
+
+TEST_F(TimeSeriesStoreTest, RollsSegmentsPerWindowAndAppliesRetention) {
+    options_.segment_window = 60s;
+    options_.block_points = 1;
+    options_.max_age = 100s;
+    TimeSeriesStore store(options_);
+    for (int seconds : {0, 30, 60, 120}) appendReading(store, BASE + std::chrono::seconds(seconds), seconds);
+    EXPECT_EQ(store.stats().segments, 3u);
+
+    EXPECT_TRUE(store.sync(BASE + 150s));
+    EXPECT_EQ(store.stats().segments, 2u); // The first window's newest point is 120s old
+    EXPECT_EQ(store.stats().dropped_segments, 1u);
+    EXPECT_EQ(points(store, BASE, BASE + 1h), (std::vector<std::pair<int64_t, double>>{{60, 60}, {120, 120}}));
+}
+
+TEST_F(TimeSeriesStoreTest, StaysWithinMaxBytes) {
+    options_.max_bytes = 2 * options_.segment_bytes;
+    options_.block_points = 256;
+    TimeSeriesStore store(options_);
+    for (int i = 0; i < 20000; ++i) appendReading(store, BASE + std::chrono::seconds(i), i);
+
+    const auto stats = store.stats();
+    EXPECT_LE(stats.disk_bytes, options_.max_bytes);
+    EXPECT_GT(stats.dropped_segments, 0u);
+    EXPECT_EQ(stats.dropped_points, 0u);
+    const auto kept = points(store, BASE, BASE + 10h);
+    ASSERT_FALSE(kept.empty());
+    EXPECT_EQ(kept.back().first, 19999); // Oldest dropped first
+}
+
+TEST_F(TimeSeriesStoreTest, KeepsMoreSegmentsThanOpenFilesAllow) {
+    // Lowers the soft limit on open files for the test
+    struct FileLimit {
+        rlimit saved{};
+        explicit FileLimit(rlim_t files) {
+            ::getrlimit(RLIMIT_NOFILE, &saved);
+            rlimit lowered = saved;
+            lowered.rlim_cur = std::min(saved.rlim_cur, files);
+            ::setrlimit(RLIMIT_NOFILE, &lowered);
+        }
+        ~FileLimit() { ::setrlimit(RLIMIT_NOFILE, &saved); }
+    } limit(64);
+
+    options_.segment_window = 1s;
+    options_.block_points = 1;
+    options_.max_bytes = 1024 * options_.segment_bytes;
+    const size_t segments = 200;
+    {
+        TimeSeriesStore store(options_);
+        for (size_t i = 0; i < segments; ++i) appendReading(store, BASE + std::chrono::seconds(i), static_cast<double>(i));
+        EXPECT_TRUE(store.sync(BASE + 1h, true));
+        EXPECT_EQ(store.stats().segments, segments);
+        EXPECT_EQ(store.stats().dropped_points, 0u);
+    }
+    // Reopening maps every segment again
+    TimeSeriesStore store(options_);
+    EXPECT_EQ(store.stats().segments, segments);
+    EXPECT_EQ(points(store, BASE, BASE + 1h).size(), segments);
+    appendReading(store, BASE + 1h, 1);
+    EXPECT_TRUE(store.sync(BASE + 2h, true));
+    EXPECT_EQ(store.stats().dropped_points, 0u);
+}
+
+TEST_F(TimeSeriesStoreTest, ScansLongRangesAcrossBatchesAndSegments) {
+    options_.segment_window = 100s;
+    options_.block_points = 1;
+    options_.max_bytes = 32 * options_.segment_bytes;
+    options_.max_age = 300s;
+    TimeSeriesStore store(options_);
+    for (int i = 0; i < 1000; ++i) appendReading(store, BASE + std::chrono::seconds(i), i);
+    EXPECT_EQ(store.stats().segments, 10u);
+
+    const auto all = points(store, BASE, BASE + 1h);
+    ASSERT_EQ(all.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(all[i].first, i);
+
+    // Part by part like /api/range: a few blocks per scan, resuming after the last point
+    std::vector<int64_t> parts;
+    for (Clock::time_point next = BASE;;) {
+        size_t views = 0;
+        const size_t visited = store.scan("bme280", next, BASE + 1h, [&](const TimeSeriesStore::BlockView& view) {
+            parts.push_back((view.timestamps_ns.back() - BASE.time_since_epoch().count()) / 1000000000);
+            next = Clock::time_point(std::chrono::nanoseconds(view.timestamps_ns.back() + 1));
+            return ++views < 10;
+        });
+        if (visited == 0) break;
+    }
+    ASSERT_EQ(parts.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(parts[i], i);
+
+    // Segments dropped while a scan is under way are skipped, the rest of the range still follows
+    std::vector<int64_t> seen;
+    store.scan("bme280", BASE, BASE + 1h, [&](const TimeSeriesStore::BlockView& view) {
+        if (seen.empty()) {
+            EXPECT_TRUE(store.sync(BASE + 1000s)); // Drops the windows before 700s
+        }
+        seen.push_back((view.timestamps_ns[0] - BASE.time_since_epoch().count()) / 1000000000);
+        return true;
+    });
+    EXPECT_EQ(store.stats().segments, 3u);
+    ASSERT_FALSE(seen.empty());
+    EXPECT_EQ(seen.front(), 0);
+    EXPECT_TRUE(std::is_sorted(seen.begin(), seen.end()));
+    EXPECT_EQ(std::count_if(seen.begin(), seen.end(), [](int64_t second) { return second >= 700; }), 300);
+}
+
+TEST_F(TimeSeriesStoreTest, RejectsUnusableOptions) {
+    auto options = options_;
+    options.segment_bytes = 4096;
+    EXPECT_THROW(TimeSeriesStore{options}, std::invalid_argument);
+    options = options_;
+    options.max_bytes = options.segment_bytes;
+    EXPECT_THROW(TimeSeriesStore{options}, std::invalid_argument);
+    options = options_;
+    options.block_points = 70000;
+    EXPECT_THROW(TimeSeriesStore{options}, std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "History/time_series_store.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Incremental rollups of sensor readings over fixed windows (e.g. one minute and
+ * one hour): per channel and field, the count, min, max, sum, sum of squares, first and
+ * last value.
+ *
+ * Windows are aligned to wall-clock multiples of their length since the Unix epoch, so
+ * every device and every restart agree on their boundaries. A sample costs one update
+ * per field and window, with no allocation once a channel's fields are known. A window
+ * is emitted when a sample of the same channel falls outside it, or by flush() once its
+ * end has passed; a channel whose set of fields changes emits its open windows first.
+ * Windows still open at shutdown are not emitted.
+ *
+ * The aggregates merge: sums and counts add, min and max combine, so a range of stored
+ * one-minute rollups yields the exact mean, variance and extremes of the raw readings.
+ * Not thread-safe: keep one instance per thread.
+ */
+class RollupEngine {
+public:
+    using Clock = std::chrono::system_clock;
+
+    struct Window {
+        std::string name;             // "1m", "1h": topic level and history channel suffix
+        std::chrono::seconds length{0};
+    };
+
+    /**
+     * @brief Running statistics of one field within one window.
+     */
+    struct Aggregate {
+        uint64_t count = 0;
+        double min = 0.0;
+        double max = 0.0;
+        double sum = 0.0;
+        double sum_squares = 0.0;
+        double first = 0.0;
+        double last = 0.0;
+
+        void add(double value) {
+            if (count == 0) {
+                min = max = first = value;
+            } else {
+                if (value < min) min = value;
+                if (value > max) max = value;
+            }
+            last = value;
+            sum += value;
+            sum_squares += value * value;
+            ++count;
+        }
+
+        /**
+         * @brief Combines the aggregate of a later stretch of the same field into this one.
+         */
+        void merge(const Aggregate& later) {
+            if (later.count == 0) return;
+            if (count == 0) {
+                *this = later;
+                return;
+            }
+            if (later.min < min) min = later.min;
+            if (later.max > max) max = later.max;
+            last = later.last;
+            sum += later.sum;
+            sum_squares += later.sum_squares;
+            count += later.count;
+        }
+
+        double mean() const { return count ? sum / static_cast<double>(count) : 0.0; }
+
+        /**
+         * @brief Population variance, clamped at zero against rounding.
+         */
+        double variance() const;
+    };
+
+    /**
+     * @brief A finished window of one channel. Valid during the emit callback only.
+     */
+    struct Rollup {
+        std::string_view channel;
+        const Window* window = nullptr;
+        Clock::time_point start;               // The window ends at start + window->length
+        std::span<const std::string> fields;
+        std::span<const Aggregate> aggregates; // One per field; a field without finite values has count 0
+    };
+
+    using Emit = std::function<void(const Rollup&)>;
+
+    /**
+     * @brief Names of the per-field history columns written by toValues(), in order.
+     */
+    static constexpr std::string_view STATISTICS[] = {"count", "min", "max", "sum", "sum_squares", "first", "last"};
+
+    /**
+     * @throws std::invalid_argument if there are no windows, a length is not positive or
+     * a name repeats.
+     */
+    explicit RollupEngine(std::vector<Window> windows);
+
+    // Delete copy/move operations
+    RollupEngine(const RollupEngine&) = delete;
+    RollupEngine& operator=(const RollupEngine&) = delete;
+    RollupEngine(RollupEngine&&) = delete;
+    RollupEngine& operator=(RollupEngine&&) = delete;
+
+    /**
+     * @brief Parses a window such as "30s", "1m", "15m", "1h" or "1d"; the text becomes its name.
+     * @throws std::invalid_argument if the text is not a positive count and one of s, m, h, d.
+     */
+    static Window parseWindow(std::string_view text);
+
+    /**
+     * @brief Adds a reading of the channel to every window. A sample outside a channel's
+     * open window (a later one, or an earlier one after the clock stepped back) emits it
+     * and opens the sample's window. Non-finite values are skipped.
+     */
+    void add(std::string_view channel, Clock::time_point time, std::span<const TimeSeriesStore::Value> values,
+             const Emit& emit);
+
+    /**
+     * @brief Emits every open window that ended at or before now.
+     * @return Windows emitted.
+     */
+    size_t flush(Clock::time_point now, const Emit& emit);
+
+    /**
+     * @brief Flattens a rollup into history values "<field>.<statistic>", one per field and
+     * STATISTICS entry, for TimeSeriesStore::append(). names holds the strings the values
+     * refer to.
+     */
+    static void toValues(const Rollup& rollup, std::vector<std::string>& names,
+                         std::vector<TimeSeriesStore::Value>& values);
+
+    const std::vector<Window>& windows() const { return windows_; }
+
+private:
+    struct OpenWindow {
+        int64_t start_ns = 0;
+        bool open = false;
+        std::vector<Aggregate> aggregates; // One per channel field
+    };
+
+    struct Channel {
+        std::vector<std::string> fields;
+        std::vector<OpenWindow> windows;   // One per engine window
+    };
+
+    void emitWindow(std::string_view name, Channel& channel, size_t window, const Emit& emit);
+    static bool sameFields(const Channel& channel, std::span<const TimeSeriesStore::Value> values);
+
+    std::vector<Window> windows_;
+    std::vector<int64_t> lengths_ns_;
+    std::map<std::string, Channel, std::less<>> channels_;
+    int64_t next_end_ns_ = INT64_MAX; // Earliest end of an open window: flush() has nothing to do before it
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "StoreForward/segment_file.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Embedded history of sensor readings on local storage: append-only, segmented by
+ * time window, memory-mapped, with a columnar layout per channel.
+ *
+ * A channel is a named series (usually a sensor's topic suffix) of points: a timestamp
+ * and the numeric fields of one reading. Points are buffered per channel and written as
+ * one block once block_points have gathered, or by sync() once the oldest is block_age
+ * old. A block holds the timestamps, then one column per field, each an 8-byte aligned
+ * array, so scans read them straight from the mapping. A channel whose set of fields
+ * changes starts a new block.
+ *
+ * Each segment is a preallocated file <sequence>.tss (16 hex digits) for one
+ * segment_window of wall-clock time; a full segment continues in a new file. It holds a
+ * 64-byte header, then records back to back, each starting with a 32-byte header
+ * (length, CRC-32 of the body, type, channel id, field and point counts, time range).
+ * A channel record gives a segment-local channel id its name and field names, so every
+ * segment can be read on its own; a block record holds the points. As in SegmentQueue
+ * the length goes in last and records are checked when a segment is opened, so a torn
+ * write reads as the end of its segment. A segment is truncated to its data when the
+ * next one starts. Reopened segments are read-only; new blocks go to a fresh segment.
+ * Everything is in host byte order.
+ *
+ * The time index is sparse: one entry per block (channel, first and last timestamp,
+ * offset), kept in memory and rebuilt at open by walking the records. A range scan
+ * finds its first block with a binary search and visits the columns in place, holding
+ * the lock only to gather the next few dozen blocks.
+ *
+ * Retention drops whole segments, oldest first, once they would outgrow max_bytes or
+ * when a segment's newest point is older than max_age. Blocks only reach the page cache
+ * until sync() forces them to storage, so syncing on an interval writes each SD card
+ * page once instead of once per reading. Points still buffered are lost on a crash.
+ * Thread-safe; scans run outside the lock, on mappings kept alive until they finish.
+ */
+class TimeSeriesStore {
+public:
+    using Clock = std::chrono::system_clock;
+
+    struct Options {
+        std::filesystem::path directory{"history"};
+        std::chrono::seconds segment_window{3600}; // Wall-clock span of one segment
+        size_t segment_bytes = 4 << 20;            // Preallocated size of each segment file
+        size_t max_bytes = 256 << 20;              // Bound on all segments together, at least two segments
+        std::chrono::seconds max_age{0};           // Drop segments whose newest point is older (0 = no age limit)
+        size_t block_points = 256;                 // Points per block, 1 to 65535
+        std::chrono::seconds block_age{60};        // sync() writes buffered points at least this old
+    };
+
+    /**
+     * @brief One numeric member of a reading.
+     */
+    struct Value {
+        std::string_view name;
+        double value = 0.0;
+    };
+
+    /**
+     * @brief Consecutive points of one channel within the scanned range, in place.
+     */
+    struct BlockView {
+        std::string_view channel;
+        std::span<const std::string> fields;
+        std::span<const int64_t> timestamps_ns; // Since the Unix epoch
+
+        /**
+         * @brief Values of fields[field], one per timestamp.
+         */
+        std::span<const double> column(size_t field) const {
+            return {columns + field * stride, timestamps_ns.size()};
+        }
+
+        const double* columns = nullptr; // First value of the first column
+        size_t stride = 0;               // Distance between columns
+    };
+
+    /**
+     * @brief A channel with points in the store, and the time range they cover.
+     */
+    struct ChannelInfo {
+        std::string name;
+        Clock::time_point first;
+        Clock::time_point last;
+    };
+
+    struct Stats {
+        uint64_t points = 0;           // Appended since open
+        uint64_t blocks = 0;           // Written since open
+        uint64_t dropped_points = 0;   // Could not be written (no segment)
+        uint64_t dropped_segments = 0; // Removed by retention since open
+        size_t segments = 0;
+        size_t disk_bytes = 0;
+    };
+
+    /**
+     * @brief Opens the store in options.directory (created if missing) and indexes its segments.
+     * @throws std::invalid_argument if segment_bytes is below 64 KiB, max_bytes holds fewer
+     * than two segments, segment_window is not positive or block_points is out of range.
+     * @throws std::runtime_error if the directory or a segment cannot be opened.
+     */
+    explicit TimeSeriesStore(Options options);
+
+    /**
+     * @brief Truncates the open segment and unmaps. Buffered points are not written; call
+     * sync() with all set first.
+     */
+    ~TimeSeriesStore();
+
+    // Delete copy/move operations
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+    TimeSeriesStore(TimeSeriesStore&&) = delete;
+    TimeSeriesStore& operator=(TimeSeriesStore&&) = delete;
+
+    /**
+     * @brief Adds a point to the channel's buffer, and writes the buffer as a block once
+     * it holds block_points. A reading without values is ignored. Points of a channel are
+     * expected in time order; scans skip points appended out of order.
+     */
+    void append(std::string_view channel, Clock::time_point timestamp, std::span<const Value> values);
+
+    /**
+     * @brief Writes buffers whose oldest point is block_age old (all buffers if all is set),
+     * applies max_age, and forces what was written since the last sync to storage.
+     * @return false if forcing a segment to storage failed.
+     */
+    bool sync(Clock::time_point now = Clock::now(), bool all = false);
+
+    /**
+     * @brief Visits the channel's points in [from, to], oldest first: written blocks, then
+     * points still buffered. Blocks are gathered in batches, so a scan that ends early
+     * costs the blocks it visited, not the whole range.
+     * @param visit Returns false to end the scan early. Runs without the store's lock.
+     * @return Points visited.
+     */
+    size_t scan(std::string_view channel, Clock::time_point from, Clock::time_point to,
+                const std::function<bool(const BlockView&)>& visit) const;
+
+    /**
+     * @brief Every channel with written or buffered points, by name.
+     */
+    std::vector<ChannelInfo> channels() const;
+
+    Stats stats() const;
+
+    const Options& options() const { return options_; }
+
+private:
+    struct ChannelDef {
+        std::string name;
+        std::vector<std::string> fields;
+    };
+
+    struct BlockRef {
+        uint16_t channel = 0; // Segment-local id
+        uint16_t points = 0;
+        int64_t first_ns = 0;
+        int64_t last_ns = 0;
+        size_t offset = 0;    // Of the record header
+    };
+
+    struct Segment {
+        uint64_t sequence = 0;
+        SegmentFile file;        // Mapped whole; no file descriptor stays open
+        size_t file_bytes = 0;   // On disk: the mapped size, or the data once truncated
+        size_t write_offset = 0; // End of the last complete record
+        int64_t window_start_ns = 0;
+        int64_t first_ns = INT64_MAX; // Time range of all blocks
+        int64_t last_ns = INT64_MIN;
+        bool sealed = false;
+        bool dirty = false;
+        std::vector<std::shared_ptr<const ChannelDef>> channels; // By id
+        std::map<std::string, std::vector<BlockRef>, std::less<>> index; // Per channel name, in write order
+    };
+
+    struct Buffer {
+        std::vector<std::string> fields;
+        std::vector<int64_t> timestamps_ns;
+        std::vector<double> values; // Point by point
+    };
+
+    void recover();
+    std::shared_ptr<Segment> openRecovered(uint64_t sequence);
+    Segment* openSegment(int64_t window_start_ns);
+    void seal(Segment& segment);
+    void dropSegment(size_t position);
+    void writeBuffer(const std::string& channel, Buffer& buffer);
+    uint16_t writeChannel(Segment& segment, const std::string& channel, const std::vector<std::string>& fields);
+    void writeBlock(Segment& segment, uint16_t channel_id, const Buffer& buffer, size_t first, size_t count);
+    std::filesystem::path segmentPath(uint64_t sequence) const;
+
+    Options options_;
+    int64_t window_ns_;
+    std::deque<std::shared_ptr<Segment>> segments_; // Oldest first; only the last may be open
+    std::map<std::string, Buffer, std::less<>> buffers_;
+    uint64_t next_sequence_ = 0;
+    size_t disk_bytes_ = 0;
+    bool directory_dirty_ = false;
+    Stats stats_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace SensorHub::Components
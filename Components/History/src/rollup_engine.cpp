@@ -0,0 +1,148 @@
+#include "History/rollup_engine.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+namespace {
+
+// Start of the window of the given length that contains time_ns (floor, also before the epoch)
+int64_t windowStart(int64_t time_ns, int64_t length_ns) {
+    int64_t start = time_ns - time_ns % length_ns;
+    if (start > time_ns) start -= length_ns;
+    return start;
+}
+
+} // namespace
+
+double RollupEngine::Aggregate::variance() const {
+    if (count == 0) return 0.0;
+    const double n = static_cast<double>(count);
+    const double mean_value = sum / n;
+    return std::max(0.0, sum_squares / n - mean_value * mean_value);
+}
+
+RollupEngine::RollupEngine(std::vector<Window> windows) : windows_(std::move(windows)) {
+    if (windows_.empty()) throw std::invalid_argument("At least one rollup window is required.");
+    for (size_t i = 0; i < windows_.size(); ++i) {
+        if (windows_[i].length.count() <= 0) {
+            throw std::invalid_argument("Rollup window '" + windows_[i].name + "' must be positive.");
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (windows_[j].name == windows_[i].name) {
+                throw std::invalid_argument("Rollup window '" + windows_[i].name + "' is listed twice.");
+            }
+        }
+        lengths_ns_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(windows_[i].length).count());
+    }
+}
+
+RollupEngine::Window RollupEngine::parseWindow(std::string_view text) {
+    int64_t count = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), count);
+    if (error != std::errc{} || count <= 0 || end + 1 != text.data() + text.size()) {
+        throw std::invalid_argument("Rollup window '" + std::string(text) + "' is not like \"1m\" or \"1h\".");
+    }
+    int64_t unit = 0;
+    switch (*end) {
+        case 's': unit = 1; break;
+        case 'm': unit = 60; break;
+        case 'h': unit = 3600; break;
+        case 'd': unit = 86400; break;
+        default:
+            throw std::invalid_argument("Rollup window '" + std::string(text) + "' needs a unit of s, m, h or d.");
+    }
+    return Window{std::string(text), std::chrono::seconds(count * unit)};
+}
+
+bool RollupEngine::sameFields(const Channel& channel, std::span<const TimeSeriesStore::Value> values) {
+    if (channel.fields.size() != values.size()) return false;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (channel.fields[i] != values[i].name) return false;
+    }
+    return true;
+}
+
+void RollupEngine::add(std::string_view channel_name, Clock::time_point time,
+                       std::span<const TimeSeriesStore::Value> values, const Emit& emit) {
+    if (values.empty()) return;
+    auto it = channels_.find(channel_name);
+    if (it == channels_.end()) {
+        it = channels_.emplace(std::string(channel_name), Channel{}).first;
+        it->second.windows.resize(windows_.size());
+    }
+    Channel& channel = it->second;
+    if (!sameFields(channel, values)) {
+        // Aggregates are per field position: finish what was gathered under the old fields
+        for (size_t w = 0; w < windows_.size(); ++w) {
+            if (channel.windows[w].open) emitWindow(it->first, channel, w, emit);
+        }
+        channel.fields.clear();
+        for (const auto& value : values) channel.fields.emplace_back(value.name);
+        for (auto& window : channel.windows) window.aggregates.assign(values.size(), Aggregate{});
+    }
+
+    const int64_t time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    for (size_t w = 0; w < windows_.size(); ++w) {
+        OpenWindow& window = channel.windows[w];
+        const int64_t start_ns = windowStart(time_ns, lengths_ns_[w]);
+        if (window.open && window.start_ns != start_ns) emitWindow(it->first, channel, w, emit);
+        if (!window.open) {
+            window.open = true;
+            window.start_ns = start_ns;
+            next_end_ns_ = std::min(next_end_ns_, start_ns + lengths_ns_[w]);
+        }
+        for (size_t f = 0; f < values.size(); ++f) {
+            if (std::isfinite(values[f].value)) window.aggregates[f].add(values[f].value);
+        }
+    }
+}
+
+size_t RollupEngine::flush(Clock::time_point now, const Emit& emit) {
+    const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    if (now_ns < next_end_ns_) return 0;
+    size_t emitted = 0;
+    next_end_ns_ = INT64_MAX;
+    for (auto& [name, channel] : channels_) {
+        for (size_t w = 0; w < windows_.size(); ++w) {
+            if (!channel.windows[w].open) continue;
+            const int64_t end_ns = channel.windows[w].start_ns + lengths_ns_[w];
+            if (end_ns <= now_ns) {
+                emitWindow(name, channel, w, emit);
+                ++emitted;
+            } else {
+                next_end_ns_ = std::min(next_end_ns_, end_ns);
+            }
+        }
+    }
+    return emitted;
+}
+
+void RollupEngine::emitWindow(std::string_view name, Channel& channel, size_t window, const Emit& emit) {
+    OpenWindow& open = channel.windows[window];
+    emit(Rollup{name, &windows_[window], Clock::time_point(std::chrono::nanoseconds(open.start_ns)), channel.fields,
+                open.aggregates});
+    open.open = false;
+    std::fill(open.aggregates.begin(), open.aggregates.end(), Aggregate{});
+}
+
+void RollupEngine::toValues(const Rollup& rollup, std::vector<std::string>& names,
+                            std::vector<TimeSeriesStore::Value>& values) {
+    constexpr size_t statistics = std::size(STATISTICS);
+    names.resize(rollup.fields.size() * statistics);
+    values.clear();
+    for (size_t f = 0; f < rollup.fields.size(); ++f) {
+        const Aggregate& aggregate = rollup.aggregates[f];
+        const double stats[statistics] = {static_cast<double>(aggregate.count), aggregate.min, aggregate.max,
+                                          aggregate.sum, aggregate.sum_squares, aggregate.first, aggregate.last};
+        for (size_t s = 0; s < statistics; ++s) {
+            std::string& name = names[f * statistics + s];
+            name.assign(rollup.fields[f]).append(".").append(STATISTICS[s]);
+            values.push_back({name, stats[s]});
+        }
+    }
+}
+
+} // namespace SensorHub::Components
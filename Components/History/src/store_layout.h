@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SensorHub::Components::StoreLayout {
+
+// On-disk layout of a TimeSeriesStore segment (host byte order)
+
+constexpr uint32_t MAGIC = 0x53544853; // "SHTS"
+constexpr uint16_t VERSION = 1;
+
+constexpr uint16_t CHANNEL_RECORD = 1; // Body: name, then each field name, NUL-terminated
+constexpr uint16_t BLOCK_RECORD = 2;   // Body: i64 timestamps[points], then f64 values[points] per field
+
+struct SegmentHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_header_size; // sizeof(RecordHeader)
+    int64_t window_start_ns;     // Start of the wall-clock window, ns since the Unix epoch
+    int64_t window_ns;
+    uint8_t reserved[40];
+};
+
+struct RecordHeader {
+    uint32_t length;  // Whole record, a multiple of 8; 0 = end of data
+    uint32_t crc;     // CRC-32 of the body
+    uint16_t type;
+    uint16_t channel; // Segment-local id
+    uint16_t fields;
+    uint16_t points;  // BLOCK_RECORD only
+    int64_t first_ns; // Time range of a block
+    int64_t last_ns;
+};
+
+static_assert(sizeof(SegmentHeader) == 64);
+static_assert(sizeof(RecordHeader) == 32);
+
+constexpr size_t align8(size_t bytes) { return (bytes + 7) & ~size_t{7}; }
+
+} // namespace SensorHub::Components::StoreLayout
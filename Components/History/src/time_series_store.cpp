@@ -0,0 +1,573 @@
+#include "History/time_series_store.h"
+#include "StoreForward/crc32.h"
+#include "store_layout.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace SensorHub::Components {
+
+using namespace StoreLayout;
+
+namespace {
+
+constexpr size_t MIN_SEGMENT_BYTES = 64 * 1024;
+constexpr size_t MAX_CHANNELS = 0xFFFF; // Per segment
+constexpr size_t MAX_BLOCK_POINTS = 0xFFFF;
+constexpr std::string_view EXTENSION = ".tss";
+constexpr size_t SCAN_BATCH = 64; // Blocks a scan gathers per hold of the lock
+
+int64_t toNs(TimeSeriesStore::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::string errorText() { return std::strerror(errno); }
+
+size_t channelBodyBytes(const std::string& name, const std::vector<std::string>& fields) {
+    size_t bytes = name.size() + 1;
+    for (const auto& field : fields) bytes += field.size() + 1;
+    return align8(bytes);
+}
+
+/**
+ * @brief Header of the valid record at offset, or std::nullopt at the end of data (or a torn record).
+ */
+std::optional<RecordHeader> recordAt(const char* data, size_t end, size_t offset) {
+    if (end - offset < sizeof(RecordHeader)) return std::nullopt;
+    RecordHeader header;
+    std::memcpy(&header, data + offset, sizeof(header));
+    if (header.length < sizeof(RecordHeader) || header.length % 8 != 0 || header.length > end - offset) {
+        return std::nullopt;
+    }
+    const std::string_view body(data + offset + sizeof(RecordHeader), header.length - sizeof(RecordHeader));
+    if (crc32(body) != header.crc) return std::nullopt;
+    return header;
+}
+
+void putRecordHeader(char* record, RecordHeader header) {
+    const uint32_t length = header.length;
+    header.length = 0;
+    std::memcpy(record, &header, sizeof(header));
+    std::memcpy(record, &length, sizeof(length)); // Last: until it is written the record reads as the end of data
+}
+
+/**
+ * @brief The next NUL-terminated name in a channel record body, or std::nullopt if there is none.
+ */
+std::optional<std::string> nextName(std::string_view body, size_t& position) {
+    const size_t end = body.find('\0', position);
+    if (end == std::string_view::npos) return std::nullopt;
+    std::string name(body.substr(position, end - position));
+    position = end + 1;
+    return name;
+}
+
+} // namespace
+
+TimeSeriesStore::TimeSeriesStore(Options options)
+    : options_(std::move(options)),
+      window_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(options_.segment_window).count()) {
+    if (options_.segment_bytes < MIN_SEGMENT_BYTES) {
+        throw std::invalid_argument("History segment_bytes must be at least 65536");
+    }
+    if (options_.max_bytes / options_.segment_bytes < 2) {
+        throw std::invalid_argument("History max_bytes must hold at least two segments");
+    }
+    if (window_ns_ <= 0) {
+        throw std::invalid_argument("History segment_window must be positive");
+    }
+    if (options_.block_points == 0 || options_.block_points > MAX_BLOCK_POINTS) {
+        throw std::invalid_argument("History block_points must be between 1 and 65535");
+    }
+    recover();
+}
+
+TimeSeriesStore::~TimeSeriesStore() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!segments_.empty() && !segments_.back()->sealed) seal(*segments_.back());
+}
+
+void TimeSeriesStore::recover() {
+    std::error_code ec;
+    std::filesystem::create_directories(options_.directory, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot create history directory " + options_.directory.string() + ": " + ec.message());
+    }
+
+    const std::vector<uint64_t> sequences = SegmentFile::list(options_.directory, EXTENSION);
+    next_sequence_ = sequences.empty() ? 0 : sequences.back() + 1;
+
+    for (const uint64_t sequence : sequences) {
+        if (auto segment = openRecovered(sequence)) {
+            disk_bytes_ += segment->file_bytes;
+            segments_.push_back(std::move(segment));
+        }
+    }
+    while (!segments_.empty() && disk_bytes_ > options_.max_bytes) dropSegment(0);
+
+    if (!segments_.empty()) {
+        size_t blocks = 0;
+        for (const auto& segment : segments_) {
+            for (const auto& [channel, refs] : segment->index) blocks += refs.size();
+        }
+        std::cout << "History in " << options_.directory.string() << " holds " << blocks << " blocks in "
+                  << segments_.size() << " segments (" << disk_bytes_ << " bytes)." << std::endl;
+    }
+}
+
+std::shared_ptr<TimeSeriesStore::Segment> TimeSeriesStore::openRecovered(uint64_t sequence) {
+    const auto path = segmentPath(sequence);
+    auto segment = std::make_shared<Segment>();
+    segment->sequence = sequence;
+    segment->sealed = true;
+    try {
+        segment->file = SegmentFile::open(path, false);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(std::string("History: ") + e.what());
+    }
+    segment->file_bytes = segment->file.size();
+    if (segment->file_bytes < sizeof(SegmentHeader) + sizeof(RecordHeader)) { // Created but never written
+        segment->file.remove();
+        directory_dirty_ = true;
+        return nullptr;
+    }
+    const char* data = segment->file.data();
+    const size_t size = segment->file.size();
+
+    SegmentHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION || header.record_header_size != sizeof(RecordHeader)) {
+        std::cerr << "Skipping history segment " << path.string() << ": unknown format." << std::endl;
+        return nullptr;
+    }
+    segment->window_start_ns = header.window_start_ns;
+
+    // Indexes each record; one that does not check out or make sense ends the data
+    segment->write_offset = SegmentFile::scanRecords(sizeof(SegmentHeader), [&](size_t offset) -> size_t {
+        const auto record = recordAt(data, size, offset);
+        if (!record) return 0;
+        const std::string_view body(data + offset + sizeof(RecordHeader), record->length - sizeof(RecordHeader));
+        if (record->type == CHANNEL_RECORD) {
+            if (record->channel != segment->channels.size()) return 0;
+            ChannelDef channel;
+            size_t position = 0;
+            auto name = nextName(body, position);
+            if (!name) return 0;
+            channel.name = std::move(*name);
+            for (size_t i = 0; i < record->fields; ++i) {
+                auto field = nextName(body, position);
+                if (!field) break;
+                channel.fields.push_back(std::move(*field));
+            }
+            if (channel.fields.size() != record->fields) return 0;
+            segment->channels.push_back(std::make_shared<const ChannelDef>(std::move(channel)));
+        } else if (record->type == BLOCK_RECORD) {
+            if (record->channel >= segment->channels.size() || record->points == 0 ||
+                segment->channels[record->channel]->fields.size() != record->fields ||
+                body.size() != 8 * static_cast<size_t>(record->points) * (record->fields + 1u)) {
+                return 0;
+            }
+            segment->index[segment->channels[record->channel]->name].push_back(
+                BlockRef{record->channel, record->points, record->first_ns, record->last_ns, offset});
+            segment->first_ns = std::min(segment->first_ns, record->first_ns);
+            segment->last_ns = std::max(segment->last_ns, record->last_ns);
+        } else {
+            return 0;
+        }
+        return record->length;
+    });
+
+    if (segment->index.empty()) {
+        segment->file.remove();
+        directory_dirty_ = true;
+        return nullptr;
+    }
+    // Left open by a crash: give back the preallocated rest
+    if (segment->write_offset < segment->file_bytes && segment->file.truncate(segment->write_offset)) {
+        segment->file_bytes = segment->write_offset;
+    }
+    return segment;
+}
+
+TimeSeriesStore::Segment* TimeSeriesStore::openSegment(int64_t window_start_ns) {
+    while (!segments_.empty() && disk_bytes_ + options_.segment_bytes > options_.max_bytes) dropSegment(0);
+
+    auto segment = std::make_shared<Segment>();
+    segment->sequence = next_sequence_++;
+    const auto path = segmentPath(segment->sequence);
+    std::string error;
+    auto file = SegmentFile::create(path, options_.segment_bytes, error);
+    if (!file) {
+        std::cerr << "Cannot create history segment " << path.string() << ": " << error << std::endl;
+        return nullptr;
+    }
+    segment->file = std::move(*file);
+    segment->file_bytes = segment->file.size();
+    segment->window_start_ns = window_start_ns;
+
+    SegmentHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.record_header_size = sizeof(RecordHeader);
+    header.window_start_ns = window_start_ns;
+    header.window_ns = window_ns_;
+    std::memcpy(segment->file.data(), &header, sizeof(header));
+    segment->write_offset = sizeof(header);
+    segment->dirty = true;
+
+    disk_bytes_ += segment->file_bytes;
+    directory_dirty_ = true;
+    segments_.push_back(segment);
+    return segment.get();
+}
+
+void TimeSeriesStore::seal(Segment& segment) {
+    segment.sealed = true;
+    // Scans never read past write_offset, so the mapping can stay as it is
+    if (segment.write_offset < segment.file_bytes && segment.file.truncate(segment.write_offset)) {
+        disk_bytes_ -= segment.file_bytes - segment.write_offset;
+        segment.file_bytes = segment.write_offset;
+    }
+}
+
+void TimeSeriesStore::dropSegment(size_t position) {
+    const auto& segment = segments_[position];
+    ::unlink(segment->file.path().c_str()); // The mapping goes with the last scan holding the segment
+    disk_bytes_ -= segment->file_bytes;
+    segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(position)); // Scans may still hold the mapping
+    ++stats_.dropped_segments;
+    directory_dirty_ = true;
+}
+
+std::filesystem::path TimeSeriesStore::segmentPath(uint64_t sequence) const {
+    return SegmentFile::pathFor(options_.directory, sequence, EXTENSION);
+}
+
+void TimeSeriesStore::append(std::string_view channel, Clock::time_point timestamp, std::span<const Value> values) {
+    if (values.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(channel);
+    if (it == buffers_.end()) it = buffers_.emplace(std::string(channel), Buffer{}).first;
+    Buffer& buffer = it->second;
+
+    const bool same_fields = std::equal(buffer.fields.begin(), buffer.fields.end(), values.begin(), values.end(),
+                                        [](const std::string& field, const Value& value) { return field == value.name; });
+    if (!same_fields) {
+        if (!buffer.timestamps_ns.empty()) writeBuffer(it->first, buffer);
+        buffer.fields.clear();
+        for (const auto& value : values) buffer.fields.emplace_back(value.name);
+    }
+    buffer.timestamps_ns.push_back(toNs(timestamp));
+    for (const auto& value : values) buffer.values.push_back(value.value);
+    ++stats_.points;
+    if (buffer.timestamps_ns.size() >= options_.block_points) writeBuffer(it->first, buffer);
+}
+
+void TimeSeriesStore::writeBuffer(const std::string& channel, Buffer& buffer) {
+    const size_t count = buffer.timestamps_ns.size();
+    const size_t point_bytes = 8 * (buffer.fields.size() + 1);
+    const size_t channel_bytes = sizeof(RecordHeader) + channelBodyBytes(channel, buffer.fields);
+    // Whole points that still fit behind a block header (and the channel record, if needed)
+    const auto room = [&](const Segment& segment, bool with_channel) -> size_t {
+        const size_t fixed = sizeof(RecordHeader) + (with_channel ? channel_bytes : 0);
+        const size_t free = segment.file.size() - segment.write_offset;
+        return free > fixed ? (free - fixed) / point_bytes : 0;
+    };
+    const auto findChannel = [&](const Segment& segment) -> std::optional<uint16_t> {
+        for (size_t id = 0; id < segment.channels.size(); ++id) {
+            const auto& known = *segment.channels[id];
+            if (known.name == channel && known.fields == buffer.fields) return static_cast<uint16_t>(id);
+        }
+        return std::nullopt;
+    };
+
+    size_t done = 0;
+    while (done < count) {
+        const int64_t first_ns = buffer.timestamps_ns[done];
+        const int64_t window_start = first_ns - ((first_ns % window_ns_) + window_ns_) % window_ns_;
+        Segment* segment = segments_.empty() || segments_.back()->sealed ? nullptr : segments_.back().get();
+        std::optional<uint16_t> channel_id;
+        if (segment && segment->window_start_ns == window_start) channel_id = findChannel(*segment);
+        if (segment && (segment->window_start_ns != window_start || room(*segment, !channel_id) == 0 ||
+                        (!channel_id && segment->channels.size() >= MAX_CHANNELS))) {
+            seal(*segment);
+            segment = nullptr;
+            channel_id.reset();
+        }
+        if (!segment) {
+            segment = openSegment(window_start);
+            if (!segment || room(*segment, true) == 0) {
+                if (segment) std::cerr << "History: a point of " << channel << " does not fit in a segment." << std::endl;
+                stats_.dropped_points += count - done;
+                break;
+            }
+        }
+        if (!channel_id) channel_id = writeChannel(*segment, channel, buffer.fields);
+
+        // Points past the window go to the next segment
+        const size_t limit = std::min({count - done, room(*segment, false), MAX_BLOCK_POINTS});
+        size_t points = 1;
+        while (points < limit && buffer.timestamps_ns[done + points] - window_start < window_ns_ &&
+               buffer.timestamps_ns[done + points] >= window_start) {
+            ++points;
+        }
+        writeBlock(*segment, *channel_id, buffer, done, points);
+        done += points;
+    }
+    buffer.timestamps_ns.clear();
+    buffer.values.clear();
+}
+
+uint16_t TimeSeriesStore::writeChannel(Segment& segment, const std::string& channel, const std::vector<std::string>& fields) {
+    const size_t body_bytes = channelBodyBytes(channel, fields);
+    char* record = segment.file.data() + segment.write_offset;
+    char* body = record + sizeof(RecordHeader);
+    std::memset(body, 0, body_bytes);
+    size_t position = 0;
+    std::memcpy(body, channel.data(), channel.size());
+    position += channel.size() + 1;
+    for (const auto& field : fields) {
+        std::memcpy(body + position, field.data(), field.size());
+        position += field.size() + 1;
+    }
+
+    const auto id = static_cast<uint16_t>(segment.channels.size());
+    RecordHeader header{};
+    header.length = static_cast<uint32_t>(sizeof(RecordHeader) + body_bytes);
+    header.crc = crc32(std::string_view(body, body_bytes));
+    header.type = CHANNEL_RECORD;
+    header.channel = id;
+    header.fields = static_cast<uint16_t>(fields.size());
+    putRecordHeader(record, header);
+
+    segment.channels.push_back(std::make_shared<const ChannelDef>(ChannelDef{channel, fields}));
+    segment.write_offset += header.length;
+    segment.dirty = true;
+    return id;
+}
+
+void TimeSeriesStore::writeBlock(Segment& segment, uint16_t channel_id, const Buffer& buffer, size_t first, size_t count) {
+    const size_t fields = buffer.fields.size();
+    char* record = segment.file.data() + segment.write_offset;
+    char* body = record + sizeof(RecordHeader);
+    const size_t body_bytes = 8 * count * (fields + 1);
+
+    std::memcpy(body, buffer.timestamps_ns.data() + first, 8 * count);
+    // Point by point in the buffer, column by column on disk
+    char* out = body + 8 * count;
+    for (size_t field = 0; field < fields; ++field) {
+        for (size_t i = 0; i < count; ++i, out += 8) std::memcpy(out, &buffer.values[(first + i) * fields + field], 8);
+    }
+
+    const auto [min_ns, max_ns] = std::minmax_element(buffer.timestamps_ns.begin() + static_cast<std::ptrdiff_t>(first),
+                                                      buffer.timestamps_ns.begin() + static_cast<std::ptrdiff_t>(first + count));
+    RecordHeader header{};
+    header.length = static_cast<uint32_t>(sizeof(RecordHeader) + body_bytes);
+    header.crc = crc32(std::string_view(body, body_bytes));
+    header.type = BLOCK_RECORD;
+    header.channel = channel_id;
+    header.fields = static_cast<uint16_t>(fields);
+    header.points = static_cast<uint16_t>(count);
+    header.first_ns = *min_ns;
+    header.last_ns = *max_ns;
+    putRecordHeader(record, header);
+
+    segment.index[segment.channels[channel_id]->name].push_back(
+        BlockRef{channel_id, header.points, header.first_ns, header.last_ns, segment.write_offset});
+    segment.first_ns = std::min(segment.first_ns, header.first_ns);
+    segment.last_ns = std::max(segment.last_ns, header.last_ns);
+    segment.write_offset += header.length;
+    segment.dirty = true;
+    ++stats_.blocks;
+}
+
+bool TimeSeriesStore::sync(Clock::time_point now, bool all) {
+    std::vector<std::pair<std::shared_ptr<Segment>, size_t>> dirty; // Segment and bytes written
+    bool sync_directory = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const int64_t now_ns = toNs(now);
+        const int64_t block_age_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(options_.block_age).count();
+        for (auto& [channel, buffer] : buffers_) {
+            if (!buffer.timestamps_ns.empty() && (all || now_ns - buffer.timestamps_ns.front() >= block_age_ns)) {
+                writeBuffer(channel, buffer);
+            }
+        }
+        // Truncate a finished window now rather than with the next block
+        if (!segments_.empty() && !segments_.back()->sealed &&
+            now_ns - segments_.back()->window_start_ns >= window_ns_) {
+            seal(*segments_.back());
+        }
+        if (options_.max_age.count() > 0) {
+            const int64_t oldest_ns = now_ns - std::chrono::duration_cast<std::chrono::nanoseconds>(options_.max_age).count();
+            for (size_t i = 0; i < segments_.size();) {
+                if (segments_[i]->sealed && segments_[i]->last_ns < oldest_ns) {
+                    dropSegment(i);
+                } else {
+                    ++i;
+                }
+            }
+        }
+        for (const auto& segment : segments_) {
+            if (!segment->dirty) continue;
+            dirty.emplace_back(segment, segment->write_offset);
+            segment->dirty = false;
+        }
+        sync_directory = std::exchange(directory_dirty_, false);
+    }
+
+    // Storage I/O without the lock, so appends never wait for the SD card
+    bool synced = true;
+    for (const auto& [segment, bytes] : dirty) {
+        if (!segment->file.sync(bytes)) {
+            std::cerr << "History sync failed: " << errorText() << std::endl;
+            std::lock_guard<std::mutex> lock(mutex_);
+            segment->dirty = true;
+            synced = false;
+        }
+    }
+    if (sync_directory) { // Segment files created or deleted since the last sync
+        SegmentFile::syncDirectory(options_.directory);
+    }
+    return synced;
+}
+
+size_t TimeSeriesStore::scan(std::string_view channel, Clock::time_point from, Clock::time_point to,
+                             const std::function<bool(const BlockView&)>& visit) const {
+    const int64_t from_ns = toNs(from);
+    const int64_t to_ns = toNs(to);
+
+    struct Found {
+        std::shared_ptr<const Segment> segment;
+        std::shared_ptr<const ChannelDef> channel;
+        BlockRef block;
+    };
+    std::vector<Found> found;
+    std::vector<std::string> buffered_fields;
+    std::vector<int64_t> buffered_timestamps;
+    std::vector<double> buffered_columns;
+    // Where the next batch starts: a segment's blocks only ever grow, so an index into
+    // them stays valid, and a dropped segment is simply not found again
+    uint64_t next_sequence = 0;
+    size_t next_block = 0;
+    bool resumed = false;
+    // Gathers up to SCAN_BATCH blocks; true if more may follow. The buffered points come with the last batch.
+    const auto gather = [&] {
+        found.clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto segment = std::partition_point(segments_.begin(), segments_.end(),
+                                            [&](const auto& candidate) { return candidate->sequence < next_sequence; });
+        for (; segment != segments_.end(); ++segment) {
+            const auto& current = *segment;
+            if (current->last_ns < from_ns || current->first_ns > to_ns) continue;
+            const auto it = current->index.find(channel);
+            if (it == current->index.end()) continue;
+            const auto& blocks = it->second;
+            auto block = resumed && current->sequence == next_sequence
+                             ? blocks.begin() + static_cast<std::ptrdiff_t>(std::min(next_block, blocks.size()))
+                             : std::partition_point(blocks.begin(), blocks.end(),
+                                                    [&](const BlockRef& ref) { return ref.last_ns < from_ns; });
+            for (; block != blocks.end() && block->first_ns <= to_ns; ++block) {
+                if (found.size() == SCAN_BATCH) {
+                    next_sequence = current->sequence;
+                    next_block = static_cast<size_t>(block - blocks.begin());
+                    resumed = true;
+                    return true;
+                }
+                found.push_back(Found{current, current->channels[block->channel], *block});
+            }
+        }
+        // Points not written yet, turned into columns like a block
+        if (const auto it = buffers_.find(channel); it != buffers_.end() && !it->second.timestamps_ns.empty()) {
+            const Buffer& buffer = it->second;
+            const size_t count = buffer.timestamps_ns.size();
+            const size_t fields = buffer.fields.size();
+            buffered_fields = buffer.fields;
+            buffered_timestamps = buffer.timestamps_ns;
+            buffered_columns.resize(count * fields);
+            for (size_t i = 0; i < count; ++i) {
+                for (size_t field = 0; field < fields; ++field) {
+                    buffered_columns[field * count + i] = buffer.values[i * fields + field];
+                }
+            }
+        }
+        return false;
+    };
+
+    size_t visited = 0;
+    // Trims a block's points to [from, to]; false once visit() asked to stop
+    const auto visitRange = [&](const std::string& name, std::span<const std::string> fields,
+                                std::span<const int64_t> timestamps, const double* columns) {
+        const auto begin = std::lower_bound(timestamps.begin(), timestamps.end(), from_ns);
+        const auto end = std::upper_bound(begin, timestamps.end(), to_ns);
+        if (begin == end) return true;
+        const auto skipped = static_cast<size_t>(begin - timestamps.begin());
+        BlockView view;
+        view.channel = name;
+        view.fields = fields;
+        view.timestamps_ns = std::span<const int64_t>(&*begin, static_cast<size_t>(end - begin));
+        view.columns = columns + skipped;
+        view.stride = timestamps.size();
+        visited += view.timestamps_ns.size();
+        return visit(view);
+    };
+
+    // A caller that stops early (a streamed part) pays for one batch, not for the rest of the range
+    for (bool more = true; more;) {
+        more = gather();
+        for (const auto& [segment, definition, block] : found) {
+            const char* body = segment->file.data() + block.offset + sizeof(RecordHeader);
+            const auto* timestamps = reinterpret_cast<const int64_t*>(body);
+            const auto* columns = reinterpret_cast<const double*>(body + 8 * static_cast<size_t>(block.points));
+            if (!visitRange(definition->name, definition->fields, std::span<const int64_t>(timestamps, block.points),
+                            columns)) {
+                return visited;
+            }
+        }
+    }
+    if (!buffered_timestamps.empty()) {
+        visitRange(std::string(channel), buffered_fields, buffered_timestamps, buffered_columns.data());
+    }
+    return visited;
+}
+
+std::vector<TimeSeriesStore::ChannelInfo> TimeSeriesStore::channels() const {
+    std::map<std::string_view, std::pair<int64_t, int64_t>> ranges; // First and last timestamp
+    const auto extend = [&](std::string_view name, int64_t first_ns, int64_t last_ns) {
+        const auto [it, inserted] = ranges.try_emplace(name, first_ns, last_ns);
+        if (inserted) return;
+        it->second.first = std::min(it->second.first, first_ns);
+        it->second.second = std::max(it->second.second, last_ns);
+    };
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& segment : segments_) {
+        for (const auto& [name, blocks] : segment->index) {
+            if (!blocks.empty()) extend(name, blocks.front().first_ns, blocks.back().last_ns);
+        }
+    }
+    for (const auto& [name, buffer] : buffers_) {
+        if (!buffer.timestamps_ns.empty()) extend(name, buffer.timestamps_ns.front(), buffer.timestamps_ns.back());
+    }
+    std::vector<ChannelInfo> result;
+    result.reserve(ranges.size());
+    for (const auto& [name, range] : ranges) {
+        result.push_back(ChannelInfo{std::string(name), Clock::time_point(std::chrono::nanoseconds(range.first)),
+                                     Clock::time_point(std::chrono::nanoseconds(range.second))});
+    }
+    return result;
+}
+
+TimeSeriesStore::Stats TimeSeriesStore::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.segments = segments_.size();
+    stats.disk_bytes = disk_bytes_;
+    return stats;
+}
+
+} // namespace SensorHub::Components
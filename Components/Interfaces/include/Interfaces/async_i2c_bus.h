@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Interfaces/ii2c_bus.h"
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace SensorHub::Interfaces {
+
+/**
+ * @brief Awaitable wrapper around an II2C_Bus for coroutine-based drivers.
+ *
+ * Usage inside a Coro::Task: `auto id = co_await bus.readByte(addr, reg);`.
+ * Linux i2c-dev transfers are short synchronous ioctl/read calls, so operations
+ * complete inline when awaited (no suspension). Keeping drivers on this layer lets a
+ * truly asynchronous bus backend suspend here later without touching driver code.
+ */
+class AsyncI2C_Bus {
+public:
+    /**
+     * @brief Awaitable that runs a bus operation when the coroutine resumes.
+     */
+    template <typename Op>
+    struct Operation {
+        Op op;
+        bool await_ready() const noexcept { return true; }
+        void await_suspend(std::coroutine_handle<>) const noexcept {}
+        auto await_resume() { return op(); }
+    };
+
+    explicit AsyncI2C_Bus(std::shared_ptr<II2C_Bus> bus) : bus_(std::move(bus)) {}
+
+    /**
+     * @brief Awaitable readBlockData(); yields std::optional<std::vector<uint8_t>>.
+     */
+    auto read(uint8_t device_address, uint8_t start_reg, size_t count) {
+        return makeOperation([bus = bus_.get(), device_address, start_reg, count] {
+            return bus->readBlockData(device_address, start_reg, count);
+        });
+    }
+
+    /**
+     * @brief Awaitable readByteData(); yields std::optional<uint8_t>.
+     */
+    auto readByte(uint8_t device_address, uint8_t reg) {
+        return makeOperation([bus = bus_.get(), device_address, reg] {
+            return bus->readByteData(device_address, reg);
+        });
+    }
+
+    /**
+     * @brief Awaitable writeByteData(); yields true on success.
+     */
+    auto writeByte(uint8_t device_address, uint8_t reg, uint8_t value) {
+        return makeOperation([bus = bus_.get(), device_address, reg, value] {
+            return bus->writeByteData(device_address, reg, value);
+        });
+    }
+
+    /**
+     * @brief The wrapped synchronous bus.
+     */
+    II2C_Bus& sync() const { return *bus_; }
+
+private:
+    template <typename Op>
+    static Operation<Op> makeOperation(Op op) { return Operation<Op>{std::move(op)}; }
+
+    std::shared_ptr<II2C_Bus> bus_;
+};
+
+} // namespace SensorHub::Interfaces
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Interfaces/sensor_config.h" // Include the config struct definition
+#include "Coro/task.h"                // Awaitable sensor operations
 #include <nlohmann/json.hpp>          // Include json for return type
 #include <string>
 #include <chrono>
@@ -29,9 +30,9 @@ public:
 
     /**
      * @brief Gets the configured publish interval for this sensor.
-     * @return Publish interval.
+     * @return Publish interval (millisecond resolution, may be sub-second).
      */
-    virtual std::chrono::seconds getPublishInterval() const = 0;
+    virtual std::chrono::milliseconds getPublishInterval() const = 0;
 
     /**
      * @brief Gets the MQTT topic suffix specific to this sensor instance.
@@ -39,12 +40,34 @@ public:
      */
     virtual std::string getTopicSuffix() const = 0;
 
+    /**
+     * @brief Identifies the bus this sensor is attached to (e.g., "/dev/i2c-1").
+     * Reads of sensors sharing a bus id are serialized and published in read order.
+     * @return Bus identifier, or an empty string if the sensor has no shared bus.
+     */
+    virtual std::string getBusId() const { return ""; }
+
     /**
      * @brief Reads the current data from the sensor.
      * @return A nlohmann::json object containing the sensor-specific data payload.
      * Returns an empty json object `{}` or includes an "error" key on failure.
      */
     virtual nlohmann::json readDataJson() = 0;
+
+    /**
+     * @brief Runs the sensor's initialization sequence (device check, calibration, configuration).
+     * Delays are awaited, so many sensors can initialize on one scheduler thread.
+     * @throws std::runtime_error if initialization fails.
+     */
+    virtual Coro::Task<void> initializeAsync() { co_return; }
+
+    /**
+     * @brief Awaitable variant of readDataJson().
+     * Drivers that wait for a conversion suspend here instead of blocking the thread.
+     * The default simply wraps the synchronous read.
+     * @return Same payload contract as readDataJson().
+     */
+    virtual Coro::Task<nlohmann::json> readDataJsonAsync() { co_return readDataJson(); }
 };
 
 } // namespace SensorHub::Interfaces
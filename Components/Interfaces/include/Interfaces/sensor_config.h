@@ -16,7 +16,7 @@ struct SensorConfig {
     std::string type; // e.g., "BME280", "DS18B20"
     bool enabled = false;
     std::string publish_topic_suffix;
-    std::chrono::seconds publish_interval{10}; // Default interval
+    std::chrono::milliseconds publish_interval{10000}; // Default interval (10 s)
 
     // --- I2C Specific (Example) ---
     std::string i2c_bus;
@@ -29,6 +29,33 @@ struct SensorConfig {
     // std::string one_wire_id;
     // int gpio_pin;
 
+    /**
+     * @brief Parses a publish interval from a JSON object.
+     * Accepts "<key>_ms" (integer milliseconds) or "<key>_sec" (integer or fractional
+     * seconds, e.g. 0.04 for 25 Hz). The millisecond key wins if both are set.
+     * @param j The JSON object holding the interval keys.
+     * @param fallback Interval returned when neither key is present.
+     * @param key Key prefix, e.g. "publish_interval" or "global_publish_interval".
+     * @return The parsed interval, clamped to at least 1 ms.
+     * @throws nlohmann::json::type_error if a key holds a non-numeric value.
+     */
+    static inline std::chrono::milliseconds parseInterval(const nlohmann::json& j,
+                                                          std::chrono::milliseconds fallback,
+                                                          const std::string& key = "publish_interval") {
+        std::chrono::milliseconds interval = fallback;
+        if (j.contains(key + "_ms")) {
+            interval = std::chrono::milliseconds(j.at(key + "_ms").get<int64_t>());
+        } else if (j.contains(key + "_sec")) {
+            double seconds = j.at(key + "_sec").get<double>();
+            interval = std::chrono::milliseconds(static_cast<int64_t>(seconds * 1000.0 + 0.5));
+        }
+        if (interval < std::chrono::milliseconds(1)) {
+            std::cerr << "SensorConfig Warning: Publish interval below 1 ms, clamping to 1 ms." << std::endl;
+            interval = std::chrono::milliseconds(1);
+        }
+        return interval;
+    }
+
     /**
      * @brief Parses common fields from a sensor JSON object into the config struct.
      * @param j_sensor The nlohmann::json object representing one sensor config entry.
@@ -45,7 +72,7 @@ struct SensorConfig {
             config.type = j_sensor.at("type").get<std::string>();
             config.publish_topic_suffix = j_sensor.at("publish_topic_suffix").get<std::string>();
             // Use global interval by default, allow sensor to override if needed later
-            config.publish_interval = std::chrono::seconds(j_sensor.value("publish_interval_sec", 10));
+            config.publish_interval = parseInterval(j_sensor, config.publish_interval);
 
             return true; // Common fields parsed successfully
         } catch (const nlohmann::json::out_of_range& e) {
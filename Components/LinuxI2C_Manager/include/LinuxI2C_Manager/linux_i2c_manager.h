@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Interfaces/ii2c_bus.h" // Include the interface
+#include "Metrics/metrics_registry.h"
+#include <chrono>
 #include <string>
 #include <mutex>
 #include <vector>
@@ -12,7 +14,12 @@ namespace SensorHub::Components {
 // Inherit from the interface
 class I2C_Manager : public SensorHub::Interfaces::II2C_Bus {
 public:
-    explicit I2C_Manager(std::string bus_device_path);
+    /**
+     * @param bus_device_path The device path (e.g., "/dev/i2c-1").
+     * @param metrics If set, every transaction is counted (by result) and timed under
+     * sensorhub_i2c_transactions_total / sensorhub_i2c_transaction_seconds{bus="..."}.
+     */
+    explicit I2C_Manager(std::string bus_device_path, MetricsRegistry* metrics = nullptr);
     ~I2C_Manager() override; // Override virtual destructor
 
     // Override interface methods
@@ -33,11 +40,17 @@ public:
 
 private:
     bool setActiveDevice(uint8_t device_address); // Keep this helper
+    // Counts and times one transaction begun at start; returns ok
+    bool record(std::chrono::steady_clock::time_point start, bool ok);
 
     std::string bus_path_;
     int fd_ = -1;
     uint8_t current_address_ = 0;
     std::mutex bus_mutex_; // Protect access to fd_ and current_address_
+    // Owned by the MetricsRegistry; null without one
+    Counter* transactions_ok_ = nullptr;
+    Counter* transactions_failed_ = nullptr;
+    Histogram* transaction_seconds_ = nullptr;
 };
 
 } // namespace SensorHub::Components
\ No newline at end of file
@@ -14,7 +14,7 @@
 namespace SensorHub::Components {
 
 // --- Constructor / Destructor ---
-I2C_Manager::I2C_Manager(std::string bus_device_path)
+I2C_Manager::I2C_Manager(std::string bus_device_path, MetricsRegistry* metrics)
     : bus_path_(std::move(bus_device_path)) {
     // Lock immediately during construction phase
     std::lock_guard<std::mutex> lock(bus_mutex_);
@@ -24,6 +24,18 @@ I2C_Manager::I2C_Manager(std::string bus_device_path)
         throw std::runtime_error("I2C_Manager: Failed to open bus " + bus_path_ + ": " + strerror(errno));
     }
     std::cout << "I2C_Manager: Opened bus " << bus_path_ << std::endl;
+
+    if (metrics) {
+        const char* total_help = "I2C transactions on the bus, by result.";
+        transactions_ok_ = &metrics->counter("sensorhub_i2c_transactions_total", total_help,
+                                             {{"bus", bus_path_}, {"result", "ok"}});
+        transactions_failed_ = &metrics->counter("sensorhub_i2c_transactions_total", total_help,
+                                                 {{"bus", bus_path_}, {"result", "error"}});
+        // 50 us .. ~100 ms: a register write at 400 kHz up to a stretched or retried block read
+        transaction_seconds_ = &metrics->histogram("sensorhub_i2c_transaction_seconds",
+                                                   "Duration of I2C transactions, bus lock wait included.",
+                                                   Histogram::exponentialBounds(50e-6, 2, 12), {{"bus", bus_path_}});
+    }
 }
 
 I2C_Manager::~I2C_Manager() {
@@ -41,7 +53,10 @@ I2C_Manager::~I2C_Manager() {
 I2C_Manager::I2C_Manager(I2C_Manager&& other) noexcept
     : bus_path_(std::move(other.bus_path_)),
       fd_(other.fd_),
-      current_address_(other.current_address_)
+      current_address_(other.current_address_),
+      transactions_ok_(other.transactions_ok_),
+      transactions_failed_(other.transactions_failed_),
+      transaction_seconds_(other.transaction_seconds_)
 // Note: Mutex is not moved, the new object gets its own default-constructed mutex.
 {
     // Prevent the moved-from object's destructor from closing the fd
@@ -64,6 +79,9 @@ I2C_Manager& I2C_Manager::operator=(I2C_Manager&& other) noexcept {
         bus_path_ = std::move(other.bus_path_);
         fd_ = other.fd_;
         current_address_ = other.current_address_;
+        transactions_ok_ = other.transactions_ok_;
+        transactions_failed_ = other.transactions_failed_;
+        transaction_seconds_ = other.transaction_seconds_;
 
         // Reset the moved-from object
         other.fd_ = -1;
@@ -95,13 +113,22 @@ bool I2C_Manager::setActiveDevice(uint8_t device_address) {
     return true;
 }
 
+bool I2C_Manager::record(std::chrono::steady_clock::time_point start, bool ok) {
+    if (transaction_seconds_) {
+        transaction_seconds_->observe(std::chrono::steady_clock::now() - start);
+        (ok ? transactions_ok_ : transactions_failed_)->inc();
+    }
+    return ok;
+}
+
 // --- Public I2C Operations ---
 
 bool I2C_Manager::writeByteData(uint8_t device_address, uint8_t reg, uint8_t value) {
+    const auto start = std::chrono::steady_clock::now();
     std::lock_guard<std::mutex> lock(bus_mutex_); // Lock the bus for this transaction
 
     if (!setActiveDevice(device_address)) {
-        return false;
+        return record(start, false);
     }
 
     // Prepare buffer: [register_address, value]
@@ -111,15 +138,17 @@ bool I2C_Manager::writeByteData(uint8_t device_address, uint8_t reg, uint8_t val
         std::cerr << "I2C_Manager Error: Failed writeByteData to addr 0x"
                   << std::hex << static_cast<int>(device_address) << " reg 0x" << static_cast<int>(reg)
                   << ": " << strerror(errno) << std::dec << std::endl;
-        return false;
+        return record(start, false);
     }
-    return true;
+    return record(start, true);
 }
 
 std::optional<uint8_t> I2C_Manager::readByteData(uint8_t device_address, uint8_t reg) {
+    const auto start = std::chrono::steady_clock::now();
     std::lock_guard<std::mutex> lock(bus_mutex_); // Lock the bus
 
     if (!setActiveDevice(device_address)) {
+        record(start, false);
         return std::nullopt;
     }
 
@@ -128,6 +157,7 @@ std::optional<uint8_t> I2C_Manager::readByteData(uint8_t device_address, uint8_t
          std::cerr << "I2C_Manager Error: Failed write reg address 0x" << std::hex << static_cast<int>(reg)
                    << " for readByteData from addr 0x" << static_cast<int>(device_address)
                    << ": " << strerror(errno) << std::dec << std::endl;
+        record(start, false);
         return std::nullopt;
     }
 
@@ -136,16 +166,20 @@ std::optional<uint8_t> I2C_Manager::readByteData(uint8_t device_address, uint8_t
     if (read(fd_, &value, 1) != 1) {
          std::cerr << "I2C_Manager Error: Failed readByteData from addr 0x" << std::hex << static_cast<int>(device_address)
                    << " reg 0x" << static_cast<int>(reg) << ": " << strerror(errno) << std::dec << std::endl;
+        record(start, false);
         return std::nullopt;
     }
+    record(start, true);
     return value;
 }
 
 std::optional<std::vector<uint8_t>> I2C_Manager::readBlockData(uint8_t device_address, uint8_t start_reg, size_t count) {
+     const auto start = std::chrono::steady_clock::now();
      std::lock_guard<std::mutex> lock(bus_mutex_); // Lock the bus
 
      if (count == 0) return std::vector<uint8_t>(); // Return empty vector if count is 0
      if (!setActiveDevice(device_address)) {
+        record(start, false);
         return std::nullopt;
      }
 
@@ -154,6 +188,7 @@ std::optional<std::vector<uint8_t>> I2C_Manager::readBlockData(uint8_t device_ad
          std::cerr << "I2C_Manager Error: Failed write start reg 0x" << std::hex << static_cast<int>(start_reg)
                    << " for readBlockData from addr 0x" << static_cast<int>(device_address)
                    << ": " << strerror(errno) << std::dec << std::endl;
+         record(start, false);
          return std::nullopt;
      }
 
@@ -166,6 +201,7 @@ std::optional<std::vector<uint8_t>> I2C_Manager::readBlockData(uint8_t device_ad
         std::cerr << "I2C_Manager Error: Failed readBlockData (" << count << " bytes) from addr 0x"
                   << std::hex << static_cast<int>(device_address) << " reg 0x" << static_cast<int>(start_reg)
                   << ": " << strerror(errno) << std::dec << std::endl;
+        record(start, false);
         return std::nullopt;
      }
      // Check for partial reads (might happen, sometimes okay, sometimes an error)
@@ -176,15 +212,17 @@ std::optional<std::vector<uint8_t>> I2C_Manager::readBlockData(uint8_t device_ad
          buffer.resize(bytes_read); // Adjust vector size to actual bytes read
      }
 
+     record(start, true);
      return buffer; // Return the (potentially resized) vector
 }
 
  bool I2C_Manager::writeBlockData(uint8_t device_address, uint8_t start_reg, const std::vector<uint8_t>& data) {
+     const auto start = std::chrono::steady_clock::now();
      std::lock_guard<std::mutex> lock(bus_mutex_); // Lock the bus
 
      if (data.empty()) return true; // Nothing to write
      if (!setActiveDevice(device_address)) {
-        return false;
+        return record(start, false);
      }
 
      // Create a single buffer: [start_reg, data_byte_0, data_byte_1, ...]
@@ -200,17 +238,18 @@ std::optional<std::vector<uint8_t>> I2C_Manager::readBlockData(uint8_t device_ad
           std::cerr << "I2C_Manager Error: Failed writeBlockData (" << data.size() << " bytes) to addr 0x"
                     << std::hex << static_cast<int>(device_address) << " reg 0x" << static_cast<int>(start_reg)
                     << ": " << strerror(errno) << std::dec << std::endl;
-          return false;
+          return record(start, false);
      }
-     return true;
+     return record(start, true);
  }
 
  bool I2C_Manager::probeDevice(uint8_t device_address) {
+     const auto start = std::chrono::steady_clock::now();
      std::lock_guard<std::mutex> lock(bus_mutex_); // Lock the bus
 
      if (fd_ < 0) {
          std::cerr << "I2C_Manager Error: Bus not open for probe." << std::endl;
-         return false;
+         return record(start, false);
      }
 
      // Attempt to set the slave address. A failure often indicates no device.
@@ -223,6 +262,7 @@ std::optional<std::vector<uint8_t>> I2C_Manager::readBlockData(uint8_t device_ad
              if (current_address_ != 0 && current_address_ != device_address) {
                  ioctl(fd_, I2C_SLAVE, current_address_); // Best effort restore
              }
+             record(start, true); // An absent device is a probe result, not a bus error
              return false; // No device acknowledged
          } else {
              // Other unexpected error during ioctl
@@ -230,13 +270,13 @@ std::optional<std::vector<uint8_t>> I2C_Manager::readBlockData(uint8_t device_ad
                        << std::hex << static_cast<int>(device_address) << ": "
                        << strerror(errno) << std::dec << std::endl;
              current_address_ = 0; // Invalidate address cache on error
-             return false;
+             return record(start, false);
          }
      }
 
      // If ioctl succeeded, a device responded. Cache the address.
      current_address_ = device_address;
-     return true; // Device acknowledged
+     return record(start, true); // Device acknowledged
  }
 
  const std::string& I2C_Manager::getBusPath() const {
@@ -0,0 +1,147 @@
+#include "LocalApi/history_api.h"
+#include "History/rollup_engine.h"
+#include "http_client.h"
+#include "gtest/gtest.h"
+#include <nlohmann/json.hpp>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using namespace TestClient;
+using Clock = TimeSeriesStore::Clock;
+using json = nlohmann::json;
+using namespace std::chrono_literals;
+
+const Clock::time_point BASE{std::chrono::seconds(1699999200)}; // On an hour boundary
+constexpr int64_t BASE_MS = 1699999200000;
+
+class HistoryApiTest : public testing::Test {
+protected:
+    void SetUp() override {
+        const auto* test = testing::UnitTest::GetInstance()->current_test_info();
+        options_.directory = std::filesystem::temp_directory_path() / ("history_api_" + std::string(test->name()));
+        std::filesystem::remove_all(options_.directory);
+        options_.segment_bytes = 1 << 20;
+        options_.max_bytes = 8 << 20;
+        options_.block_points = 16;
+        store_ = std::make_unique<TimeSeriesStore>(options_);
+    }
+
+    void TearDown() override {
+        server_.reset();
+        store_.reset();
+        std::filesystem::remove_all(options_.directory);
+    }
+
+    void serve() {
+        HttpServer::Options options;
+        options.listen = "127.0.0.1:0";
+        server_ = std::make_unique<HttpServer>(options);
+        api_ = std::make_unique<HistoryApi>(*store_);
+        api_->attach(*server_);
+        server_->start();
+    }
+
+    json query(const std::string& target) {
+        const auto response = get(server_->address(), target);
+        EXPECT_TRUE(response.starts_with("HTTP/1.1 200 ")) << response.substr(0, 200);
+        return json::parse(body(response));
+    }
+
+    static std::string seconds(Clock::time_point time) {
+        return std::to_string(std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count());
+    }
+
+    TimeSeriesStore::Options options_;
+    std::unique_ptr<TimeSeriesStore> store_;
+    std::unique_ptr<HistoryApi> api_;
+    std::unique_ptr<HttpServer> server_;
+};
+
+} // namespace
+
+TEST_F(HistoryApiTest, ListsChannelsAndLatestPoints) {
+    for (int i = 0; i < 20; ++i) {
+        const TimeSeriesStore::Value values[] = {{"humidity", 40.0 + i}, {"temperature", 20.0 + i}};
+        store_->append("bme280", BASE + std::chrono::seconds(i), values);
+    }
+    const TimeSeriesStore::Value door[] = {{"open", 1}};
+    store_->append("door", BASE + 5s, door);
+    serve();
+
+    const auto channels = query("/api/channels")["channels"];
+    ASSERT_EQ(channels.size(), 2u);
+    EXPECT_EQ(channels[0]["channel"], "bme280");
+    EXPECT_EQ(channels[0]["first"], BASE_MS);
+    EXPECT_EQ(channels[0]["last"], BASE_MS + 19000);
+
+    const auto latest = query("/api/latest?channel=bme280");
+    EXPECT_EQ(latest["t"], BASE_MS + 19000);
+    EXPECT_EQ(latest["values"]["temperature"], 39.0);
+    EXPECT_EQ(query("/api/latest")["channels"].size(), 2u);
+    EXPECT_TRUE(get(server_->address(), "/api/latest?channel=nothing").starts_with("HTTP/1.1 404 "));
+}
+
+TEST_F(HistoryApiTest, StreamsLongRangesInOrder) {
+    constexpr int POINTS = 20000; // Many parts and blocks, half of the last block still buffered
+    for (int i = 0; i < POINTS; ++i) {
+        const TimeSeriesStore::Value values[] = {{"value", static_cast<double>(i)}};
+        store_->append("fast", BASE + std::chrono::seconds(i), values);
+    }
+    serve();
+
+    const auto response = get(server_->address(), "/api/range?channel=fast&from=" + seconds(BASE) +
+                                                       "&to=" + seconds(BASE + std::chrono::seconds(POINTS)));
+    EXPECT_NE(response.find("Transfer-Encoding: chunked"), std::string::npos);
+    const auto result = json::parse(body(response));
+    ASSERT_EQ(result["series"].size(), 1u);
+    EXPECT_EQ(result["series"][0]["fields"], json::array({"value"}));
+    const auto& points = result["series"][0]["points"];
+    ASSERT_EQ(points.size(), static_cast<size_t>(POINTS));
+    for (int i = 0; i < POINTS; ++i) {
+        ASSERT_EQ(points[i][0], BASE_MS + 1000 * i);
+        ASSERT_EQ(points[i][1], i);
+    }
+
+    const auto part = query("/api/range?channel=fast&from=" + seconds(BASE + 10s) + "&to=" + seconds(BASE + 12s));
+    EXPECT_EQ(part["series"][0]["points"].size(), 3u);
+    EXPECT_TRUE(get(server_->address(), "/api/range").starts_with("HTTP/1.1 400 "));
+    EXPECT_TRUE(get(server_->address(), "/api/range?channel=fast&from=yesterday").starts_with("HTTP/1.1 400 "));
+}
+
+TEST_F(HistoryApiTest, AggregatesRawPointsAndMergesRollups) {
+    RollupEngine rollups({RollupEngine::parseWindow("1m")});
+    std::vector<std::string> names;
+    std::vector<TimeSeriesStore::Value> stored;
+    const RollupEngine::Emit keep = [&](const RollupEngine::Rollup& rollup) {
+        RollupEngine::toValues(rollup, names, stored);
+        store_->append("bme280/1m", rollup.start, stored);
+    };
+    // Two hours of readings every 10 s: temperature 0..719
+    for (int i = 0; i < 720; ++i) {
+        const TimeSeriesStore::Value values[] = {{"temperature", static_cast<double>(i)}};
+        store_->append("bme280", BASE + std::chrono::seconds(10 * i), values);
+        rollups.add("bme280", BASE + std::chrono::seconds(10 * i), values, keep);
+    }
+    rollups.flush(BASE + 2h, keep);
+    serve();
+
+    const auto range = "&from=" + seconds(BASE) + "&to=" + seconds(BASE + 2h);
+    for (const std::string channel : {"bme280", "bme280%2F1m"}) {
+        const auto result = query("/api/aggregate?channel=" + channel + "&step=1h" + range);
+        ASSERT_EQ(result["buckets"].size(), 2u) << channel;
+        const auto& second_hour = result["buckets"][1];
+        EXPECT_EQ(second_hour["t"], BASE_MS + 3600000);
+        const auto& temperature = second_hour["fields"]["temperature"];
+        EXPECT_EQ(temperature["count"], 360);
+        EXPECT_DOUBLE_EQ(temperature["mean"].get<double>(), 539.5);
+        EXPECT_EQ(temperature["min"], 360.0);
+        EXPECT_EQ(temperature["max"], 719.0);
+        EXPECT_NEAR(temperature["stddev"].get<double>(), std::sqrt((360.0 * 360.0 - 1) / 12.0), 1e-6);
+    }
+    EXPECT_EQ(query("/api/aggregate?channel=bme280&step=10m" + range)["buckets"].size(), 12u);
+    EXPECT_TRUE(get(server_->address(), "/api/aggregate?channel=bme280&step=week").starts_with("HTTP/1.1 400 "));
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,118 @@
+#include "LocalApi/http_server.h"
+#include "http_client.h"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using namespace TestClient;
+
+HttpServer::Options localOptions() {
+    HttpServer::Options options;
+    options.listen = "127.0.0.1:0";
+    return options;
+}
+
+size_t count(const std::string& text, std::string_view part) {
+    size_t found = 0;
+    for (size_t at = text.find(part); at != std::string::npos; at = text.find(part, at + 1)) ++found;
+    return found;
+}
+
+} // namespace
+
+TEST(HttpServerTest, AnswersRoutesWithDecodedParameters) {
+    HttpServer server(localOptions());
+    server.route("/echo", [](const HttpServer::Request& request, HttpServer::Response& response) {
+        response.content_type = "text/plain";
+        response.body = std::string(request.param("name", "none")) + "|" + std::string(request.param("other", "none"));
+    });
+    server.start();
+
+    const auto response = get(server.address(), "/echo?name=a%2Fb+c&empty=");
+    EXPECT_TRUE(response.starts_with("HTTP/1.1 200 OK\r\n")) << response;
+    EXPECT_NE(response.find("Content-Type: text/plain\r\n"), std::string::npos);
+    EXPECT_NE(response.find("Content-Length: 10\r\n"), std::string::npos);
+    EXPECT_EQ(body(response), "a/b c|none");
+    EXPECT_EQ(server.stats().requests, 1u);
+}
+
+TEST(HttpServerTest, StreamsChunkedParts) {
+    HttpServer server(localOptions());
+    server.route("/stream", [](const HttpServer::Request&, HttpServer::Response& response) {
+        response.stream = [part = 0](std::string& out) mutable {
+            out.assign(100000, static_cast<char>('a' + part));
+            return ++part < 5;
+        };
+    });
+    server.start();
+
+    const auto response = get(server.address(), "/stream");
+    EXPECT_NE(response.find("Transfer-Encoding: chunked\r\n"), std::string::npos);
+    const auto streamed = body(response);
+    ASSERT_EQ(streamed.size(), 500000u);
+    EXPECT_EQ(streamed.front(), 'a');
+    EXPECT_EQ(streamed.back(), 'e');
+
+    // HTTP/1.0: no chunked framing, the end of the body is the end of the connection
+    const auto old = roundTrip(server.address(), "GET /stream HTTP/1.0\r\n\r\n");
+    EXPECT_EQ(old.find("Transfer-Encoding"), std::string::npos);
+    EXPECT_EQ(body(old).size(), 500000u);
+}
+
+TEST(HttpServerTest, KeepsConnectionsAliveAcrossRequests) {
+    HttpServer server(localOptions());
+    server.route("/a", [](const HttpServer::Request&, HttpServer::Response& response) { response.body = "{}"; });
+    server.start();
+
+    const auto response = roundTrip(server.address(), "GET /a HTTP/1.1\r\n\r\nGET /a HTTP/1.1\r\n\r\n"
+                                                      "GET /a HTTP/1.1\r\nConnection: close\r\n\r\n");
+    EXPECT_EQ(count(response, "HTTP/1.1 200 OK"), 3u);
+    EXPECT_EQ(count(response, "Connection: close"), 1u);
+    EXPECT_EQ(server.stats().connections, 1u);
+}
+
+TEST(HttpServerTest, AnswersErrors) {
+    HttpServer server(localOptions());
+    server.route("/bad", [](const HttpServer::Request&, HttpServer::Response&) { throw std::invalid_argument("no \"x\""); });
+    server.route("/broken", [](const HttpServer::Request&, HttpServer::Response&) { throw std::runtime_error("boom"); });
+    server.start();
+
+    EXPECT_TRUE(get(server.address(), "/missing").starts_with("HTTP/1.1 404 "));
+    const auto bad = get(server.address(), "/bad");
+    EXPECT_TRUE(bad.starts_with("HTTP/1.1 400 "));
+    EXPECT_EQ(body(bad), R"({"error":"no \"x\""})");
+    EXPECT_TRUE(get(server.address(), "/broken").starts_with("HTTP/1.1 500 "));
+    const auto post = roundTrip(server.address(), "POST /bad HTTP/1.1\r\nContent-Length: 2\r\n\r\n{}");
+    EXPECT_TRUE(post.starts_with("HTTP/1.1 413 ")) << post;
+    EXPECT_TRUE(roundTrip(server.address(), "DELETE /bad HTTP/1.1\r\nConnection: close\r\n\r\n").starts_with("HTTP/1.1 405 "));
+    EXPECT_TRUE(roundTrip(server.address(), "GET /bad HTTP/2.0\r\n\r\n").starts_with("HTTP/1.1 505 "));
+    EXPECT_TRUE(roundTrip(server.address(), std::string(10000, 'x')).starts_with("HTTP/1.1 431 "));
+    EXPECT_EQ(server.stats().errors, 7u);
+}
+
+TEST(HttpServerTest, ListensOnUnixSocket) {
+    const auto path = std::filesystem::temp_directory_path() / "http_server_test.sock";
+    {
+        HttpServer::Options options;
+        options.listen = "unix:" + path.string();
+        HttpServer server(options);
+        server.route("/a", [](const HttpServer::Request&, HttpServer::Response& response) { response.body = "[]"; });
+        server.start();
+        EXPECT_EQ(body(get(server.address(), "/a")), "[]");
+    }
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(HttpServerTest, RejectsMalformedAddresses) {
+    HttpServer::Options options;
+    for (const char* listen : {"nonsense", "unix:", "[::1]8080"}) {
+        options.listen = listen;
+        EXPECT_THROW(HttpServer{options}, std::invalid_argument) << listen;
+    }
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,116 @@
+#include "LocalApi/live_feed.h"
+#include "http_client.h"
+#include "gtest/gtest.h"
+
+namespace SensorHub::Components {
+
+namespace {
+
+using namespace TestClient;
+using json = nlohmann::json;
+
+const LiveFeed::Clock::time_point TIME{std::chrono::milliseconds(1700000000123)};
+
+json next(const LiveFeed& feed, LiveFeed::Cursor& cursor) {
+    std::string out;
+    if (!feed.collect(cursor, out)) return nullptr;
+    return json::parse(out);
+}
+
+} // namespace
+
+TEST(LiveFeedTest, SendsSnapshotThenChangedReadings) {
+    LiveFeed feed("rpi");
+    feed.update("bme280", "BME280", TIME, json{{"temperature", 21.5}, {"humidity", 40}});
+    feed.update("door", "Dummy", TIME, json{{"open", true}});
+
+    LiveFeed::Cursor cursor;
+    const auto snapshot = next(feed, cursor);
+    EXPECT_EQ(snapshot["type"], "snapshot");
+    EXPECT_EQ(snapshot["platform"], "rpi");
+    EXPECT_EQ(snapshot["readings"]["bme280"],
+              (json{{"sensor_type", "BME280"}, {"timestamp", 1700000000123}, {"temperature", 21.5}, {"humidity", 40}}));
+    EXPECT_EQ(snapshot["readings"].size(), 2u);
+    EXPECT_TRUE(next(feed, cursor).is_null());
+
+    feed.update("door", "Dummy", TIME, json{{"open", false}});
+    feed.remove("bme280");
+    feed.remove("never_seen");
+    const auto delta = next(feed, cursor);
+    EXPECT_EQ(delta["type"], "delta");
+    EXPECT_EQ(delta["readings"], (json{{"door", {{"sensor_type", "Dummy"}, {"timestamp", 1700000000123}, {"open", false}}},
+                                       {"bme280", nullptr}}));
+
+    LiveFeed::Cursor late;
+    EXPECT_EQ(next(feed, late)["readings"].size(), 1u); // Removed channels are left out of snapshots
+    LiveFeed::Cursor empty;
+    EXPECT_TRUE(next(LiveFeed(), empty)["readings"].empty()); // A snapshot goes out even with nothing in it
+}
+
+TEST(LiveFeedTest, CoalescesReadingsAClientHasNotTaken) {
+    LiveFeed feed;
+    LiveFeed::Cursor cursor;
+    next(feed, cursor);
+    for (int i = 0; i < 1000; ++i) feed.update("fast", "Dummy", TIME, json{{"counter", i}});
+    const auto delta = next(feed, cursor);
+    EXPECT_EQ(delta["readings"]["fast"]["counter"], 999);
+    EXPECT_TRUE(next(feed, cursor).is_null());
+}
+
+TEST(LiveFeedTest, PushesOverWebSocket) {
+    HttpServer::Options options;
+    options.listen = "127.0.0.1:0";
+    LiveFeed feed("rpi");
+    HttpServer server(options);
+    feed.attach(server);
+    server.start();
+    feed.update("bme280", "BME280", TIME, json{{"temperature", 21.5}});
+
+    WebSocketClient client(server.address(), "/live");
+    EXPECT_TRUE(client.head().starts_with("HTTP/1.1 101 ")) << client.head();
+    EXPECT_NE(client.head().find("Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"), std::string::npos);
+    const auto [opcode, snapshot] = client.receive();
+    EXPECT_EQ(opcode, 1);
+    EXPECT_EQ(json::parse(snapshot)["readings"]["bme280"]["temperature"], 21.5);
+
+    feed.update("bme280", "BME280", TIME, json{{"temperature", 22.0}});
+    const auto delta = json::parse(client.receive().second);
+    EXPECT_EQ(delta["type"], "delta");
+    EXPECT_EQ(delta["readings"]["bme280"]["temperature"], 22.0);
+
+    client.send(0x9, "ping");
+    EXPECT_EQ(client.receive(), std::make_pair(0xA, std::string("ping")));
+    client.send(0x8, std::string("\x03\xE8", 2));
+    EXPECT_EQ(client.receive(), std::make_pair(0x8, std::string("\x03\xE8", 2)));
+    EXPECT_EQ(client.receive().first, -1);
+
+    EXPECT_TRUE(get(server.address(), "/live").starts_with("HTTP/1.1 426 ")); // Not an upgrade
+    EXPECT_EQ(server.stats().messages, 2u);
+}
+
+TEST(LiveFeedTest, SlowClientGetsNewestReadingsWithoutHoldingUpUpdates) {
+    HttpServer::Options options;
+    options.listen = "127.0.0.1:0";
+    LiveFeed feed;
+    HttpServer server(options);
+    feed.attach(server);
+    server.start();
+
+    WebSocketClient slow(server.address(), "/live");
+    slow.receive(); // Snapshot; then it stops reading while far more than socket buffers hold comes in
+    constexpr int UPDATES = 20000;
+    const std::string padding(1000, 'x');
+    for (int i = 0; i < UPDATES; ++i) feed.update("fast", "Dummy", TIME, json{{"counter", i}, {"padding", padding}});
+
+    int messages = 0;
+    for (int counter = -1; counter != UPDATES - 1; ++messages) {
+        const auto [opcode, message] = slow.receive();
+        ASSERT_EQ(opcode, 1);
+        const int received = json::parse(message)["readings"]["fast"]["counter"];
+        ASSERT_GT(received, counter); // In order, possibly skipping
+        counter = received;
+    }
+    EXPECT_LT(messages, UPDATES);
+}
+
+} // namespace SensorHub::Components
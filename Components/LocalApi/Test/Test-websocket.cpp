@@ -0,0 +1,50 @@
+#include "websocket.h"
+#include "gtest/gtest.h"
+
+namespace SensorHub::Components {
+
+TEST(WebSocketTest, AcceptKeyMatchesRfcExample) {
+    EXPECT_EQ(WebSocket::acceptKey("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST(WebSocketTest, ParsesMaskedClientFrames) {
+    // RFC 6455 section 5.7: a masked "Hello"
+    const std::string hello = "\x81\x85\x37\xfa\x21\x3d\x7f\x9f\x4d\x51\x58";
+    WebSocket::Frame frame;
+    size_t consumed = 0;
+    ASSERT_EQ(WebSocket::parseFrame(hello + "\x89", 1024, frame, consumed), WebSocket::ParseResult::Frame);
+    EXPECT_EQ(consumed, hello.size());
+    EXPECT_EQ(frame.opcode, WebSocket::TEXT);
+    EXPECT_TRUE(frame.fin);
+    EXPECT_EQ(frame.payload, "Hello");
+
+    for (size_t size = 0; size < hello.size(); ++size) {
+        EXPECT_EQ(WebSocket::parseFrame(hello.substr(0, size), 1024, frame, consumed), WebSocket::ParseResult::Incomplete);
+    }
+    EXPECT_EQ(WebSocket::parseFrame("\x81\x05Hello", 1024, frame, consumed), WebSocket::ParseResult::Malformed);
+    EXPECT_EQ(WebSocket::parseFrame(hello, 4, frame, consumed), WebSocket::ParseResult::TooBig);
+    const std::string long_ping("\x89\xFE\x01\x00", 4); // Control frames carry at most 125 bytes
+    EXPECT_EQ(WebSocket::parseFrame(long_ping, 1024, frame, consumed), WebSocket::ParseResult::Malformed);
+}
+
+TEST(WebSocketTest, FramesPayloadsWithExtendedLengths) {
+    std::string out;
+    WebSocket::appendFrame(WebSocket::TEXT, "hi", out);
+    EXPECT_EQ(out, "\x81\x02hi");
+
+    out.clear();
+    WebSocket::appendFrame(WebSocket::TEXT, std::string(300, 'x'), out);
+    ASSERT_EQ(out.size(), 4u + 300u);
+    EXPECT_EQ(out.substr(0, 4), std::string("\x81\x7E\x01\x2C", 4));
+
+    out.clear();
+    WebSocket::appendFrame(WebSocket::BINARY, std::string(70000, 'x'), out);
+    ASSERT_EQ(out.size(), 10u + 70000u);
+    EXPECT_EQ(out.substr(0, 10), std::string("\x82\x7F\x00\x00\x00\x00\x00\x01\x11\x70", 10));
+
+    out.clear();
+    WebSocket::appendClose(WebSocket::CLOSE_NORMAL, out);
+    EXPECT_EQ(out, std::string("\x88\x02\x03\xE8", 4));
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace SensorHub::Components::TestClient {
+
+/**
+ * @brief Connects to an HttpServer address ("127.0.0.1:port" or "unix:/path"); -1 on failure.
+ */
+inline int connectTo(const std::string& address) {
+    if (address.starts_with("unix:")) {
+        sockaddr_un target{};
+        target.sun_family = AF_UNIX;
+        const std::string path = address.substr(5);
+        std::memcpy(target.sun_path, path.c_str(), path.size() + 1);
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&target), sizeof(target)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+    const size_t colon = address.rfind(':');
+    sockaddr_in target{};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(static_cast<uint16_t>(std::stoi(address.substr(colon + 1))));
+    ::inet_pton(AF_INET, address.substr(0, colon).c_str(), &target.sin_addr);
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&target), sizeof(target)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Sends raw request bytes and reads until the server closes the connection.
+ */
+inline std::string roundTrip(const std::string& address, std::string_view request) {
+    const int fd = connectTo(address);
+    if (fd < 0) return {};
+    ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    std::string response;
+    char buffer[65536];
+    for (ssize_t n; (n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0;) response.append(buffer, static_cast<size_t>(n));
+    ::close(fd);
+    return response;
+}
+
+/**
+ * @brief GET with "Connection: close": the whole response, head included.
+ */
+inline std::string get(const std::string& address, const std::string& target) {
+    return roundTrip(address, "GET " + target + " HTTP/1.1\r\nHost: test\r\nConnection: close\r\n\r\n");
+}
+
+/**
+ * @brief The body of a response, with chunked framing removed.
+ */
+inline std::string body(const std::string& response) {
+    const size_t head_end = response.find("\r\n\r\n");
+    if (head_end == std::string::npos) return {};
+    const std::string_view head(response.data(), head_end);
+    std::string_view rest(response.data() + head_end + 4, response.size() - head_end - 4);
+    if (head.find("Transfer-Encoding: chunked") == std::string_view::npos) return std::string(rest);
+    std::string out;
+    for (;;) {
+        const size_t line_end = rest.find("\r\n");
+        if (line_end == std::string_view::npos) return out;
+        const size_t size = std::stoul(std::string(rest.substr(0, line_end)), nullptr, 16);
+        if (size == 0) return out;
+        out.append(rest.substr(line_end + 2, size));
+        rest.remove_prefix(line_end + 2 + size + 2);
+    }
+}
+
+/**
+ * @brief Blocking WebSocket client: handshake, masked frames out, whole frames in.
+ * Receives time out after 5 s so a broken server fails the test instead of hanging it.
+ */
+class WebSocketClient {
+public:
+    WebSocketClient(const std::string& address, const std::string& target) : fd_(connectTo(address)) {
+        timeval timeout{5, 0};
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        const std::string request = "GET " + target + " HTTP/1.1\r\nHost: test\r\nUpgrade: websocket\r\n"
+                                    "Connection: keep-alive, Upgrade\r\nSec-WebSocket-Version: 13\r\n"
+                                    "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n\r\n";
+        ::send(fd_, request.data(), request.size(), MSG_NOSIGNAL);
+        size_t head_end;
+        while ((head_end = buffer_.find("\r\n\r\n")) == std::string::npos && fill()) {}
+        if (head_end == std::string::npos) return;
+        head_ = buffer_.substr(0, head_end + 4);
+        buffer_.erase(0, head_end + 4);
+    }
+
+    ~WebSocketClient() { ::close(fd_); }
+
+    WebSocketClient(const WebSocketClient&) = delete;
+    WebSocketClient& operator=(const WebSocketClient&) = delete;
+
+    /**
+     * @brief The handshake response, head only.
+     */
+    const std::string& head() const { return head_; }
+
+    void send(uint8_t opcode, std::string_view payload) {
+        static constexpr uint8_t MASK[4] = {0x12, 0x34, 0x56, 0x78};
+        std::string frame{static_cast<char>(0x80 | opcode), static_cast<char>(0x80 | payload.size())};
+        frame.append(reinterpret_cast<const char*>(MASK), sizeof(MASK));
+        for (size_t i = 0; i < payload.size(); ++i) frame.push_back(static_cast<char>(payload[i] ^ MASK[i % 4]));
+        ::send(fd_, frame.data(), frame.size(), MSG_NOSIGNAL);
+    }
+
+    /**
+     * @brief The next frame's opcode and payload; opcode -1 once the connection is closed.
+     */
+    std::pair<int, std::string> receive() {
+        for (;;) {
+            if (buffer_.size() >= 2) {
+                const auto byte = [&](size_t i) { return static_cast<uint8_t>(buffer_[i]); };
+                size_t header = 2;
+                uint64_t size = byte(1) & 0x7F;
+                if (size >= 126) {
+                    const size_t length_bytes = size == 126 ? 2 : 8;
+                    if (buffer_.size() >= header + length_bytes) {
+                        size = 0;
+                        for (size_t i = 0; i < length_bytes; ++i) size = size << 8 | byte(header + i);
+                    }
+                    header += length_bytes;
+                }
+                if (buffer_.size() >= header + size) {
+                    std::pair<int, std::string> frame{byte(0) & 0x0F, buffer_.substr(header, size)};
+                    buffer_.erase(0, header + size);
+                    return frame;
+                }
+            }
+            if (!fill()) return {-1, {}};
+        }
+    }
+
+private:
+    bool fill() {
+        char data[65536];
+        const ssize_t n = ::recv(fd_, data, sizeof(data), 0);
+        if (n <= 0) return false;
+        buffer_.append(data, static_cast<size_t>(n));
+        return true;
+    }
+
+    int fd_;
+    std::string head_;
+    std::string buffer_;
+};
+
+} // namespace SensorHub::Components::TestClient
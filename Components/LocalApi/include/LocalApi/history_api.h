@@ -0,0 +1,48 @@
+#pragma once
+
+#include "History/time_series_store.h"
+#include "LocalApi/http_server.h"
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Read-only JSON queries over a TimeSeriesStore, served by an HttpServer.
+ *
+ * - GET /api/channels: every channel and the time range of its points.
+ * - GET /api/latest?channel=C: the newest point of C, or of every channel without it.
+ * - GET /api/range?channel=C&from=F&to=T: the points of C in [F, T], as series of rows
+ *   [time, value...] that share a list of fields.
+ * - GET /api/aggregate?channel=C&from=F&to=T&step=S: count, mean, stddev, min and max of
+ *   every field per wall-clock aligned step ("1m", "1h", "1d"; default "1h"). Columns
+ *   stored by a rollup ("<field>.count", "<field>.sum"...) are merged exactly instead of
+ *   averaged, so a rollup channel ("bme280/1m") answers year-long queries from a few
+ *   hundred thousand points.
+ *
+ * Times are Unix seconds in requests (fractions allowed; a negative value counts back
+ * from now; from defaults to the epoch, to to now) and Unix milliseconds in responses.
+ * Range and aggregate responses are streamed: each part scans on from where the last
+ * one ended, straight from the store's mapped blocks, so memory use does not grow with
+ * the range. Points sharing the timestamp at which a part ends may be cut short.
+ */
+class HistoryApi {
+public:
+    /**
+     * @param store Must outlive every server this is attached to.
+     */
+    explicit HistoryApi(const TimeSeriesStore& store) : store_(store) {}
+
+    /**
+     * @brief Adds the routes to server. Call before the server starts.
+     */
+    void attach(HttpServer& server) const;
+
+private:
+    void channels(const HttpServer::Request& request, HttpServer::Response& response) const;
+    void latest(const HttpServer::Request& request, HttpServer::Response& response) const;
+    void range(const HttpServer::Request& request, HttpServer::Response& response) const;
+    void aggregate(const HttpServer::Request& request, HttpServer::Response& response) const;
+
+    const TimeSeriesStore& store_;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Small HTTP/1.1 server for local clients (dashboards, scripts) on a TCP port or a
+ * Unix socket.
+ *
+ * One I/O thread accepts connections and serves them on non-blocking sockets and epoll,
+ * one request at a time per connection, with keep-alive. Only GET is supported and
+ * requests with a body are refused. Handlers are looked up by exact path and run on the
+ * I/O thread, so they should answer quickly or stream.
+ *
+ * A response either carries its body, sent with Content-Length, or a stream: a callback
+ * that appends the next part of the body whenever the connection's unsent output is
+ * below a low-water mark. Each part goes out as one chunk (Transfer-Encoding: chunked),
+ * so a long response is never held in memory as a whole and a slow client only holds
+ * back its own stream. HTTP/1.0 clients get the stream unframed, then the connection
+ * closes.
+ *
+ * Paths registered with websocket() answer a GET with "Upgrade: websocket" by switching the
+ * connection to WebSocket (RFC 6455) and pushing text messages to it. Each client has its
+ * own MessageSource, asked for the next message only once everything sent before has left
+ * the process, and again on notify(). A client that reads slowly is simply asked less
+ * often, so the source can fold what it missed into one message instead of queueing it,
+ * and no producer ever waits for a socket. Clients are pinged after half the idle timeout
+ * without traffic; frames they send are answered (ping, close) but otherwise ignored.
+ *
+ * Addresses: "host:port" ("127.0.0.1:8080", "[::1]:8080", ":8080" for every interface;
+ * port 0 picks a free one) or "unix:/path" (an existing socket file is replaced, and
+ * removed again by the destructor).
+ */
+class HttpServer {
+public:
+    struct Options {
+        std::string listen{"127.0.0.1:8080"};
+        size_t max_connections = 16;
+        size_t max_request_bytes = 8192;               // Request line and headers
+        std::chrono::milliseconds idle_timeout{30000}; // Without progress in either direction
+    };
+
+    struct Request {
+        std::string method;
+        std::string path;                                       // Decoded, without the query
+        std::map<std::string, std::string, std::less<>> query;  // Decoded parameters
+        std::map<std::string, std::string, std::less<>> headers; // Names in lower case
+
+        /**
+         * @brief The query parameter, or fallback if it is absent.
+         */
+        std::string_view param(std::string_view name, std::string_view fallback = {}) const;
+    };
+
+    struct Response {
+        int status = 200;
+        std::string content_type{"application/json"};
+        std::string body;
+
+        /**
+         * @brief If set, the body is streamed instead: appends the next part to out and returns
+         * false once that was the last one. Runs on the I/O thread; an exception drops the
+         * connection, since the status has already gone out.
+         */
+        std::function<bool(std::string& out)> stream;
+    };
+
+    /**
+     * @brief Fills in the response. Throwing std::invalid_argument answers 400 with the
+     * message; any other exception answers 500.
+     */
+    using Handler = std::function<void(const Request&, Response&)>;
+
+    /**
+     * @brief A WebSocket client's messages: appends the next one to out and returns true, or
+     * returns false if there is nothing new for this client. Runs on the I/O thread.
+     */
+    using MessageSource = std::function<bool(std::string& out)>;
+
+    /**
+     * @brief Returns the MessageSource of a new WebSocket client. Throwing
+     * std::invalid_argument refuses the upgrade with 400.
+     */
+    using WebSocketHandler = std::function<MessageSource(const Request&)>;
+
+    struct Stats {
+        uint64_t connections = 0; // Accepted since start
+        uint64_t rejected = 0;    // Closed at once: max_connections reached
+        uint64_t requests = 0;
+        uint64_t errors = 0;      // Answered 4xx/5xx, or dropped mid-stream
+        size_t open = 0;
+        size_t websockets = 0;    // Open WebSocket clients
+        uint64_t messages = 0;    // WebSocket messages sent
+    };
+
+    /**
+     * @brief Binds and listens; serving starts with start().
+     * @throws std::invalid_argument if the address is malformed.
+     * @throws std::system_error if the socket cannot be bound or epoll cannot be set up.
+     */
+    explicit HttpServer(Options options);
+
+    /**
+     * @brief Stops the I/O thread and closes every connection.
+     */
+    ~HttpServer();
+
+    // Delete copy/move operations (the I/O thread refers to this object)
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+    HttpServer(HttpServer&&) = delete;
+    HttpServer& operator=(HttpServer&&) = delete;
+
+    /**
+     * @brief Serves GET requests for path with handler. Call before start().
+     */
+    void route(std::string path, Handler handler);
+
+    /**
+     * @brief Accepts WebSocket clients on path with handler. Call before start().
+     */
+    void websocket(std::string path, WebSocketHandler handler);
+
+    /**
+     * @brief Asks every WebSocket client's source for a new message, as soon as the client has
+     * taken its earlier output. Thread-safe and cheap: calls before the I/O thread got to the
+     * previous one are merged, and nothing happens without clients.
+     */
+    void notify();
+
+    /**
+     * @brief Starts the I/O thread.
+     */
+    void start();
+
+    /**
+     * @brief The bound address: "host:port" with the actual port, or "unix:/path".
+     */
+    const std::string& address() const { return address_; }
+
+    Stats stats() const;
+
+private:
+    struct Connection;
+
+    void run();
+    void accept();
+    void closeConnection(int fd);
+    bool readInput(Connection& connection);
+    bool serve(Connection& connection);
+    bool takeRequest(Connection& connection);
+    void respond(Connection& connection, const Request& request, int error_status);
+    bool produce(Connection& connection);
+    bool sendOutput(Connection& connection, bool& full);
+    bool serveWebSocket(Connection& connection);
+    void readFrames(Connection& connection);
+    void pushMessages();
+    void watchOutput(Connection& connection, bool enable);
+    void closeIdle(std::chrono::steady_clock::time_point now);
+
+    const Options options_;
+    std::string address_;
+    std::string unix_path_; // Removed by the destructor
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::thread io_thread_;
+    std::atomic<bool> stop_{false};
+    std::map<std::string, Handler, std::less<>> routes_; // Fixed once started
+    std::map<std::string, WebSocketHandler, std::less<>> websockets_;
+    std::atomic<bool> notified_{false}; // A wake for notify() is pending
+
+    // I/O thread only
+    std::map<int, std::unique_ptr<Connection>> connections_;
+    std::string chunk_; // Scratch for one streamed part
+
+    std::atomic<uint64_t> accepted_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<size_t> open_{0};
+    std::atomic<size_t> websocket_clients_{0};
+    std::atomic<uint64_t> messages_{0};
+};
+
+} // namespace SensorHub::Components
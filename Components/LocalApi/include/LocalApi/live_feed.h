@@ -0,0 +1,90 @@
+#pragma once
+
+#include "LocalApi/http_server.h"
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Latest reading of every sensor, pushed to WebSocket clients of an HttpServer.
+ *
+ * A client gets {"type":"snapshot","platform":P,"readings":{channel: reading...}} with every
+ * sensor on connect, then {"type":"delta",...} messages holding only the readings that
+ * changed since its previous message (null for a removed channel). Each reading is the
+ * sensor's JSON plus "sensor_type" and "timestamp" (Unix milliseconds).
+ *
+ * Every reading carries a version; a client remembers the version it has been sent up to.
+ * A client whose socket keeps up gets one delta per reading. One that falls behind is asked
+ * for its next message only once it has taken the previous one, and that delta then holds
+ * each sensor's newest reading once, however many came in between: its backlog is bounded
+ * by the number of sensors, and update() never waits for a client.
+ */
+class LiveFeed {
+public:
+    using Clock = std::chrono::system_clock;
+
+    /**
+     * @brief How far one client has been sent.
+     */
+    struct Cursor {
+        uint64_t version = 0;
+        bool started = false; // Snapshot sent
+    };
+
+    /**
+     * @param platform Sent with every message.
+     */
+    explicit LiveFeed(std::string platform = {});
+
+    /**
+     * @brief Serves the feed on path. Call before the server starts; the server must not
+     * outlive this object.
+     */
+    void attach(HttpServer& server, std::string path = "/live");
+
+    /**
+     * @brief Replaces the reading of channel and wakes the clients. Call from one thread at a
+     * time (the hub's sampling thread); clients are served concurrently.
+     */
+    void update(std::string_view channel, std::string_view sensor_type, Clock::time_point time,
+                const nlohmann::json& reading);
+
+    /**
+     * @brief Drops channel (a sensor removed by a reload): clients get null for it.
+     */
+    void remove(std::string_view channel);
+
+    /**
+     * @brief Appends the client's next message to out and advances cursor: the snapshot first,
+     * then every reading newer than the cursor.
+     * @return false if there is nothing new (out is left alone).
+     */
+    bool collect(Cursor& cursor, std::string& out) const;
+
+private:
+    struct Entry {
+        std::string channel;
+        std::string reading; // JSON object; empty once removed
+        uint64_t version = 0;
+    };
+
+    Entry* find(std::string_view channel); // Under mutex_
+    void publish(std::string_view channel, std::string& reading);
+
+    std::string platform_; // Encoded JSON string
+    HttpServer* server_ = nullptr;
+    std::string scratch_; // update() only: the next reading, encoded outside the lock
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_; // Few sensors: a linear lookup beats a map
+    uint64_t version_ = 0;       // Newest version of any entry
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,365 @@
+#include "LocalApi/history_api.h"
+#include "Encoding/payload_encoder.h"
+#include "History/rollup_engine.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using Clock = TimeSeriesStore::Clock;
+
+constexpr size_t PART_BYTES = 32 * 1024; // A streamed part ends after the block that reaches this size
+
+int64_t toNs(Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+Clock::time_point fromNs(int64_t ns) { return Clock::time_point(std::chrono::nanoseconds(ns)); }
+
+void appendInteger(int64_t value, std::string& out) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendMs(int64_t ns, std::string& out) { appendInteger(ns / 1000000, out); }
+
+void appendNumber(double value, std::string& out) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+std::string_view requireChannel(const HttpServer::Request& request) {
+    const std::string_view channel = request.param("channel");
+    if (channel.empty()) throw std::invalid_argument("Parameter 'channel' is required");
+    return channel;
+}
+
+// Unix seconds, fractions allowed; a negative value counts back from now
+int64_t timeParam(const HttpServer::Request& request, std::string_view name, int64_t fallback_ns, int64_t now_ns) {
+    const std::string_view text = request.param(name);
+    if (text.empty()) return fallback_ns;
+    double seconds = 0.0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), seconds);
+    if (error != std::errc{} || end != text.data() + text.size() || !std::isfinite(seconds)) {
+        throw std::invalid_argument("Parameter '" + std::string(name) + "' must be Unix seconds");
+    }
+    const auto ns = static_cast<int64_t>(seconds * 1e9);
+    return seconds < 0 ? now_ns + ns : ns;
+}
+
+bool sameFields(const std::vector<std::string>& known, std::span<const std::string> fields) {
+    return std::equal(known.begin(), known.end(), fields.begin(), fields.end());
+}
+
+/**
+ * @brief Body of /api/range, one part per call.
+ */
+struct RangeStream {
+    const TimeSeriesStore* store;
+    std::string channel;
+    int64_t next_ns; // Resume point
+    int64_t to_ns;
+    std::vector<std::string> fields; // Of the open series
+    bool started = false;
+    bool in_series = false;
+    bool first_row = true;
+
+    bool operator()(std::string& out) {
+        if (!started) {
+            out += "{\"channel\":";
+            PayloadEncoder::appendString(channel, out);
+            out += ",\"series\":[";
+            started = true;
+        }
+        bool full = false;
+        if (next_ns <= to_ns) {
+            store->scan(channel, fromNs(next_ns), fromNs(to_ns), [&](const TimeSeriesStore::BlockView& view) {
+                if (!in_series || !sameFields(fields, view.fields)) {
+                    if (in_series) out += "]},";
+                    fields.assign(view.fields.begin(), view.fields.end());
+                    out += "{\"fields\":[";
+                    for (size_t f = 0; f < fields.size(); ++f) {
+                        if (f) out += ',';
+                        PayloadEncoder::appendString(fields[f], out);
+                    }
+                    out += "],\"points\":[";
+                    in_series = true;
+                    first_row = true;
+                }
+                for (size_t i = 0; i < view.timestamps_ns.size(); ++i) {
+                    if (!first_row) out += ',';
+                    first_row = false;
+                    out += '[';
+                    appendMs(view.timestamps_ns[i], out);
+                    for (size_t f = 0; f < view.fields.size(); ++f) {
+                        out += ',';
+                        appendNumber(view.column(f)[i], out);
+                    }
+                    out += ']';
+                }
+                next_ns = view.timestamps_ns.back() + 1;
+                full = out.size() >= PART_BYTES;
+                return !full;
+            });
+        }
+        if (full) return true;
+        if (in_series) out += "]}";
+        out += "]}";
+        return false;
+    }
+};
+
+/**
+ * @brief Body of /api/aggregate, one part per call.
+ */
+struct AggregateStream {
+    static constexpr size_t STATISTICS = std::size(RollupEngine::STATISTICS);
+
+    // Where a field's values come from in the current fields: one raw column, or the columns of a rollup
+    struct Source {
+        size_t output = 0; // Index into names and current
+        bool rollup = false;
+        std::array<size_t, STATISTICS> columns{};
+    };
+
+    const TimeSeriesStore* store;
+    std::string channel;
+    std::string step;
+    int64_t step_ns;
+    int64_t next_ns;
+    int64_t to_ns;
+    std::vector<std::string> fields; // Of the last view
+    std::vector<Source> sources;
+    std::vector<std::string> names;  // Output fields seen so far
+    std::vector<RollupEngine::Aggregate> current; // Per output field, for the open bucket
+    int64_t bucket_ns = 0;
+    bool has_bucket = false;
+    bool started = false;
+    bool first_bucket = true;
+
+    size_t outputIndex(std::string_view name) {
+        const auto it = std::find(names.begin(), names.end(), name);
+        if (it != names.end()) return static_cast<size_t>(it - names.begin());
+        names.emplace_back(name);
+        current.emplace_back();
+        return names.size() - 1;
+    }
+
+    void mapFields(std::span<const std::string> view_fields) {
+        fields.assign(view_fields.begin(), view_fields.end());
+        sources.clear();
+        std::vector<bool> used(fields.size(), false);
+        // Complete sets of "<field>.<statistic>" columns are rollups of <field>
+        // (names are appended piecewise: "." + std::string trips GCC 12's -Wrestrict at -O3)
+        std::string suffix = ".";
+        suffix += RollupEngine::STATISTICS[0];
+        for (size_t f = 0; f < fields.size(); ++f) {
+            if (!fields[f].ends_with(suffix)) continue;
+            const std::string_view base = std::string_view(fields[f]).substr(0, fields[f].size() - suffix.size());
+            Source source;
+            source.rollup = true;
+            bool complete = true;
+            for (size_t s = 0; s < STATISTICS && complete; ++s) {
+                std::string column(base);
+                column += '.';
+                column += RollupEngine::STATISTICS[s];
+                const auto it = std::find(fields.begin(), fields.end(), column);
+                complete = it != fields.end();
+                if (complete) source.columns[s] = static_cast<size_t>(it - fields.begin());
+            }
+            if (!complete) continue;
+            for (const size_t column : source.columns) used[column] = true;
+            source.output = outputIndex(base);
+            sources.push_back(source);
+        }
+        for (size_t f = 0; f < fields.size(); ++f) {
+            if (used[f]) continue;
+            Source source;
+            source.columns[0] = f;
+            source.output = outputIndex(fields[f]);
+            sources.push_back(source);
+        }
+    }
+
+    void emitBucket(std::string& out) {
+        if (!first_bucket) out += ',';
+        first_bucket = false;
+        out += "{\"t\":";
+        appendMs(bucket_ns, out);
+        out += ",\"fields\":{";
+        bool first_field = true;
+        for (size_t i = 0; i < names.size(); ++i) {
+            auto& aggregate = current[i];
+            if (aggregate.count == 0) continue;
+            if (!first_field) out += ',';
+            first_field = false;
+            PayloadEncoder::appendString(names[i], out);
+            out += ":{\"count\":";
+            appendInteger(static_cast<int64_t>(aggregate.count), out);
+            out += ",\"mean\":";
+            appendNumber(aggregate.mean(), out);
+            out += ",\"stddev\":";
+            appendNumber(std::sqrt(aggregate.variance()), out);
+            out += ",\"min\":";
+            appendNumber(aggregate.min, out);
+            out += ",\"max\":";
+            appendNumber(aggregate.max, out);
+            out += '}';
+            aggregate = RollupEngine::Aggregate{};
+        }
+        out += "}}";
+    }
+
+    bool operator()(std::string& out) {
+        if (!started) {
+            out += "{\"channel\":";
+            PayloadEncoder::appendString(channel, out);
+            out += ",\"step\":";
+            PayloadEncoder::appendString(step, out);
+            out += ",\"buckets\":[";
+            started = true;
+        }
+        bool full = false;
+        if (next_ns <= to_ns) {
+            store->scan(channel, fromNs(next_ns), fromNs(to_ns), [&](const TimeSeriesStore::BlockView& view) {
+                if (!sameFields(fields, view.fields)) mapFields(view.fields);
+                for (size_t i = 0; i < view.timestamps_ns.size(); ++i) {
+                    const int64_t time_ns = view.timestamps_ns[i];
+                    int64_t start_ns = time_ns - time_ns % step_ns;
+                    if (start_ns > time_ns) start_ns -= step_ns;
+                    if (has_bucket && start_ns != bucket_ns) emitBucket(out);
+                    bucket_ns = start_ns;
+                    has_bucket = true;
+                    for (const auto& source : sources) {
+                        auto& aggregate = current[source.output];
+                        if (!source.rollup) {
+                            const double value = view.column(source.columns[0])[i];
+                            if (std::isfinite(value)) aggregate.add(value);
+                            continue;
+                        }
+                        const auto at = [&](size_t statistic) { return view.column(source.columns[statistic])[i]; };
+                        RollupEngine::Aggregate stored;
+                        stored.count = static_cast<uint64_t>(at(0));
+                        stored.min = at(1);
+                        stored.max = at(2);
+                        stored.sum = at(3);
+                        stored.sum_squares = at(4);
+                        stored.first = at(5);
+                        stored.last = at(6);
+                        aggregate.merge(stored);
+                    }
+                }
+                next_ns = view.timestamps_ns.back() + 1;
+                full = out.size() >= PART_BYTES;
+                return !full;
+            });
+        }
+        if (full) return true;
+        if (has_bucket) emitBucket(out);
+        out += "]}";
+        return false;
+    }
+};
+
+} // namespace
+
+void HistoryApi::attach(HttpServer& server) const {
+    server.route("/api/channels", [this](const auto& request, auto& response) { channels(request, response); });
+    server.route("/api/latest", [this](const auto& request, auto& response) { latest(request, response); });
+    server.route("/api/range", [this](const auto& request, auto& response) { range(request, response); });
+    server.route("/api/aggregate", [this](const auto& request, auto& response) { aggregate(request, response); });
+}
+
+void HistoryApi::channels(const HttpServer::Request&, HttpServer::Response& response) const {
+    std::string& out = response.body;
+    out += "{\"channels\":[";
+    bool first = true;
+    for (const auto& info : store_.channels()) {
+        if (!first) out += ',';
+        first = false;
+        out += "{\"channel\":";
+        PayloadEncoder::appendString(info.name, out);
+        out += ",\"first\":";
+        appendMs(toNs(info.first), out);
+        out += ",\"last\":";
+        appendMs(toNs(info.last), out);
+        out += '}';
+    }
+    out += "]}";
+}
+
+void HistoryApi::latest(const HttpServer::Request& request, HttpServer::Response& response) const {
+    const std::string_view wanted = request.param("channel");
+    std::string& out = response.body;
+    std::vector<std::string> fields;
+    std::vector<double> values;
+    int64_t time_ns = 0;
+    bool any = false;
+    if (wanted.empty()) out += "{\"channels\":[";
+    for (const auto& info : store_.channels()) {
+        if (!wanted.empty() && info.name != wanted) continue;
+        // Only the newest timestamp is scanned; of equal ones the last appended wins
+        fields.clear();
+        store_.scan(info.name, info.last, info.last, [&](const TimeSeriesStore::BlockView& view) {
+            const size_t last = view.timestamps_ns.size() - 1;
+            time_ns = view.timestamps_ns[last];
+            fields.assign(view.fields.begin(), view.fields.end());
+            values.clear();
+            for (size_t f = 0; f < fields.size(); ++f) values.push_back(view.column(f)[last]);
+            return true;
+        });
+        if (fields.empty()) continue;
+        if (any) out += ',';
+        any = true;
+        out += "{\"channel\":";
+        PayloadEncoder::appendString(info.name, out);
+        out += ",\"t\":";
+        appendMs(time_ns, out);
+        out += ",\"values\":{";
+        for (size_t f = 0; f < fields.size(); ++f) {
+            if (f) out += ',';
+            PayloadEncoder::appendString(fields[f], out);
+            out += ':';
+            appendNumber(values[f], out);
+        }
+        out += "}}";
+    }
+    if (wanted.empty()) {
+        out += "]}";
+    } else if (!any) {
+        response.status = 404;
+        out = "{\"error\":\"Unknown channel\"}";
+    }
+}
+
+void HistoryApi::range(const HttpServer::Request& request, HttpServer::Response& response) const {
+    const std::string channel(requireChannel(request));
+    const int64_t now_ns = toNs(Clock::now());
+    const int64_t from_ns = timeParam(request, "from", 0, now_ns);
+    const int64_t to_ns = timeParam(request, "to", now_ns, now_ns);
+    response.stream = RangeStream{&store_, channel, from_ns, to_ns, {}};
+}
+
+void HistoryApi::aggregate(const HttpServer::Request& request, HttpServer::Response& response) const {
+    const std::string channel(requireChannel(request));
+    const auto window = RollupEngine::parseWindow(request.param("step", "1h"));
+    const int64_t now_ns = toNs(Clock::now());
+    const int64_t from_ns = timeParam(request, "from", 0, now_ns);
+    const int64_t to_ns = timeParam(request, "to", now_ns, now_ns);
+    response.stream = AggregateStream{&store_, channel, window.name,
+                                      std::chrono::duration_cast<std::chrono::nanoseconds>(window.length).count(),
+                                      from_ns, to_ns, {}, {}, {}, {}};
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,675 @@
+#include "LocalApi/http_server.h"
+#include "websocket.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+constexpr size_t LOW_WATER = 64 * 1024;  // Refill a stream below this much unsent output
+constexpr size_t READ_BYTES = 4096;
+constexpr int MAX_EVENTS = 16;
+constexpr int SWEEP_INTERVAL_MS = 1000;  // Idle connections are checked at least this often
+
+std::string errnoMessage(const char* what, int error) {
+    return std::string(what) + ": " + std::generic_category().message(error);
+}
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 101: return "Switching Protocols";
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 426: return "Upgrade Required";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        case 505: return "HTTP Version Not Supported";
+        default: return "Unknown";
+    }
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Percent-decoding; '+' is a space in query components only
+std::string decode(std::string_view text, bool query) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '%' && i + 2 < text.size() && hexDigit(text[i + 1]) >= 0 && hexDigit(text[i + 2]) >= 0) {
+            out.push_back(static_cast<char>(hexDigit(text[i + 1]) * 16 + hexDigit(text[i + 2])));
+            i += 2;
+        } else if (query && text[i] == '+') {
+            out.push_back(' ');
+        } else {
+            out.push_back(text[i]);
+        }
+    }
+    return out;
+}
+
+std::string lowerCase(std::string_view text) {
+    std::string out(text);
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+void appendJsonError(std::string_view message, std::string& out) {
+    out += "{\"error\":\"";
+    for (const char c : message) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(static_cast<unsigned char>(c) < 0x20 ? ' ' : c);
+    }
+    out += "\"}";
+}
+
+} // namespace
+
+struct HttpServer::Connection {
+    int fd = -1;
+    std::string in;
+    std::string out;
+    size_t out_offset = 0;                       // Sent part of out
+    std::function<bool(std::string&)> stream;    // Body still being produced
+    bool chunked = false;
+    bool close_after = false;                    // Once out is sent
+    bool watching_output = false;
+    bool websocket = false;                      // Upgraded: out holds whole frames only
+    bool ping_sent = false;                      // Since the client last sent anything
+    MessageSource messages;
+    std::chrono::steady_clock::time_point last_progress;
+};
+
+std::string_view HttpServer::Request::param(std::string_view name, std::string_view fallback) const {
+    const auto it = query.find(name);
+    return it != query.end() ? std::string_view(it->second) : fallback;
+}
+
+HttpServer::HttpServer(Options options) : options_(std::move(options)) {
+    const std::string_view listen = options_.listen;
+    if (listen.starts_with("unix:")) {
+        unix_path_ = listen.substr(5);
+        sockaddr_un address{};
+        if (unix_path_.empty() || unix_path_.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument("Malformed HTTP listen address: " + options_.listen);
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, unix_path_.c_str(), unix_path_.size() + 1);
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listen_fd_ < 0) throw std::system_error(errno, std::generic_category(), "socket");
+        ::unlink(unix_path_.c_str());
+        if (::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            const int error = errno;
+            ::close(listen_fd_);
+            throw std::system_error(error, std::generic_category(), "bind " + unix_path_);
+        }
+        address_ = options_.listen;
+    } else {
+        // host:port, host may be a bracketed IPv6 literal or empty (every interface)
+        std::string host;
+        std::string port;
+        if (listen.starts_with('[')) {
+            const size_t close = listen.find("]:");
+            if (close == std::string_view::npos) throw std::invalid_argument("Malformed HTTP listen address: " + options_.listen);
+            host = listen.substr(1, close - 1);
+            port = listen.substr(close + 2);
+        } else if (const size_t colon = listen.rfind(':'); colon != std::string_view::npos) {
+            host = listen.substr(0, colon);
+            port = listen.substr(colon + 1);
+        }
+        if (port.empty()) throw std::invalid_argument("HTTP listen address without port: " + options_.listen);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+        addrinfo* result = nullptr;
+        const int rc = ::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result);
+        if (rc != 0) {
+            throw std::invalid_argument("Cannot resolve HTTP listen address " + options_.listen + ": " + ::gai_strerror(rc));
+        }
+        int error = 0;
+        for (const addrinfo* candidate = result; candidate; candidate = candidate->ai_next) {
+            listen_fd_ = ::socket(candidate->ai_family, candidate->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                                  candidate->ai_protocol);
+            if (listen_fd_ < 0) {
+                error = errno;
+                continue;
+            }
+            const int on = 1;
+            ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+            if (::bind(listen_fd_, candidate->ai_addr, candidate->ai_addrlen) == 0) break;
+            error = errno;
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+        }
+        ::freeaddrinfo(result);
+        if (listen_fd_ < 0) throw std::system_error(error, std::generic_category(), "bind " + options_.listen);
+
+        sockaddr_storage bound{};
+        socklen_t length = sizeof(bound);
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&bound), &length);
+        const int bound_port = bound.ss_family == AF_INET6 ? ntohs(reinterpret_cast<const sockaddr_in6*>(&bound)->sin6_port)
+                                                           : ntohs(reinterpret_cast<const sockaddr_in*>(&bound)->sin_port);
+        address_ = (host.find(':') != std::string::npos ? "[" + host + "]" : host) + ":" + std::to_string(bound_port);
+    }
+
+    const auto fail = [this](const char* what) {
+        const int error = errno;
+        if (wake_fd_ >= 0) ::close(wake_fd_);
+        if (epoll_fd_ >= 0) ::close(epoll_fd_);
+        ::close(listen_fd_);
+        if (!unix_path_.empty()) ::unlink(unix_path_.c_str());
+        throw std::system_error(error, std::generic_category(), what);
+    };
+    if (::listen(listen_fd_, SOMAXCONN) != 0) fail("listen");
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) fail("epoll_create1");
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) fail("eventfd");
+    for (const int fd : {listen_fd_, wake_fd_}) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+HttpServer::~HttpServer() {
+    stop_.store(true);
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t n = ::write(wake_fd_, &one, sizeof(one));
+    if (io_thread_.joinable()) io_thread_.join();
+    while (!connections_.empty()) closeConnection(connections_.begin()->first);
+    ::close(listen_fd_);
+    ::close(wake_fd_);
+    ::close(epoll_fd_);
+    if (!unix_path_.empty()) ::unlink(unix_path_.c_str());
+}
+
+void HttpServer::route(std::string path, Handler handler) {
+    routes_[std::move(path)] = std::move(handler);
+}
+
+void HttpServer::websocket(std::string path, WebSocketHandler handler) {
+    websockets_[std::move(path)] = std::move(handler);
+}
+
+void HttpServer::notify() {
+    if (websocket_clients_.load() == 0 || notified_.exchange(true)) return;
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t n = ::write(wake_fd_, &one, sizeof(one));
+}
+
+void HttpServer::start() {
+    if (!io_thread_.joinable()) io_thread_ = std::thread(&HttpServer::run, this);
+}
+
+HttpServer::Stats HttpServer::stats() const {
+    return Stats{accepted_.load(std::memory_order_relaxed), rejected_.load(std::memory_order_relaxed),
+                 requests_.load(std::memory_order_relaxed), errors_.load(std::memory_order_relaxed),
+                 open_.load(std::memory_order_relaxed), websocket_clients_.load(std::memory_order_relaxed),
+                 messages_.load(std::memory_order_relaxed)};
+}
+
+// --- I/O Thread ---
+
+void HttpServer::run() {
+    epoll_event ready[MAX_EVENTS];
+    while (!stop_.load()) {
+        const int count = ::epoll_wait(epoll_fd_, ready, MAX_EVENTS, SWEEP_INTERVAL_MS);
+        bool notified = false;
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "HTTP server error: " << errnoMessage("epoll_wait", errno) << std::endl;
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            const int fd = ready[i].data.fd;
+            if (fd == wake_fd_) {
+                uint64_t counter;
+                [[maybe_unused]] const ssize_t n = ::read(wake_fd_, &counter, sizeof(counter));
+                notified_.store(false); // Before the sources are asked, so no later notify() is missed
+                notified = true;
+                continue;
+            }
+            if (fd == listen_fd_) {
+                accept();
+                continue;
+            }
+            const auto it = connections_.find(fd);
+            if (it == connections_.end()) continue;
+            Connection& connection = *it->second;
+            bool keep = true;
+            if (ready[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) keep = readInput(connection);
+            if (keep) keep = serve(connection);
+            if (!keep) closeConnection(fd);
+        }
+        if (notified) pushMessages();
+        closeIdle(std::chrono::steady_clock::now());
+    }
+}
+
+void HttpServer::accept() {
+    for (;;) {
+        const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN) {
+                std::cerr << "HTTP server error: " << errnoMessage("accept", errno) << std::endl;
+            }
+            return;
+        }
+        if (connections_.size() >= options_.max_connections) {
+            static constexpr std::string_view BUSY = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            [[maybe_unused]] const ssize_t n = ::send(fd, BUSY.data(), BUSY.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+            ::close(fd);
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (unix_path_.empty()) {
+            const int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->last_progress = std::chrono::steady_clock::now();
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        connections_.emplace(fd, std::move(connection));
+        accepted_.fetch_add(1, std::memory_order_relaxed);
+        open_.store(connections_.size(), std::memory_order_relaxed);
+    }
+}
+
+void HttpServer::closeConnection(int fd) {
+    if (const auto it = connections_.find(fd); it != connections_.end() && it->second->websocket) {
+        websocket_clients_.fetch_sub(1);
+    }
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections_.erase(fd);
+    open_.store(connections_.size(), std::memory_order_relaxed);
+}
+
+bool HttpServer::readInput(Connection& connection) {
+    for (;;) {
+        const size_t size = connection.in.size();
+        connection.in.resize(size + READ_BYTES);
+        const ssize_t n = ::recv(connection.fd, connection.in.data() + size, READ_BYTES, 0);
+        connection.in.resize(size + static_cast<size_t>(std::max<ssize_t>(n, 0)));
+        if (n > 0) {
+            connection.last_progress = std::chrono::steady_clock::now();
+            connection.ping_sent = false;
+            // Only the request being assembled is buffered; more than that is a misbehaving client
+            if (connection.in.size() > 2 * options_.max_request_bytes) return false;
+            continue;
+        }
+        if (n == 0) return false; // Peer closed; whatever it still expects cannot be delivered
+        if (errno == EINTR) continue;
+        return errno == EAGAIN;
+    }
+}
+
+// Answers buffered requests and writes output until the socket is full or nothing is left
+bool HttpServer::serve(Connection& connection) {
+    for (;;) {
+        if (connection.websocket) return serveWebSocket(connection);
+        if (connection.out_offset == connection.out.size() && !connection.stream) {
+            connection.out.clear();
+            connection.out_offset = 0;
+            if (connection.close_after) return false;
+            if (!takeRequest(connection)) {
+                watchOutput(connection, false);
+                return true;
+            }
+            continue;
+        }
+        if (connection.stream && connection.out.size() - connection.out_offset < LOW_WATER) {
+            if (!produce(connection)) return false;
+            continue;
+        }
+        bool full = false;
+        if (!sendOutput(connection, full)) return false;
+        if (full) return true;
+    }
+}
+
+// Sends until out is empty or the socket is full (then waits for EPOLLOUT); false if the connection broke
+bool HttpServer::sendOutput(Connection& connection, bool& full) {
+    while (connection.out_offset < connection.out.size()) {
+        const ssize_t n = ::send(connection.fd, connection.out.data() + connection.out_offset,
+                                 connection.out.size() - connection.out_offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) {
+                watchOutput(connection, true);
+                full = true;
+                return true;
+            }
+            return false;
+        }
+        connection.out_offset += static_cast<size_t>(n);
+        connection.last_progress = std::chrono::steady_clock::now();
+    }
+    return true;
+}
+
+// Answers the client's frames, then sends new messages for as long as the socket takes them
+bool HttpServer::serveWebSocket(Connection& connection) {
+    readFrames(connection);
+    for (;;) {
+        if (connection.out_offset == connection.out.size()) {
+            connection.out.clear();
+            connection.out_offset = 0;
+            if (connection.close_after) return false;
+            chunk_.clear();
+            bool more = false;
+            try {
+                more = connection.messages(chunk_);
+            } catch (const std::exception& e) {
+                std::cerr << "HTTP server: WebSocket message source failed: " << e.what() << std::endl;
+                errors_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            if (!more) {
+                watchOutput(connection, false);
+                return true;
+            }
+            WebSocket::appendFrame(WebSocket::TEXT, chunk_, connection.out);
+            messages_.fetch_add(1, std::memory_order_relaxed);
+            if (chunk_.capacity() > 4 * LOW_WATER) std::string().swap(chunk_);
+        }
+        bool full = false;
+        if (!sendOutput(connection, full)) return false;
+        if (full) return true;
+    }
+}
+
+void HttpServer::readFrames(Connection& connection) {
+    WebSocket::Frame frame;
+    size_t offset = 0;
+    while (!connection.close_after) {
+        size_t consumed = 0;
+        const auto result = WebSocket::parseFrame(std::string_view(connection.in).substr(offset),
+                                                  options_.max_request_bytes, frame, consumed);
+        if (result == WebSocket::ParseResult::Incomplete) break;
+        if (result != WebSocket::ParseResult::Frame) {
+            WebSocket::appendClose(result == WebSocket::ParseResult::TooBig ? WebSocket::CLOSE_TOO_BIG
+                                                                             : WebSocket::CLOSE_PROTOCOL_ERROR,
+                                   connection.out);
+            connection.close_after = true;
+            break;
+        }
+        offset += consumed;
+        if (frame.opcode == WebSocket::PING) {
+            // A client that pings without reading gets no more pongs than fit below the low-water mark
+            if (connection.out.size() - connection.out_offset < LOW_WATER) {
+                WebSocket::appendFrame(WebSocket::PONG, frame.payload, connection.out);
+            }
+        } else if (frame.opcode == WebSocket::CLOSE) {
+            WebSocket::appendFrame(WebSocket::CLOSE, std::string_view(frame.payload).substr(0, 2), connection.out);
+            connection.close_after = true;
+        }
+        // Pongs answer our idle pings; messages from the client are not used
+    }
+    connection.in.erase(0, connection.close_after ? connection.in.size() : offset);
+}
+
+void HttpServer::pushMessages() {
+    for (auto it = connections_.begin(); it != connections_.end();) {
+        Connection& connection = *it->second;
+        ++it;
+        // A client still taking earlier output is asked once it has, from serve()
+        if (!connection.websocket || connection.out_offset != connection.out.size()) continue;
+        if (!serveWebSocket(connection)) closeConnection(connection.fd);
+    }
+}
+
+bool HttpServer::takeRequest(Connection& connection) {
+    const size_t head_end = connection.in.find("\r\n\r\n");
+    if (head_end == std::string::npos) {
+        if (connection.in.size() > options_.max_request_bytes) {
+            requests_.fetch_add(1, std::memory_order_relaxed);
+            connection.in.clear();
+            connection.chunked = false;
+            connection.close_after = true;
+            respond(connection, Request{}, 431);
+            return true;
+        }
+        return false;
+    }
+    const std::string head = connection.in.substr(0, head_end);
+    connection.in.erase(0, head_end + 4);
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    Request request;
+    std::string_view rest = head;
+    const size_t line_end = rest.find("\r\n");
+    const std::string_view line = rest.substr(0, line_end);
+    rest = line_end == std::string_view::npos ? std::string_view{} : rest.substr(line_end + 2);
+
+    // Request line: METHOD SP target SP HTTP/1.x
+    const size_t first_space = line.find(' ');
+    const size_t last_space = line.rfind(' ');
+    std::string_view version;
+    if (first_space != std::string_view::npos && last_space > first_space) {
+        request.method = line.substr(0, first_space);
+        const std::string_view target = line.substr(first_space + 1, last_space - first_space - 1);
+        version = line.substr(last_space + 1);
+        const size_t question = target.find('?');
+        request.path = decode(target.substr(0, question), false);
+        if (question != std::string_view::npos) {
+            std::string_view query = target.substr(question + 1);
+            while (!query.empty()) {
+                const size_t amp = query.find('&');
+                const std::string_view pair = query.substr(0, amp);
+                const size_t equals = pair.find('=');
+                if (!pair.empty()) {
+                    request.query[decode(pair.substr(0, equals), true)] =
+                        equals == std::string_view::npos ? std::string() : decode(pair.substr(equals + 1), true);
+                }
+                query = amp == std::string_view::npos ? std::string_view{} : query.substr(amp + 1);
+            }
+        }
+    }
+    while (!rest.empty()) {
+        const size_t end = rest.find("\r\n");
+        const std::string_view header = rest.substr(0, end);
+        rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end + 2);
+        const size_t colon = header.find(':');
+        if (colon == std::string_view::npos) continue;
+        request.headers[lowerCase(trim(header.substr(0, colon)))] = trim(header.substr(colon + 1));
+    }
+
+    const auto header = [&](std::string_view name) {
+        const auto it = request.headers.find(name);
+        return it != request.headers.end() ? lowerCase(it->second) : std::string();
+    };
+    connection.chunked = version == "HTTP/1.1";
+    connection.close_after = version == "HTTP/1.1" ? header("connection") == "close" : header("connection") != "keep-alive";
+    int error_status = 0;
+    if (request.method.empty() || (version != "HTTP/1.1" && version != "HTTP/1.0")) {
+        error_status = request.method.empty() ? 400 : 505;
+    } else if (request.headers.contains("transfer-encoding") ||
+               (request.headers.contains("content-length") && header("content-length") != "0")) {
+        error_status = 413;
+    }
+    if (error_status != 0) connection.close_after = true; // What follows in the input can't be trusted
+    respond(connection, request, error_status);
+    return true;
+}
+
+void HttpServer::respond(Connection& connection, const Request& request, int error_status) {
+    Response response;
+    if (error_status != 0) {
+        // Refused before routing
+    } else if (request.method != "GET") {
+        error_status = 405;
+    } else if (const auto socket = websockets_.find(request.path); socket != websockets_.end()) {
+        const auto header = [&](std::string_view name) {
+            const auto it = request.headers.find(name);
+            return it != request.headers.end() ? lowerCase(it->second) : std::string();
+        };
+        const auto key = request.headers.find("sec-websocket-key");
+        if (header("upgrade") != "websocket" || header("connection").find("upgrade") == std::string::npos ||
+            header("sec-websocket-version") != "13" || key == request.headers.end()) {
+            error_status = 426;
+        } else {
+            try {
+                connection.messages = socket->second(request);
+            } catch (const std::invalid_argument& e) {
+                response = Response{400, "application/json", {}, {}};
+                appendJsonError(e.what(), response.body);
+            } catch (const std::exception& e) {
+                response = Response{500, "application/json", {}, {}};
+                appendJsonError(e.what(), response.body);
+            }
+            if (connection.messages) {
+                connection.out += "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                  "Sec-WebSocket-Accept: ";
+                connection.out += WebSocket::acceptKey(key->second);
+                connection.out += "\r\n\r\n";
+                connection.websocket = true;
+                connection.close_after = false;
+                websocket_clients_.fetch_add(1);
+                return;
+            }
+        }
+    } else if (const auto route = routes_.find(request.path); route == routes_.end()) {
+        error_status = 404;
+    } else {
+        try {
+            route->second(request, response);
+        } catch (const std::invalid_argument& e) {
+            response = Response{400, "application/json", {}, {}};
+            appendJsonError(e.what(), response.body);
+        } catch (const std::exception& e) {
+            response = Response{500, "application/json", {}, {}};
+            appendJsonError(e.what(), response.body);
+        }
+    }
+    if (error_status != 0) {
+        response.status = error_status;
+        appendJsonError(reasonPhrase(error_status), response.body);
+    }
+    if (response.status >= 400) errors_.fetch_add(1, std::memory_order_relaxed);
+
+    std::string& out = connection.out;
+    out += "HTTP/1.1 ";
+    out += std::to_string(response.status);
+    out += ' ';
+    out += reasonPhrase(response.status);
+    out += "\r\nContent-Type: ";
+    out += response.content_type;
+    out += "\r\nCache-Control: no-store\r\n";
+    if (error_status == 405) out += "Allow: GET\r\n";
+    if (error_status == 426) out += "Upgrade: websocket\r\nSec-WebSocket-Version: 13\r\n";
+    if (response.stream) {
+        if (connection.chunked) {
+            out += "Transfer-Encoding: chunked\r\n";
+        } else {
+            connection.close_after = true; // The end of the body is the end of the connection
+        }
+        connection.stream = std::move(response.stream);
+    } else {
+        out += "Content-Length: ";
+        out += std::to_string(response.body.size());
+        out += "\r\n";
+    }
+    if (connection.close_after) out += "Connection: close\r\n";
+    out += "\r\n";
+    out += response.body;
+}
+
+bool HttpServer::produce(Connection& connection) {
+    chunk_.clear();
+    bool more = false;
+    try {
+        more = connection.stream(chunk_);
+    } catch (const std::exception& e) {
+        std::cerr << "HTTP server: response stream failed: " << e.what() << std::endl;
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    connection.out.erase(0, connection.out_offset);
+    connection.out_offset = 0;
+    if (connection.chunked) {
+        if (!chunk_.empty()) {
+            char size[16];
+            const auto result = std::to_chars(size, size + sizeof(size), chunk_.size(), 16);
+            connection.out.append(size, result.ptr);
+            connection.out += "\r\n";
+            connection.out += chunk_;
+            connection.out += "\r\n";
+        }
+        if (!more) connection.out += "0\r\n\r\n";
+    } else {
+        connection.out += chunk_;
+    }
+    if (!more) connection.stream = nullptr;
+    if (chunk_.capacity() > 4 * LOW_WATER) std::string().swap(chunk_); // Don't keep one oversized part around
+    return true;
+}
+
+void HttpServer::watchOutput(Connection& connection, bool enable) {
+    if (connection.watching_output == enable) return;
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | (enable ? EPOLLOUT : 0u);
+    event.data.fd = connection.fd;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.watching_output = enable;
+}
+
+void HttpServer::closeIdle(std::chrono::steady_clock::time_point now) {
+    for (auto it = connections_.begin(); it != connections_.end();) {
+        Connection& connection = *it->second;
+        ++it;
+        const auto idle = now - connection.last_progress;
+        if (idle > options_.idle_timeout) {
+            closeConnection(connection.fd);
+        } else if (connection.websocket && !connection.ping_sent && idle > options_.idle_timeout / 2) {
+            // A live browser answers with a pong, which counts as progress
+            WebSocket::appendFrame(WebSocket::PING, {}, connection.out);
+            connection.ping_sent = true;
+            if (!serveWebSocket(connection)) closeConnection(connection.fd);
+        }
+    }
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,85 @@
+#include "LocalApi/live_feed.h"
+#include "Encoding/payload_encoder.h"
+#include <charconv>
+
+namespace SensorHub::Components {
+
+LiveFeed::LiveFeed(std::string platform) {
+    PayloadEncoder::appendString(platform, platform_);
+}
+
+void LiveFeed::attach(HttpServer& server, std::string path) {
+    server_ = &server;
+    server.websocket(std::move(path), [this](const HttpServer::Request&) -> HttpServer::MessageSource {
+        return [this, cursor = Cursor{}](std::string& out) mutable { return collect(cursor, out); };
+    });
+}
+
+void LiveFeed::update(std::string_view channel, std::string_view sensor_type, Clock::time_point time,
+                      const nlohmann::json& reading) {
+    // {"sensor_type":T,"timestamp":ms,<members of reading>}
+    scratch_.assign("{\"sensor_type\":");
+    PayloadEncoder::appendString(sensor_type, scratch_);
+    scratch_ += ",\"timestamp\":";
+    char digits[24];
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    scratch_.append(digits, std::to_chars(digits, digits + sizeof(digits), millis).ptr);
+    const size_t members = scratch_.size();
+    if (reading.is_object() && !reading.empty()) {
+        PayloadEncoder::appendJson(reading, scratch_);
+        scratch_[members] = ','; // The reading's opening brace
+    } else {
+        scratch_ += '}';
+    }
+    publish(channel, scratch_);
+}
+
+void LiveFeed::remove(std::string_view channel) {
+    scratch_.clear();
+    publish(channel, scratch_);
+}
+
+// Swaps reading in (keeping the old buffer for the next update), so the lock is held for no copy
+void LiveFeed::publish(std::string_view channel, std::string& reading) {
+    {
+        const std::lock_guard lock(mutex_);
+        Entry* target = find(channel);
+        if (!target) {
+            if (reading.empty()) return; // Removing what was never there
+            target = &entries_.emplace_back(Entry{std::string(channel), {}, 0});
+        }
+        target->reading.swap(reading);
+        target->version = ++version_;
+    }
+    if (server_) server_->notify();
+}
+
+LiveFeed::Entry* LiveFeed::find(std::string_view channel) {
+    for (Entry& existing : entries_) {
+        if (existing.channel == channel) return &existing;
+    }
+    return nullptr;
+}
+
+bool LiveFeed::collect(Cursor& cursor, std::string& out) const {
+    const std::lock_guard lock(mutex_);
+    if (cursor.started && cursor.version == version_) return false;
+    out += cursor.started ? "{\"type\":\"delta\",\"platform\":" : "{\"type\":\"snapshot\",\"platform\":";
+    out += platform_;
+    out += ",\"readings\":{";
+    bool first = true;
+    for (const Entry& item : entries_) {
+        if (item.version <= cursor.version || (!cursor.started && item.reading.empty())) continue;
+        if (!first) out += ',';
+        first = false;
+        PayloadEncoder::appendString(item.channel, out);
+        out += ':';
+        out += item.reading.empty() ? std::string_view("null") : std::string_view(item.reading);
+    }
+    out += "}}";
+    cursor.version = version_;
+    cursor.started = true;
+    return true;
+}
+
+} // namespace SensorHub::Components
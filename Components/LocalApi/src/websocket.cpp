@@ -0,0 +1,139 @@
+#include "websocket.h"
+#include <array>
+
+namespace SensorHub::Components::WebSocket {
+
+namespace {
+
+constexpr std::string_view GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+uint32_t rotateLeft(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// SHA-1 (FIPS 180-4); only used for the handshake, not for anything that needs to be secure
+std::array<uint8_t, 20> sha1(std::string_view message) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::string data(message);
+    const uint64_t bit_length = static_cast<uint64_t>(message.size()) * 8;
+    data.push_back(static_cast<char>(0x80));
+    while (data.size() % 64 != 56) data.push_back(0);
+    for (int shift = 56; shift >= 0; shift -= 8) data.push_back(static_cast<char>(bit_length >> shift));
+
+    for (size_t block = 0; block < data.size(); block += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(data.data() + block + 4 * static_cast<size_t>(i));
+            w[i] = static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 |
+                   static_cast<uint32_t>(bytes[2]) << 8 | bytes[3];
+        }
+        for (int i = 16; i < 80; ++i) w[i] = rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            const uint32_t next = rotateLeft(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = next;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+    std::array<uint8_t, 20> digest;
+    for (size_t i = 0; i < digest.size(); ++i) digest[i] = static_cast<uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+    return digest;
+}
+
+std::string base64(const uint8_t* data, size_t size) {
+    static constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < size; i += 3) {
+        const uint32_t group = static_cast<uint32_t>(data[i]) << 16 |
+                               (i + 1 < size ? static_cast<uint32_t>(data[i + 1]) << 8 : 0) |
+                               (i + 2 < size ? data[i + 2] : 0);
+        out.push_back(ALPHABET[group >> 18 & 63]);
+        out.push_back(ALPHABET[group >> 12 & 63]);
+        out.push_back(i + 1 < size ? ALPHABET[group >> 6 & 63] : '=');
+        out.push_back(i + 2 < size ? ALPHABET[group & 63] : '=');
+    }
+    return out;
+}
+
+} // namespace
+
+std::string acceptKey(std::string_view key) {
+    std::string input(key);
+    input += GUID;
+    const auto digest = sha1(input);
+    return base64(digest.data(), digest.size());
+}
+
+void appendFrame(uint8_t opcode, std::string_view payload, std::string& out) {
+    out.push_back(static_cast<char>(0x80 | opcode));
+    const uint64_t size = payload.size();
+    if (size < 126) {
+        out.push_back(static_cast<char>(size));
+    } else if (size <= 0xFFFF) {
+        out.push_back(126);
+        out.push_back(static_cast<char>(size >> 8));
+        out.push_back(static_cast<char>(size));
+    } else {
+        out.push_back(127);
+        for (int shift = 56; shift >= 0; shift -= 8) out.push_back(static_cast<char>(size >> shift));
+    }
+    out += payload;
+}
+
+void appendClose(uint16_t code, std::string& out) {
+    const char payload[] = {static_cast<char>(code >> 8), static_cast<char>(code)};
+    appendFrame(CLOSE, std::string_view(payload, sizeof(payload)), out);
+}
+
+ParseResult parseFrame(std::string_view in, size_t max_payload, Frame& frame, size_t& consumed) {
+    if (in.size() < 2) return ParseResult::Incomplete;
+    const auto byte = [&](size_t i) { return static_cast<uint8_t>(in[i]); };
+    const bool masked = (byte(1) & 0x80) != 0;
+    if (!masked || (byte(0) & 0x70) != 0) return ParseResult::Malformed; // Unmasked, or extension bits
+    size_t header = 2;
+    uint64_t size = byte(1) & 0x7F;
+    if (size == 126 || size == 127) {
+        const size_t length_bytes = size == 126 ? 2 : 8;
+        if (in.size() < header + length_bytes) return ParseResult::Incomplete;
+        size = 0;
+        for (size_t i = 0; i < length_bytes; ++i) size = size << 8 | byte(header + i);
+        header += length_bytes;
+    }
+    if (size > max_payload) return ParseResult::TooBig;
+    const uint8_t opcode = byte(0) & 0x0F;
+    if ((opcode & 0x08) != 0 && (size > 125 || (byte(0) & 0x80) == 0)) return ParseResult::Malformed; // Control frames
+    if (in.size() < header + 4 + size) return ParseResult::Incomplete;
+
+    const size_t mask_at = header;
+    header += 4;
+    frame.opcode = opcode;
+    frame.fin = (byte(0) & 0x80) != 0;
+    frame.payload.assign(in.substr(header, size));
+    for (size_t i = 0; i < frame.payload.size(); ++i) frame.payload[i] ^= in[mask_at + i % 4];
+    consumed = header + size;
+    return ParseResult::Frame;
+}
+
+} // namespace SensorHub::Components::WebSocket
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace SensorHub::Components::WebSocket {
+
+// RFC 6455 framing, as much of it as a server that pushes text messages needs
+
+constexpr uint8_t CONTINUATION = 0x0;
+constexpr uint8_t TEXT = 0x1;
+constexpr uint8_t BINARY = 0x2;
+constexpr uint8_t CLOSE = 0x8;
+constexpr uint8_t PING = 0x9;
+constexpr uint8_t PONG = 0xA;
+
+constexpr uint16_t CLOSE_NORMAL = 1000;
+constexpr uint16_t CLOSE_PROTOCOL_ERROR = 1002;
+constexpr uint16_t CLOSE_TOO_BIG = 1009;
+
+/**
+ * @brief Sec-WebSocket-Accept for a client's Sec-WebSocket-Key: base64(SHA-1(key + GUID)).
+ */
+std::string acceptKey(std::string_view key);
+
+/**
+ * @brief Appends one unmasked, unfragmented frame (server to client).
+ */
+void appendFrame(uint8_t opcode, std::string_view payload, std::string& out);
+
+/**
+ * @brief Appends a close frame with status code (and no reason).
+ */
+void appendClose(uint16_t code, std::string& out);
+
+struct Frame {
+    uint8_t opcode = 0;
+    bool fin = false;
+    std::string payload; // Unmasked
+};
+
+enum class ParseResult { Frame, Incomplete, Malformed, TooBig };
+
+/**
+ * @brief Takes the first frame off the front of in (client to server: it must be masked).
+ * @param consumed Bytes of in taken by the frame, when the result is Frame.
+ */
+ParseResult parseFrame(std::string_view in, size_t max_payload, Frame& frame, size_t& consumed);
+
+} // namespace SensorHub::Components::WebSocket
@@ -0,0 +1,75 @@
+#include "Metrics/deadline_tracker.h"
+#include "gtest/gtest.h"
+#include <chrono>
+
+namespace SensorHub::Components {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// A sample on a 100 ms grid with its phase boundaries as offsets from the scheduled slot
+SampleTiming sample(std::chrono::milliseconds read_start, std::chrono::milliseconds read_end,
+                    std::chrono::milliseconds encode_end, std::chrono::milliseconds publish_start,
+                    std::chrono::milliseconds publish_end) {
+    SampleTiming timing;
+    timing.scheduled = SampleTiming::Clock::time_point{} + 1h;
+    timing.read_start = timing.scheduled + read_start;
+    timing.read_end = timing.scheduled + read_end;
+    timing.encode_end = timing.scheduled + encode_end;
+    timing.publish_start = timing.scheduled + publish_start;
+    timing.publish_end = timing.scheduled + publish_end;
+    timing.interval = 100ms;
+    return timing;
+}
+
+} // namespace
+
+TEST(DeadlineTrackerTest, RecordsPhasesWithoutMissOnTime) {
+    DeadlineTracker tracker("bme280");
+    const auto timing = sample(2ms, 12ms, 13ms, 13ms, 100ms); // Exactly on the deadline
+    tracker.recordRead(timing);
+    tracker.recordPublished(timing);
+
+    EXPECT_EQ(tracker.name(), "bme280");
+    EXPECT_EQ(tracker.published(), 1u);
+    EXPECT_EQ(tracker.deadlineMisses(), 0u);
+    EXPECT_EQ(tracker.startLag().summary().max, 2000u);
+    EXPECT_EQ(tracker.readDuration().summary().max, 10000u);
+    EXPECT_EQ(tracker.publishLatency().summary().max, 88000u);
+}
+
+TEST(DeadlineTrackerTest, BlamesThePhaseThatTookLongest) {
+    DeadlineTracker tracker("lps25hb");
+    // Driver: a 149 ms read
+    tracker.recordPublished(sample(1ms, 150ms, 151ms, 151ms, 152ms));
+    // Bus wait: started 90 ms late and queued 34 ms behind the bus's other samples
+    tracker.recordPublished(sample(90ms, 95ms, 96ms, 130ms, 131ms));
+    // Publish: 58 ms encoding plus a 60 ms publish call
+    tracker.recordPublished(sample(1ms, 2ms, 60ms, 60ms, 120ms));
+    // Tie between bus wait and driver goes to the bus
+    tracker.recordPublished(sample(60ms, 120ms, 120ms, 120ms, 121ms));
+    // Tie between driver and publish goes to the driver
+    tracker.recordPublished(sample(0ms, 60ms, 90ms, 90ms, 120ms));
+
+    EXPECT_EQ(tracker.published(), 5u);
+    EXPECT_EQ(tracker.deadlineMisses(), 5u);
+    EXPECT_EQ(tracker.missesBy(OverrunCause::Driver), 2u);
+    EXPECT_EQ(tracker.missesBy(OverrunCause::BusWait), 2u);
+    EXPECT_EQ(tracker.missesBy(OverrunCause::Publish), 1u);
+}
+
+TEST(DeadlineTrackerTest, CountsSkippedCyclesInTheReport) {
+    DeadlineTracker tracker("dummy");
+    tracker.recordSkipped(3);
+    tracker.recordSkipped();
+    tracker.recordPublished(sample(1ms, 150ms, 151ms, 151ms, 152ms));
+    EXPECT_EQ(tracker.skippedCycles(), 4u);
+
+    const std::string report = tracker.report();
+    EXPECT_NE(report.find("'dummy' published=1"), std::string::npos) << report;
+    EXPECT_NE(report.find("missed=1 (bus=0 driver=1 publish=0) skipped=4"), std::string::npos) << report;
+    EXPECT_STREQ(overrunCauseName(OverrunCause::BusWait), "bus");
+}
+
+} // namespace SensorHub::Components
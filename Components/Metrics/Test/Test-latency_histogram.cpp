@@ -0,0 +1,71 @@
+#include "Metrics/latency_histogram.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <limits>
+
+namespace SensorHub::Components {
+
+TEST(LatencyHistogramTest, MapsValuesToLogLinearBuckets) {
+    // Below SUB_BUCKETS every value has its own bucket, as does the first power of two
+    for (uint64_t value = 0; value < 16; ++value) {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(value), value);
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(value), value);
+    }
+    // From 16 on, each power of two is split into 8 buckets of equal width
+    EXPECT_EQ(LatencyHistogram::bucketIndex(16), 16u);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(17), 16u);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(18), 17u);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(31), 23u);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(32), 24u);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(16), 17u);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(23), 31u);
+
+    const uint64_t top = std::numeric_limits<uint64_t>::max();
+    EXPECT_EQ(LatencyHistogram::bucketIndex(top), LatencyHistogram::BUCKET_COUNT - 1);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::BUCKET_COUNT - 1), top);
+
+    // Buckets tile the value range without gaps, each within 12.5% of its values
+    for (size_t i = 0; i + 1 < LatencyHistogram::BUCKET_COUNT; ++i) {
+        const uint64_t upper = LatencyHistogram::bucketUpperBound(i);
+        ASSERT_EQ(LatencyHistogram::bucketIndex(upper), i);
+        ASSERT_EQ(LatencyHistogram::bucketIndex(upper + 1), i + 1);
+        if (i >= 16) {
+            const uint64_t lower = LatencyHistogram::bucketUpperBound(i - 1) + 1;
+            ASSERT_LE(static_cast<double>(upper - lower), 0.125 * static_cast<double>(lower)) << i;
+        }
+    }
+}
+
+TEST(LatencyHistogramTest, ReportsPercentilesAsBucketUpperEdges) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1000; ++value) histogram.record(value);
+
+    const auto summary = histogram.summary();
+    EXPECT_EQ(summary.count, 1000u);
+    EXPECT_DOUBLE_EQ(summary.mean, 500.5);
+    EXPECT_EQ(summary.p50, 511u);  // 500 lies in [480, 511]
+    EXPECT_EQ(summary.p90, 959u);  // 900 lies in [896, 959]
+    EXPECT_EQ(summary.p99, 1000u); // 990 lies in [960, 1023], capped at the recorded max
+    EXPECT_EQ(summary.max, 1000u);
+    EXPECT_EQ(histogram.percentile(0.0), 1u);
+    EXPECT_EQ(histogram.percentile(1.0), 1000u);
+    EXPECT_EQ(histogram.percentile(0.5), summary.p50);
+}
+
+TEST(LatencyHistogramTest, RecordsDurationsAndResets) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.99), 0u);
+    EXPECT_EQ(histogram.summary().count, 0u);
+
+    histogram.record(std::chrono::milliseconds(3));
+    histogram.record(std::chrono::microseconds(-5)); // Clock went backwards: counted as zero
+    EXPECT_EQ(histogram.count(), 2u);
+    EXPECT_EQ(histogram.summary().max, 3000u);
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.summary().max, 0u);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,107 @@
+#include "Metrics/metrics_registry.h"
+#include "Metrics/process_metrics.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace SensorHub::Components {
+
+TEST(MetricsRegistryTest, RendersCountersAndGaugesWithLabels) {
+    MetricsRegistry registry;
+    registry.counter("hub_readings_total", "Readings.", {{"sensor", "bme280"}}).inc(3);
+    registry.counter("hub_readings_total", "Readings.", {{"sensor", "door \"front\"\n"}}).inc();
+    registry.gauge("hub_queue_depth", "Queued now.").set(2.5);
+    registry.callback("hub_connected", "Connected.", MetricsRegistry::Type::Gauge, {}, [] { return 1.0; });
+
+    std::string text;
+    registry.writeText(text);
+    EXPECT_EQ(text, "# HELP hub_connected Connected.\n"
+                    "# TYPE hub_connected gauge\n"
+                    "hub_connected 1\n"
+                    "# HELP hub_queue_depth Queued now.\n"
+                    "# TYPE hub_queue_depth gauge\n"
+                    "hub_queue_depth 2.5\n"
+                    "# HELP hub_readings_total Readings.\n"
+                    "# TYPE hub_readings_total counter\n"
+                    "hub_readings_total{sensor=\"bme280\"} 3\n"
+                    "hub_readings_total{sensor=\"door \\\"front\\\"\\n\"} 1\n");
+}
+
+TEST(MetricsRegistryTest, ReturnsTheSameSeriesForTheSameLabels) {
+    MetricsRegistry registry;
+    Counter& first = registry.counter("hub_total", "Help.", {{"a", "1"}});
+    EXPECT_EQ(&registry.counter("hub_total", "Help.", {{"a", "1"}}), &first);
+    EXPECT_NE(&registry.counter("hub_total", "Help.", {{"a", "2"}}), &first);
+
+    EXPECT_THROW(registry.gauge("hub_total", "Help."), std::invalid_argument);
+    EXPECT_THROW(registry.counter("0bad", "Help."), std::invalid_argument);
+    EXPECT_THROW(registry.counter("hub_other", "Help.", {{"le", "1"}}), std::invalid_argument);
+    registry.histogram("hub_seconds", "Help.", {0.1, 1});
+    EXPECT_THROW(registry.histogram("hub_seconds", "Help.", {0.1, 2}), std::invalid_argument);
+    EXPECT_THROW(registry.histogram("hub_bad_seconds", "Help.", {1, 1}), std::invalid_argument);
+
+    std::string text;
+    registry.writeText(text); // The failed histogram left an empty series behind: it is skipped
+    EXPECT_EQ(text.find("hub_bad_seconds_bucket"), std::string::npos);
+}
+
+TEST(MetricsRegistryTest, RendersCumulativeHistogramBuckets) {
+    MetricsRegistry registry;
+    Histogram& latency = registry.histogram("hub_latency_seconds", "Latency.", {0.001, 0.01, 0.1}, {{"bus", "1"}});
+    latency.observe(0.001); // Bounds are inclusive
+    latency.observe(std::chrono::milliseconds(5));
+    latency.observe(0.05);
+    latency.observe(3.0);
+    EXPECT_EQ(latency.counts(), (std::vector<uint64_t>{1, 1, 1, 1}));
+
+    std::string text;
+    registry.writeText(text);
+    EXPECT_NE(text.find("# TYPE hub_latency_seconds histogram\n"
+                        "hub_latency_seconds_bucket{bus=\"1\",le=\"0.001\"} 1\n"
+                        "hub_latency_seconds_bucket{bus=\"1\",le=\"0.01\"} 2\n"
+                        "hub_latency_seconds_bucket{bus=\"1\",le=\"0.1\"} 3\n"
+                        "hub_latency_seconds_bucket{bus=\"1\",le=\"+Inf\"} 4\n"
+                        "hub_latency_seconds_sum{bus=\"1\"} 3.056\n"
+                        "hub_latency_seconds_count{bus=\"1\"} 4\n"),
+              std::string::npos)
+        << text;
+    EXPECT_EQ(Histogram::exponentialBounds(0.001, 10, 3), (std::vector<double>{0.001, 0.01, 0.1}));
+}
+
+TEST(MetricsRegistryTest, CountsFromManyThreadsWithoutLosingUpdates) {
+    MetricsRegistry registry;
+    Counter& counter = registry.counter("hub_total", "Help.");
+    Gauge& gauge = registry.gauge("hub_level", "Help.");
+    Histogram& histogram = registry.histogram("hub_seconds", "Help.", {0.5});
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 100000; ++i) {
+                counter.inc();
+                gauge.add(1);
+                histogram.observe(1.0);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(counter.value(), 400000u);
+    EXPECT_EQ(gauge.value(), 400000.0);
+    EXPECT_EQ(histogram.counts().back(), 400000u);
+    EXPECT_EQ(histogram.sum(), 400000.0);
+}
+
+TEST(MetricsRegistryTest, ReportsProcessMetrics) {
+    MetricsRegistry registry;
+    registerProcessMetrics(registry);
+    std::string text;
+    registry.writeText(text);
+    for (const char* name : {"process_cpu_seconds_total ", "process_resident_memory_bytes ", "process_open_fds ",
+                             "process_threads ", "process_start_time_seconds "}) {
+        const size_t at = text.find(std::string("\n") + name);
+        ASSERT_NE(at, std::string::npos) << name;
+        EXPECT_GT(std::stod(text.substr(at + 1 + std::string(name).size())), 0.0) << name;
+    }
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Metrics/latency_histogram.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Where the time of a late sample went.
+ */
+enum class OverrunCause {
+    BusWait,  // Read started late or waited behind other samples of the same bus
+    Driver,   // Sensor read (conversion wait + I2C transfers) took long
+    Publish,  // Encoding and the MQTT publish call took long
+    Count
+};
+
+const char* overrunCauseName(OverrunCause cause);
+
+/**
+ * @brief Timestamps of one sample as it moves through the pipeline.
+ */
+struct SampleTiming {
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point scheduled;     // Slot on the sensor's publish grid
+    Clock::time_point read_start;
+    Clock::time_point read_end;
+    Clock::time_point encode_end;    // Payload ready, handed to the bus publish lane
+    Clock::time_point publish_start; // Publish lane released this sample
+    Clock::time_point publish_end;
+    std::chrono::microseconds interval{0};
+};
+
+/**
+ * @brief Per-sensor schedule adherence: start lag, read duration and publish latency
+ * histograms plus deadline-miss and skipped-cycle counters.
+ *
+ * A sample's deadline is its scheduled slot plus one interval (it must be out before the
+ * next one is due). Late samples are attributed to the phase that took the longest.
+ * All methods are thread-safe; recording never blocks.
+ */
+class DeadlineTracker {
+public:
+    explicit DeadlineTracker(std::string name);
+
+    /**
+     * @brief Records start lag and read duration of a sample (also for failed reads).
+     */
+    void recordRead(const SampleTiming& timing);
+
+    /**
+     * @brief Records publish latency and checks the deadline once the sample is out.
+     */
+    void recordPublished(const SampleTiming& timing);
+
+    /**
+     * @brief Counts publish slots that produced no sample (previous one still in flight,
+     * or the schedule fell behind the grid).
+     */
+    void recordSkipped(uint64_t slots = 1);
+
+    /**
+     * @brief One-line summary with percentiles in milliseconds.
+     */
+    std::string report() const;
+
+    const std::string& name() const { return name_; }
+    const LatencyHistogram& startLag() const { return start_lag_; }
+    const LatencyHistogram& readDuration() const { return read_duration_; }
+    const LatencyHistogram& publishLatency() const { return publish_latency_; }
+    uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+    uint64_t deadlineMisses() const { return deadline_misses_.load(std::memory_order_relaxed); }
+    uint64_t missesBy(OverrunCause cause) const;
+    uint64_t skippedCycles() const { return skipped_.load(std::memory_order_relaxed); }
+
+    // Delete copy/move operations
+    DeadlineTracker(const DeadlineTracker&) = delete;
+    DeadlineTracker& operator=(const DeadlineTracker&) = delete;
+    DeadlineTracker(DeadlineTracker&&) = delete;
+    DeadlineTracker& operator=(DeadlineTracker&&) = delete;
+
+private:
+    std::string name_;
+    LatencyHistogram start_lag_;        // scheduled -> read_start
+    LatencyHistogram read_duration_;    // read_start -> read_end
+    LatencyHistogram publish_latency_;  // read_end -> publish_end
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> deadline_misses_{0};
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(OverrunCause::Count)> misses_by_cause_{};
+    std::atomic<uint64_t> skipped_{0};
+};
+
+} // namespace SensorHub::Components
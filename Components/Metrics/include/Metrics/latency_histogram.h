@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Point-in-time view of a LatencyHistogram. All values are in microseconds.
+ */
+struct HistogramSummary {
+    uint64_t count = 0;
+    double mean = 0.0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t max = 0;
+};
+
+/**
+ * @brief Fixed-size log-linear histogram of microsecond latencies.
+ *
+ * Each power of two is split into 8 linear sub-buckets, so any recorded value is
+ * reported within 12.5% of its true value. Recording is a handful of relaxed atomic
+ * adds with no allocation or locking, so it can be called from any thread on the
+ * sample path.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    LatencyHistogram() = default;
+
+    /**
+     * @brief Records one value in microseconds.
+     */
+    void record(uint64_t micros);
+
+    /**
+     * @brief Records a duration; negative durations are recorded as zero.
+     */
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> value) {
+        const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(value).count();
+        record(micros > 0 ? static_cast<uint64_t>(micros) : 0);
+    }
+
+    /**
+     * @brief Number of recorded values.
+     */
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Estimated value at quantile q (0..1), as the upper edge of its bucket.
+     */
+    uint64_t percentile(double q) const;
+
+    /**
+     * @brief Count, mean, p50/p90/p99 and max in one pass.
+     */
+    HistogramSummary summary() const;
+
+    /**
+     * @brief Clears all recorded values. Not atomic with respect to concurrent record().
+     */
+    void reset();
+
+    /**
+     * @brief Bucket index for a value (exposed for tests).
+     */
+    static size_t bucketIndex(uint64_t micros);
+
+    /**
+     * @brief Largest value that maps to a bucket.
+     */
+    static uint64_t bucketUpperBound(size_t index);
+
+    // Delete copy/move operations
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    LatencyHistogram(LatencyHistogram&&) = delete;
+    LatencyHistogram& operator=(LatencyHistogram&&) = delete;
+
+private:
+    uint64_t percentileFrom(const std::array<uint64_t, BUCKET_COUNT>& counts, uint64_t total,
+                            double q, uint64_t max) const;
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace SensorHub::Components
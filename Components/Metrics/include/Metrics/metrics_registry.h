@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Monotonic counter. inc() is one relaxed atomic add on the counter's own cache line.
+ */
+class Counter {
+public:
+    void inc(uint64_t amount = 1) { value_.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<uint64_t> value_{0}; // Own cache line: counters of different threads don't contend
+};
+
+/**
+ * @brief Value that goes up and down. Lock-free; add() is a compare-and-swap loop.
+ */
+class Gauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    void add(double amount);
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<double> value_{0.0};
+};
+
+/**
+ * @brief Histogram over fixed upper bounds (Prometheus "le" buckets, inclusive), plus +Inf.
+ *
+ * observe() finds the bucket by a linear scan (bounds are few) and does two relaxed atomic
+ * updates; the total count is the sum of the buckets, computed when read.
+ */
+class Histogram {
+public:
+    /**
+     * @param bounds Ascending upper bounds, without +Inf.
+     * @throws std::invalid_argument if bounds are empty or not strictly ascending.
+     */
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    /**
+     * @brief Observes a duration in seconds.
+     */
+    template <typename Rep, typename Period>
+    void observe(std::chrono::duration<Rep, Period> value) {
+        observe(std::chrono::duration<double>(value).count());
+    }
+
+    const std::vector<double>& bounds() const { return bounds_; }
+
+    /**
+     * @brief Count per bucket (not cumulative); the last one is +Inf.
+     */
+    std::vector<uint64_t> counts() const;
+
+    double sum() const { return sum_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief count bounds growing by factor from start: start, start * factor, ...
+     */
+    static std::vector<double> exponentialBounds(double start, double factor, size_t count);
+
+    // Delete copy/move operations (instrumented code keeps references)
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+    Histogram(Histogram&&) = delete;
+    Histogram& operator=(Histogram&&) = delete;
+
+private:
+    const std::vector<double> bounds_;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_; // bounds_.size() + 1
+    alignas(64) std::atomic<double> sum_{0.0};
+};
+
+/**
+ * @brief Named metrics of the hub, rendered in the Prometheus text exposition format.
+ *
+ * counter(), gauge() and histogram() return the series for a name and label set, creating
+ * it on first use; later calls with the same name and labels return the same object, so a
+ * sensor rebuilt by a reload keeps counting where it left off. Registration takes a lock;
+ * instrumented code keeps the returned reference and updates it without one. Series are
+ * never removed, and references stay valid for the life of the registry.
+ *
+ * callback() registers a value that is sampled when the metrics are rendered (queue depths,
+ * memory use), so it costs nothing between scrapes.
+ */
+class MetricsRegistry {
+public:
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    enum class Type { Counter, Gauge, Histogram };
+
+    /**
+     * @brief Content-Type of writeText() output.
+     */
+    static constexpr std::string_view CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+    MetricsRegistry() = default;
+
+    /**
+     * @throws std::invalid_argument if name is not a valid metric name or is already
+     * registered with another type (or, for histograms, other bounds).
+     */
+    Counter& counter(std::string_view name, std::string_view help, Labels labels = {});
+    Gauge& gauge(std::string_view name, std::string_view help, Labels labels = {});
+    Histogram& histogram(std::string_view name, std::string_view help, const std::vector<double>& bounds,
+                         Labels labels = {});
+
+    /**
+     * @brief Adds (or replaces) a series whose value is read by sample() on every render.
+     * sample() runs on the rendering thread, with the registry locked: it must not call back
+     * into the registry.
+     * @param type Counter or Gauge.
+     */
+    void callback(std::string_view name, std::string_view help, Type type, Labels labels,
+                  std::function<double()> sample);
+
+    /**
+     * @brief Appends every metric, families sorted by name, series in registration order.
+     */
+    void writeText(std::string& out) const;
+
+    // Delete copy/move operations (instrumented code keeps references)
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+    MetricsRegistry(MetricsRegistry&&) = delete;
+    MetricsRegistry& operator=(MetricsRegistry&&) = delete;
+
+private:
+    struct Series {
+        Labels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+        std::function<double()> sample;
+    };
+
+    struct Family {
+        std::string help;
+        Type type = Type::Counter;
+        std::vector<std::unique_ptr<Series>> series;
+    };
+
+    Series& series(std::string_view name, std::string_view help, Type type, Labels& labels); // Under mutex_
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family, std::less<>> families_;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Metrics/metrics_registry.h"
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Registers the usual process_* metrics of the running process: CPU seconds, resident
+ * and virtual memory, open file descriptors, threads and start time. They are read from
+ * /proc and getrusage() when the registry is rendered; nothing runs in between.
+ */
+void registerProcessMetrics(MetricsRegistry& registry);
+
+} // namespace SensorHub::Components
@@ -0,0 +1,81 @@
+#include "Metrics/deadline_tracker.h"
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace SensorHub::Components {
+
+namespace {
+
+void appendHistogram(std::ostringstream& out, const char* label, const LatencyHistogram& histogram) {
+    const auto s = histogram.summary();
+    out << " " << label << "[p50=" << static_cast<double>(s.p50) / 1000.0
+        << " p90=" << static_cast<double>(s.p90) / 1000.0
+        << " p99=" << static_cast<double>(s.p99) / 1000.0
+        << " max=" << static_cast<double>(s.max) / 1000.0 << "]";
+}
+
+} // namespace
+
+const char* overrunCauseName(OverrunCause cause) {
+    switch (cause) {
+        case OverrunCause::BusWait: return "bus";
+        case OverrunCause::Driver:  return "driver";
+        case OverrunCause::Publish: return "publish";
+        case OverrunCause::Count:   break;
+    }
+    return "unknown";
+}
+
+DeadlineTracker::DeadlineTracker(std::string name) : name_(std::move(name)) {}
+
+void DeadlineTracker::recordRead(const SampleTiming& timing) {
+    start_lag_.record(timing.read_start - timing.scheduled);
+    read_duration_.record(timing.read_end - timing.read_start);
+}
+
+void DeadlineTracker::recordPublished(const SampleTiming& timing) {
+    publish_latency_.record(timing.publish_end - timing.read_end);
+    published_.fetch_add(1, std::memory_order_relaxed);
+
+    if (timing.publish_end <= timing.scheduled + timing.interval) return;
+    deadline_misses_.fetch_add(1, std::memory_order_relaxed);
+
+    // Blame the phase that consumed the most time
+    const auto bus_wait = (timing.read_start - timing.scheduled) + (timing.publish_start - timing.encode_end);
+    const auto driver = timing.read_end - timing.read_start;
+    const auto publish = (timing.encode_end - timing.read_end) + (timing.publish_end - timing.publish_start);
+    OverrunCause cause = OverrunCause::BusWait;
+    if (driver > bus_wait && driver >= publish) {
+        cause = OverrunCause::Driver;
+    } else if (publish > bus_wait && publish > driver) {
+        cause = OverrunCause::Publish;
+    }
+    misses_by_cause_[static_cast<size_t>(cause)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void DeadlineTracker::recordSkipped(uint64_t slots) {
+    skipped_.fetch_add(slots, std::memory_order_relaxed);
+}
+
+uint64_t DeadlineTracker::missesBy(OverrunCause cause) const {
+    return misses_by_cause_[static_cast<size_t>(cause)].load(std::memory_order_relaxed);
+}
+
+std::string DeadlineTracker::report() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    out << "'" << name_ << "' published=" << published() << " (ms)";
+    appendHistogram(out, "start_lag", start_lag_);
+    appendHistogram(out, "read", read_duration_);
+    appendHistogram(out, "publish", publish_latency_);
+    out << " missed=" << deadlineMisses() << " (";
+    for (size_t i = 0; i < misses_by_cause_.size(); ++i) {
+        if (i) out << " ";
+        out << overrunCauseName(static_cast<OverrunCause>(i)) << "=" << missesBy(static_cast<OverrunCause>(i));
+    }
+    out << ") skipped=" << skippedCycles();
+    return out.str();
+}
+
+} // namespace SensorHub::Components
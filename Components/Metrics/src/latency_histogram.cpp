@@ -0,0 +1,83 @@
+#include "Metrics/latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace SensorHub::Components {
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < SUB_BUCKETS) return static_cast<size_t>(micros);
+    // Values in [2^e, 2^(e+1)) share one group of SUB_BUCKETS linear buckets
+    const unsigned exponent = static_cast<unsigned>(std::bit_width(micros)) - 1;
+    const unsigned shift = exponent - SUB_BUCKET_BITS;
+    const size_t sub = static_cast<size_t>((micros >> shift) & (SUB_BUCKETS - 1));
+    return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) return index;
+    const unsigned shift = static_cast<unsigned>(index / SUB_BUCKETS) - 1;
+    const uint64_t lower = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    buckets_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(micros, std::memory_order_relaxed);
+    uint64_t current = max_.load(std::memory_order_relaxed);
+    while (micros > current && !max_.compare_exchange_weak(current, micros, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::percentileFrom(const std::array<uint64_t, BUCKET_COUNT>& counts, uint64_t total,
+                                          double q, uint64_t max) const {
+    if (total == 0) return 0;
+    const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= std::max<uint64_t>(rank, 1)) {
+            return std::min(bucketUpperBound(i), max);
+        }
+    }
+    return max;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    std::array<uint64_t, BUCKET_COUNT> counts{};
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    return percentileFrom(counts, total, q, max_.load(std::memory_order_relaxed));
+}
+
+HistogramSummary LatencyHistogram::summary() const {
+    std::array<uint64_t, BUCKET_COUNT> counts{};
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    HistogramSummary result;
+    result.count = total;
+    result.max = max_.load(std::memory_order_relaxed);
+    if (total == 0) return result;
+    result.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(total);
+    result.p50 = percentileFrom(counts, total, 0.50, result.max);
+    result.p90 = percentileFrom(counts, total, 0.90, result.max);
+    result.p99 = percentileFrom(counts, total, 0.99, result.max);
+    return result;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace SensorHub::Components
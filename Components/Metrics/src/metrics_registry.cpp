@@ -0,0 +1,240 @@
+#include "Metrics/metrics_registry.h"
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+namespace {
+
+bool validName(std::string_view name, bool allow_colon) {
+    if (name.empty()) return false;
+    for (size_t i = 0; i < name.size(); ++i) {
+        const char c = name[i];
+        const bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || (allow_colon && c == ':');
+        if (!letter && (i == 0 || c < '0' || c > '9')) return false;
+    }
+    return true;
+}
+
+void appendNumber(double value, std::string& out) {
+    if (std::isnan(value)) {
+        out += "NaN";
+    } else if (std::isinf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+    } else {
+        char digits[32];
+        out.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+    }
+}
+
+void appendNumber(uint64_t value, std::string& out) {
+    char digits[24];
+    out.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+}
+
+// Label values escape backslash, double quote and newline; help text only the first and last
+void appendEscaped(std::string_view text, bool quote, std::string& out) {
+    for (const char c : text) {
+        if (c == '\\') {
+            out += "\\\\";
+        } else if (c == '\n') {
+            out += "\\n";
+        } else if (quote && c == '"') {
+            out += "\\\"";
+        } else {
+            out += c;
+        }
+    }
+}
+
+// {a="1",b="2"} with an optional extra label (a histogram's "le"); nothing without labels
+void appendLabels(const MetricsRegistry::Labels& labels, std::string_view extra_name, std::string_view extra_value,
+                  std::string& out) {
+    if (labels.empty() && extra_name.empty()) return;
+    out += '{';
+    bool first = true;
+    const auto add = [&](std::string_view name, std::string_view value) {
+        if (!first) out += ',';
+        first = false;
+        out += name;
+        out += "=\"";
+        appendEscaped(value, true, out);
+        out += '"';
+    };
+    for (const auto& [name, value] : labels) add(name, value);
+    if (!extra_name.empty()) add(extra_name, extra_value);
+    out += '}';
+}
+
+const char* typeName(MetricsRegistry::Type type) {
+    switch (type) {
+        case MetricsRegistry::Type::Counter: return "counter";
+        case MetricsRegistry::Type::Gauge: return "gauge";
+        case MetricsRegistry::Type::Histogram: return "histogram";
+    }
+    return "untyped";
+}
+
+} // namespace
+
+// --- Gauge ---
+
+void Gauge::add(double amount) {
+    double current = value_.load(std::memory_order_relaxed);
+    while (!value_.compare_exchange_weak(current, current + amount, std::memory_order_relaxed)) {}
+}
+
+// --- Histogram ---
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds)), buckets_(std::make_unique<std::atomic<uint64_t>[]>(bounds_.size() + 1)) {
+    if (bounds_.empty()) throw std::invalid_argument("Histogram needs at least one bucket bound");
+    for (size_t i = 1; i < bounds_.size(); ++i) {
+        if (!(bounds_[i] > bounds_[i - 1])) throw std::invalid_argument("Histogram bounds must be strictly ascending");
+    }
+}
+
+void Histogram::observe(double value) {
+    size_t bucket = 0;
+    while (bucket < bounds_.size() && value > bounds_[bucket]) ++bucket;
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    double current = sum_.load(std::memory_order_relaxed);
+    while (!sum_.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {}
+}
+
+std::vector<uint64_t> Histogram::counts() const {
+    std::vector<uint64_t> counts(bounds_.size() + 1);
+    for (size_t i = 0; i < counts.size(); ++i) counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    return counts;
+}
+
+std::vector<double> Histogram::exponentialBounds(double start, double factor, size_t count) {
+    std::vector<double> bounds;
+    bounds.reserve(count);
+    for (double bound = start; bounds.size() < count; bound *= factor) bounds.push_back(bound);
+    return bounds;
+}
+
+// --- Registry ---
+
+MetricsRegistry::Series& MetricsRegistry::series(std::string_view name, std::string_view help, Type type,
+                                                 Labels& labels) {
+    if (!validName(name, true)) throw std::invalid_argument("Invalid metric name: " + std::string(name));
+    for (const auto& label : labels) {
+        if (!validName(label.first, false) || label.first == "le") {
+            throw std::invalid_argument("Invalid label name for " + std::string(name) + ": " + label.first);
+        }
+    }
+    auto family = families_.find(name);
+    if (family == families_.end()) {
+        family = families_.emplace(std::string(name), Family{std::string(help), type, {}}).first;
+    } else if (family->second.type != type) {
+        throw std::invalid_argument("Metric " + std::string(name) + " is already registered as a " +
+                                    typeName(family->second.type));
+    }
+    for (auto& existing : family->second.series) {
+        if (existing->labels == labels) return *existing;
+    }
+    family->second.series.push_back(std::make_unique<Series>());
+    family->second.series.back()->labels = std::move(labels);
+    return *family->second.series.back();
+}
+
+Counter& MetricsRegistry::counter(std::string_view name, std::string_view help, Labels labels) {
+    const std::lock_guard lock(mutex_);
+    Series& found = series(name, help, Type::Counter, labels);
+    if (found.sample) throw std::invalid_argument("Metric " + std::string(name) + " is sampled by a callback");
+    if (!found.counter) found.counter = std::make_unique<Counter>();
+    return *found.counter;
+}
+
+Gauge& MetricsRegistry::gauge(std::string_view name, std::string_view help, Labels labels) {
+    const std::lock_guard lock(mutex_);
+    Series& found = series(name, help, Type::Gauge, labels);
+    if (found.sample) throw std::invalid_argument("Metric " + std::string(name) + " is sampled by a callback");
+    if (!found.gauge) found.gauge = std::make_unique<Gauge>();
+    return *found.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(std::string_view name, std::string_view help, const std::vector<double>& bounds,
+                                      Labels labels) {
+    const std::lock_guard lock(mutex_);
+    Series& found = series(name, help, Type::Histogram, labels);
+    if (!found.histogram) {
+        found.histogram = std::make_unique<Histogram>(bounds);
+    } else if (found.histogram->bounds() != bounds) {
+        throw std::invalid_argument("Histogram " + std::string(name) + " is already registered with other bounds");
+    }
+    return *found.histogram;
+}
+
+void MetricsRegistry::callback(std::string_view name, std::string_view help, Type type, Labels labels,
+                               std::function<double()> sample) {
+    if (type == Type::Histogram) throw std::invalid_argument("Histograms cannot be sampled by a callback");
+    const std::lock_guard lock(mutex_);
+    Series& found = series(name, help, type, labels);
+    if (found.counter || found.gauge) throw std::invalid_argument("Metric " + std::string(name) + " is already updated directly");
+    found.sample = std::move(sample);
+}
+
+void MetricsRegistry::writeText(std::string& out) const {
+    const std::lock_guard lock(mutex_);
+    for (const auto& [name, family] : families_) {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        appendEscaped(family.help, false, out);
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += typeName(family.type);
+        out += '\n';
+        for (const auto& entry : family.series) {
+            if (entry->histogram) {
+                const auto& bounds = entry->histogram->bounds();
+                const auto counts = entry->histogram->counts();
+                uint64_t cumulative = 0;
+                std::string le;
+                for (size_t i = 0; i < counts.size(); ++i) {
+                    cumulative += counts[i];
+                    le.clear();
+                    appendNumber(i < bounds.size() ? bounds[i] : INFINITY, le);
+                    out += name;
+                    out += "_bucket";
+                    appendLabels(entry->labels, "le", le, out);
+                    out += ' ';
+                    appendNumber(cumulative, out);
+                    out += '\n';
+                }
+                out += name;
+                out += "_sum";
+                appendLabels(entry->labels, {}, {}, out);
+                out += ' ';
+                appendNumber(entry->histogram->sum(), out);
+                out += '\n';
+                out += name;
+                out += "_count";
+                appendLabels(entry->labels, {}, {}, out);
+                out += ' ';
+                appendNumber(cumulative, out);
+                out += '\n';
+                continue;
+            }
+            if (!entry->counter && !entry->gauge && !entry->sample) continue; // Its registration failed
+            out += name;
+            appendLabels(entry->labels, {}, {}, out);
+            out += ' ';
+            if (entry->counter) {
+                appendNumber(entry->counter->value(), out);
+            } else if (entry->gauge) {
+                appendNumber(entry->gauge->value(), out);
+            } else {
+                appendNumber(entry->sample(), out);
+            }
+            out += '\n';
+        }
+    }
+}
+
+} // namespace SensorHub::Components
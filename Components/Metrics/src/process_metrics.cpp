@@ -0,0 +1,85 @@
+#include "Metrics/process_metrics.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+// Field of /proc/self/stat by its 1-based number in proc(5); 0 if unreadable
+double statField(size_t number) {
+    std::ifstream file("/proc/self/stat");
+    std::string line;
+    if (!std::getline(file, line)) return 0;
+    // The command name (field 2) is parenthesised and may contain spaces: count from after it
+    const size_t close = line.rfind(')');
+    if (close == std::string::npos) return 0;
+    std::istringstream fields(line.substr(close + 2));
+    std::string field;
+    for (size_t current = 3; fields >> field; ++current) {
+        if (current == number) return std::stod(field);
+    }
+    return 0;
+}
+
+// Field of /proc/self/statm (0 = total program size, 1 = resident set), in bytes
+double statmBytes(size_t index) {
+    std::ifstream file("/proc/self/statm");
+    double pages = 0;
+    for (size_t i = 0; i <= index && file >> pages; ++i) {}
+    return file ? pages * static_cast<double>(::sysconf(_SC_PAGESIZE)) : 0;
+}
+
+double cpuSeconds() {
+    rusage usage{};
+    if (::getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    const auto seconds = [](const timeval& time) { return static_cast<double>(time.tv_sec) + time.tv_usec / 1e6; };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+double openFds() {
+    std::error_code error;
+    double count = 0;
+    for (std::filesystem::directory_iterator it("/proc/self/fd", error), end; !error && it != end; it.increment(error)) {
+        ++count;
+    }
+    return count;
+}
+
+double startTimeSeconds() {
+    std::ifstream file("/proc/stat");
+    std::string key;
+    double boot_time = 0;
+    while (file >> key) {
+        if (key == "btime") {
+            file >> boot_time;
+            break;
+        }
+        file.ignore(1 << 16, '\n');
+    }
+    return boot_time + statField(22) / static_cast<double>(::sysconf(_SC_CLK_TCK));
+}
+
+} // namespace
+
+void registerProcessMetrics(MetricsRegistry& registry) {
+    using Type = MetricsRegistry::Type;
+    registry.callback("process_cpu_seconds_total", "Total user and system CPU time spent in seconds.", Type::Counter, {},
+                      cpuSeconds);
+    registry.callback("process_resident_memory_bytes", "Resident memory size in bytes.", Type::Gauge, {},
+                      [] { return statmBytes(1); });
+    registry.callback("process_virtual_memory_bytes", "Virtual memory size in bytes.", Type::Gauge, {},
+                      [] { return statmBytes(0); });
+    registry.callback("process_open_fds", "Number of open file descriptors.", Type::Gauge, {}, openFds);
+    registry.callback("process_threads", "Number of OS threads in the process.", Type::Gauge, {},
+                      [] { return statField(20); });
+    registry.gauge("process_start_time_seconds", "Start time of the process since unix epoch in seconds.")
+        .set(startTimeSeconds());
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,370 @@
+#include "NetworkMQTT/epoll_transport.h"
+#include "NetworkMQTT/mqtt_publisher.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct RecordingListener : IMqttTransport::Listener {
+    std::mutex mutex;
+    std::condition_variable cv;
+    int connected = 0;
+    uint16_t alias_max = 0;
+    int connect_failed = 0;
+    int lost = 0;
+    std::vector<std::pair<uint64_t, bool>> delivered;
+    std::vector<std::string> messages; // "<topic> <payload>", "retained " prefixed
+
+    void onConnected(uint16_t topic_alias_max) override {
+        record([&] { ++connected; alias_max = topic_alias_max; });
+    }
+    void onConnectFailed(const std::string&) override { record([&] { ++connect_failed; }); }
+    void onConnectionLost(const std::string&) override { record([&] { ++lost; }); }
+    void onDelivered(uint64_t context, bool ok) override { record([&] { delivered.emplace_back(context, ok); }); }
+    void onMessage(std::string_view topic, std::string_view payload, bool retained) override {
+        record([&] { messages.push_back((retained ? "retained " : "") + std::string(topic) + " " + std::string(payload)); });
+    }
+
+    template <typename Predicate>
+    bool waitFor(Predicate predicate) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, 5s, predicate);
+    }
+
+private:
+    template <typename Update>
+    void record(Update update) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            update();
+        }
+        cv.notify_all();
+    }
+};
+
+/**
+ * @brief Accepts one client on 127.0.0.1 and answers like an MQTT 5 broker.
+ */
+class FakeBroker {
+public:
+    struct Publish {
+        std::string topic;
+        std::string payload;
+        int qos = 0;
+        uint16_t alias = 0;
+        uint32_t expiry = 0;
+    };
+
+    FakeBroker() {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        ::listen(listen_fd_, 1);
+        socklen_t length = sizeof(address);
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = ntohs(address.sin_port);
+        thread_ = std::thread([this] { serve(); });
+    }
+
+    ~FakeBroker() {
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        dropClient();
+        thread_.join();
+        ::close(listen_fd_);
+    }
+
+    std::string address() const { return "tcp://127.0.0.1:" + std::to_string(port_); }
+
+    // Publishes are recorded but no longer acknowledged
+    void holdAcks() { hold_acks_.store(true); }
+
+    void dropClient() {
+        const int fd = client_fd_.load();
+        if (fd >= 0) ::shutdown(fd, SHUT_RDWR);
+    }
+
+    std::vector<Publish> publishes() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return publishes_;
+    }
+
+    std::string subscribed() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return subscribed_;
+    }
+
+    bool waitForPuback(uint16_t packet_id) {
+        for (int i = 0; i < 500; ++i) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (std::find(pubacks_.begin(), pubacks_.end(), packet_id) != pubacks_.end()) return true;
+            }
+            std::this_thread::sleep_for(10ms);
+        }
+        return false;
+    }
+
+    bool waitForDisconnect() {
+        for (int i = 0; i < 500 && !disconnect_.load(); ++i) std::this_thread::sleep_for(10ms);
+        return disconnect_.load();
+    }
+
+private:
+    void serve() {
+        const int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) return;
+        client_fd_.store(fd);
+        std::string in;
+        char buffer[512];
+        ssize_t n;
+        while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            in.append(buffer, static_cast<size_t>(n));
+            MqttCodec::Packet packet;
+            while (const auto used = MqttCodec::parsePacket(in, packet)) {
+                handle(fd, packet);
+                in.erase(0, *used);
+            }
+        }
+        client_fd_.store(-1);
+        ::close(fd);
+    }
+
+    void handle(int fd, const MqttCodec::Packet& packet) {
+        std::string reply;
+        const auto body = packet.body;
+        switch (packet.type) {
+            case MqttCodec::CONNECT:
+                // Accepted, with Topic Alias Maximum 5
+                reply = {0x20, 6, 0x00, 0x00, 3, 0x22, 0x00, 0x05};
+                break;
+            case MqttCodec::PUBLISH: {
+                Publish publish;
+                publish.qos = (packet.flags >> 1) & 0x03;
+                size_t pos = 2 + ((static_cast<uint8_t>(body[0]) << 8) | static_cast<uint8_t>(body[1]));
+                publish.topic = std::string(body.substr(2, pos - 2));
+                uint16_t packet_id = 0;
+                if (publish.qos > 0) {
+                    packet_id = static_cast<uint16_t>((static_cast<uint8_t>(body[pos]) << 8) | static_cast<uint8_t>(body[pos + 1]));
+                    pos += 2;
+                }
+                const size_t end = pos + 1 + static_cast<uint8_t>(body[pos]);
+                for (++pos; pos < end;) {
+                    if (body[pos] == 0x02) {
+                        for (int i = 1; i <= 4; ++i) publish.expiry = (publish.expiry << 8) | static_cast<uint8_t>(body[pos + i]);
+                        pos += 5;
+                    } else {
+                        publish.alias = static_cast<uint16_t>((static_cast<uint8_t>(body[pos + 1]) << 8) | static_cast<uint8_t>(body[pos + 2]));
+                        pos += 3;
+                    }
+                }
+                publish.payload = std::string(body.substr(end));
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    publishes_.push_back(publish);
+                }
+                if (hold_acks_.load()) break;
+                if (publish.qos == 1) MqttCodec::appendAck(reply, MqttCodec::PUBACK, packet_id);
+                if (publish.qos == 2) MqttCodec::appendAck(reply, MqttCodec::PUBREC, packet_id);
+                break;
+            }
+            case MqttCodec::PUBREL:
+                MqttCodec::appendAck(reply, MqttCodec::PUBCOMP, MqttCodec::parseAck(body).packet_id);
+                break;
+            case MqttCodec::PUBACK: {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pubacks_.push_back(MqttCodec::parseAck(body).packet_id);
+                break;
+            }
+            case MqttCodec::SUBSCRIBE: {
+                // Packet id, no properties, filter; granted QoS 1, then a retained QoS 1 message
+                const size_t size = (static_cast<uint8_t>(body[3]) << 8) | static_cast<uint8_t>(body[4]);
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    subscribed_ = std::string(body.substr(5, size));
+                }
+                reply = {static_cast<char>(0x90), 4, body[0], body[1], 0, 1};
+                reply += {0x33, 17, 0, 10, 'h', 'u', 'b', '/', 'c', 'o', 'n', 'f', 'i', 'g', 0, 7, 0, '{', '}'};
+                break;
+            }
+            case MqttCodec::DISCONNECT:
+                disconnect_.store(true);
+                break;
+            default:
+                break;
+        }
+        if (!reply.empty()) ::send(fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+    }
+
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<int> client_fd_{-1};
+    std::atomic<bool> disconnect_{false};
+    std::atomic<bool> hold_acks_{false};
+    std::thread thread_;
+    std::mutex mutex_;
+    std::vector<Publish> publishes_;
+    std::vector<uint16_t> pubacks_;
+    std::string subscribed_;
+};
+
+IMqttTransport::Settings settingsFor(const std::string& address) {
+    IMqttTransport::Settings settings;
+    settings.address = address;
+    settings.client_id = "test";
+    settings.mqtt5 = true;
+    settings.connect_timeout = 2000ms;
+    return settings;
+}
+
+} // namespace
+
+TEST(EpollTransportTest, PublishesAtEachQosAndReportsDelivery) {
+    FakeBroker broker;
+    RecordingListener listener;
+    EpollTransport transport(settingsFor(broker.address()), listener);
+
+    IMqttTransport::Message message;
+    message.topic = "hub/t";
+    message.payload = "{}";
+    EXPECT_FALSE(transport.publish(message)); // Not connected yet
+
+    ASSERT_TRUE(transport.beginConnect());
+    ASSERT_TRUE(listener.waitFor([&] { return listener.connected == 1; }));
+    EXPECT_EQ(listener.alias_max, 5);
+
+    for (int qos = 0; qos <= 2; ++qos) {
+        message.qos = qos;
+        message.context = 10 + static_cast<uint64_t>(qos);
+        message.topic_alias = qos == 2 ? 1 : 0;
+        message.expiry = qos == 2 ? 60s : 0s;
+        ASSERT_TRUE(transport.publish(message));
+    }
+    ASSERT_TRUE(listener.waitFor([&] { return listener.delivered.size() == 3; }));
+    {
+        std::lock_guard<std::mutex> lock(listener.mutex);
+        EXPECT_EQ(listener.delivered[0], std::make_pair(uint64_t{10}, true)); // Written out
+        std::sort(listener.delivered.begin(), listener.delivered.end());
+        EXPECT_EQ(listener.delivered[1], std::make_pair(uint64_t{11}, true)); // PUBACK
+        EXPECT_EQ(listener.delivered[2], std::make_pair(uint64_t{12}, true)); // PUBREC, PUBREL, PUBCOMP
+    }
+
+    const auto publishes = broker.publishes();
+    ASSERT_EQ(publishes.size(), 3u);
+    EXPECT_EQ(publishes[2].topic, "hub/t");
+    EXPECT_EQ(publishes[2].payload, "{}");
+    EXPECT_EQ(publishes[2].qos, 2);
+    EXPECT_EQ(publishes[2].alias, 1);
+    EXPECT_EQ(publishes[2].expiry, 60u);
+
+    transport.disconnect(1000ms);
+    EXPECT_TRUE(broker.waitForDisconnect()); // Flushed before the socket closed
+    EXPECT_FALSE(transport.publish(message));
+}
+
+TEST(EpollTransportTest, SubscribesAndAcknowledgesIncomingMessages) {
+    FakeBroker broker;
+    RecordingListener listener;
+    EpollTransport transport(settingsFor(broker.address()), listener);
+    EXPECT_FALSE(transport.subscribe("hub/config", 1)); // Not connected yet
+
+    ASSERT_TRUE(transport.beginConnect());
+    ASSERT_TRUE(listener.waitFor([&] { return listener.connected == 1; }));
+    ASSERT_TRUE(transport.subscribe("hub/config", 1));
+    ASSERT_TRUE(listener.waitFor([&] { return listener.messages.size() == 1; }));
+    {
+        std::lock_guard<std::mutex> lock(listener.mutex);
+        EXPECT_EQ(listener.messages[0], "retained hub/config {}");
+    }
+    EXPECT_EQ(broker.subscribed(), "hub/config");
+    EXPECT_TRUE(broker.waitForPuback(7));
+}
+
+TEST(EpollTransportTest, ReportsFailedAttemptsAndLostConnections) {
+    RecordingListener listener;
+    {
+        EpollTransport transport(settingsFor("127.0.0.1:1"), listener); // Nobody listens on port 1
+        ASSERT_TRUE(transport.beginConnect());
+        ASSERT_TRUE(listener.waitFor([&] { return listener.connect_failed == 1; }));
+    }
+
+    FakeBroker broker;
+    EpollTransport transport(settingsFor(broker.address()), listener);
+    ASSERT_TRUE(transport.beginConnect());
+    ASSERT_TRUE(listener.waitFor([&] { return listener.connected == 1; }));
+    broker.dropClient();
+    ASSERT_TRUE(listener.waitFor([&] { return listener.lost == 1; }));
+}
+
+TEST(EpollTransportTest, PublisherHandsBackMessagesLostBeforeTheirAck) {
+    FakeBroker broker;
+    MqttPublisher::Options options;
+    options.backend = MqttPublisher::Backend::Epoll;
+    options.mqtt5 = true;
+    options.backoff.initial_delay = 10s; // No reconnect within the test
+    MqttPublisher publisher(broker.address(), "test", options);
+    std::mutex mutex;
+    std::vector<MqttPublisher::UnackedMessage> handed_back;
+    publisher.setUnackedHandler([&](std::vector<MqttPublisher::UnackedMessage> messages) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& message : messages) handed_back.push_back(std::move(message));
+    });
+    ASSERT_TRUE(publisher.connect(2000));
+    ASSERT_TRUE(publisher.addTopicAlias("hub/t"));
+
+    // Acknowledged: nothing to hand back
+    ASSERT_TRUE(publisher.publish("hub/t", "1", 1));
+    for (int i = 0; i < 500 && publisher.window().stats().acked < 1; ++i) std::this_thread::sleep_for(10ms);
+    ASSERT_EQ(publisher.window().stats().acked, 1u);
+
+    broker.holdAcks();
+    ASSERT_TRUE(publisher.publish("hub/t", "2", 1));        // Goes out as an alias only
+    ASSERT_TRUE(publisher.publish("hub/s", "3", 1, true));
+    ASSERT_TRUE(publisher.publish("hub/q0", "4", 0));       // QoS 0 carries no promise
+    for (int i = 0; i < 500 && broker.publishes().size() < 4; ++i) std::this_thread::sleep_for(10ms);
+    ASSERT_EQ(broker.publishes().size(), 4u);
+    EXPECT_TRUE(broker.publishes()[1].topic.empty());
+
+    broker.dropClient();
+    const auto handedBack = [&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return handed_back.size();
+    };
+    for (int i = 0; i < 500 && handedBack() < 2; ++i) std::this_thread::sleep_for(10ms);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_EQ(handed_back.size(), 2u);
+        EXPECT_EQ(handed_back[0].topic, "hub/t"); // Full topic, oldest first
+        EXPECT_EQ(handed_back[0].payload, "2");
+        EXPECT_EQ(handed_back[1].topic, "hub/s");
+        EXPECT_EQ(handed_back[1].qos, 1);
+        EXPECT_TRUE(handed_back[1].retained);
+    }
+    EXPECT_EQ(publisher.window().stats().messages, 0u);
+    publisher.disconnect();
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(handed_back.size(), 2u); // Handed back once
+}
+
+TEST(EpollTransportTest, RejectsAddressesItCannotServe) {
+    RecordingListener listener;
+    EXPECT_THROW(EpollTransport(settingsFor("ssl://broker:8883"), listener), std::invalid_argument);
+    EXPECT_THROW(EpollTransport(settingsFor("tcp://:1883"), listener), std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
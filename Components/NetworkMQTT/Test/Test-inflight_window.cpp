@@ -0,0 +1,66 @@
+#include "NetworkMQTT/inflight_window.h"
+#include "gtest/gtest.h"
+
+namespace SensorHub::Components {
+
+using namespace std::chrono_literals;
+
+TEST(InFlightWindowTest, LimitsTheNumberOfMessages) {
+    InFlightWindow window({2, 0});
+    const auto first = window.acquire(100);
+    const auto second = window.acquire(100);
+    ASSERT_TRUE(first && second);
+    EXPECT_FALSE(window.acquire(1));
+    EXPECT_DOUBLE_EQ(window.utilisation(), 1.0);
+
+    window.complete(*first, true);
+    EXPECT_TRUE(window.acquire(1));
+    EXPECT_EQ(window.stats().rejected, 1u);
+    EXPECT_EQ(window.stats().peak_messages, 2u);
+}
+
+TEST(InFlightWindowTest, LimitsTheBytesButAdmitsOneLargeMessage) {
+    InFlightWindow window({0, 1000});
+    const auto large = window.acquire(5000);
+    ASSERT_TRUE(large); // Alone in the window
+    EXPECT_FALSE(window.acquire(10));
+    window.complete(*large, true);
+
+    ASSERT_TRUE(window.acquire(600));
+    EXPECT_FALSE(window.acquire(500));
+    EXPECT_TRUE(window.acquire(400));
+    EXPECT_EQ(window.stats().bytes, 1000u);
+}
+
+TEST(InFlightWindowTest, MeasuresAckLatency) {
+    InFlightWindow window({8, 0});
+    const auto start = InFlightWindow::Clock::now();
+    const auto id = window.acquire(10, start);
+    ASSERT_TRUE(id);
+    const auto latency = window.complete(*id, true, start + 25ms);
+    ASSERT_TRUE(latency);
+    EXPECT_EQ(*latency, 25ms);
+    EXPECT_EQ(window.ackLatency().count(), 1u);
+    EXPECT_EQ(window.stats().acked, 1u);
+
+    // Unknown ids and failures release nothing twice and record no latency
+    EXPECT_FALSE(window.complete(*id, true));
+    const auto failed = window.acquire(10);
+    EXPECT_FALSE(window.complete(*failed, false));
+    EXPECT_EQ(window.stats().failed, 1u);
+    EXPECT_EQ(window.stats().messages, 0u);
+    EXPECT_EQ(window.ackLatency().count(), 1u);
+}
+
+TEST(InFlightWindowTest, AbandonEmptiesTheWindow) {
+    InFlightWindow window({2, 0});
+    const auto id = window.acquire(10);
+    window.acquire(10);
+    EXPECT_EQ(window.abandon(), 2u);
+    EXPECT_EQ(window.stats().messages, 0u);
+    EXPECT_EQ(window.stats().failed, 2u);
+    EXPECT_FALSE(window.complete(*id, true)); // A late ack of the old session
+    EXPECT_TRUE(window.acquire(10));
+}
+
+} // namespace SensorHub::Components
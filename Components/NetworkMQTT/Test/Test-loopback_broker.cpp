@@ -0,0 +1,144 @@
+#include "NetworkMQTT/epoll_transport.h"
+#include "NetworkMQTT/loopback_broker.h"
+#include "NetworkMQTT/mqtt_publisher.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace SensorHub::Components {
+
+using namespace std::chrono_literals;
+
+TEST(LoopbackBrokerTest, RecordsPublishesOfAnInProcessPublisher) {
+    const auto broker = LoopbackBroker::forAddress("loop://publisher-test");
+    ASSERT_TRUE(broker);
+    EXPECT_EQ(broker, LoopbackBroker::forAddress("loop://publisher-test"));
+    EXPECT_FALSE(LoopbackBroker::forAddress("tcp://127.0.0.1:1883"));
+
+    MqttPublisher::Options options;
+    options.mqtt5 = true;
+    MqttPublisher publisher("loop://publisher-test", "test", options);
+    EXPECT_STREQ(publisher.backendName(), "loopback");
+    ASSERT_TRUE(publisher.connect(1000));
+    ASSERT_TRUE(publisher.addTopicAlias("hub/temp"));
+
+    // The second and third publish only carry the alias
+    for (int i = 0; i < 3; ++i) EXPECT_TRUE(publisher.publish("hub/temp", "{\"t\":" + std::to_string(i) + "}", 1));
+    EXPECT_TRUE(publisher.publish("hub/meta", "{}", 0, true));
+    EXPECT_EQ(publisher.window().stats().messages, 0u); // Delivered synchronously
+
+    const auto records = broker->records();
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[2].topic, "hub/temp");
+    EXPECT_EQ(records[2].payload_bytes, 7u);
+    EXPECT_EQ(records[2].qos, 1);
+    EXPECT_TRUE(records[2].payload.empty()); // Payloads are not kept by default
+    EXPECT_TRUE(records[3].retained);
+    EXPECT_EQ(broker->retained("hub/meta"), "{}");
+    EXPECT_LE(records[0].arrival, records[3].arrival);
+
+    const auto stats = broker->stats();
+    EXPECT_EQ(stats.messages, 4u);
+    EXPECT_EQ(stats.bytes, 3 * (8u + 7u) + 8u + 2u);
+    publisher.disconnect();
+}
+
+TEST(LoopbackBrokerTest, DeliversSubscriptionsWithRetainedMessagesFirst) {
+    LoopbackBroker broker;
+    broker.receive("hub/config", "v1", 1, true);
+    broker.receive("hub/other", "x", 0, true);
+
+    std::vector<std::string> seen;
+    const auto id = broker.subscribe("hub/+fig", [&](std::string_view topic, std::string_view payload, bool retained) {
+        seen.push_back(std::string(topic) + "=" + std::string(payload) + (retained ? " retained" : ""));
+    });
+    EXPECT_TRUE(seen.empty()); // "+fig" is not a wildcard level
+
+    const auto config = broker.subscribe("hub/config", [&](std::string_view topic, std::string_view payload, bool retained) {
+        seen.push_back(std::string(topic) + "=" + std::string(payload) + (retained ? " retained" : ""));
+    });
+    broker.receive("hub/config", "v2", 1, true);
+    broker.unsubscribe(config);
+    broker.receive("hub/config", "v3", 1, true);
+    broker.unsubscribe(id);
+    EXPECT_EQ(seen, (std::vector<std::string>{"hub/config=v1 retained", "hub/config=v2"}));
+
+    // Through a loop:// publisher: subscribed on connect, again after a reconnect
+    const auto shared = LoopbackBroker::forAddress("loop://subscribe-test");
+    shared->receive("hub/config", "{\"a\":1}", 1, true);
+    MqttPublisher publisher("loop://subscribe-test", "test");
+    std::vector<std::string> received;
+    publisher.subscribe("hub/#", 1, [&](std::string_view topic, std::string_view payload, bool) {
+        received.push_back(std::string(topic) + " " + std::string(payload));
+    });
+    ASSERT_TRUE(publisher.connect(1000));
+    shared->receive("hub/config", "{}", 1, true);
+    publisher.disconnect();
+    shared->receive("hub/config", "lost", 1, false);
+    ASSERT_TRUE(publisher.connect(1000));
+    EXPECT_EQ(received, (std::vector<std::string>{"hub/config {\"a\":1}", "hub/config {}", "hub/config {}"}));
+    publisher.disconnect();
+}
+
+TEST(LoopbackBrokerTest, AcceptsMqttClientsOverTcp) {
+    LoopbackBroker::Options options;
+    options.keep_payloads = true;
+    LoopbackBroker broker(options);
+    EXPECT_TRUE(broker.tcpAddress().empty());
+    broker.listen();
+    EXPECT_THROW(broker.listen(), std::logic_error);
+
+    for (bool mqtt5 : {false, true}) {
+        MqttPublisher::Options publisher_options;
+        publisher_options.backend = MqttPublisher::Backend::Epoll;
+        publisher_options.mqtt5 = mqtt5;
+        MqttPublisher publisher(broker.tcpAddress(), "test", publisher_options);
+        ASSERT_TRUE(publisher.connect(2000));
+        publisher.addTopicAlias("hub/t");
+        for (int qos = 0; qos <= 2; ++qos) ASSERT_TRUE(publisher.publish("hub/t", "q" + std::to_string(qos), qos));
+        for (int i = 0; i < 200 && publisher.window().stats().messages > 0; ++i) std::this_thread::sleep_for(10ms);
+        EXPECT_EQ(publisher.window().stats().messages, 0u); // QoS 1 and 2 acknowledged
+        publisher.disconnect();
+    }
+
+    const auto records = broker.records();
+    ASSERT_EQ(records.size(), 6u);
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].topic, "hub/t"); // MQTT 5 aliases resolved
+        EXPECT_EQ(records[i].payload, "q" + std::to_string(i % 3));
+        EXPECT_EQ(records[i].qos, static_cast<int>(i % 3));
+    }
+}
+
+TEST(LoopbackBrokerTest, ReportsRatesAndWritesCsv) {
+    LoopbackBroker::Options options;
+    options.max_records = 2;
+    LoopbackBroker broker(options);
+    const auto start = LoopbackBroker::Clock::now();
+    broker.receive("a", "1234", 0, true, start);
+    broker.receive("b,c", "", 1, false, start + 500ms);
+    broker.receive("a", "", 0, true, start + 1s); // Clears the retained message; not recorded
+
+    const auto stats = broker.stats();
+    EXPECT_EQ(stats.messages, 3u);
+    EXPECT_EQ(stats.unrecorded, 1u);
+    EXPECT_DOUBLE_EQ(stats.messagesPerSecond(), 2.0);
+    EXPECT_DOUBLE_EQ(stats.bytesPerMessage(), 3.0); // (5 + 3 + 1) / 3
+    EXPECT_FALSE(broker.retained("a"));
+
+    const std::string path = ::testing::TempDir() + "loopback_broker.csv";
+    ASSERT_TRUE(broker.writeCsv(path));
+    std::ifstream file(path);
+    std::stringstream csv;
+    csv << file.rdbuf();
+    EXPECT_EQ(csv.str(), "arrival_us,topic,qos,retained,payload_bytes\n0,a,0,1,4\n500000,\"b,c\",1,0,0\n");
+    std::remove(path.c_str());
+
+    broker.clear();
+    EXPECT_EQ(broker.stats().messages, 0u);
+    EXPECT_TRUE(broker.records().empty());
+}
+
+} // namespace SensorHub::Components
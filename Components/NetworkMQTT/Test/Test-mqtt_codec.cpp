@@ -0,0 +1,117 @@
+#include "NetworkMQTT/mqtt_codec.h"
+#include "gtest/gtest.h"
+
+namespace SensorHub::Components {
+
+namespace {
+
+std::string bytes(std::initializer_list<int> values) {
+    std::string out;
+    for (int value : values) out += static_cast<char>(value);
+    return out;
+}
+
+// Assembles the packet the way a scatter-gather write would send it
+std::string wire(const IMqttTransport::Message& message, const MqttCodec::PublishHeader& header) {
+    std::string out(reinterpret_cast<const char*>(header.head.data()), header.head_size);
+    out += message.topic;
+    out.append(reinterpret_cast<const char*>(header.tail.data()), header.tail_size);
+    out += message.payload;
+    return out;
+}
+
+} // namespace
+
+TEST(MqttCodecTest, EncodesRemainingLengthAtTheBoundaries) {
+    uint8_t out[4];
+    EXPECT_EQ(MqttCodec::writeRemainingLength(0, out), 1u);
+    EXPECT_EQ(MqttCodec::writeRemainingLength(127, out), 1u);
+    EXPECT_EQ(out[0], 0x7F);
+    ASSERT_EQ(MqttCodec::writeRemainingLength(128, out), 2u);
+    EXPECT_EQ(out[0], 0x80);
+    EXPECT_EQ(out[1], 0x01);
+    EXPECT_EQ(MqttCodec::writeRemainingLength(16383, out), 2u);
+    EXPECT_EQ(MqttCodec::writeRemainingLength(16384, out), 3u);
+    EXPECT_EQ(MqttCodec::writeRemainingLength(MqttCodec::MAX_REMAINING_LENGTH, out), 4u);
+}
+
+TEST(MqttCodecTest, EncodesPublishAroundTopicAndPayload) {
+    IMqttTransport::Message message;
+    message.topic = "a/b";
+    message.payload = "xyz";
+    message.qos = 1;
+    message.retained = true;
+    MqttCodec::PublishHeader header;
+
+    // MQTT 3.1.1: fixed header, topic, packet id, payload
+    MqttCodec::encodePublish(message, 0x1234, false, header);
+    EXPECT_EQ(wire(message, header), bytes({0x33, 10, 0, 3, 'a', '/', 'b', 0x12, 0x34, 'x', 'y', 'z'}));
+
+    // MQTT 5: alias-only topic, expiry and topic alias properties
+    message.topic = "";
+    message.qos = 0;
+    message.retained = false;
+    message.topic_alias = 7;
+    message.expiry = std::chrono::seconds(300);
+    MqttCodec::encodePublish(message, 0, true, header);
+    EXPECT_EQ(wire(message, header), bytes({0x30, 14, 0, 0, 8, 0x02, 0, 0, 0x01, 0x2C, 0x23, 0, 7, 'x', 'y', 'z'}));
+}
+
+TEST(MqttCodecTest, EncodesConnect) {
+    std::string out;
+    MqttCodec::appendConnect(out, "id", 20, false);
+    EXPECT_EQ(out, bytes({0x10, 14, 0, 4, 'M', 'Q', 'T', 'T', 4, 0x02, 0, 20, 0, 2, 'i', 'd'}));
+    out.clear();
+    MqttCodec::appendConnect(out, "id", 20, true);
+    EXPECT_EQ(out, bytes({0x10, 15, 0, 4, 'M', 'Q', 'T', 'T', 5, 0x02, 0, 20, 0, 0, 2, 'i', 'd'}));
+}
+
+TEST(MqttCodecTest, EncodesSubscribe) {
+    std::string out;
+    MqttCodec::appendSubscribe(out, 3, "a/#", 1, false);
+    EXPECT_EQ(out, bytes({0x82, 8, 0, 3, 0, 3, 'a', '/', '#', 1}));
+    out.clear();
+    MqttCodec::appendSubscribe(out, 3, "a/#", 1, true);
+    EXPECT_EQ(out, bytes({0x82, 9, 0, 3, 0, 0, 3, 'a', '/', '#', 1}));
+    EXPECT_THROW(MqttCodec::appendSubscribe(out, 4, "", 0, false), std::invalid_argument);
+}
+
+TEST(MqttCodecTest, MatchesTopicFilters) {
+    EXPECT_TRUE(MqttCodec::topicMatches("hub/config", "hub/config"));
+    EXPECT_FALSE(MqttCodec::topicMatches("hub/config", "hub/config/x"));
+    EXPECT_FALSE(MqttCodec::topicMatches("hub/config/x", "hub/config"));
+    EXPECT_TRUE(MqttCodec::topicMatches("hub/+/config", "hub/a/config"));
+    EXPECT_FALSE(MqttCodec::topicMatches("hub/+", "hub/a/config"));
+    EXPECT_TRUE(MqttCodec::topicMatches("hub/#", "hub/a/config"));
+    EXPECT_TRUE(MqttCodec::topicMatches("hub/#", "hub")); // "#" includes the parent level
+    EXPECT_TRUE(MqttCodec::topicMatches("#", "x"));
+    EXPECT_TRUE(MqttCodec::topicMatches("+/+", "/x"));
+}
+
+TEST(MqttCodecTest, ParsesPacketsFromAStream) {
+    // PUBACK, then half a CONNACK
+    const std::string stream = bytes({0x40, 2, 0, 9, 0x20, 3, 0});
+    MqttCodec::Packet packet;
+    const auto used = MqttCodec::parsePacket(stream, packet);
+    ASSERT_TRUE(used);
+    EXPECT_EQ(*used, 4u);
+    EXPECT_EQ(packet.type, MqttCodec::PUBACK);
+    EXPECT_EQ(MqttCodec::parseAck(packet.body).packet_id, 9);
+    EXPECT_FALSE(MqttCodec::parsePacket(std::string_view(stream).substr(4), packet));
+
+    EXPECT_THROW(MqttCodec::parsePacket(bytes({0x20, 0xFF, 0xFF, 0xFF, 0xFF, 0x01}), packet), std::runtime_error);
+}
+
+TEST(MqttCodecTest, ReadsTopicAliasMaximumFromConnackProperties) {
+    // Receive maximum, reason string, topic alias maximum
+    const std::string body = bytes({0x00, 0x00, 11, 0x21, 0, 10, 0x1F, 0, 2, 'o', 'k', 0x22, 0, 32});
+    const auto connack = MqttCodec::parseConnack(body, true);
+    EXPECT_EQ(connack.reason, 0);
+    EXPECT_EQ(connack.topic_alias_max, 32);
+
+    EXPECT_EQ(MqttCodec::parseConnack(bytes({0x00, 0x05}), false).reason, 5); // 3.1.1: not authorized
+    EXPECT_THROW(MqttCodec::parseConnack(bytes({0x00, 0x00, 3, 0x7F, 0, 0}), true), std::runtime_error);
+    EXPECT_THROW(MqttCodec::parseConnack(bytes({0x00}), true), std::runtime_error);
+}
+
+} // namespace SensorHub::Components
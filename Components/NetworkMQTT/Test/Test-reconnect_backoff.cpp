@@ -0,0 +1,56 @@
+#include "NetworkMQTT/reconnect_backoff.h"
+#include "gtest/gtest.h"
+#include <set>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+using std::chrono::milliseconds;
+
+TEST(ReconnectBackoffTest, GrowsExponentiallyUpToTheCap) {
+    ReconnectBackoff backoff({milliseconds(100), milliseconds(1000), 2.0, 0.0});
+    const std::vector<int64_t> expected = {100, 200, 400, 800, 1000, 1000, 1000};
+    for (const auto delay : expected) EXPECT_EQ(backoff.next().count(), delay);
+    EXPECT_EQ(backoff.failures(), expected.size());
+
+    backoff.reset();
+    EXPECT_EQ(backoff.failures(), 0u);
+    EXPECT_EQ(backoff.next().count(), 100);
+}
+
+TEST(ReconnectBackoffTest, JitterStaysWithinItsFraction) {
+    ReconnectBackoff backoff({milliseconds(1000), milliseconds(8000), 2.0, 0.5}, 1234);
+    for (int round = 0; round < 200; ++round) {
+        backoff.reset();
+        for (const int64_t ceiling : {1000, 2000, 4000, 8000, 8000}) {
+            const auto delay = backoff.next().count();
+            EXPECT_GE(delay, ceiling / 2);
+            EXPECT_LE(delay, ceiling);
+        }
+    }
+}
+
+TEST(ReconnectBackoffTest, JitterSpreadsHubsApart) {
+    // Hubs that lost the broker at the same moment must not retry in lock-step
+    std::set<int64_t> first_retries;
+    for (uint64_t seed = 0; seed < 50; ++seed) {
+        ReconnectBackoff backoff({milliseconds(1000), milliseconds(60000), 2.0, 0.5}, seed);
+        first_retries.insert(backoff.next().count());
+    }
+    EXPECT_GT(first_retries.size(), 25u);
+}
+
+TEST(ReconnectBackoffTest, LongOutagesStayAtTheCap) {
+    ReconnectBackoff backoff({milliseconds(1), milliseconds(30000), 10.0, 0.0});
+    for (int i = 0; i < 5000; ++i) backoff.next();
+    EXPECT_EQ(backoff.next().count(), 30000);
+}
+
+TEST(ReconnectBackoffTest, RejectsInvalidOptions) {
+    EXPECT_THROW(ReconnectBackoff({milliseconds(0), milliseconds(10), 2.0, 0.5}), std::invalid_argument);
+    EXPECT_THROW(ReconnectBackoff({milliseconds(100), milliseconds(10), 2.0, 0.5}), std::invalid_argument);
+    EXPECT_THROW(ReconnectBackoff({milliseconds(10), milliseconds(100), 0.5, 0.5}), std::invalid_argument);
+    EXPECT_THROW(ReconnectBackoff({milliseconds(10), milliseconds(100), 2.0, 1.5}), std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
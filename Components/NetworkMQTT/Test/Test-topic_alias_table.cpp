@@ -0,0 +1,52 @@
+#include "NetworkMQTT/topic_alias_table.h"
+#include "gtest/gtest.h"
+
+namespace SensorHub::Components {
+
+TEST(TopicAliasTableTest, SendsTheTopicOncePerConnection) {
+    TopicAliasTable table(4);
+    ASSERT_TRUE(table.add("hub/bme280"));
+    ASSERT_TRUE(table.add("hub/lps25hb"));
+    EXPECT_TRUE(table.add("hub/bme280")); // Already there
+    EXPECT_EQ(table.size(), 2u);
+    table.reset(10);
+
+    auto first = table.use("hub/lps25hb");
+    EXPECT_EQ(first.alias, 2);
+    EXPECT_TRUE(first.send_topic);
+    auto second = table.use("hub/lps25hb");
+    EXPECT_EQ(second.alias, 2);
+    EXPECT_FALSE(second.send_topic);
+
+    // A new connection knows no aliases; the numbers stay the same
+    table.reset(10);
+    EXPECT_TRUE(table.use("hub/lps25hb").send_topic);
+    EXPECT_EQ(table.use("hub/lps25hb").alias, 2);
+}
+
+TEST(TopicAliasTableTest, HonoursTheBrokerMaximumAndTableSize) {
+    TopicAliasTable table(2);
+    table.add("a");
+    table.add("b");
+    EXPECT_FALSE(table.add("c"));
+
+    table.reset(0); // Broker accepts no aliases (or not connected yet)
+    EXPECT_EQ(table.use("a").alias, 0);
+    table.reset(1);
+    EXPECT_EQ(table.use("a").alias, 1);
+    EXPECT_EQ(table.use("b").alias, 0);
+    EXPECT_EQ(table.use("unknown").alias, 0);
+    EXPECT_TRUE(table.use("unknown").send_topic);
+}
+
+TEST(TopicAliasTableTest, UnuseSendsTheTopicAgain) {
+    TopicAliasTable table(1);
+    table.add("a");
+    table.reset(5);
+    EXPECT_TRUE(table.use("a").send_topic);
+    table.unuse("a"); // That publish never left
+    EXPECT_TRUE(table.use("a").send_topic);
+    EXPECT_FALSE(table.use("a").send_topic);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "NetworkMQTT/mqtt_codec.h"
+#include "NetworkMQTT/mqtt_transport.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct addrinfo;
+struct iovec;
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Minimal MQTT 3.1.1 / 5 client on a non-blocking socket and epoll, built for
+ * publishing; it can also subscribe to a few control topics.
+ *
+ * One I/O thread waits on the socket, an eventfd (wake-ups) and the keep-alive timer;
+ * it connects, reads acknowledgements, PINGRESP and PUBLISHes on subscriptions, and
+ * flushes pending output.
+ * publish() encodes only the packet header and writes header, topic and payload to the
+ * socket with one scatter-gather sendmsg() from the caller's buffers; bytes the kernel
+ * does not take right away are copied to a send buffer reserved at construction and
+ * flushed by the I/O thread. Packet ids index a table of QoS 1/2 messages that only
+ * grows to the most in flight at once, so nothing is allocated per message.
+ *
+ * QoS 0 messages are reported delivered when fully written to the socket; QoS 1 and 2
+ * when PUBACK or PUBCOMP arrives. Messages pending when the connection drops are not
+ * reported: the session is clean and the publisher abandons them with it.
+ *
+ * Supported addresses: "tcp://host:port", "mqtt://host:port" and "host:port" (port
+ * defaults to 1883). No TLS. Incoming messages must fit the receive buffer. Thread-safe.
+ */
+class EpollTransport : public IMqttTransport {
+public:
+    struct Buffers {
+        size_t send = 320 * 1024;  // Unsent output; above the default in-flight window plus headers
+        size_t receive = 64 * 1024; // Largest packet accepted from the broker (e.g. a retained config)
+    };
+
+    /**
+     * @throws std::invalid_argument if the address is not supported.
+     * @throws std::system_error if epoll or the eventfd cannot be created.
+     */
+    EpollTransport(Settings settings, Listener& listener, Buffers buffers);
+    EpollTransport(Settings settings, Listener& listener);
+    /**
+     * @brief Stops the I/O thread and closes the socket without DISCONNECT.
+     */
+    ~EpollTransport() override;
+
+    bool beginConnect() override;
+    bool publish(const Message& message) override;
+    bool subscribe(std::string_view topic_filter, int qos) override;
+    void disconnect(std::chrono::milliseconds timeout) override;
+    const char* name() const override { return "epoll"; }
+
+    // Delete copy/move operations (the I/O thread refers to this object)
+    EpollTransport(const EpollTransport&) = delete;
+    EpollTransport& operator=(const EpollTransport&) = delete;
+    EpollTransport(EpollTransport&&) = delete;
+    EpollTransport& operator=(EpollTransport&&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class State {
+        Idle,           // No socket
+        Connecting,     // TCP handshake in progress
+        AwaitingConnack,
+        Connected,
+        Disconnecting   // DISCONNECT queued; closing once flushed or at the deadline
+    };
+
+    /**
+     * @brief A listener call recorded under the lock and made after releasing it.
+     */
+    struct Event {
+        enum class Kind { Connected, ConnectFailed, ConnectionLost, Delivered, Message } kind;
+        uint64_t context = 0;
+        bool delivered = false;      // Or retained, for a message
+        uint16_t topic_alias_max = 0;
+        std::string reason;          // Or the topic of a message
+        std::string payload;         // Message only
+    };
+
+    struct Pending {
+        uint64_t context = 0;
+        bool in_use = false;
+    };
+
+    // --- I/O thread (mutex_ held) ---
+    void run();
+    void handleSocket(uint32_t events);
+    void openSocket(const addrinfo* addresses);
+    void finishConnect();
+    void readSocket();
+    void handlePacket(const MqttCodec::Packet& packet);
+    void flushOut();
+    void checkTimers(Clock::time_point now);
+    int nextTimeoutMs(Clock::time_point now) const;
+    void dispatch(std::vector<Event>& events);
+    void sendControl(); // Sends control_
+    void completeFlushed();
+    void fail(const std::string& reason);
+    void closeSocket();
+    Pending* findPending(uint16_t packet_id);
+    std::optional<uint16_t> takePacketId();
+    void releasePending(uint16_t packet_id);
+
+    // --- Shared, mutex_ held ---
+    /**
+     * @brief Writes a packet, or queues what the socket does not take.
+     * @param limit_output Refuse the packet if the send buffer would exceed its size.
+     * @return false if refused or the socket failed.
+     */
+    bool sendPacket(iovec* parts, int count, size_t total, bool limit_output);
+    void watchOutput(bool enable);
+    void wake();
+
+    const Settings settings_;
+    Listener& listener_;
+    const Buffers buffers_;
+    std::string host_;
+    std::string port_;
+
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::thread io_thread_;
+
+    // I/O thread only
+    std::vector<char> in_;
+    size_t in_size_ = 0;
+    std::string control_;                        // CONNECT, PUBREL, PINGREQ, DISCONNECT being sent
+
+    mutable std::mutex mutex_;
+    std::condition_variable idle_cv_;            // disconnect() waits for State::Idle
+    int socket_ = -1;
+    State state_ = State::Idle;
+    bool stop_ = false;
+    bool connect_requested_ = false;
+    bool disconnect_requested_ = false;
+    bool watching_output_ = false;
+    std::string out_;                            // Bytes not yet taken by the socket
+    uint64_t queued_bytes_ = 0;                  // Stream offsets of everything written or queued
+    uint64_t flushed_bytes_ = 0;
+    std::deque<std::pair<uint64_t, uint64_t>> unflushed_qos0_; // (end offset, context)
+    std::vector<Pending> pending_;               // QoS 1/2 and SUBSCRIBE awaiting their ack; index = packet id - 1
+    std::vector<uint16_t> free_ids_;             // Packet ids of unused pending_ entries
+    Clock::time_point last_write_;
+    bool ping_outstanding_ = false;
+    Clock::time_point ping_sent_;
+    Clock::time_point deadline_;                 // End of the connect attempt or of the DISCONNECT flush
+    std::string send_error_;                     // Failure seen by publish(), reported by the I/O thread
+    std::vector<Event> events_;
+};
+
+} // namespace SensorHub::Components
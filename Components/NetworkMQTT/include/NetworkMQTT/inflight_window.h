@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Metrics/latency_histogram.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Bounds the messages handed to the MQTT client that are not yet acknowledged.
+ *
+ * A message takes a slot with acquire() before it is published and gives it back with
+ * complete() when its delivery token finishes: after PUBACK (QoS 1), PUBCOMP (QoS 2) or
+ * once written to the socket (QoS 0). The time in between is recorded as ack latency.
+ * When the window is full, acquire() fails and the caller decides what to do with the
+ * message, instead of the client library buffering without bound. Thread-safe.
+ */
+class InFlightWindow {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Limits {
+        size_t max_messages = 64;       // 0 = no limit
+        size_t max_bytes = 256 * 1024;  // 0 = no limit; an empty window takes any one message
+    };
+
+    struct Stats {
+        size_t messages = 0;       // In flight now
+        size_t bytes = 0;
+        size_t peak_messages = 0;  // Most in flight at once
+        uint64_t acked = 0;
+        uint64_t failed = 0;       // Delivery failed, or abandoned with a lost connection
+        uint64_t rejected = 0;     // acquire() calls refused because the window was full
+    };
+
+    explicit InFlightWindow(Limits limits);
+
+    /**
+     * @brief Takes a slot for a message of the given size.
+     * @return Id to pass to complete(), or std::nullopt if the window is full.
+     */
+    std::optional<uint64_t> acquire(size_t bytes, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Releases the slot of a finished delivery.
+     * @return The ack latency if the message was delivered; std::nullopt if it failed or the id is unknown.
+     */
+    std::optional<Clock::duration> complete(uint64_t id, bool delivered, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Releases every slot without an acknowledgement (the session they belong to is gone).
+     * @return Number of messages abandoned.
+     */
+    size_t abandon();
+
+    /**
+     * @brief Fill level from 0 (empty) to 1 (full), by whichever limit is closer.
+     */
+    double utilisation() const;
+
+    Stats stats() const;
+
+    const LatencyHistogram& ackLatency() const { return ack_latency_; }
+
+    const Limits& limits() const { return limits_; }
+
+    // Delete copy/move operations
+    InFlightWindow(const InFlightWindow&) = delete;
+    InFlightWindow& operator=(const InFlightWindow&) = delete;
+    InFlightWindow(InFlightWindow&&) = delete;
+    InFlightWindow& operator=(InFlightWindow&&) = delete;
+
+private:
+    struct Slot {
+        size_t bytes = 0;
+        Clock::time_point sent;
+    };
+
+    const Limits limits_;
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Slot> slots_;
+    uint64_t next_id_ = 1;
+    Stats stats_;
+    LatencyHistogram ack_latency_;
+};
+
+} // namespace SensorHub::Components
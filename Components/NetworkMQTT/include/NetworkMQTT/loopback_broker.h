@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief In-process stand-in for an MQTT broker that records every message it receives.
+ *
+ * Messages reach it either through the "loop://<name>" transport of MqttPublisher (a
+ * direct call, no sockets), or over TCP from any MQTT 3.1.1/5 client once listen() is
+ * called. Each message is recorded with its arrival time, so throughput, bytes per
+ * message and latency can be measured without a network or an external broker.
+ * Retained messages are kept per topic, like a broker would. In-process code can
+ * subscribe (loop:// publishers do so through the transport); TCP clients can only
+ * publish. Thread-safe.
+ */
+class LoopbackBroker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr const char* SCHEME = "loop://";
+    static constexpr uint16_t TOPIC_ALIAS_MAX = 1024; // Announced to MQTT 5 clients
+
+    struct Options {
+        size_t max_records = 1000000; // Arrivals kept in records(); later ones are only counted
+        bool keep_payloads = false;   // Copy payloads into the records
+    };
+
+    struct Record {
+        std::string topic;       // Resolved from the topic alias if only that was sent
+        std::string payload;     // Only with Options::keep_payloads
+        size_t payload_bytes = 0;
+        int qos = 0;
+        bool retained = false;
+        Clock::time_point arrival;
+    };
+
+    struct Stats {
+        uint64_t messages = 0;
+        uint64_t bytes = 0;            // Topic and payload
+        uint64_t unrecorded = 0;       // Arrived after max_records
+        Clock::time_point first_arrival;
+        Clock::time_point last_arrival;
+
+        /**
+         * @brief Arrival rate between the first and the last message (0 with fewer than two).
+         */
+        double messagesPerSecond() const;
+        double bytesPerMessage() const;
+    };
+
+    /**
+     * @brief Receives messages on a subscription; retained is set for the retained
+     * messages handed over when subscribing.
+     */
+    using MessageHandler = std::function<void(std::string_view topic, std::string_view payload, bool retained)>;
+
+    LoopbackBroker();
+    explicit LoopbackBroker(Options options);
+    /**
+     * @brief Stops listening and closes TCP clients.
+     */
+    ~LoopbackBroker();
+
+    /**
+     * @brief The broker for a "loop://<name>" address, created on first use and kept
+     * for the life of the process, so it can be inspected after its publishers are gone.
+     * @return nullptr if the address is not a loopback address.
+     */
+    static std::shared_ptr<LoopbackBroker> forAddress(const std::string& address);
+
+    /**
+     * @brief Records one arriving message. Topic aliases must already be resolved.
+     */
+    void receive(std::string_view topic, std::string_view payload, int qos, bool retained,
+                 Clock::time_point arrival = Clock::now());
+
+    std::vector<Record> records() const;
+    Stats stats() const;
+
+    /**
+     * @brief The retained message of a topic, if any.
+     */
+    std::optional<std::string> retained(const std::string& topic) const;
+
+    /**
+     * @brief Delivers messages on topics matching the filter ("+" and "#" wildcards),
+     * starting with the matching retained messages. Handlers run on the thread that
+     * receive()s the message, after it is recorded, and must not subscribe, unsubscribe
+     * or publish to this broker.
+     * @return Id for unsubscribe().
+     */
+    uint64_t subscribe(std::string topic_filter, MessageHandler handler);
+
+    /**
+     * @brief Removes a subscription. Once this returns its handler is not running and
+     * will not be called again.
+     */
+    void unsubscribe(uint64_t id);
+
+    /**
+     * @brief Forgets records, statistics and retained messages.
+     */
+    void clear();
+
+    /**
+     * @brief Writes the records as CSV: arrival_us (since the first arrival), topic, qos,
+     * retained, payload_bytes.
+     * @return false if the file could not be written.
+     */
+    bool writeCsv(const std::string& path) const;
+
+    /**
+     * @brief Accepts MQTT clients on 127.0.0.1. Each connection gets its own thread;
+     * QoS 1 and 2 are acknowledged right after recording.
+     * @param port TCP port; 0 picks a free one.
+     * @return The port listened on.
+     * @throws std::system_error if the socket cannot be set up.
+     * @throws std::logic_error if already listening.
+     */
+    uint16_t listen(uint16_t port = 0);
+
+    /**
+     * @brief "tcp://127.0.0.1:<port>" once listen() was called, else empty.
+     */
+    std::string tcpAddress() const;
+
+    // Delete copy/move operations (listener threads refer to this object)
+    LoopbackBroker(const LoopbackBroker&) = delete;
+    LoopbackBroker& operator=(const LoopbackBroker&) = delete;
+    LoopbackBroker(LoopbackBroker&&) = delete;
+    LoopbackBroker& operator=(LoopbackBroker&&) = delete;
+
+private:
+    void record(std::string_view topic, std::string_view payload, int qos, bool retained, Clock::time_point arrival);
+    void acceptClients();
+    void serveClient(int fd);
+
+    // Topics are stored once; records refer to them by index
+    struct TopicHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view topic) const { return std::hash<std::string_view>{}(topic); }
+    };
+
+    struct Entry {
+        uint32_t topic = 0;
+        int qos = 0;
+        bool retained = false;
+        size_t payload_bytes = 0;
+        Clock::time_point arrival;
+        std::string payload;
+    };
+
+    const Options options_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::string> topics_;
+    std::unordered_map<std::string, uint32_t, TopicHash, std::equal_to<>> topic_index_;
+    std::vector<Entry> entries_;
+    Stats stats_;
+    std::unordered_map<std::string, std::string, TopicHash, std::equal_to<>> retained_;
+
+    // Subscriptions; held while handlers run, so unsubscribe() waits for them
+    std::mutex subscribers_mutex_;
+    std::map<uint64_t, std::pair<std::string, MessageHandler>> subscribers_;
+    uint64_t next_subscriber_ = 1;
+    std::atomic<size_t> subscriber_count_{0}; // Lets receive() skip the lock without subscribers
+
+    // TCP side
+    mutable std::mutex clients_mutex_;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    bool stopping_ = false;
+    std::thread acceptor_;
+    std::vector<std::thread> client_threads_;
+    std::vector<int> client_fds_;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "NetworkMQTT/mqtt_transport.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief MQTT 3.1.1 / 5 packet encoding and decoding for a client that publishes and
+ * subscribes to a few control topics, plus the few broker-side packets LoopbackBroker needs.
+ *
+ * PUBLISH packets are not assembled in one buffer: encodePublish() only renders the
+ * bytes around the topic and the payload into a fixed-size header, so a sender can hand
+ * header, topic, header tail and payload to one scatter-gather write without copying.
+ */
+class MqttCodec {
+public:
+    enum PacketType : uint8_t {
+        CONNECT = 1, CONNACK = 2, PUBLISH = 3, PUBACK = 4, PUBREC = 5, PUBREL = 6, PUBCOMP = 7,
+        SUBSCRIBE = 8, SUBACK = 9, PINGREQ = 12, PINGRESP = 13, DISCONNECT = 14
+    };
+
+    static constexpr uint32_t MAX_REMAINING_LENGTH = 268435455; // Four length bytes
+
+    /**
+     * @brief The bytes of a PUBLISH except topic and payload.
+     * Wire order: head, topic, tail, payload.
+     */
+    struct PublishHeader {
+        std::array<uint8_t, 8> head{};  // Fixed header and topic length
+        uint8_t head_size = 0;
+        std::array<uint8_t, 12> tail{}; // Packet id and MQTT 5 properties
+        uint8_t tail_size = 0;
+    };
+
+    /**
+     * @brief A complete packet in the input stream.
+     */
+    struct Packet {
+        uint8_t type = 0;
+        uint8_t flags = 0;
+        std::string_view body; // Variable header and payload
+    };
+
+    struct Connack {
+        bool session_present = false;
+        uint8_t reason = 0;           // 0 = accepted
+        uint16_t topic_alias_max = 0; // MQTT 5 property; 0 if absent
+    };
+
+    struct Ack {
+        uint16_t packet_id = 0;
+        uint8_t reason = 0; // MQTT 5 reason code; >= 0x80 is a failure
+    };
+
+    struct Connect {
+        uint8_t protocol_level = 0; // 4 = MQTT 3.1.1, 5 = MQTT 5
+        std::string_view client_id;
+    };
+
+    /**
+     * @brief A PUBLISH as a broker sees it; the views point into the packet.
+     */
+    struct Publish {
+        std::string_view topic; // Empty if only the topic alias was sent
+        std::string_view payload;
+        int qos = 0;
+        bool retained = false;
+        uint16_t packet_id = 0;
+        uint16_t topic_alias = 0;
+        uint32_t expiry = 0;
+    };
+
+    /**
+     * @brief Renders the PUBLISH bytes around message.topic and message.payload.
+     * @param packet_id Used for QoS 1 and 2 only.
+     * @throws std::invalid_argument if the topic or the packet is too long.
+     */
+    static void encodePublish(const IMqttTransport::Message& message, uint16_t packet_id, bool mqtt5,
+                              PublishHeader& out);
+
+    /**
+     * @brief Appends a CONNECT packet with a clean session/start and no credentials.
+     */
+    static void appendConnect(std::string& out, std::string_view client_id, uint16_t keep_alive_sec, bool mqtt5);
+
+    /**
+     * @brief Appends a SUBSCRIBE for one topic filter.
+     * @throws std::invalid_argument if the filter is empty or too long.
+     */
+    static void appendSubscribe(std::string& out, uint16_t packet_id, std::string_view topic_filter, int qos,
+                                bool mqtt5);
+
+    /**
+     * @brief Appends a two-byte-body packet: PUBREL (with its required flags) and the like.
+     */
+    static void appendAck(std::string& out, PacketType type, uint16_t packet_id);
+
+    /**
+     * @brief Appends a packet without body: PINGREQ or DISCONNECT.
+     */
+    static void appendEmpty(std::string& out, PacketType type);
+
+    /**
+     * @brief Finds the first complete packet in a stream.
+     * @return Bytes the packet takes, or std::nullopt if more input is needed.
+     * @throws std::runtime_error on a malformed remaining length.
+     */
+    static std::optional<size_t> parsePacket(std::string_view in, Packet& out);
+
+    /**
+     * @throws std::runtime_error if the CONNACK is malformed.
+     */
+    static Connack parseConnack(std::string_view body, bool mqtt5);
+
+    /**
+     * @brief Parses PUBACK, PUBREC, PUBREL or PUBCOMP.
+     * @throws std::runtime_error if the packet is malformed.
+     */
+    static Ack parseAck(std::string_view body);
+
+    /**
+     * @brief Whether a topic matches a subscription filter: "+" stands for one level, a
+     * trailing "#" for any number of levels, including none.
+     */
+    static bool topicMatches(std::string_view filter, std::string_view topic);
+
+    // --- Broker side ---
+
+    /**
+     * @throws std::runtime_error if the CONNECT is malformed or not MQTT.
+     */
+    static Connect parseConnect(std::string_view body);
+
+    /**
+     * @throws std::runtime_error if the PUBLISH is malformed.
+     */
+    static Publish parsePublish(const Packet& packet, bool mqtt5);
+
+    /**
+     * @brief Appends a CONNACK; with MQTT 5 it carries the Topic Alias Maximum.
+     */
+    static void appendConnack(std::string& out, uint8_t reason, uint16_t topic_alias_max, bool mqtt5);
+
+    /**
+     * @brief Writes the variable-length remaining length.
+     * @return Number of bytes written (1 to 4).
+     */
+    static size_t writeRemainingLength(uint32_t length, uint8_t* out);
+};
+
+} // namespace SensorHub::Components
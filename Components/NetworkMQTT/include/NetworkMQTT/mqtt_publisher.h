@@ -4,36 +4,158 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
 #include <memory> // For std::unique_ptr
-#include "mqtt/async_client.h" // Paho C++ header
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Metrics/metrics_registry.h"
+#include "NetworkMQTT/inflight_window.h"
+#include "NetworkMQTT/mqtt_transport.h"
+#include "NetworkMQTT/reconnect_backoff.h"
+#include "NetworkMQTT/topic_alias_table.h"
 
 namespace SensorHub::Components {
 
-class MqttPublisher : public virtual mqtt::callback,
-                      public virtual mqtt::iaction_listener {
+/**
+ * @brief Publishes to an MQTT broker; keeps the connection up in the background.
+ *
+ * A supervisor thread owns (re)connecting: it starts an asynchronous connect, waits for
+ * the outcome or a timeout, and schedules the next attempt with ReconnectBackoff.
+ * Transport callbacks only record the outcome, and publish() never waits for a
+ * connection, so callers keep running at full rate while the broker is unreachable.
+ *
+ * The connection itself is an IMqttTransport: the Paho asynchronous client, or a small
+ * single-threaded epoll client (EpollTransport) with preallocated buffers, chosen with
+ * Options::backend. A "loop://<name>" address bypasses the backend and delivers to the
+ * in-process LoopbackBroker of that name, for benchmarks and tests without a network.
+ *
+ * Every publish takes a slot of an InFlightWindow until its delivery completes, so the
+ * messages buffered by the transport are bounded by count and bytes. A full window is
+ * reported to the caller (PublishResult::WindowFull), which can spill, batch or retry.
+ *
+ * Optionally the client speaks MQTT 5: topics registered with addTopicAlias() are sent as
+ * a two-byte alias after their first publish on a connection, and messages can carry a
+ * message expiry interval so the broker drops them once stale.
+ *
+ * A few control topics (e.g. a retained configuration) can be subscribed to with
+ * subscribe(); subscriptions are renewed on every connection.
+ *
+ * Sessions are clean, so a QoS 1/2 message the broker has not acknowledged when the
+ * connection drops is gone. With setUnackedHandler() the publisher keeps a copy of each
+ * until its acknowledgement and hands the ones that never get it back to the caller.
+ */
+class MqttPublisher : private IMqttTransport::Listener {
 public:
+    /**
+     * @brief MQTT client implementation behind the publisher.
+     */
+    enum class Backend {
+        Paho,  // Eclipse Paho C++ (only when built with SENSORHUB_WITH_PAHO)
+        Epoll  // EpollTransport: one I/O thread, no TLS
+    };
+
+#ifdef SENSORHUB_WITH_PAHO
+    static constexpr Backend DEFAULT_BACKEND = Backend::Paho;
+#else
+    static constexpr Backend DEFAULT_BACKEND = Backend::Epoll;
+#endif
+
+    struct Options {
+        ReconnectBackoff::Options backoff;                 // Delays between failed attempts
+        std::chrono::milliseconds connect_timeout{10000}; // An attempt without outcome counts as failed
+        InFlightWindow::Limits inflight;                   // Unacknowledged messages handed to the transport
+        bool mqtt5 = false;                                // Connect with MQTT 5 instead of 3.1.1
+        uint16_t topic_aliases = 16;                       // MQTT 5: most topics to alias (0 = none)
+        Backend backend = DEFAULT_BACKEND;
+        // Publish results, deliveries, ack latency and connection events go here (sensorhub_mqtt_*).
+        // The registry must outlive the publisher, and not be rendered once it is destroyed.
+        MetricsRegistry* metrics = nullptr;
+    };
+
+    /**
+     * @brief Receives messages on a subscription, on the transport's thread. The views only
+     * live for the call. Handlers must return quickly and must not publish.
+     */
+    using MessageHandler = std::function<void(std::string_view topic, std::string_view payload, bool retained)>;
+
+    /**
+     * @brief An accepted QoS 1/2 message that was not acknowledged.
+     */
+    struct UnackedMessage {
+        std::string topic; // Full topic, also when it went out as an alias
+        std::string payload;
+        int qos = 1;
+        bool retained = false;
+    };
+
+    /**
+     * @brief Takes back messages whose delivery failed, or whose connection was lost or
+     * closed before the broker acknowledged them. Called on the transport's thread, or in
+     * disconnect(). Must return quickly and must not publish.
+     */
+    using UnackedHandler = std::function<void(std::vector<UnackedMessage> messages)>;
+
+    /**
+     * @brief Parses a backend name ("paho" or "epoll").
+     * @return std::nullopt if unknown or not built in.
+     */
+    static std::optional<Backend> parseBackend(std::string_view name);
+
+    /**
+     * @brief Outcome of tryPublish().
+     */
+    enum class PublishResult {
+        Accepted,     // Handed to the transport; its slot is freed when the delivery completes
+        NotConnected,
+        WindowFull,   // Too many unacknowledged messages or bytes; nothing was sent
+        Failed        // Rejected by the transport
+    };
+
+    /**
+     * @brief Connection state as seen by the supervisor.
+     */
+    enum class State {
+        Idle,         // start() not called (or stopped by disconnect())
+        Connecting,   // Attempt in flight
+        Connected,
+        WaitingRetry  // Attempt failed or connection lost; next attempt scheduled
+    };
+
     /**
      * @brief Constructor.
-     * @param broker_address The address of the MQTT broker (e.g., "tcp://localhost:1883").
+     * @param broker_address The address of the MQTT broker (e.g., "tcp://localhost:1883"),
+     * or "loop://<name>" for an in-process LoopbackBroker.
      * @param client_id The unique client ID for this connection.
-     * @throws mqtt::exception if client creation fails.
+     * @param options Reconnect schedule, connect timeout and client backend.
+     * @throws std::invalid_argument on invalid options or an address the backend cannot use.
+     * @throws std::runtime_error (mqtt::exception, std::system_error) if client creation fails.
      */
+    MqttPublisher(std::string broker_address, std::string client_id, Options options);
     MqttPublisher(std::string broker_address, std::string client_id);
     /**
-     * @brief Destructor. Attempts to disconnect gracefully.
+     * @brief Destructor. Stops the supervisor and attempts to disconnect gracefully.
      */
     ~MqttPublisher() override;
 
     /**
-     * @brief Connects to the MQTT broker asynchronously.
-     * Uses internal retry logic on failure based on MAX_RECONNECT_ATTEMPTS.
-     * @param timeout_ms Maximum time to wait for the initial connection attempt.
-     * @return True if connection attempt was initiated successfully, false otherwise.
+     * @brief Starts connecting in the background and keeps reconnecting until disconnect().
+     * Returns immediately; calling it again while running has no effect.
+     */
+    void start();
+
+    /**
+     * @brief Starts the supervisor (see start()) and waits for the connection.
+     * @param timeout_ms Maximum time to wait; the supervisor keeps trying afterwards.
+     * @return True if connected within the timeout.
      */
     bool connect(long timeout_ms = 30000);
 
     /**
-     * @brief Disconnects from the MQTT broker asynchronously.
+     * @brief Stops reconnecting and disconnects from the MQTT broker.
      * @param timeout_ms Maximum time to wait for disconnection action.
      */
     void disconnect(long timeout_ms = 10000);
@@ -44,9 +166,58 @@ public:
      * @param payload The message payload.
      * @param qos The Quality of Service level (0, 1, or 2). Default 0.
      * @param retained Whether the message should be retained by the broker. Default false.
-     * @return True if the publish request was accepted by the client library, false otherwise (e.g., not connected).
+     * @param expiry MQTT 5: the broker discards the message if it cannot deliver it within
+     * this time (zero = never; ignored with MQTT 3.1.1).
+     * @return Accepted, or why the message was not sent.
+     */
+    PublishResult tryPublish(const std::string& topic, const std::string& payload, int qos = 0, bool retained = false,
+                             std::chrono::seconds expiry = std::chrono::seconds::zero());
+
+    /**
+     * @brief tryPublish() for callers that only need to know whether the message went out.
+     * @return True if the publish request was accepted by the transport, false otherwise
+     * (e.g., not connected or in-flight window full).
      */
-    bool publish(const std::string& topic, const std::string& payload, int qos = 0, bool retained = false);
+    bool publish(const std::string& topic, const std::string& payload, int qos = 0, bool retained = false) {
+        return tryPublish(topic, payload, qos, retained) == PublishResult::Accepted;
+    }
+
+    /**
+     * @brief MQTT 5: sends the topic as an alias from its second publish on each connection.
+     * Call for frequently published topics; the broker's Topic Alias Maximum is honoured.
+     * @return false if the alias table is full or MQTT 5 is off.
+     */
+    bool addTopicAlias(const std::string& topic);
+
+    /**
+     * @brief Subscribes to a topic filter ("+" and "#" wildcards) for the life of the
+     * publisher: now if connected, and again after every (re)connect. Sessions are clean,
+     * so the broker hands over matching retained messages each time.
+     * @param qos Maximum QoS of deliveries.
+     */
+    void subscribe(std::string topic_filter, int qos, MessageHandler handler);
+
+    /**
+     * @brief Keeps a copy of every accepted QoS 1/2 message until it is acknowledged, and
+     * hands the ones that are not to the handler (at least once: the broker may have
+     * received a message whose acknowledgement was lost). Call before start(); without a
+     * handler, unacknowledged messages are dropped with the connection.
+     */
+    void setUnackedHandler(UnackedHandler handler);
+
+    bool isMqtt5() const { return mqtt5_; }
+
+    const std::string& brokerAddress() const { return broker_address_; }
+
+    /**
+     * @brief Name of the transport in use ("paho", "epoll" or "loopback").
+     */
+    const char* backendName() const { return transport_->name(); }
+
+    /**
+     * @brief Unacknowledged messages, ack latency and rejections.
+     */
+    const InFlightWindow& window() const { return window_; }
 
     /**
      * @brief Checks if the client believes it is currently connected.
@@ -55,45 +226,85 @@ public:
      */
     bool isConnected() const;
 
-    // Delete copy/assignment
+    State state() const;
+
+    /**
+     * @brief Failed attempts since the last successful connection.
+     */
+    uint32_t consecutiveFailures() const;
+
+    // Delete copy/move operations (the supervisor thread refers to this object)
     MqttPublisher(const MqttPublisher&) = delete;
     MqttPublisher& operator=(const MqttPublisher&) = delete;
-    // Allow move semantics
-    MqttPublisher(MqttPublisher&&) noexcept;
-    MqttPublisher& operator=(MqttPublisher&&) noexcept;
+    MqttPublisher(MqttPublisher&&) = delete;
+    MqttPublisher& operator=(MqttPublisher&&) = delete;
 
 private:
-    // --- Paho MQTT Callback overrides ---
-    void on_failure(const mqtt::token& tok) override;
-    void on_success(const mqtt::token& tok) override;
-    void connected(const std::string& cause) override;
-    void connection_lost(const std::string& cause) override;
-    void message_arrived(mqtt::const_message_ptr msg) override;
-    void delivery_complete(mqtt::delivery_token_ptr tok) override;
+    // --- Transport callbacks (IMqttTransport::Listener) ---
+    void onConnected(uint16_t topic_alias_max) override;
+    void onConnectFailed(const std::string& reason) override;
+    void onConnectionLost(const std::string& cause) override;
+    void onDelivered(uint64_t context, bool delivered) override; // context = window slot id
+    void onMessage(std::string_view topic, std::string_view payload, bool retained) override;
+
+    // --- Reconnect state machine (state_mutex_ held) ---
+    void superviseConnection();
+    void beginAttempt(std::unique_lock<std::mutex>& lock);
+    void scheduleRetry(const char* reason);
+
+    std::vector<UnackedMessage> takeUnacked(); // Empties unacked_
+    void handBack(std::vector<UnackedMessage> messages);
+
+    void registerMetrics(MetricsRegistry& metrics);
+    PublishResult counted(PublishResult result); // Counts a tryPublish() outcome, returns it
 
     // --- Member Variables ---
     std::string broker_address_;
     std::string client_id_;
-    std::unique_ptr<mqtt::async_client> client_; // MQTT asynchronous client instance
-    mqtt::connect_options conn_opts_;           // Connection options
+    const std::chrono::milliseconds connect_timeout_;
+    const bool mqtt5_;
+    TopicAliasTable aliases_;
 
     std::atomic<bool> connected_{false}; // Thread-safe flag for connection status
 
-    // Synchronization for connect() waiting on callback
-    std::mutex connection_mutex_;
-    std::condition_variable connection_cv_;
-    bool connection_attempt_in_progress_ = false; // Tracks if connect() is waiting
-    bool connection_succeeded_ = false;          // Result for connect() wait
+    InFlightWindow window_;
 
-    // --- Reconnection Logic ---
-    const int MAX_RECONNECT_ATTEMPTS = 5; // Max attempts before giving up (for now)
-    const std::chrono::seconds RECONNECT_DELAY = std::chrono::seconds(5); // Delay between attempts
-    int reconnect_attempts_ = 0; // Current attempt counter
+    // Copies of accepted QoS 1/2 messages by window slot, while an UnackedHandler is set
+    UnackedHandler unacked_handler_; // Set before start(), read only afterwards
+    std::mutex unacked_mutex_;
+    std::unordered_map<uint64_t, UnackedMessage> unacked_;
 
-    /**
-     * @brief Internal helper to schedule and attempt reconnection after a delay.
-     */
-    void attempt_reconnect();
+    struct Subscription {
+        std::string topic_filter;
+        int qos = 0;
+        MessageHandler handler;
+    };
+    // Only ever added to; handlers are called from copies of the pointers, outside the lock
+    std::mutex subscriptions_mutex_;
+    std::vector<std::shared_ptr<const Subscription>> subscriptions_;
+
+    // Supervisor state, guarded by state_mutex_; state_cv_ wakes the supervisor and connect() waiters
+    mutable std::mutex state_mutex_;
+    std::condition_variable state_cv_;
+    State state_ = State::Idle;
+    bool stop_requested_ = false;
+    std::chrono::steady_clock::time_point deadline_; // Retry time, or end of the current attempt
+    ReconnectBackoff backoff_;
+    std::thread supervisor_;
+
+    // Owned by Options::metrics; all null without one
+    struct Instruments {
+        Counter* publish_results[4] = {}; // By PublishResult
+        Counter* acked = nullptr;
+        Counter* delivery_failed = nullptr;
+        Histogram* ack_seconds = nullptr;
+        Counter* connection_attempts = nullptr;
+        Counter* connections_lost = nullptr;
+        Counter* reconnects = nullptr;
+    } instruments_;
+    bool ever_connected_ = false; // Tells a reconnect from the first connection (transport thread)
+
+    std::unique_ptr<IMqttTransport> transport_; // Last: its callbacks use the members above
 };
 
 } // namespace SensorHub::Components
\ No newline at end of file
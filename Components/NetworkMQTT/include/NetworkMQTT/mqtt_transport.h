@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief One connection to an MQTT broker, as MqttPublisher drives it.
+ *
+ * MqttPublisher owns reconnecting, the in-flight window, topic aliases and which topics
+ * to subscribe to; a transport only opens a session when asked, sends PUBLISH and
+ * SUBSCRIBE packets and reports what happened (and what arrived) through its Listener. Listener calls may come from the transport's own thread, or
+ * from inside the call that caused them, and are never made with a transport lock held.
+ */
+class IMqttTransport {
+public:
+    /**
+     * @brief Connection settings shared by all backends.
+     */
+    struct Settings {
+        std::string address;                               // e.g. "tcp://localhost:1883"
+        std::string client_id;
+        bool mqtt5 = false;                                // MQTT 5 instead of 3.1.1
+        std::chrono::seconds keep_alive{20};
+        std::chrono::milliseconds connect_timeout{10000};
+    };
+
+    /**
+     * @brief Receives connection and delivery events.
+     */
+    class Listener {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+         * @brief The broker accepted the session (CONNACK).
+         * @param topic_alias_max The broker's Topic Alias Maximum (MQTT 5; 0 otherwise).
+         */
+        virtual void onConnected(uint16_t topic_alias_max) = 0;
+        virtual void onConnectFailed(const std::string& reason) = 0;
+        virtual void onConnectionLost(const std::string& cause) = 0;
+
+        /**
+         * @brief A publish finished: written out (QoS 0), PUBACK (QoS 1) or PUBCOMP (QoS 2).
+         * @param context The value passed in Message::context.
+         * @param delivered false if the broker refused it or the attempt failed.
+         */
+        virtual void onDelivered(uint64_t context, bool delivered) = 0;
+
+        /**
+         * @brief A PUBLISH arrived on a subscription. The views only live for the call.
+         * Publish-only listeners can ignore it.
+         */
+        virtual void onMessage([[maybe_unused]] std::string_view topic, [[maybe_unused]] std::string_view payload,
+                               [[maybe_unused]] bool retained) {}
+    };
+
+    /**
+     * @brief One PUBLISH; the views only need to live for the duration of publish().
+     */
+    struct Message {
+        std::string_view topic;       // Empty when the topic alias stands for it
+        std::string_view payload;
+        int qos = 0;
+        bool retained = false;
+        uint16_t topic_alias = 0;     // MQTT 5; 0 = none
+        std::chrono::seconds expiry{0}; // MQTT 5 message expiry; 0 = none
+        uint64_t context = 0;         // Handed back in Listener::onDelivered
+    };
+
+    virtual ~IMqttTransport() = default;
+
+    /**
+     * @brief Starts a connection attempt; the outcome arrives through the Listener.
+     * Drops any previous connection first.
+     * @return false if the attempt could not even be started.
+     */
+    virtual bool beginConnect() = 0;
+
+    /**
+     * @brief Hands a message to the connection.
+     * @return false if it was not taken (not connected, or the send failed); onDelivered
+     * is not called for it then.
+     */
+    virtual bool publish(const Message& message) = 0;
+
+    /**
+     * @brief Subscribes the current session to a topic filter ("+" and "#" wildcards).
+     * Sessions are clean: the caller subscribes again after every onConnected().
+     * @param qos Maximum QoS of deliveries; transports may grant less.
+     * @return false if not connected or the request could not be sent.
+     */
+    virtual bool subscribe(std::string_view topic_filter, int qos) = 0;
+
+    /**
+     * @brief Closes the session gracefully, waiting up to timeout for queued data to go out.
+     */
+    virtual void disconnect(std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * @brief Backend name for logs.
+     */
+    virtual const char* name() const = 0;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Delays between reconnect attempts: exponential growth up to a cap, with jitter.
+ *
+ * The n-th consecutive failure waits a random time in [(1 - jitter) * d, d], where
+ * d = min(max_delay, initial_delay * multiplier^n). The random part keeps a fleet of
+ * hubs from reconnecting in lock-step after a broker restart. Not thread-safe.
+ */
+class ReconnectBackoff {
+public:
+    struct Options {
+        std::chrono::milliseconds initial_delay{1000};
+        std::chrono::milliseconds max_delay{60000};
+        double multiplier = 2.0;
+        double jitter = 0.5; // Fraction of the delay that is randomised, 0 to 1
+    };
+
+    /**
+     * @param options Delay schedule.
+     * @param seed Seed of the jitter generator (random by default).
+     * @throws std::invalid_argument if the delays are not positive, max_delay < initial_delay,
+     * multiplier < 1 or jitter is outside [0, 1].
+     */
+    explicit ReconnectBackoff(Options options, uint64_t seed = std::random_device{}());
+
+    /**
+     * @brief Delay before the next attempt; counts one more failure.
+     */
+    std::chrono::milliseconds next();
+
+    /**
+     * @brief Starts over at initial_delay (after a successful connection).
+     */
+    void reset() { failures_ = 0; }
+
+    /**
+     * @brief Consecutive failures since the last reset().
+     */
+    uint32_t failures() const { return failures_; }
+
+    const Options& options() const { return options_; }
+
+private:
+    Options options_;
+    std::mt19937_64 rng_;
+    uint32_t failures_ = 0;
+};
+
+} // namespace SensorHub::Components
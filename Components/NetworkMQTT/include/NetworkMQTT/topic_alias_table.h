@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief MQTT 5 topic aliases for a fixed set of topics.
+ *
+ * Each registered topic gets a number that stays the same across reconnects. Aliases
+ * only live as long as a network connection, so after reset() the first publish of a
+ * topic carries the full name together with its alias, and later ones only the alias
+ * (an empty topic name). Aliases above the broker's Topic Alias Maximum are not used.
+ * Thread-safe.
+ */
+class TopicAliasTable {
+public:
+    /**
+     * @brief What to put in the PUBLISH packet.
+     */
+    struct Use {
+        uint16_t alias = 0;      // 0: send without alias
+        bool send_topic = true;  // false: the topic name may be left empty
+    };
+
+    /**
+     * @param max_aliases Most topics to register (0 disables aliases).
+     */
+    explicit TopicAliasTable(uint16_t max_aliases);
+
+    /**
+     * @brief Registers a topic; registering it again has no effect.
+     * @return false if the table is full.
+     */
+    bool add(const std::string& topic);
+
+    /**
+     * @brief Looks up the alias for one publish; counts the topic as known to the broker afterwards.
+     */
+    Use use(const std::string& topic);
+
+    /**
+     * @brief Forgets that the broker knows the topic (the publish that introduced it was not sent).
+     */
+    void unuse(const std::string& topic);
+
+    /**
+     * @brief Starts a new connection: no alias is known to the broker yet.
+     * @param broker_max The broker's Topic Alias Maximum from CONNACK (0 = none allowed).
+     */
+    void reset(uint16_t broker_max);
+
+    size_t size() const;
+
+    // Delete copy/move operations
+    TopicAliasTable(const TopicAliasTable&) = delete;
+    TopicAliasTable& operator=(const TopicAliasTable&) = delete;
+    TopicAliasTable(TopicAliasTable&&) = delete;
+    TopicAliasTable& operator=(TopicAliasTable&&) = delete;
+
+private:
+    struct Entry {
+        uint16_t alias = 0;
+        bool known = false; // The broker has seen topic and alias together on this connection
+    };
+
+    const uint16_t max_aliases_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    uint16_t broker_max_ = 0;
+};
+
+} // namespace SensorHub::Components
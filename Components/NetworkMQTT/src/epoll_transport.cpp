@@ -0,0 +1,624 @@
+#include "NetworkMQTT/epoll_transport.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+constexpr const char* DEFAULT_PORT = "1883";
+
+std::string errnoMessage(const char* what, int error) {
+    return std::string(what) + ": " + std::generic_category().message(error);
+}
+
+} // namespace
+
+EpollTransport::EpollTransport(Settings settings, Listener& listener, Buffers buffers)
+    : settings_(std::move(settings)), listener_(listener), buffers_(buffers) {
+    // Address: [tcp:// | mqtt://]host[:port], host may be a bracketed IPv6 literal
+    std::string_view address = settings_.address;
+    for (const std::string_view scheme : {"tcp://", "mqtt://"}) {
+        if (address.starts_with(scheme)) {
+            address.remove_prefix(scheme.size());
+            break;
+        }
+    }
+    if (address.find("://") != std::string_view::npos) {
+        throw std::invalid_argument("Unsupported MQTT address for the epoll client (plain TCP only): " + settings_.address);
+    }
+    if (address.starts_with('[')) {
+        const size_t close = address.find(']');
+        if (close == std::string_view::npos) throw std::invalid_argument("Malformed MQTT address: " + settings_.address);
+        host_ = address.substr(1, close - 1);
+        address.remove_prefix(close + 1);
+        if (address.starts_with(':')) port_ = address.substr(1);
+        else if (!address.empty()) throw std::invalid_argument("Malformed MQTT address: " + settings_.address);
+    } else if (const size_t colon = address.rfind(':'); colon != std::string_view::npos) {
+        host_ = address.substr(0, colon);
+        port_ = address.substr(colon + 1);
+    } else {
+        host_ = address;
+    }
+    if (port_.empty()) port_ = DEFAULT_PORT;
+    if (host_.empty()) throw std::invalid_argument("MQTT address without host: " + settings_.address);
+    if (buffers_.receive < 16) throw std::invalid_argument("MQTT receive buffer too small");
+
+    in_.resize(buffers_.receive);
+    out_.reserve(buffers_.send);
+    events_.reserve(16);
+
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) throw std::system_error(errno, std::generic_category(), "epoll_create1");
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        const int error = errno;
+        ::close(epoll_fd_);
+        throw std::system_error(error, std::generic_category(), "eventfd");
+    }
+    epoll_event wake_event{};
+    wake_event.events = EPOLLIN;
+    wake_event.data.fd = wake_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &wake_event);
+
+    io_thread_ = std::thread(&EpollTransport::run, this);
+}
+
+EpollTransport::EpollTransport(Settings settings, Listener& listener)
+    : EpollTransport(std::move(settings), listener, Buffers{}) {}
+
+EpollTransport::~EpollTransport() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        wake();
+    }
+    idle_cv_.notify_all();
+    if (io_thread_.joinable()) io_thread_.join();
+    closeSocket();
+    ::close(wake_fd_);
+    ::close(epoll_fd_);
+}
+
+// --- Public Methods ---
+
+bool EpollTransport::beginConnect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) return false;
+    connect_requested_ = true; // The I/O thread drops the current socket, if any
+    wake();
+    return true;
+}
+
+bool EpollTransport::publish(const Message& message) {
+    MqttCodec::PublishHeader header;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (state_ != State::Connected) return false;
+
+    uint16_t packet_id = 0;
+    if (message.qos > 0) {
+        const auto id = takePacketId();
+        if (!id) return false; // Every packet id is taken
+        packet_id = *id;
+    }
+    try {
+        MqttCodec::encodePublish(message, packet_id, settings_.mqtt5, header);
+    } catch (const std::invalid_argument& exc) {
+        std::cerr << "MQTT Error publishing to topic '" << message.topic << "': " << exc.what() << std::endl;
+        if (packet_id != 0) free_ids_.push_back(packet_id);
+        return false;
+    }
+
+    // Wire order: fixed header + topic length, topic, packet id + properties, payload
+    iovec parts[4] = {
+        {header.head.data(), header.head_size},
+        {const_cast<char*>(message.topic.data()), message.topic.size()},
+        {header.tail.data(), header.tail_size},
+        {const_cast<char*>(message.payload.data()), message.payload.size()},
+    };
+    const size_t total = header.head_size + message.topic.size() + header.tail_size + message.payload.size();
+    if (!sendPacket(parts, 4, total, true)) {
+        if (packet_id != 0) free_ids_.push_back(packet_id);
+        return false;
+    }
+
+    if (message.qos > 0) {
+        pending_[packet_id - 1] = Pending{message.context, true};
+        return true;
+    }
+    if (flushed_bytes_ < queued_bytes_) {
+        unflushed_qos0_.emplace_back(queued_bytes_, message.context); // Completes as out_ drains
+        return true;
+    }
+    lock.unlock();
+    listener_.onDelivered(message.context, true); // QoS 0, fully written
+    return true;
+}
+
+bool EpollTransport::subscribe(std::string_view topic_filter, int qos) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ != State::Connected) return false;
+    const auto packet_id = takePacketId();
+    if (!packet_id) return false;
+    std::string packet;
+    try {
+        MqttCodec::appendSubscribe(packet, *packet_id, topic_filter, qos, settings_.mqtt5);
+    } catch (const std::invalid_argument& exc) {
+        std::cerr << "MQTT Error subscribing to '" << topic_filter << "': " << exc.what() << std::endl;
+        free_ids_.push_back(*packet_id);
+        return false;
+    }
+    iovec part{packet.data(), packet.size()};
+    if (!sendPacket(&part, 1, packet.size(), false)) {
+        free_ids_.push_back(*packet_id);
+        return false;
+    }
+    pending_[*packet_id - 1] = Pending{0, true}; // Released by the SUBACK
+    return true;
+}
+
+void EpollTransport::disconnect(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    connect_requested_ = false;
+    disconnect_requested_ = true; // Also cancels an attempt still resolving the host
+    deadline_ = Clock::now() + timeout;
+    wake();
+    idle_cv_.wait(lock, [this] { return (state_ == State::Idle && !disconnect_requested_) || stop_; });
+}
+
+// --- I/O Thread ---
+
+void EpollTransport::run() {
+    std::vector<Event> events;
+    events.reserve(events_.capacity());
+    epoll_event ready[8];
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        if (connect_requested_) {
+            connect_requested_ = false;
+            closeSocket();
+            // Name resolution may block; publish() must not wait for it
+            lock.unlock();
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            hints.ai_flags = AI_ADDRCONFIG;
+            addrinfo* result = nullptr;
+            const int rc = ::getaddrinfo(host_.c_str(), port_.c_str(), &hints, &result);
+            lock.lock();
+            if (rc != 0) {
+                events_.push_back(Event{Event::Kind::ConnectFailed, 0, false, 0,
+                                        "cannot resolve " + host_ + ": " + ::gai_strerror(rc), {}});
+            } else {
+                if (!stop_ && !connect_requested_ && !disconnect_requested_) openSocket(result);
+                ::freeaddrinfo(result);
+            }
+        }
+        if (disconnect_requested_) {
+            disconnect_requested_ = false;
+            if (state_ == State::Connected) {
+                control_.clear();
+                MqttCodec::appendEmpty(control_, MqttCodec::DISCONNECT);
+                sendControl();
+                state_ = State::Disconnecting; // Closed by checkTimers() once flushed
+            } else {
+                closeSocket();
+            }
+        }
+        checkTimers(Clock::now());
+
+        if (!events_.empty()) {
+            events.swap(events_);
+            lock.unlock();
+            dispatch(events);
+            lock.lock();
+            continue;
+        }
+
+        const int timeout_ms = nextTimeoutMs(Clock::now());
+        lock.unlock();
+        const int count = ::epoll_wait(epoll_fd_, ready, 8, timeout_ms);
+        const int wait_error = errno;
+        lock.lock();
+        if (count < 0) {
+            if (wait_error == EINTR) continue;
+            std::cerr << "MQTT Error: " << errnoMessage("epoll_wait", wait_error) << std::endl;
+            stop_ = true; // Nothing can be serviced any more; don't leave disconnect() waiting
+            closeSocket();
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (ready[i].data.fd == wake_fd_) {
+                uint64_t counter;
+                [[maybe_unused]] const ssize_t n = ::read(wake_fd_, &counter, sizeof(counter));
+            } else if (ready[i].data.fd == socket_) {
+                handleSocket(ready[i].events);
+            }
+        }
+    }
+}
+
+void EpollTransport::dispatch(std::vector<Event>& events) {
+    for (const Event& event : events) {
+        switch (event.kind) {
+            case Event::Kind::Connected:      listener_.onConnected(event.topic_alias_max); break;
+            case Event::Kind::ConnectFailed:  listener_.onConnectFailed(event.reason); break;
+            case Event::Kind::ConnectionLost: listener_.onConnectionLost(event.reason); break;
+            case Event::Kind::Delivered:      listener_.onDelivered(event.context, event.delivered); break;
+            case Event::Kind::Message:        listener_.onMessage(event.reason, event.payload, event.delivered); break;
+        }
+    }
+    events.clear();
+}
+
+void EpollTransport::openSocket(const addrinfo* addresses) {
+    in_size_ = 0;
+    send_error_.clear();
+    std::string error = "no address for " + host_;
+    for (const addrinfo* ai = addresses; ai; ai = ai->ai_next) {
+        const int fd = ::socket(ai->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            error = errnoMessage("socket", errno);
+            continue;
+        }
+        const int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // Small packets go out right away
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) < 0 && errno != EINPROGRESS) {
+            error = errnoMessage("connect", errno);
+            ::close(fd);
+            continue;
+        }
+        // Writable once the handshake finished (or failed)
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+        socket_ = fd;
+        watching_output_ = true;
+        state_ = State::Connecting;
+        deadline_ = Clock::now() + settings_.connect_timeout;
+        return;
+    }
+    events_.push_back(Event{Event::Kind::ConnectFailed, 0, false, 0, error, {}});
+}
+
+void EpollTransport::handleSocket(uint32_t events) {
+    if (state_ == State::Connecting) {
+        if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) finishConnect();
+        return;
+    }
+    if (events & (EPOLLIN | EPOLLERR | EPOLLHUP)) readSocket();
+    if (socket_ >= 0 && (events & EPOLLOUT)) flushOut();
+}
+
+void EpollTransport::finishConnect() {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    ::getsockopt(socket_, SOL_SOCKET, SO_ERROR, &error, &length);
+    if (error != 0) {
+        fail(errnoMessage("connect", error));
+        return;
+    }
+    state_ = State::AwaitingConnack;
+    const auto keep_alive = std::min<std::chrono::seconds::rep>(settings_.keep_alive.count(), 0xFFFF);
+    control_.clear();
+    MqttCodec::appendConnect(control_, settings_.client_id, static_cast<uint16_t>(keep_alive), settings_.mqtt5);
+    sendControl();
+    if (socket_ >= 0 && out_.empty()) watchOutput(false);
+}
+
+void EpollTransport::readSocket() {
+    while (socket_ >= 0) {
+        if (in_size_ == in_.size()) {
+            fail("packet from broker exceeds the receive buffer");
+            return;
+        }
+        const ssize_t n = ::recv(socket_, in_.data() + in_size_, in_.size() - in_size_, 0);
+        if (n == 0) {
+            fail(send_error_.empty() ? "connection closed by broker" : send_error_);
+            return;
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) return;
+            fail(errnoMessage("recv", errno));
+            return;
+        }
+        in_size_ += static_cast<size_t>(n);
+
+        size_t offset = 0;
+        try {
+            MqttCodec::Packet packet;
+            while (socket_ >= 0) {
+                const auto used = MqttCodec::parsePacket(std::string_view(in_.data() + offset, in_size_ - offset), packet);
+                if (!used) break;
+                handlePacket(packet);
+                offset += *used;
+            }
+        } catch (const std::runtime_error& exc) {
+            fail(std::string("protocol error: ") + exc.what());
+            return;
+        }
+        if (socket_ < 0) return;
+        std::memmove(in_.data(), in_.data() + offset, in_size_ - offset);
+        in_size_ -= offset;
+    }
+}
+
+void EpollTransport::handlePacket(const MqttCodec::Packet& packet) {
+    switch (packet.type) {
+        case MqttCodec::CONNACK: {
+            if (state_ != State::AwaitingConnack) throw std::runtime_error("unexpected CONNACK");
+            const auto connack = MqttCodec::parseConnack(packet.body, settings_.mqtt5);
+            if (connack.reason != 0) {
+                fail("broker refused the connection (reason " + std::to_string(connack.reason) + ")");
+                return;
+            }
+            state_ = State::Connected;
+            ping_outstanding_ = false;
+            events_.push_back(Event{Event::Kind::Connected, 0, false, connack.topic_alias_max, {}, {}});
+            break;
+        }
+        case MqttCodec::PUBACK:
+        case MqttCodec::PUBCOMP: {
+            const auto ack = MqttCodec::parseAck(packet.body);
+            const Pending* pending = findPending(ack.packet_id);
+            if (!pending) break; // Not ours any more
+            events_.push_back(Event{Event::Kind::Delivered, pending->context, ack.reason < 0x80, 0, {}, {}});
+            releasePending(ack.packet_id);
+            break;
+        }
+        case MqttCodec::PUBREC: {
+            const auto ack = MqttCodec::parseAck(packet.body);
+            const Pending* pending = findPending(ack.packet_id);
+            if (!pending) break;
+            if (ack.reason >= 0x80) { // Refused; there is no PUBCOMP to wait for
+                events_.push_back(Event{Event::Kind::Delivered, pending->context, false, 0, {}, {}});
+                releasePending(ack.packet_id);
+                break;
+            }
+            control_.clear();
+            MqttCodec::appendAck(control_, MqttCodec::PUBREL, ack.packet_id);
+            sendControl();
+            break;
+        }
+        case MqttCodec::SUBACK: {
+            // A refused filter (reason >= 0x80) only means nothing will arrive on it
+            const auto ack = MqttCodec::parseAck(packet.body);
+            if (findPending(ack.packet_id)) releasePending(ack.packet_id);
+            break;
+        }
+        case MqttCodec::PUBLISH: {
+            // Subscriptions are few and quiet; QoS 2 is acknowledged like QoS 1 and may be seen twice
+            const auto publish = MqttCodec::parsePublish(packet, settings_.mqtt5);
+            if (publish.topic.empty()) throw std::runtime_error("PUBLISH without topic (no aliases were offered)");
+            Event event{Event::Kind::Message, 0, publish.retained, 0, {}, {}};
+            event.reason.assign(publish.topic);
+            event.payload.assign(publish.payload);
+            events_.push_back(std::move(event));
+            if (publish.qos > 0) {
+                control_.clear();
+                MqttCodec::appendAck(control_, publish.qos == 1 ? MqttCodec::PUBACK : MqttCodec::PUBREC, publish.packet_id);
+                sendControl();
+            }
+            break;
+        }
+        case MqttCodec::PUBREL:
+            control_.clear();
+            MqttCodec::appendAck(control_, MqttCodec::PUBCOMP, MqttCodec::parseAck(packet.body).packet_id);
+            sendControl();
+            break;
+        case MqttCodec::PINGRESP:
+            ping_outstanding_ = false;
+            break;
+        case MqttCodec::DISCONNECT:
+            fail("broker sent DISCONNECT");
+            break;
+        default:
+            break;
+    }
+}
+
+void EpollTransport::flushOut() {
+    while (!out_.empty()) {
+        const ssize_t n = ::send(socket_, out_.data(), out_.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) break;
+            fail(errnoMessage("send", errno));
+            return;
+        }
+        out_.erase(0, static_cast<size_t>(n));
+        flushed_bytes_ += static_cast<uint64_t>(n);
+        last_write_ = Clock::now();
+    }
+    completeFlushed();
+    if (out_.empty()) watchOutput(false);
+}
+
+void EpollTransport::checkTimers(Clock::time_point now) {
+    switch (state_) {
+        case State::Idle:
+            break;
+        case State::Connecting:
+        case State::AwaitingConnack:
+            if (now >= deadline_) fail("connect timed out");
+            break;
+        case State::Disconnecting:
+            if (out_.empty() || now >= deadline_) closeSocket();
+            break;
+        case State::Connected: {
+            const auto keep_alive = settings_.keep_alive;
+            if (keep_alive.count() <= 0) break;
+            if (ping_outstanding_) {
+                if (now - ping_sent_ >= keep_alive) fail("no PINGRESP within the keep-alive interval");
+            } else if (now - last_write_ >= keep_alive) {
+                control_.clear();
+                MqttCodec::appendEmpty(control_, MqttCodec::PINGREQ);
+                sendControl();
+                ping_outstanding_ = true;
+                ping_sent_ = now;
+            }
+            break;
+        }
+    }
+}
+
+int EpollTransport::nextTimeoutMs(Clock::time_point now) const {
+    Clock::time_point due;
+    switch (state_) {
+        case State::Idle:
+            return -1;
+        case State::Connecting:
+        case State::AwaitingConnack:
+        case State::Disconnecting:
+            due = deadline_;
+            break;
+        case State::Connected:
+            if (settings_.keep_alive.count() <= 0) return -1;
+            due = (ping_outstanding_ ? ping_sent_ : last_write_) + settings_.keep_alive;
+            break;
+    }
+    const auto ms = std::chrono::ceil<std::chrono::milliseconds>(due - now).count();
+    return static_cast<int>(std::clamp<decltype(ms)>(ms, 0, INT_MAX));
+}
+
+// --- Shared Helpers (mutex_ held) ---
+
+bool EpollTransport::sendPacket(iovec* parts, int count, size_t total, bool limit_output) {
+    if (socket_ < 0) return false;
+    if (limit_output && !out_.empty() && out_.size() + total > buffers_.send) return false;
+
+    size_t written = 0;
+    if (out_.empty()) { // Nothing queued ahead: write straight from the caller's buffers
+        msghdr header{};
+        header.msg_iov = parts;
+        header.msg_iovlen = static_cast<size_t>(count);
+        ssize_t n;
+        do {
+            n = ::sendmsg(socket_, &header, MSG_NOSIGNAL | MSG_DONTWAIT);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+            if (errno != EAGAIN) {
+                // Let the I/O thread see the failure and report it as a lost connection
+                send_error_ = errnoMessage("send", errno);
+                ::shutdown(socket_, SHUT_RDWR);
+                return false;
+            }
+            n = 0;
+        }
+        written = static_cast<size_t>(n);
+        flushed_bytes_ += written;
+        if (written > 0) last_write_ = Clock::now();
+    }
+    queued_bytes_ += total;
+
+    // Keep whatever the socket did not take, in order
+    size_t skip = written;
+    for (int i = 0; i < count; ++i) {
+        const size_t length = parts[i].iov_len;
+        if (skip >= length) {
+            skip -= length;
+            continue;
+        }
+        out_.append(static_cast<const char*>(parts[i].iov_base) + skip, length - skip);
+        skip = 0;
+    }
+    if (!out_.empty()) watchOutput(true);
+    return true;
+}
+
+void EpollTransport::sendControl() {
+    iovec part{control_.data(), control_.size()};
+    sendPacket(&part, 1, control_.size(), false);
+}
+
+void EpollTransport::watchOutput(bool enable) {
+    if (socket_ < 0 || watching_output_ == enable) return;
+    epoll_event event{};
+    event.events = EPOLLIN | (enable ? EPOLLOUT : 0u);
+    event.data.fd = socket_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, socket_, &event);
+    watching_output_ = enable;
+}
+
+void EpollTransport::completeFlushed() {
+    while (!unflushed_qos0_.empty() && unflushed_qos0_.front().first <= flushed_bytes_) {
+        events_.push_back(Event{Event::Kind::Delivered, unflushed_qos0_.front().second, true, 0, {}, {}});
+        unflushed_qos0_.pop_front();
+    }
+}
+
+void EpollTransport::fail(const std::string& reason) {
+    const State was = state_;
+    closeSocket();
+    if (was == State::Connecting || was == State::AwaitingConnack) {
+        events_.push_back(Event{Event::Kind::ConnectFailed, 0, false, 0, reason, {}});
+    } else if (was == State::Connected) {
+        events_.push_back(Event{Event::Kind::ConnectionLost, 0, false, 0, reason, {}});
+    }
+}
+
+void EpollTransport::closeSocket() {
+    if (socket_ >= 0) {
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, socket_, nullptr);
+        ::close(socket_);
+        socket_ = -1;
+    }
+    state_ = State::Idle;
+    watching_output_ = false;
+    out_.clear();
+    queued_bytes_ = flushed_bytes_;
+    unflushed_qos0_.clear();
+    free_ids_.clear();
+    for (size_t id = pending_.size(); id > 0; --id) { // Lowest ids are handed out first
+        pending_[id - 1].in_use = false;
+        free_ids_.push_back(static_cast<uint16_t>(id));
+    }
+    ping_outstanding_ = false;
+    in_size_ = 0;
+    idle_cv_.notify_all();
+}
+
+EpollTransport::Pending* EpollTransport::findPending(uint16_t packet_id) {
+    if (packet_id == 0 || packet_id > pending_.size() || !pending_[packet_id - 1].in_use) return nullptr;
+    return &pending_[packet_id - 1];
+}
+
+std::optional<uint16_t> EpollTransport::takePacketId() {
+    // Ids are reused once acknowledged, so the table stays as large as the most in flight
+    if (!free_ids_.empty()) {
+        const uint16_t packet_id = free_ids_.back();
+        free_ids_.pop_back();
+        return packet_id;
+    }
+    if (pending_.size() == 0xFFFF) return std::nullopt;
+    pending_.emplace_back();
+    return static_cast<uint16_t>(pending_.size());
+}
+
+void EpollTransport::releasePending(uint16_t packet_id) {
+    pending_[packet_id - 1].in_use = false;
+    free_ids_.push_back(packet_id);
+}
+
+void EpollTransport::wake() {
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t n = ::write(wake_fd_, &one, sizeof(one));
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,73 @@
+#include "NetworkMQTT/inflight_window.h"
+#include <algorithm>
+
+namespace SensorHub::Components {
+
+InFlightWindow::InFlightWindow(Limits limits) : limits_(limits) {}
+
+std::optional<uint64_t> InFlightWindow::acquire(size_t bytes, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool count_full = limits_.max_messages != 0 && stats_.messages >= limits_.max_messages;
+    // A message larger than the byte limit still goes out, but only on its own
+    const bool bytes_full = limits_.max_bytes != 0 && stats_.messages != 0 && stats_.bytes + bytes > limits_.max_bytes;
+    if (count_full || bytes_full) {
+        ++stats_.rejected;
+        return std::nullopt;
+    }
+    const uint64_t id = next_id_++;
+    slots_.emplace(id, Slot{bytes, now});
+    ++stats_.messages;
+    stats_.bytes += bytes;
+    stats_.peak_messages = std::max(stats_.peak_messages, stats_.messages);
+    return id;
+}
+
+std::optional<InFlightWindow::Clock::duration> InFlightWindow::complete(uint64_t id, bool delivered,
+                                                                        Clock::time_point now) {
+    Clock::duration latency{};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = slots_.find(id);
+        if (it == slots_.end()) return std::nullopt; // Abandoned already
+        --stats_.messages;
+        stats_.bytes -= it->second.bytes;
+        latency = now - it->second.sent;
+        slots_.erase(it);
+        if (!delivered) {
+            ++stats_.failed;
+            return std::nullopt;
+        }
+        ++stats_.acked;
+    }
+    ack_latency_.record(latency);
+    return latency;
+}
+
+size_t InFlightWindow::abandon() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t abandoned = slots_.size();
+    slots_.clear();
+    stats_.messages = 0;
+    stats_.bytes = 0;
+    stats_.failed += abandoned;
+    return abandoned;
+}
+
+double InFlightWindow::utilisation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double level = 0.0;
+    if (limits_.max_messages != 0) {
+        level = static_cast<double>(stats_.messages) / static_cast<double>(limits_.max_messages);
+    }
+    if (limits_.max_bytes != 0) {
+        level = std::max(level, static_cast<double>(stats_.bytes) / static_cast<double>(limits_.max_bytes));
+    }
+    return std::min(level, 1.0);
+}
+
+InFlightWindow::Stats InFlightWindow::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,310 @@
+#include "NetworkMQTT/loopback_broker.h"
+#include "NetworkMQTT/mqtt_codec.h"
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+std::string csvField(const std::string& value) {
+    if (value.find_first_of(",\"\n") == std::string::npos) return value;
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + '"';
+}
+
+bool sendAll(int fd, std::string_view data) {
+    while (!data.empty()) {
+        const ssize_t sent = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(sent));
+    }
+    return true;
+}
+
+} // namespace
+
+double LoopbackBroker::Stats::messagesPerSecond() const {
+    const double seconds = std::chrono::duration<double>(last_arrival - first_arrival).count();
+    if (messages < 2 || seconds <= 0.0) return 0.0;
+    return static_cast<double>(messages - 1) / seconds;
+}
+
+double LoopbackBroker::Stats::bytesPerMessage() const {
+    return messages ? static_cast<double>(bytes) / static_cast<double>(messages) : 0.0;
+}
+
+LoopbackBroker::LoopbackBroker() : LoopbackBroker(Options{}) {}
+
+LoopbackBroker::LoopbackBroker(Options options) : options_(options) {
+    entries_.reserve(std::min<size_t>(options_.max_records, 4096));
+}
+
+LoopbackBroker::~LoopbackBroker() {
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        stopping_ = true;
+        if (listen_fd_ >= 0) ::shutdown(listen_fd_, SHUT_RDWR);
+        for (int fd : client_fds_) ::shutdown(fd, SHUT_RDWR);
+    }
+    if (acceptor_.joinable()) acceptor_.join();
+    // The acceptor was the only one adding client threads
+    for (auto& thread : client_threads_) thread.join();
+    if (listen_fd_ >= 0) ::close(listen_fd_);
+}
+
+std::shared_ptr<LoopbackBroker> LoopbackBroker::forAddress(const std::string& address) {
+    if (!address.starts_with(SCHEME)) return nullptr;
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::shared_ptr<LoopbackBroker>> registry;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& broker = registry[address.substr(std::char_traits<char>::length(SCHEME))];
+    if (!broker) broker = std::make_shared<LoopbackBroker>();
+    return broker;
+}
+
+void LoopbackBroker::receive(std::string_view topic, std::string_view payload, int qos, bool retained,
+                             Clock::time_point arrival) {
+    record(topic, payload, qos, retained, arrival);
+    if (subscriber_count_.load(std::memory_order_acquire) == 0) return;
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    for (const auto& [id, subscriber] : subscribers_) {
+        if (MqttCodec::topicMatches(subscriber.first, topic)) subscriber.second(topic, payload, false);
+    }
+}
+
+uint64_t LoopbackBroker::subscribe(std::string topic_filter, MessageHandler handler) {
+    // Taken first, so a message arriving meanwhile is either among the retained ones or delivered after them
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    std::vector<std::pair<std::string, std::string>> matching;
+    {
+        std::lock_guard<std::mutex> retained_lock(mutex_);
+        for (const auto& [topic, payload] : retained_) {
+            if (MqttCodec::topicMatches(topic_filter, topic)) matching.emplace_back(topic, payload);
+        }
+    }
+    for (const auto& [topic, payload] : matching) handler(topic, payload, true);
+    const uint64_t id = next_subscriber_++;
+    subscribers_.emplace(id, std::make_pair(std::move(topic_filter), std::move(handler)));
+    subscriber_count_.store(subscribers_.size(), std::memory_order_release);
+    return id;
+}
+
+void LoopbackBroker::unsubscribe(uint64_t id) {
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    subscribers_.erase(id);
+    subscriber_count_.store(subscribers_.size(), std::memory_order_release);
+}
+
+void LoopbackBroker::record(std::string_view topic, std::string_view payload, int qos, bool retained,
+                            Clock::time_point arrival) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stats_.messages == 0) stats_.first_arrival = arrival;
+    ++stats_.messages;
+    stats_.bytes += topic.size() + payload.size();
+    stats_.last_arrival = std::max(stats_.last_arrival, arrival);
+
+    if (retained) {
+        // An empty retained payload clears the topic, as on a real broker
+        auto it = retained_.find(topic);
+        if (payload.empty()) {
+            if (it != retained_.end()) retained_.erase(it);
+        } else if (it != retained_.end()) {
+            it->second.assign(payload);
+        } else {
+            retained_.emplace(std::string(topic), std::string(payload));
+        }
+    }
+
+    if (entries_.size() >= options_.max_records) {
+        ++stats_.unrecorded;
+        return;
+    }
+    auto index = topic_index_.find(topic);
+    if (index == topic_index_.end()) {
+        index = topic_index_.emplace(std::string(topic), static_cast<uint32_t>(topics_.size())).first;
+        topics_.emplace_back(topic);
+    }
+    Entry& entry = entries_.emplace_back();
+    entry.topic = index->second;
+    entry.qos = qos;
+    entry.retained = retained;
+    entry.payload_bytes = payload.size();
+    entry.arrival = arrival;
+    if (options_.keep_payloads) entry.payload.assign(payload);
+}
+
+std::vector<LoopbackBroker::Record> LoopbackBroker::records() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Record> result;
+    result.reserve(entries_.size());
+    for (const Entry& entry : entries_) {
+        result.push_back(Record{topics_[entry.topic], entry.payload, entry.payload_bytes, entry.qos,
+                                entry.retained, entry.arrival});
+    }
+    return result;
+}
+
+LoopbackBroker::Stats LoopbackBroker::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::optional<std::string> LoopbackBroker::retained(const std::string& topic) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = retained_.find(topic);
+    if (it == retained_.end()) return std::nullopt;
+    return it->second;
+}
+
+void LoopbackBroker::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    topics_.clear();
+    topic_index_.clear();
+    entries_.clear();
+    retained_.clear();
+    stats_ = Stats{};
+}
+
+bool LoopbackBroker::writeCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    file << "arrival_us,topic,qos,retained,payload_bytes\n";
+    for (const Entry& entry : entries_) {
+        const auto offset = std::chrono::duration_cast<std::chrono::microseconds>(entry.arrival - stats_.first_arrival);
+        file << offset.count() << ',' << csvField(topics_[entry.topic]) << ',' << entry.qos << ','
+             << (entry.retained ? 1 : 0) << ',' << entry.payload_bytes << '\n';
+    }
+    return static_cast<bool>(file.flush());
+}
+
+uint16_t LoopbackBroker::listen(uint16_t port) {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    if (listen_fd_ >= 0) throw std::logic_error("LoopbackBroker is already listening");
+
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "LoopbackBroker socket");
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    socklen_t length = sizeof(address);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, 16) < 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) < 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "LoopbackBroker listen on port " + std::to_string(port));
+    }
+    listen_fd_ = fd;
+    port_ = ntohs(address.sin_port);
+    acceptor_ = std::thread([this] { acceptClients(); });
+    return port_;
+}
+
+std::string LoopbackBroker::tcpAddress() const {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    return port_ ? "tcp://127.0.0.1:" + std::to_string(port_) : std::string();
+}
+
+void LoopbackBroker::acceptClients() {
+    while (true) {
+        const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return; // Shut down
+        }
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        if (stopping_) {
+            ::close(fd);
+            return;
+        }
+        client_fds_.push_back(fd);
+        client_threads_.emplace_back([this, fd] { serveClient(fd); });
+    }
+}
+
+void LoopbackBroker::serveClient(int fd) {
+    std::string in;
+    std::string out;
+    char buffer[16384];
+    bool mqtt5 = false;
+    bool done = false;
+    std::vector<std::string> aliases; // Per connection, index = alias
+
+    try {
+        ssize_t n;
+        while (!done && (n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            const auto arrival = Clock::now();
+            in.append(buffer, static_cast<size_t>(n));
+            out.clear();
+            size_t offset = 0;
+            MqttCodec::Packet packet;
+            while (!done) {
+                const auto used = MqttCodec::parsePacket(std::string_view(in).substr(offset), packet);
+                if (!used) break;
+                offset += *used;
+                switch (packet.type) {
+                    case MqttCodec::CONNECT:
+                        mqtt5 = MqttCodec::parseConnect(packet.body).protocol_level >= 5;
+                        aliases.assign(mqtt5 ? TOPIC_ALIAS_MAX + 1 : 0, std::string());
+                        MqttCodec::appendConnack(out, 0, TOPIC_ALIAS_MAX, mqtt5);
+                        break;
+                    case MqttCodec::PUBLISH: {
+                        const auto publish = MqttCodec::parsePublish(packet, mqtt5);
+                        std::string_view topic = publish.topic;
+                        if (publish.topic_alias) {
+                            if (publish.topic_alias >= aliases.size()) throw std::runtime_error("topic alias out of range");
+                            if (topic.empty()) topic = aliases[publish.topic_alias];
+                            else aliases[publish.topic_alias].assign(topic);
+                            if (topic.empty()) throw std::runtime_error("unknown topic alias");
+                        }
+                        receive(topic, publish.payload, publish.qos, publish.retained, arrival);
+                        if (publish.qos == 1) MqttCodec::appendAck(out, MqttCodec::PUBACK, publish.packet_id);
+                        if (publish.qos == 2) MqttCodec::appendAck(out, MqttCodec::PUBREC, publish.packet_id);
+                        break;
+                    }
+                    case MqttCodec::PUBREL:
+                        MqttCodec::appendAck(out, MqttCodec::PUBCOMP, MqttCodec::parseAck(packet.body).packet_id);
+                        break;
+                    case MqttCodec::PINGREQ:
+                        MqttCodec::appendEmpty(out, MqttCodec::PINGRESP);
+                        break;
+                    case MqttCodec::DISCONNECT:
+                        done = true;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            in.erase(0, offset);
+            if (!out.empty() && !sendAll(fd, out)) break;
+        }
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Loopback broker: dropping client: " << e.what() << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    client_fds_.erase(std::remove(client_fds_.begin(), client_fds_.end(), fd), client_fds_.end());
+    ::close(fd);
+}
+
+} // namespace SensorHub::Components
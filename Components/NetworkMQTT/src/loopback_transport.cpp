@@ -0,0 +1,74 @@
+#include "loopback_transport.h"
+
+namespace SensorHub::Components {
+
+LoopbackTransport::LoopbackTransport(Settings settings, Listener& listener, std::shared_ptr<LoopbackBroker> broker)
+    : settings_(std::move(settings)), listener_(listener), broker_(std::move(broker)) {
+    aliases_.resize(LoopbackBroker::TOPIC_ALIAS_MAX + 1);
+}
+
+LoopbackTransport::~LoopbackTransport() {
+    unsubscribeAll();
+}
+
+bool LoopbackTransport::beginConnect() {
+    unsubscribeAll(); // New session
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connected_ = true;
+        for (auto& topic : aliases_) topic.clear(); // New session
+    }
+    listener_.onConnected(settings_.mqtt5 ? LoopbackBroker::TOPIC_ALIAS_MAX : 0);
+    return true;
+}
+
+bool LoopbackTransport::publish(const Message& message) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connected_) return false;
+        std::string_view topic = message.topic;
+        if (message.topic_alias) {
+            if (message.topic_alias >= aliases_.size()) return false;
+            if (topic.empty()) topic = aliases_[message.topic_alias];
+            else aliases_[message.topic_alias].assign(topic);
+            if (topic.empty()) return false; // Alias never set
+        }
+        broker_->receive(topic, message.payload, message.qos, message.retained);
+    }
+    listener_.onDelivered(message.context, true);
+    return true;
+}
+
+bool LoopbackTransport::subscribe(std::string_view topic_filter, int) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connected_) return false;
+    }
+    // Not under mutex_: retained messages are delivered before subscribe() returns
+    const uint64_t id = broker_->subscribe(std::string(topic_filter),
+                                           [this](std::string_view topic, std::string_view payload, bool retained) {
+                                               listener_.onMessage(topic, payload, retained);
+                                           });
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscriptions_.push_back(id);
+    return true;
+}
+
+void LoopbackTransport::disconnect(std::chrono::milliseconds) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connected_ = false;
+    }
+    unsubscribeAll();
+}
+
+void LoopbackTransport::unsubscribeAll() {
+    std::vector<uint64_t> ids;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ids.swap(subscriptions_);
+    }
+    for (const uint64_t id : ids) broker_->unsubscribe(id);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "NetworkMQTT/loopback_broker.h"
+#include "NetworkMQTT/mqtt_transport.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief IMqttTransport for "loop://<name>" addresses: hands messages straight to the
+ * named LoopbackBroker.
+ *
+ * Connecting succeeds at once and every publish is recorded and reported delivered
+ * before publish() returns, at any QoS. Topic aliases are resolved as a broker would.
+ * Subscriptions are delivered on the publishing thread, retained ones while subscribing.
+ */
+class LoopbackTransport : public IMqttTransport {
+public:
+    LoopbackTransport(Settings settings, Listener& listener, std::shared_ptr<LoopbackBroker> broker);
+    /**
+     * @brief Drops the subscriptions; the broker outlives the transport.
+     */
+    ~LoopbackTransport() override;
+
+    bool beginConnect() override;
+    bool publish(const Message& message) override;
+    bool subscribe(std::string_view topic_filter, int qos) override;
+    void disconnect(std::chrono::milliseconds timeout) override;
+    const char* name() const override { return "loopback"; }
+
+    // Delete copy/move operations (subscriptions refer to this object)
+    LoopbackTransport(const LoopbackTransport&) = delete;
+    LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+    LoopbackTransport(LoopbackTransport&&) = delete;
+    LoopbackTransport& operator=(LoopbackTransport&&) = delete;
+
+private:
+    void unsubscribeAll();
+
+    const Settings settings_;
+    Listener& listener_;
+    const std::shared_ptr<LoopbackBroker> broker_;
+
+    std::mutex mutex_;
+    bool connected_ = false;
+    std::vector<std::string> aliases_; // Index = topic alias
+    std::vector<uint64_t> subscriptions_; // Broker subscription ids of this session
+};
+
+} // namespace SensorHub::Components
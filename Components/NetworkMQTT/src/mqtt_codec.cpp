@@ -0,0 +1,292 @@
+#include "NetworkMQTT/mqtt_codec.h"
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+namespace {
+
+// MQTT 5 property identifiers used here
+constexpr uint8_t PROPERTY_MESSAGE_EXPIRY = 0x02;
+constexpr uint8_t PROPERTY_TOPIC_ALIAS_MAXIMUM = 0x22;
+constexpr uint8_t PROPERTY_TOPIC_ALIAS = 0x23;
+
+void putU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value >> 8);
+    out[1] = static_cast<uint8_t>(value);
+}
+
+void appendU16(std::string& out, uint16_t value) {
+    out += static_cast<char>(value >> 8);
+    out += static_cast<char>(value & 0xFF);
+}
+
+void appendString(std::string& out, std::string_view value) {
+    appendU16(out, static_cast<uint16_t>(value.size()));
+    out += value;
+}
+
+uint8_t byteAt(std::string_view data, size_t pos) {
+    if (pos >= data.size()) throw std::runtime_error("MQTT packet truncated");
+    return static_cast<uint8_t>(data[pos]);
+}
+
+uint16_t u16At(std::string_view data, size_t pos) {
+    return static_cast<uint16_t>((byteAt(data, pos) << 8) | byteAt(data, pos + 1));
+}
+
+uint32_t varintAt(std::string_view data, size_t& pos) {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 28; shift += 7) {
+        const uint8_t byte = byteAt(data, pos++);
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    throw std::runtime_error("MQTT variable byte integer too long");
+}
+
+// Size of an MQTT 5 property value, by identifier (MQTT 5.0 section 2.2.2.2)
+size_t skipProperty(uint8_t id, std::string_view data, size_t pos) {
+    switch (id) {
+        case 0x01: case 0x17: case 0x19: case 0x24: case 0x25: case 0x28: case 0x29: case 0x2A:
+            return pos + 1;
+        case 0x13: case 0x21: case 0x22: case 0x23:
+            return pos + 2;
+        case 0x02: case 0x11: case 0x18: case 0x27:
+            return pos + 4;
+        case 0x0B:
+            varintAt(data, pos);
+            return pos;
+        case 0x03: case 0x08: case 0x09: case 0x12: case 0x15: case 0x16: case 0x1A: case 0x1C: case 0x1F:
+            return pos + 2 + u16At(data, pos);
+        case 0x26: {
+            pos += 2 + u16At(data, pos);
+            return pos + 2 + u16At(data, pos);
+        }
+        default:
+            throw std::runtime_error("Unknown MQTT 5 property " + std::to_string(id));
+    }
+}
+
+} // namespace
+
+size_t MqttCodec::writeRemainingLength(uint32_t length, uint8_t* out) {
+    size_t n = 0;
+    do {
+        uint8_t byte = length & 0x7F;
+        length >>= 7;
+        if (length) byte |= 0x80;
+        out[n++] = byte;
+    } while (length);
+    return n;
+}
+
+void MqttCodec::encodePublish(const IMqttTransport::Message& message, uint16_t packet_id, bool mqtt5,
+                              PublishHeader& out) {
+    if (message.topic.size() > 0xFFFF) throw std::invalid_argument("MQTT topic too long");
+
+    // Tail: packet id, then the property block
+    uint8_t* tail = out.tail.data();
+    size_t tail_size = 0;
+    if (message.qos > 0) {
+        putU16(tail, packet_id);
+        tail_size = 2;
+    }
+    if (mqtt5) {
+        uint8_t props[8];
+        size_t props_size = 0;
+        if (message.expiry.count() > 0) {
+            const auto seconds = static_cast<uint32_t>(message.expiry.count());
+            props[props_size++] = PROPERTY_MESSAGE_EXPIRY;
+            props[props_size++] = static_cast<uint8_t>(seconds >> 24);
+            props[props_size++] = static_cast<uint8_t>(seconds >> 16);
+            props[props_size++] = static_cast<uint8_t>(seconds >> 8);
+            props[props_size++] = static_cast<uint8_t>(seconds);
+        }
+        if (message.topic_alias != 0) {
+            props[props_size++] = PROPERTY_TOPIC_ALIAS;
+            putU16(props + props_size, message.topic_alias);
+            props_size += 2;
+        }
+        tail[tail_size++] = static_cast<uint8_t>(props_size); // Always < 128: one length byte
+        for (size_t i = 0; i < props_size; ++i) tail[tail_size++] = props[i];
+    }
+    out.tail_size = static_cast<uint8_t>(tail_size);
+
+    const uint64_t remaining = 2 + message.topic.size() + tail_size + message.payload.size();
+    if (remaining > MAX_REMAINING_LENGTH) throw std::invalid_argument("MQTT packet too long");
+
+    uint8_t* head = out.head.data();
+    head[0] = static_cast<uint8_t>((PUBLISH << 4) | ((message.qos & 0x03) << 1) | (message.retained ? 1 : 0));
+    size_t head_size = 1 + writeRemainingLength(static_cast<uint32_t>(remaining), head + 1);
+    putU16(head + head_size, static_cast<uint16_t>(message.topic.size()));
+    out.head_size = static_cast<uint8_t>(head_size + 2);
+}
+
+void MqttCodec::appendConnect(std::string& out, std::string_view client_id, uint16_t keep_alive_sec, bool mqtt5) {
+    std::string body;
+    appendString(body, "MQTT");
+    body += static_cast<char>(mqtt5 ? 5 : 4); // Protocol level
+    body += static_cast<char>(0x02);          // Clean session / clean start, no will, no credentials
+    appendU16(body, keep_alive_sec);
+    if (mqtt5) body += '\0';                  // No properties
+    appendString(body, client_id);
+
+    uint8_t length[4];
+    const size_t length_size = writeRemainingLength(static_cast<uint32_t>(body.size()), length);
+    out += static_cast<char>(CONNECT << 4);
+    out.append(reinterpret_cast<const char*>(length), length_size);
+    out += body;
+}
+
+void MqttCodec::appendSubscribe(std::string& out, uint16_t packet_id, std::string_view topic_filter, int qos,
+                                bool mqtt5) {
+    if (topic_filter.empty() || topic_filter.size() > 0xFFFF) throw std::invalid_argument("Invalid MQTT topic filter");
+    std::string body;
+    appendU16(body, packet_id);
+    if (mqtt5) body += '\0'; // No properties
+    appendString(body, topic_filter);
+    body += static_cast<char>(qos & 0x03); // Subscription options: maximum QoS only
+
+    uint8_t length[4];
+    const size_t length_size = writeRemainingLength(static_cast<uint32_t>(body.size()), length);
+    out += static_cast<char>((SUBSCRIBE << 4) | 0x02); // Reserved flags required by the spec
+    out.append(reinterpret_cast<const char*>(length), length_size);
+    out += body;
+}
+
+bool MqttCodec::topicMatches(std::string_view filter, std::string_view topic) {
+    while (true) {
+        const size_t filter_end = filter.find('/');
+        const std::string_view level = filter.substr(0, filter_end);
+        if (level == "#") return true;
+        const size_t topic_end = topic.find('/');
+        if (level != "+" && level != topic.substr(0, topic_end)) return false;
+        if (filter_end == std::string_view::npos || topic_end == std::string_view::npos) {
+            // "a/#" also matches "a"
+            return filter_end == topic_end || (topic_end == std::string_view::npos && filter.substr(filter_end + 1) == "#");
+        }
+        filter.remove_prefix(filter_end + 1);
+        topic.remove_prefix(topic_end + 1);
+    }
+}
+
+void MqttCodec::appendAck(std::string& out, PacketType type, uint16_t packet_id) {
+    out += static_cast<char>((type << 4) | (type == PUBREL ? 0x02 : 0x00));
+    out += static_cast<char>(2);
+    appendU16(out, packet_id);
+}
+
+void MqttCodec::appendEmpty(std::string& out, PacketType type) {
+    out += static_cast<char>(type << 4);
+    out += '\0';
+}
+
+std::optional<size_t> MqttCodec::parsePacket(std::string_view in, Packet& out) {
+    if (in.size() < 2) return std::nullopt;
+    uint32_t length = 0;
+    size_t pos = 1;
+    for (int shift = 0;; shift += 7) {
+        if (shift >= 28) throw std::runtime_error("MQTT remaining length too long");
+        if (pos >= in.size()) return std::nullopt;
+        const auto byte = static_cast<uint8_t>(in[pos++]);
+        length |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+    }
+    if (in.size() - pos < length) return std::nullopt;
+    out.type = static_cast<uint8_t>(in[0]) >> 4;
+    out.flags = static_cast<uint8_t>(in[0]) & 0x0F;
+    out.body = in.substr(pos, length);
+    return pos + length;
+}
+
+MqttCodec::Connack MqttCodec::parseConnack(std::string_view body, bool mqtt5) {
+    Connack connack;
+    connack.session_present = byteAt(body, 0) & 0x01;
+    connack.reason = byteAt(body, 1);
+    if (!mqtt5 || body.size() == 2) return connack;
+
+    size_t pos = 2;
+    const uint32_t props_size = varintAt(body, pos);
+    const size_t end = pos + props_size;
+    if (end > body.size()) throw std::runtime_error("MQTT CONNACK properties truncated");
+    while (pos < end) {
+        const uint8_t id = byteAt(body, pos++);
+        if (id == PROPERTY_TOPIC_ALIAS_MAXIMUM) connack.topic_alias_max = u16At(body, pos);
+        pos = skipProperty(id, body, pos);
+    }
+    if (pos != end) throw std::runtime_error("MQTT CONNACK properties malformed");
+    return connack;
+}
+
+MqttCodec::Connect MqttCodec::parseConnect(std::string_view body) {
+    Connect connect;
+    const uint16_t name_size = u16At(body, 0);
+    if (body.substr(2, name_size) != "MQTT") throw std::runtime_error("Not an MQTT CONNECT");
+    size_t pos = 2 + name_size;
+    connect.protocol_level = byteAt(body, pos);
+    pos += 4; // Level, flags, keep alive
+    if (connect.protocol_level >= 5) {
+        const uint32_t props_size = varintAt(body, pos);
+        pos += props_size;
+    }
+    const uint16_t id_size = u16At(body, pos);
+    if (pos + 2 + id_size > body.size()) throw std::runtime_error("MQTT CONNECT truncated");
+    connect.client_id = body.substr(pos + 2, id_size);
+    return connect;
+}
+
+MqttCodec::Publish MqttCodec::parsePublish(const Packet& packet, bool mqtt5) {
+    Publish publish;
+    const std::string_view body = packet.body;
+    publish.qos = (packet.flags >> 1) & 0x03;
+    publish.retained = packet.flags & 0x01;
+    const uint16_t topic_size = u16At(body, 0);
+    size_t pos = 2 + topic_size;
+    if (pos > body.size()) throw std::runtime_error("MQTT PUBLISH truncated");
+    publish.topic = body.substr(2, topic_size);
+    if (publish.qos > 0) {
+        publish.packet_id = u16At(body, pos);
+        pos += 2;
+    }
+    if (mqtt5) {
+        const uint32_t props_size = varintAt(body, pos);
+        const size_t end = pos + props_size;
+        if (end > body.size()) throw std::runtime_error("MQTT PUBLISH properties truncated");
+        while (pos < end) {
+            const uint8_t id = byteAt(body, pos++);
+            if (id == PROPERTY_TOPIC_ALIAS) publish.topic_alias = u16At(body, pos);
+            if (id == PROPERTY_MESSAGE_EXPIRY) {
+                publish.expiry = (static_cast<uint32_t>(u16At(body, pos)) << 16) | u16At(body, pos + 2);
+            }
+            pos = skipProperty(id, body, pos);
+        }
+    }
+    if (pos > body.size()) throw std::runtime_error("MQTT PUBLISH truncated");
+    publish.payload = body.substr(pos);
+    return publish;
+}
+
+void MqttCodec::appendConnack(std::string& out, uint8_t reason, uint16_t topic_alias_max, bool mqtt5) {
+    out += static_cast<char>(CONNACK << 4);
+    if (!mqtt5) {
+        out += static_cast<char>(2);
+        out += '\0';
+        out += static_cast<char>(reason);
+        return;
+    }
+    out += static_cast<char>(6);
+    out += '\0';
+    out += static_cast<char>(reason);
+    out += static_cast<char>(3);
+    out += static_cast<char>(PROPERTY_TOPIC_ALIAS_MAXIMUM);
+    appendU16(out, topic_alias_max);
+}
+
+MqttCodec::Ack MqttCodec::parseAck(std::string_view body) {
+    Ack ack;
+    ack.packet_id = u16At(body, 0);
+    if (body.size() > 2) ack.reason = byteAt(body, 2); // MQTT 5 only; absent means success
+    return ack;
+}
+
+} // namespace SensorHub::Components
@@ -1,311 +1,417 @@
 #include "NetworkMQTT/mqtt_publisher.h"
+#include "NetworkMQTT/epoll_transport.h"
+#include "NetworkMQTT/mqtt_codec.h"
+#include "loopback_transport.h"
+#ifdef SENSORHUB_WITH_PAHO
+#include "paho_transport.h"
+#endif
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
 #include <chrono>
-#include <thread> // For sleep
+#include <iterator>
 
 namespace SensorHub::Components {
 
+namespace {
+const std::string NO_TOPIC; // Topic name of a PUBLISH that only carries an alias
+} // namespace
+
+std::optional<MqttPublisher::Backend> MqttPublisher::parseBackend(std::string_view name) {
+#ifdef SENSORHUB_WITH_PAHO
+    if (name == "paho") return Backend::Paho;
+#endif
+    if (name == "epoll") return Backend::Epoll;
+    return std::nullopt;
+}
+
 // --- Constructor / Destructor ---
-MqttPublisher::MqttPublisher(std::string broker_address, std::string client_id)
+MqttPublisher::MqttPublisher(std::string broker_address, std::string client_id, Options options)
     : broker_address_(std::move(broker_address)),
-      client_id_(std::move(client_id))
-      // client_ initialization moved to the body to handle potential exceptions
+      client_id_(std::move(client_id)),
+      connect_timeout_(options.connect_timeout),
+      mqtt5_(options.mqtt5),
+      aliases_(options.mqtt5 ? options.topic_aliases : 0),
+      window_(options.inflight),
+      backoff_(options.backoff)
+      // transport_ is created in the body, once the options are validated
 {
+    if (connect_timeout_.count() <= 0) {
+        throw std::invalid_argument("MQTT connect timeout must be positive");
+    }
+    if (options.metrics) registerMetrics(*options.metrics);
+    IMqttTransport::Settings settings;
+    settings.address = broker_address_;
+    settings.client_id = client_id_;
+    settings.mqtt5 = mqtt5_;
+    settings.connect_timeout = connect_timeout_;
+    IMqttTransport::Listener& listener = *this; // Private base: convert here, not inside make_unique
     try {
-        // Create the asynchronous client object.
-        client_ = std::make_unique<mqtt::async_client>(broker_address_, client_id_);
-
-        // Set the callbacks for connection, message arrival, etc.
-        // 'this' object implements the necessary virtual functions from mqtt::callback.
-        client_->set_callback(*this);
-
-        // Configure standard connection options.
-        conn_opts_.set_keep_alive_interval(20); // Send ping request every 20 seconds.
-        conn_opts_.set_clean_session(true);    // Start fresh, don't resume previous session.
-        conn_opts_.set_automatic_reconnect(false); // Disable Paho's auto-reconnect; we handle it manually.
-        // TODO: Add options for LWT (Last Will and Testament), SSL/TLS if needed.
-
-        std::cout << "MQTT Publisher initialized for broker: " << broker_address_
-                  << ", Client ID: " << client_id_ << std::endl;
-
-    } catch (const mqtt::exception& exc) {
+        if (auto broker = LoopbackBroker::forAddress(broker_address_)) {
+            transport_ = std::make_unique<LoopbackTransport>(std::move(settings), listener, std::move(broker));
+        } else {
+            switch (options.backend) {
+                case Backend::Paho:
+#ifdef SENSORHUB_WITH_PAHO
+                    transport_ = std::make_unique<PahoTransport>(std::move(settings), listener);
+                    break;
+#else
+                    throw std::invalid_argument("MQTT backend 'paho' is not built in (SENSORHUB_WITH_PAHO=OFF)");
+#endif
+                case Backend::Epoll:
+                    transport_ = std::make_unique<EpollTransport>(std::move(settings), listener);
+                    break;
+            }
+        }
+    } catch (const std::exception& exc) {
         std::cerr << "MQTT Error initializing client: " << exc.what() << std::endl;
-        client_.reset(); // Ensure client is null if initialization failed.
         throw; // Re-throw to signal construction failure.
     }
+    std::cout << "MQTT Publisher initialized for broker: " << broker_address_
+              << ", Client ID: " << client_id_ << (mqtt5_ ? " (MQTT 5)" : "")
+              << ", client: " << transport_->name() << std::endl;
 }
 
+MqttPublisher::MqttPublisher(std::string broker_address, std::string client_id)
+    : MqttPublisher(std::move(broker_address), std::move(client_id), Options{}) {}
+
 MqttPublisher::~MqttPublisher() {
-    disconnect(); // Attempt graceful disconnect in destructor.
-    // unique_ptr will handle deletion of the client_ object.
+    disconnect(); // Stops the supervisor, then attempts a graceful disconnect.
+    // transport_ is destroyed first (declared last), before anything its callbacks touch.
     std::cout << "MQTT Publisher destroyed." << std::endl;
 }
 
- // --- Move Semantics ---
-MqttPublisher::MqttPublisher(MqttPublisher&& other) noexcept
-    : broker_address_(std::move(other.broker_address_)),
-      client_id_(std::move(other.client_id_)),
-      client_(std::move(other.client_)), // Move the unique_ptr
-      conn_opts_(std::move(other.conn_opts_)),
-      connected_(other.connected_.load()), // Copy atomic bool state
-      reconnect_attempts_(other.reconnect_attempts_)
-      // Note: Mutexes and condition variables cannot be moved.
-{
-    // If the client was successfully moved, re-set its callback to 'this' new object.
-    if (client_) {
-        client_->set_callback(*this);
-    }
-    // Reset other's state where appropriate.
-    other.connected_.store(false);
-}
+// --- Public Methods ---
 
-MqttPublisher& MqttPublisher::operator=(MqttPublisher&& other) noexcept {
-     if (this != &other) {
-        // Disconnect own client first if connected.
-        disconnect();
-
-        // Lock potentially needed if other state needs synchronized access during move.
-        // std::lock_guard<std::mutex> lock(connection_mutex_); // Example if needed
-
-        // Move resources from other.
-        broker_address_ = std::move(other.broker_address_);
-        client_id_ = std::move(other.client_id_);
-        client_ = std::move(other.client_); // Move unique_ptr.
-        conn_opts_ = std::move(other.conn_opts_);
-        connected_.store(other.connected_.load()); // Copy atomic bool state.
-        reconnect_attempts_ = other.reconnect_attempts_;
-
-        // Re-set the callback for the moved client to 'this' new object.
-        if (client_) {
-            client_->set_callback(*this);
-        }
-         // Reset other's state.
-        other.connected_.store(false);
-     }
-     return *this;
+void MqttPublisher::start() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (supervisor_.joinable()) return; // Already running
+    stop_requested_ = false;
+    state_ = State::WaitingRetry;
+    deadline_ = std::chrono::steady_clock::now(); // First attempt right away
+    supervisor_ = std::thread(&MqttPublisher::superviseConnection, this);
 }
 
-// --- Public Methods ---
-
 bool MqttPublisher::connect(long timeout_ms) {
-    if (!client_) {
-         std::cerr << "MQTT Error: Client not initialized. Cannot connect." << std::endl;
-         return false;
-    }
-    // Avoid reconnecting if already connected or connection attempt is pending.
-    if (isConnected()) {
-        // std::cout << "MQTT Info: Already connected." << std::endl;
-        return true;
-    }
-     // Check if another connect attempt is already waiting for callback
-     // Note: This simple check might have race conditions without external locking if connect() is called concurrently.
-    if(connection_attempt_in_progress_) {
-        std::cout << "MQTT Info: Connection attempt already in progress." << std::endl;
-        return false; // Indicate we didn't start a *new* attempt now
-    }
-
-
-    std::cout << "MQTT: Attempting to connect to broker " << broker_address_ << "..." << std::endl;
-
-    try {
-         // Use a mutex and condition variable to wait for the asynchronous connect operation
-         // to complete (signaled by on_success/on_failure or connected/connection_lost callbacks).
-         std::unique_lock<std::mutex> lock(connection_mutex_);
-         connection_attempt_in_progress_ = true;
-         connection_succeeded_ = false; // Reset result flag before attempt
-
-         // Initiate the asynchronous connection.
-         // 'this' is passed as the action listener to receive on_success/on_failure.
-         mqtt::token_ptr conntok = client_->connect(conn_opts_, nullptr, *this);
-
-         // Wait for the condition variable to be notified by a callback, or until timeout.
-         if (connection_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
-                                    [this]{ return !connection_attempt_in_progress_; }))
-         {
-             // Condition met: Callback fired (either success or failure determined completion).
-             // Return the outcome that was set by the callback.
-             return connection_succeeded_;
-         } else {
-             // Condition not met: Timed out waiting for a callback.
-             std::cerr << "MQTT Error: Connection attempt timed out after " << timeout_ms << " ms." << std::endl;
-             // Reset the flag since the wait is over, even if callback never arrived.
-             connection_attempt_in_progress_ = false;
-             return false;
-         }
-
-    } catch (const mqtt::exception& exc) {
-        // Exception occurred during the *initiation* of the connect call.
-        std::cerr << "MQTT Error during connect initiation: " << exc.what() << std::endl;
-         // Ensure flag is reset if exception occurs before wait_for.
-         std::unique_lock<std::mutex> lock(connection_mutex_); // Lock before modifying flag
-         connection_attempt_in_progress_ = false;
-        return false;
-    }
+    start();
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    state_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                       [this] { return state_ == State::Connected || stop_requested_; });
+    return state_ == State::Connected;
 }
 
 void MqttPublisher::disconnect(long timeout_ms) {
-    // Only attempt disconnect if the client exists and is connected.
-    if (client_ && client_->is_connected()) {
-        std::cout << "MQTT: Disconnecting..." << std::endl;
-        try {
-            // Use disconnect options to specify a timeout for the operation.
-            mqtt::disconnect_options disc_opts;
-            disc_opts.set_timeout(std::chrono::milliseconds(timeout_ms));
-            // Call disconnect and wait for the operation token to complete (or timeout).
-            client_->disconnect(disc_opts)->wait();
-            connected_.store(false); // Update status only after confirmed disconnect.
-            std::cout << "MQTT: Disconnected." << std::endl;
-        } catch (const mqtt::exception& exc) {
-            std::cerr << "MQTT Error during disconnect: " << exc.what() << std::endl;
-            // Assume we are disconnected at the client level even if there was an error.
-            connected_.store(false);
-        }
-    } else {
-         // Log quietly or skip if already disconnected or not initialized.
-         // std::cout << "MQTT Info: Not connected or client not initialized; skipping disconnect." << std::endl;
+    // Stop reconnecting first, so the supervisor cannot bring the connection back up.
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stop_requested_ = true;
+    }
+    state_cv_.notify_all();
+    if (supervisor_.joinable()) {
+        supervisor_.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        state_ = State::Idle;
     }
+
+    // Also cancels an attempt still in progress; the transport waits for queued data up to the timeout.
+    const bool was_connected = connected_.exchange(false);
+    if (was_connected) std::cout << "MQTT: Disconnecting..." << std::endl;
+    transport_->disconnect(std::chrono::milliseconds(timeout_ms));
+    if (was_connected) std::cout << "MQTT: Disconnected." << std::endl;
+    // Not acknowledged within the timeout: the next session will not resume them
+    handBack(takeUnacked());
 }
 
 
-bool MqttPublisher::publish(const std::string& topic, const std::string& payload, int qos, bool retained) {
+MqttPublisher::PublishResult MqttPublisher::tryPublish(const std::string& topic, const std::string& payload,
+                                                      int qos, bool retained, std::chrono::seconds expiry) {
      // Check connection status before attempting to publish.
      if (!isConnected()) {
          std::cerr << "MQTT Error: Cannot publish, not connected." << std::endl;
-         return false;
+         return counted(PublishResult::NotConnected);
+     }
+     // MQTT 5: a topic the broker already knows by alias goes out as an empty name
+     const TopicAliasTable::Use alias = mqtt5_ ? aliases_.use(topic) : TopicAliasTable::Use{};
+     const std::string& wire_topic = alias.send_topic ? topic : NO_TOPIC;
+     // Backpressure: don't let the transport queue more than the window while the broker is slow to ack
+     const auto slot = window_.acquire(wire_topic.size() + payload.size());
+     if (!slot) {
+         if (alias.alias != 0 && alias.send_topic) aliases_.unuse(topic);
+         return counted(PublishResult::WindowFull);
+     }
+     IMqttTransport::Message message;
+     message.topic = wire_topic;
+     message.payload = payload;
+     message.qos = qos;
+     message.retained = retained;
+     message.topic_alias = alias.alias;
+     message.expiry = mqtt5_ ? expiry : std::chrono::seconds::zero();
+     message.context = *slot; // onDelivered() frees the slot with it
+     // Kept before publishing: the acknowledgement can arrive before publish() returns
+     const bool keep = qos > 0 && unacked_handler_;
+     if (keep) {
+         UnackedMessage copy{topic, payload, qos, retained};
+         std::lock_guard<std::mutex> lock(unacked_mutex_);
+         unacked_.emplace(*slot, std::move(copy));
      }
-     try {
-          // Create a Paho message object.
-          // Using make_message handles memory management.
-         mqtt::message_ptr pubmsg = mqtt::make_message(topic, payload);
-         pubmsg->set_qos(qos);
-         pubmsg->set_retained(retained);
-
-         // Publish the message asynchronously.
-         // For QoS 1 & 2, the delivery_complete callback will be invoked later.
-         client_->publish(pubmsg);
-
-         // Optional: Verbose logging for publish attempts.
-         // std::cout << "MQTT: Published msg (QoS " << qos << ") to topic '" << topic << "'" << std::endl;
-         return true; // Indicate the publish request was sent to the library.
-     } catch (const mqtt::exception& exc) {
-         // Exception occurred during the publish call itself.
-         std::cerr << "MQTT Error publishing to topic '" << topic << "': " << exc.what() << std::endl;
-         return false;
+     if (!transport_->publish(message)) {
+         if (alias.alias != 0 && alias.send_topic) aliases_.unuse(topic);
+         if (keep) {
+             std::lock_guard<std::mutex> lock(unacked_mutex_);
+             unacked_.erase(*slot); // The caller still has the message
+         }
+         window_.complete(*slot, false);
+         return counted(PublishResult::Failed);
      }
+     return counted(PublishResult::Accepted); // Indicate the publish request was handed to the transport.
 }
 
-bool MqttPublisher::isConnected() const {
-    // Return the thread-safe atomic flag, updated by callbacks.
-    return connected_.load();
+void MqttPublisher::setUnackedHandler(UnackedHandler handler) {
+    unacked_handler_ = std::move(handler);
 }
 
-// --- Private Callback Implementations ---
+bool MqttPublisher::addTopicAlias(const std::string& topic) {
+    return mqtt5_ && aliases_.add(topic);
+}
 
-// Action listener callback: Invoked if the connect *action* itself fails
-// (e.g., network unreachable before even trying to connect to broker).
-void MqttPublisher::on_failure(const mqtt::token& tok) {
-    std::cerr << "MQTT Error: Connection attempt failed (token: "
-              << (tok ? tok.get_message_id() : -1) << ")" << std::endl;
+void MqttPublisher::subscribe(std::string topic_filter, int qos, MessageHandler handler) {
+    auto subscription = std::make_shared<const Subscription>(Subscription{std::move(topic_filter), qos, std::move(handler)});
     {
-         // Lock mutex before modifying shared state used by connect() wait.
-         std::lock_guard<std::mutex> lock(connection_mutex_);
-         connection_succeeded_ = false;          // Mark outcome as failure.
-         connection_attempt_in_progress_ = false; // Mark attempt as finished.
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        subscriptions_.push_back(subscription);
     }
-    connection_cv_.notify_all(); // Notify the waiting connect() method.
-    connected_.store(false);     // Ensure connection status is false.
+    // Otherwise onConnected() subscribes; doing both at once only repeats the SUBSCRIBE
+    if (isConnected() && !transport_->subscribe(subscription->topic_filter, subscription->qos)) {
+        std::cerr << "MQTT Error: Subscribing to '" << subscription->topic_filter << "' failed; retrying on reconnect."
+                  << std::endl;
+    }
+}
 
-    // Initiate reconnection logic after a failure.
-    reconnect_attempts_++;
-    attempt_reconnect();
+bool MqttPublisher::isConnected() const {
+    // Return the thread-safe atomic flag, updated by callbacks.
+    return connected_.load();
 }
 
-// Action listener callback: Invoked if the connect *action* was successfully
-// queued or sent by the Paho library. This *doesn't* mean connection to the
-// broker is complete yet (that's handled by the 'connected' callback).
-void MqttPublisher::on_success([[maybe_unused]] const mqtt::token& tok) {
-    // This callback isn't strictly necessary for determining connection status,
-    // as the 'connected' callback is the definitive one. We primarily use it
-    // to signal the waiting connect() method.
-    // std::cout << "MQTT Info: Connection request sent successfully (token: "
-    //           << (tok ? tok.get_message_id() : -1) << "). Waiting for broker acknowledgment." << std::endl;
-     {
-         // Lock mutex before modifying shared state.
-         std::lock_guard<std::mutex> lock(connection_mutex_);
-         // Mark potential success. The 'connected' callback will confirm.
-         // We keep connection_attempt_in_progress_ = true until 'connected' or 'connection_lost'.
-         connection_succeeded_ = true;
-     }
-     // Do NOT notify connection_cv_ here; wait for 'connected' callback.
+MqttPublisher::State MqttPublisher::state() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return state_;
 }
 
-// General callback: Invoked when the client successfully establishes a connection
-// with the MQTT broker (broker sent CONNACK).
-void MqttPublisher::connected(const std::string& cause) {
-    std::cout << "MQTT: Connection successful!"
-              << (cause.empty() ? "" : " Cause: " + cause) << std::endl;
+uint32_t MqttPublisher::consecutiveFailures() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return backoff_.failures();
+}
+
+// --- Private Callback Implementations ---
+// Transport callbacks (its own thread, or inside a transport call): they only record the
+// outcome and wake the supervisor.
+
+// The connect attempt failed (e.g., broker unreachable or connection refused).
+void MqttPublisher::onConnectFailed(const std::string& reason) {
+    std::cerr << "MQTT Error: Connection attempt failed: " << reason << std::endl;
+    connected_.store(false);
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (state_ == State::Connecting && !stop_requested_) {
+        scheduleRetry("connection attempt failed");
+    }
+}
+
+// The broker accepted the session (CONNACK).
+void MqttPublisher::onConnected(uint16_t topic_alias_max) {
+    std::cout << "MQTT: Connection successful!" << std::endl;
+    // Aliases belong to a network connection; the broker tells us how many it takes
+    aliases_.reset(topic_alias_max);
     connected_.store(true);      // Set connected status to true.
-    reconnect_attempts_ = 0;     // Reset reconnect counter on successful connection.
+    if (instruments_.reconnects && ever_connected_) instruments_.reconnects->inc();
+    ever_connected_ = true;
+
+    // Clean session: the broker has forgotten our subscriptions. Renewed before connect()
+    // returns, so a caller that connects and then publishes sees its own subscriptions.
+    std::vector<std::shared_ptr<const Subscription>> subscriptions;
     {
-        // Lock mutex before modifying shared state used by connect() wait.
-        std::lock_guard<std::mutex> lock(connection_mutex_);
-        connection_succeeded_ = true;          // Confirm success.
-        connection_attempt_in_progress_ = false; // Mark attempt as finished.
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        subscriptions = subscriptions_;
     }
-    connection_cv_.notify_all(); // Notify the waiting connect() method.
+    for (const auto& subscription : subscriptions) {
+        if (!transport_->subscribe(subscription->topic_filter, subscription->qos)) {
+            std::cerr << "MQTT Error: Subscribing to '" << subscription->topic_filter << "' failed." << std::endl;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        state_ = State::Connected;
+        backoff_.reset();        // Next outage starts again at the initial delay.
+    }
+    state_cv_.notify_all();      // Wake connect() waiters.
 }
 
-// General callback: Invoked when the connection to the broker is lost unexpectedly.
-void MqttPublisher::connection_lost(const std::string& cause) {
+// The connection to the broker was lost unexpectedly.
+void MqttPublisher::onConnectionLost(const std::string& cause) {
     std::cerr << "MQTT Error: Connection lost."
               << (cause.empty() ? "" : " Cause: " + cause) << std::endl;
     connected_.store(false);     // Set connected status to false.
-     {
-         // Lock mutex before modifying shared state.
-         std::lock_guard<std::mutex> lock(connection_mutex_);
-         connection_attempt_in_progress_ = false; // Mark attempt as finished (if one was pending).
-         connection_succeeded_ = false;          // Ensure outcome is marked as failure.
-     }
-     connection_cv_.notify_all(); // Notify connect() if it was waiting.
+    if (instruments_.connections_lost) instruments_.connections_lost->inc();
+    aliases_.reset(0);           // Until the next CONNACK says otherwise
+    // Clean session: nothing sent before the loss will be acknowledged any more
+    const size_t abandoned = window_.abandon();
+    auto unacked = takeUnacked();
+    if (abandoned > unacked.size()) {
+        std::cerr << "MQTT: " << abandoned - unacked.size() << " unacknowledged messages lost with the connection."
+                  << std::endl;
+    }
+    handBack(std::move(unacked));
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (state_ != State::Idle && !stop_requested_) {
+        scheduleRetry("connection lost");
+    }
+}
+
+// A delivery finished: frees the message's in-flight slot and records its ack latency.
+void MqttPublisher::onDelivered(uint64_t context, bool delivered) {
+    const auto latency = window_.complete(context, delivered);
+    if (unacked_handler_) {
+        std::vector<UnackedMessage> failed;
+        {
+            std::lock_guard<std::mutex> lock(unacked_mutex_);
+            auto node = unacked_.extract(context);
+            if (!node.empty() && !delivered) failed.push_back(std::move(node.mapped()));
+        }
+        handBack(std::move(failed));
+    }
+    if (!instruments_.ack_seconds) return;
+    (delivered ? instruments_.acked : instruments_.delivery_failed)->inc();
+    if (latency && delivered) instruments_.ack_seconds->observe(*latency);
+}
 
-    // Initiate reconnection logic.
-    reconnect_attempts_++;
-    attempt_reconnect();
+std::vector<MqttPublisher::UnackedMessage> MqttPublisher::takeUnacked() {
+    std::vector<UnackedMessage> messages;
+    std::lock_guard<std::mutex> lock(unacked_mutex_);
+    messages.reserve(unacked_.size());
+    // Slot ids grow with every publish: oldest first
+    std::vector<uint64_t> slots;
+    slots.reserve(unacked_.size());
+    for (const auto& entry : unacked_) slots.push_back(entry.first);
+    std::sort(slots.begin(), slots.end());
+    for (const uint64_t slot : slots) messages.push_back(std::move(unacked_.at(slot)));
+    unacked_.clear();
+    return messages;
 }
 
-// General callback: Invoked when a message arrives on a subscribed topic.
-// This example is primarily a publisher, so this is usually empty or logs unexpected messages.
-void MqttPublisher::message_arrived([[maybe_unused]] mqtt::const_message_ptr msg) {
-    // Log if unexpected messages arrive.
-    // std::cout << "MQTT Info: Unexpected message arrived on topic '" << msg->get_topic()
-    //           << "': " << msg->to_string() << std::endl;
+void MqttPublisher::handBack(std::vector<UnackedMessage> messages) {
+    if (messages.empty() || !unacked_handler_) return;
+    std::cerr << "MQTT: Handing back " << messages.size() << " unacknowledged messages." << std::endl;
+    unacked_handler_(std::move(messages));
 }
 
-// General callback: Invoked when the delivery of a QoS 1 or QoS 2 message is confirmed.
-void MqttPublisher::delivery_complete([[maybe_unused]] mqtt::delivery_token_ptr tok) {
-    // Optional: Log delivery confirmation for reliable messaging.
-    // if (tok) {
-    //     std::cout << "MQTT Info: Delivery complete for message token: "
-    //               << tok->get_message_id() << std::endl;
-    // }
+// A message arrived on a subscription: hands it to every matching handler.
+void MqttPublisher::onMessage(std::string_view topic, std::string_view payload, bool retained) {
+    std::vector<std::shared_ptr<const Subscription>> matching;
+    {
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        for (const auto& subscription : subscriptions_) {
+            if (MqttCodec::topicMatches(subscription->topic_filter, topic)) matching.push_back(subscription);
+        }
+    }
+    for (const auto& subscription : matching) subscription->handler(topic, payload, retained);
 }
 
-// --- Private Reconnection Logic ---
- void MqttPublisher::attempt_reconnect() {
-     // Check if maximum attempts have been reached.
-     if (reconnect_attempts_ <= MAX_RECONNECT_ATTEMPTS) {
-         std::cerr << "MQTT: Attempting reconnect (" << reconnect_attempts_ << "/" << MAX_RECONNECT_ATTEMPTS
-                   << ") in " << RECONNECT_DELAY.count() << " seconds..." << std::endl;
-         // Wait for the specified delay before trying again.
-         std::this_thread::sleep_for(RECONNECT_DELAY);
-         // Call connect() again to retry.
-         connect();
-     } else {
-         std::cerr << "MQTT Error: Maximum reconnect attempts (" << MAX_RECONNECT_ATTEMPTS
-                   << ") reached. Stopping reconnection attempts." << std::endl;
-         // Application might need to handle this persistent failure state.
-     }
- }
+// --- Reconnect State Machine ---
+// WaitingRetry --(deadline)--> Connecting --(connected)--> Connected --(lost)--> WaitingRetry
+//                              Connecting --(failure / timeout)--> WaitingRetry
+
+void MqttPublisher::superviseConnection() {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    while (!stop_requested_) {
+        const auto now = std::chrono::steady_clock::now();
+        switch (state_) {
+            case State::WaitingRetry:
+                if (now >= deadline_) {
+                    beginAttempt(lock);
+                    continue;
+                }
+                state_cv_.wait_until(lock, deadline_);
+                break;
+            case State::Connecting:
+                if (now >= deadline_) {
+                    std::cerr << "MQTT Error: Connection attempt timed out after "
+                              << connect_timeout_.count() << " ms." << std::endl;
+                    scheduleRetry("connect timeout");
+                    continue;
+                }
+                state_cv_.wait_until(lock, deadline_);
+                break;
+            case State::Connected:
+            case State::Idle:
+                state_cv_.wait(lock);
+                break;
+        }
+    }
+}
+
+void MqttPublisher::beginAttempt(std::unique_lock<std::mutex>& lock) {
+    state_ = State::Connecting;
+    deadline_ = std::chrono::steady_clock::now() + connect_timeout_;
+    if (instruments_.connection_attempts) instruments_.connection_attempts->inc();
+    std::cout << "MQTT: Attempting to connect to broker " << broker_address_ << "..." << std::endl;
+
+    // The transport may report the outcome before beginConnect() returns; its callbacks take the lock
+    lock.unlock();
+    const bool initiated = transport_->beginConnect();
+    lock.lock();
+
+    if (!initiated && state_ == State::Connecting && !stop_requested_) {
+        scheduleRetry("connect could not be started");
+    }
+}
+
+void MqttPublisher::scheduleRetry(const char* reason) {
+    const auto delay = backoff_.next();
+    state_ = State::WaitingRetry;
+    deadline_ = std::chrono::steady_clock::now() + delay;
+    std::cerr << "MQTT: " << reason << "; reconnect attempt " << backoff_.failures()
+              << " in " << delay.count() << " ms." << std::endl;
+    state_cv_.notify_all();
+}
+
+// --- Metrics ---
+
+void MqttPublisher::registerMetrics(MetricsRegistry& metrics) {
+    const char* publish_help = "Publish requests, by outcome (accepted = handed to the transport).";
+    const char* results[] = {"accepted", "not_connected", "window_full", "failed"}; // PublishResult order
+    for (size_t i = 0; i < std::size(results); ++i) {
+        instruments_.publish_results[i] = &metrics.counter("sensorhub_mqtt_publish_total", publish_help,
+                                                           {{"result", results[i]}});
+    }
+    const char* delivery_help = "Completed deliveries of accepted messages, by outcome.";
+    instruments_.acked = &metrics.counter("sensorhub_mqtt_deliveries_total", delivery_help, {{"result", "acked"}});
+    instruments_.delivery_failed = &metrics.counter("sensorhub_mqtt_deliveries_total", delivery_help,
+                                                    {{"result", "failed"}});
+    // 1 ms .. ~4 s
+    instruments_.ack_seconds = &metrics.histogram("sensorhub_mqtt_ack_seconds",
+                                                  "Time from publish to the broker's acknowledgement.",
+                                                  Histogram::exponentialBounds(0.001, 2, 13));
+    instruments_.connection_attempts = &metrics.counter("sensorhub_mqtt_connection_attempts_total",
+                                                        "Connection attempts to the broker.");
+    instruments_.connections_lost = &metrics.counter("sensorhub_mqtt_connections_lost_total",
+                                                     "Established connections lost unexpectedly.");
+    instruments_.reconnects = &metrics.counter("sensorhub_mqtt_reconnects_total",
+                                               "Connections established after the first one.");
+
+    using Type = MetricsRegistry::Type;
+    metrics.callback("sensorhub_mqtt_connected", "1 while connected to the broker.", Type::Gauge, {},
+                     [this] { return connected_.load() ? 1.0 : 0.0; });
+    metrics.callback("sensorhub_mqtt_inflight_messages", "Messages handed to the transport and not yet acknowledged.",
+                     Type::Gauge, {}, [this] { return static_cast<double>(window_.stats().messages); });
+    metrics.callback("sensorhub_mqtt_inflight_bytes", "Topic and payload bytes of the in-flight messages.",
+                     Type::Gauge, {}, [this] { return static_cast<double>(window_.stats().bytes); });
+}
+
+MqttPublisher::PublishResult MqttPublisher::counted(PublishResult result) {
+    if (Counter* counter = instruments_.publish_results[static_cast<size_t>(result)]) counter->inc();
+    return result;
+}
 
-} // namespace SensorHub::Components
\ No newline at end of file
+} // namespace SensorHub::Components
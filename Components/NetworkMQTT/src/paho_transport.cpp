@@ -0,0 +1,152 @@
+#include "paho_transport.h"
+#include <iostream>
+#include <string>
+
+namespace SensorHub::Components {
+
+PahoTransport::PahoTransport(Settings settings, Listener& listener)
+    : settings_(std::move(settings)), listener_(listener) {
+    // Create the asynchronous client object.
+    if (settings_.mqtt5) {
+        client_ = std::make_unique<mqtt::async_client>(settings_.address, settings_.client_id,
+                                                       mqtt::create_options(MQTTVERSION_5));
+        conn_opts_ = mqtt::connect_options::v5();
+    } else {
+        client_ = std::make_unique<mqtt::async_client>(settings_.address, settings_.client_id);
+    }
+
+    // Set the callbacks for connection, message arrival, etc.
+    // 'this' object implements the necessary virtual functions from mqtt::callback.
+    client_->set_callback(*this);
+
+    // Configure standard connection options.
+    conn_opts_.set_keep_alive_interval(static_cast<int>(settings_.keep_alive.count()));
+    // Start fresh, don't resume previous session.
+    if (settings_.mqtt5) {
+        conn_opts_.set_clean_start(true);
+    } else {
+        conn_opts_.set_clean_session(true);
+    }
+    conn_opts_.set_automatic_reconnect(false); // Disable Paho's auto-reconnect; MqttPublisher handles it.
+    conn_opts_.set_connect_timeout(std::chrono::ceil<std::chrono::seconds>(settings_.connect_timeout));
+    // TODO: Add options for LWT (Last Will and Testament), SSL/TLS if needed.
+}
+
+PahoTransport::~PahoTransport() = default;
+
+bool PahoTransport::beginConnect() {
+    try {
+        // 'this' is passed as the action listener to receive on_success/on_failure.
+        client_->connect(conn_opts_, nullptr, *this);
+        return true;
+    } catch (const mqtt::exception& exc) {
+        std::cerr << "MQTT Error during connect initiation: " << exc.what() << std::endl;
+        return false;
+    }
+}
+
+bool PahoTransport::publish(const Message& message) {
+    try {
+        // Create a Paho message object.
+        // Using make_message handles memory management.
+        mqtt::message_ptr pubmsg = mqtt::make_message(std::string(message.topic), message.payload.data(),
+                                                      message.payload.size());
+        pubmsg->set_qos(message.qos);
+        pubmsg->set_retained(message.retained);
+        if (settings_.mqtt5 && (message.topic_alias != 0 || message.expiry.count() > 0)) {
+            mqtt::properties props;
+            if (message.topic_alias != 0) props.add(mqtt::property(mqtt::property::TOPIC_ALIAS, message.topic_alias));
+            if (message.expiry.count() > 0) {
+                props.add(mqtt::property(mqtt::property::MESSAGE_EXPIRY_INTERVAL, static_cast<int>(message.expiry.count())));
+            }
+            pubmsg->set_properties(props);
+        }
+
+        // Publish the message asynchronously. The delivery listener reports completion:
+        // written out (QoS 0), PUBACK (QoS 1) or PUBCOMP (QoS 2).
+        client_->publish(pubmsg, reinterpret_cast<void*>(static_cast<uintptr_t>(message.context)), delivery_listener_);
+        return true;
+    } catch (const mqtt::exception& exc) {
+        // Exception occurred during the publish call itself.
+        std::cerr << "MQTT Error publishing to topic '" << message.topic << "': " << exc.what() << std::endl;
+        return false;
+    }
+}
+
+bool PahoTransport::subscribe(std::string_view topic_filter, int qos) {
+    if (!client_->is_connected()) return false;
+    try {
+        // Not waited for: this may run inside a Paho callback. A refusal only means nothing arrives.
+        client_->subscribe(std::string(topic_filter), qos);
+        return true;
+    } catch (const mqtt::exception& exc) {
+        std::cerr << "MQTT Error subscribing to '" << topic_filter << "': " << exc.what() << std::endl;
+        return false;
+    }
+}
+
+void PahoTransport::disconnect(std::chrono::milliseconds timeout) {
+    if (!client_->is_connected()) return;
+    try {
+        // Use disconnect options to specify a timeout for the operation.
+        mqtt::disconnect_options disc_opts;
+        disc_opts.set_timeout(timeout);
+        // Call disconnect and wait for the operation token to complete (or timeout).
+        client_->disconnect(disc_opts)->wait();
+    } catch (const mqtt::exception& exc) {
+        std::cerr << "MQTT Error during disconnect: " << exc.what() << std::endl;
+    }
+}
+
+// --- Private Callback Implementations ---
+// Callbacks run on Paho's threads and are forwarded as they are.
+
+// Action listener callback: Invoked if the connect *action* fails
+// (e.g., broker unreachable or connection refused).
+void PahoTransport::on_failure(const mqtt::token& tok) {
+    listener_.onConnectFailed("connection attempt failed (token " + std::to_string(tok ? tok.get_message_id() : -1) + ")");
+}
+
+// Action listener callback: Invoked when the connect action completed (broker sent CONNACK).
+void PahoTransport::on_success(const mqtt::token& tok) {
+    uint16_t alias_max = 0;
+    if (settings_.mqtt5) {
+        // Aliases belong to a network connection; the broker tells us how many it takes
+        const auto response = tok.get_connect_response();
+        const auto& props = response.get_properties();
+        if (props.contains(mqtt::property::TOPIC_ALIAS_MAXIMUM)) {
+            alias_max = mqtt::get<uint16_t>(props, mqtt::property::TOPIC_ALIAS_MAXIMUM);
+        }
+    }
+    listener_.onConnected(alias_max);
+}
+
+// General callback: also invoked on CONNACK. on_success has reported it already (with the CONNACK properties).
+void PahoTransport::connected([[maybe_unused]] const std::string& cause) {
+}
+
+// General callback: Invoked when the connection to the broker is lost unexpectedly.
+void PahoTransport::connection_lost(const std::string& cause) {
+    listener_.onConnectionLost(cause);
+}
+
+// General callback: Invoked when a message arrives on a subscribed topic.
+void PahoTransport::message_arrived(mqtt::const_message_ptr msg) {
+    if (!msg) return;
+    listener_.onMessage(msg->get_topic(), msg->get_payload_str(), msg->is_retained());
+}
+
+// General callback: Invoked when the delivery of a QoS 1 or QoS 2 message is confirmed.
+// The per-message delivery listener handles it.
+void PahoTransport::delivery_complete([[maybe_unused]] mqtt::delivery_token_ptr tok) {
+}
+
+void PahoTransport::DeliveryListener::on_success(const mqtt::token& tok) {
+    listener_.onDelivered(reinterpret_cast<uintptr_t>(tok.get_user_context()), true);
+}
+
+void PahoTransport::DeliveryListener::on_failure(const mqtt::token& tok) {
+    listener_.onDelivered(reinterpret_cast<uintptr_t>(tok.get_user_context()), false);
+}
+
+} // namespace SensorHub::Components
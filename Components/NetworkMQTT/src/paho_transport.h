@@ -0,0 +1,66 @@
+#pragma once
+
+#include "NetworkMQTT/mqtt_transport.h"
+#include "mqtt/async_client.h" // Paho C++ header
+#include <memory>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief IMqttTransport on the Paho asynchronous client.
+ *
+ * Paho runs its own threads; its callbacks are forwarded to the Listener. The delivery
+ * token of each publish carries Message::context as its user context.
+ */
+class PahoTransport : public IMqttTransport,
+                      public virtual mqtt::callback,
+                      public virtual mqtt::iaction_listener {
+public:
+    /**
+     * @throws mqtt::exception if client creation fails.
+     */
+    PahoTransport(Settings settings, Listener& listener);
+    ~PahoTransport() override;
+
+    bool beginConnect() override;
+    bool publish(const Message& message) override;
+    bool subscribe(std::string_view topic_filter, int qos) override;
+    void disconnect(std::chrono::milliseconds timeout) override;
+    const char* name() const override { return "paho"; }
+
+    // Delete copy/move operations (Paho holds references to this object)
+    PahoTransport(const PahoTransport&) = delete;
+    PahoTransport& operator=(const PahoTransport&) = delete;
+    PahoTransport(PahoTransport&&) = delete;
+    PahoTransport& operator=(PahoTransport&&) = delete;
+
+private:
+    // --- Paho MQTT Callback overrides ---
+    void on_failure(const mqtt::token& tok) override;
+    void on_success(const mqtt::token& tok) override;
+    void connected(const std::string& cause) override;
+    void connection_lost(const std::string& cause) override;
+    void message_arrived(mqtt::const_message_ptr msg) override;
+    void delivery_complete(mqtt::delivery_token_ptr tok) override;
+
+    /**
+     * @brief Routes delivery token outcomes to the listener.
+     */
+    class DeliveryListener : public virtual mqtt::iaction_listener {
+    public:
+        explicit DeliveryListener(Listener& listener) : listener_(listener) {}
+        void on_success(const mqtt::token& tok) override;
+        void on_failure(const mqtt::token& tok) override;
+
+    private:
+        Listener& listener_;
+    };
+
+    const Settings settings_;
+    Listener& listener_;
+    std::unique_ptr<mqtt::async_client> client_; // MQTT asynchronous client instance
+    mqtt::connect_options conn_opts_;           // Connection options
+    DeliveryListener delivery_listener_{listener_};
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,28 @@
+#include "NetworkMQTT/reconnect_backoff.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+ReconnectBackoff::ReconnectBackoff(Options options, uint64_t seed) : options_(options), rng_(seed) {
+    if (options_.initial_delay.count() <= 0 || options_.max_delay < options_.initial_delay) {
+        throw std::invalid_argument("Reconnect delays must be positive and max_delay >= initial_delay");
+    }
+    if (!(options_.multiplier >= 1.0) || !(options_.jitter >= 0.0 && options_.jitter <= 1.0)) {
+        throw std::invalid_argument("Reconnect multiplier must be >= 1 and jitter within [0, 1]");
+    }
+}
+
+std::chrono::milliseconds ReconnectBackoff::next() {
+    // Computed in double so a long outage cannot overflow the exponent
+    const double ceiling = std::min(static_cast<double>(options_.max_delay.count()),
+                                    static_cast<double>(options_.initial_delay.count()) *
+                                        std::pow(options_.multiplier, static_cast<double>(failures_)));
+    if (failures_ < UINT32_MAX) ++failures_;
+
+    std::uniform_real_distribution<double> spread(1.0 - options_.jitter, 1.0);
+    return std::chrono::milliseconds(std::max<int64_t>(1, std::llround(ceiling * spread(rng_))));
+}
+
+} // namespace SensorHub::Components
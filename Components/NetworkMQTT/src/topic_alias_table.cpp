@@ -0,0 +1,40 @@
+#include "NetworkMQTT/topic_alias_table.h"
+
+namespace SensorHub::Components {
+
+TopicAliasTable::TopicAliasTable(uint16_t max_aliases) : max_aliases_(max_aliases) {}
+
+bool TopicAliasTable::add(const std::string& topic) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.contains(topic)) return true;
+    if (entries_.size() >= max_aliases_) return false;
+    entries_.emplace(topic, Entry{static_cast<uint16_t>(entries_.size() + 1), false});
+    return true;
+}
+
+TopicAliasTable::Use TopicAliasTable::use(const std::string& topic) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = entries_.find(topic);
+    if (it == entries_.end() || it->second.alias > broker_max_) return {};
+    Use result{it->second.alias, !it->second.known};
+    it->second.known = true;
+    return result;
+}
+
+void TopicAliasTable::unuse(const std::string& topic) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const auto it = entries_.find(topic); it != entries_.end()) it->second.known = false;
+}
+
+void TopicAliasTable::reset(uint16_t broker_max) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    broker_max_ = broker_max;
+    for (auto& [topic, entry] : entries_) entry.known = false;
+}
+
+size_t TopicAliasTable::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace SensorHub::Components
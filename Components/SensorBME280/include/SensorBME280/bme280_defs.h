@@ -18,6 +18,7 @@ namespace BME280 {
     constexpr uint8_t REG_CHIP_ID = 0xD0;
     constexpr uint8_t REG_CTRL_HUM = 0xF2;
     constexpr uint8_t REG_CTRL_MEAS = 0xF4;
+    constexpr uint8_t REG_STATUS = 0xF3;
     constexpr uint8_t REG_CONFIG = 0xF5;
     constexpr uint8_t REG_CALIB_DT1_LSB = 0x88; // Start of T, P calibration data
     constexpr uint8_t REG_CALIB_DH1 = 0xA1;     // H1 calibration data
@@ -25,14 +26,39 @@ namespace BME280 {
     constexpr uint8_t REG_PRESS_MSB = 0xF7;    // Start of measurement data (P, T, H)
 
     constexpr uint8_t CHIP_ID_VALUE = 0x60; // Expected Chip ID value for BME280
+    constexpr uint8_t STATUS_MEASURING = 0x08; // Bit 3: conversion running
 
     // Operating modes (example settings - adjust as needed!)
-    // Humidity, Pressure, Temp Oversampling x1; Normal mode; IIR filter off; Standby 1000ms
+    // Humidity, Pressure, Temp Oversampling x1; Forced mode (one conversion per read); IIR filter off
     constexpr uint8_t CTRL_HUM_OS_1 = 0x01; // Oversampling x1 Humidity
     // Bits 7,6,5: temp OS; Bits 4,3,2: press OS; Bits 1,0: mode
-    constexpr uint8_t CTRL_MEAS_SETTINGS = (0b001 << 5) | (0b001 << 2) | 0b11; // T_OS=1, P_OS=1, Mode=Normal(11)
+    constexpr uint8_t CTRL_MEAS_SLEEP = (0b001 << 5) | (0b001 << 2) | 0b00;  // T_OS=1, P_OS=1, Mode=Sleep(00)
+    constexpr uint8_t CTRL_MEAS_FORCED = (0b001 << 5) | (0b001 << 2) | 0b01; // T_OS=1, P_OS=1, Mode=Forced(01)
+    // Max conversion time at x1/x1/x1 oversampling is 9.3ms (datasheet 9.1)
+    constexpr unsigned MEASUREMENT_TIME_MS = 10;
+    constexpr unsigned MEASUREMENT_POLL_MS = 1;       // Status poll period if still busy
+    constexpr unsigned MEASUREMENT_MAX_POLLS = 10;    // Give up after this many extra polls
     // Bits 7,6,5: t_sb; Bits 4,3,2: filter; Bit 0: spi3w_en (0 for I2C)
     constexpr uint8_t CONFIG_SETTINGS = (0b101 << 5) | (0b000 << 2) | 0; // t_sb=1000ms(101), filter=off(000)
+
+    // Factory trim values, read once from REG_CALIB_DT1_LSB, REG_CALIB_DH1 and REG_CALIB_DH2_LSB
+    struct Calibration {
+        uint16_t dig_T1 = 0;
+        int16_t dig_T2 = 0, dig_T3 = 0;
+        uint16_t dig_P1 = 0;
+        int16_t dig_P2 = 0, dig_P3 = 0, dig_P4 = 0, dig_P5 = 0, dig_P6 = 0, dig_P7 = 0, dig_P8 = 0, dig_P9 = 0;
+        uint8_t dig_H1 = 0;
+        int16_t dig_H2 = 0;
+        uint8_t dig_H3 = 0;
+        int16_t dig_H4 = 0, dig_H5 = 0;
+        int8_t dig_H6 = 0;
+    };
+
+    /**
+     * @brief Converts raw ADC values to physical units (datasheet 8.1, double precision).
+     * Pure function of its arguments; pressure is returned in hPa.
+     */
+    BME280Data compensate(const Calibration& calib, int32_t adc_T, int32_t adc_P, int32_t adc_H);
 } // namespace BME280
 
 } // namespace SensorHub::Components
\ No newline at end of file
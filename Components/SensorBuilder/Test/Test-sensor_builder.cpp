@@ -0,0 +1,131 @@
+#include "SensorBuilder/sensor_builder.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
+
+namespace SensorHub::Builder {
+
+namespace {
+
+using json = nlohmann::json;
+using namespace std::chrono_literals;
+
+json dummy(const std::string& suffix, int interval_ms = 1000) {
+    return {{"type", "Dummy"}, {"enabled", true}, {"publish_topic_suffix", suffix}, {"publish_interval_ms", interval_ms}};
+}
+
+std::vector<std::string> suffixes(const std::vector<std::unique_ptr<Interfaces::ISensor>>& sensors) {
+    std::vector<std::string> out;
+    for (const auto& sensor : sensors) out.push_back(sensor->getTopicSuffix());
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::vector<std::string> sorted(std::vector<std::string> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+} // namespace
+
+TEST(SensorBuilderTest, LeavesAnUnchangedConfigurationAlone) {
+    SensorBuilder builder;
+    const json config = json::array({dummy("a"), dummy("b")});
+    EXPECT_EQ(suffixes(builder.buildSensors(config)), (std::vector<std::string>{"a", "b"}));
+
+    const auto diff = builder.rebuildSensors(config);
+    EXPECT_TRUE(diff.empty());
+    EXPECT_EQ(diff.unchanged, 2u);
+    EXPECT_THROW(builder.rebuildSensors(json::object()), std::runtime_error);
+}
+
+TEST(SensorBuilderTest, ReschedulesSensorsWhoseIntervalOnlyChanged) {
+    SensorBuilder builder;
+    builder.buildSensors(json::array({dummy("a", 1000), dummy("b", 1000)}));
+
+    json changed = dummy("a");
+    changed.erase("publish_interval_ms");
+    changed["publish_interval_sec"] = 0.25; // Another key for the interval still counts as the interval
+    const auto diff = builder.rebuildSensors(json::array({changed, dummy("b", 1000)}));
+    EXPECT_TRUE(diff.removed.empty());
+    EXPECT_TRUE(diff.added.empty());
+    ASSERT_EQ(diff.rescheduled.size(), 1u);
+    EXPECT_EQ(diff.rescheduled.at("a"), 250ms);
+    EXPECT_EQ(diff.unchanged, 1u);
+
+    // The new interval is now the running configuration
+    EXPECT_TRUE(builder.rebuildSensors(json::array({changed, dummy("b", 1000)})).empty());
+}
+
+TEST(SensorBuilderTest, RebuildsSensorsWithOtherChanges) {
+    SensorBuilder builder;
+    builder.buildSensors(json::array({dummy("a"), dummy("b"), dummy("c")}));
+
+    json changed = dummy("b", 500);
+    changed["comment"] = "moved"; // Any other key forces a rebuild, even alongside an interval change
+    json disabled = dummy("c");
+    disabled["enabled"] = false;
+    const auto diff = builder.rebuildSensors(json::array({dummy("a"), changed, disabled, dummy("d")}));
+
+    EXPECT_EQ(sorted(diff.removed), (std::vector<std::string>{"b", "c"}));
+    EXPECT_EQ(suffixes(diff.added), (std::vector<std::string>{"b", "d"}));
+    EXPECT_TRUE(diff.rescheduled.empty());
+    EXPECT_EQ(diff.unchanged, 1u);
+    const auto rebuilt = std::find_if(diff.added.begin(), diff.added.end(),
+                                      [](const auto& sensor) { return sensor->getTopicSuffix() == "b"; });
+    ASSERT_NE(rebuilt, diff.added.end());
+    EXPECT_EQ((*rebuilt)->getPublishInterval(), 500ms);
+}
+
+TEST(SensorBuilderTest, RemovesOnlyWhenARebuildFails) {
+    SensorBuilder builder;
+    builder.buildSensors(json::array({dummy("a"), dummy("b")}));
+
+    // A BME280 with an invalid address cannot be built; the old sensor still has to stop
+    json broken = dummy("b");
+    broken["type"] = "BME280";
+    broken["i2c_bus"] = "/dev/i2c-sensorhub-test";
+    broken["i2c_address"] = "0xZZ";
+    auto diff = builder.rebuildSensors(json::array({dummy("a"), broken}));
+    EXPECT_EQ(diff.removed, (std::vector<std::string>{"b"}));
+    EXPECT_TRUE(diff.added.empty());
+    EXPECT_EQ(diff.unchanged, 1u);
+
+    // The failed entry is not running, so fixing it later builds it as new
+    diff = builder.rebuildSensors(json::array({dummy("a"), dummy("b")}));
+    EXPECT_TRUE(diff.removed.empty());
+    EXPECT_EQ(suffixes(diff.added), (std::vector<std::string>{"b"}));
+}
+
+TEST(SensorBuilderTest, RebuildsAForgottenSensor) {
+    SensorBuilder builder;
+    builder.buildSensors(json::array({dummy("a"), dummy("b")}));
+
+    // E.g. "b" was rebuilt but failed to initialize: the same entry is built again
+    builder.forgetSensor("b");
+    auto diff = builder.rebuildSensors(json::array({dummy("a"), dummy("b")}));
+    EXPECT_TRUE(diff.removed.empty());
+    EXPECT_EQ(suffixes(diff.added), (std::vector<std::string>{"b"}));
+    EXPECT_EQ(diff.unchanged, 1u);
+}
+
+TEST(SensorBuilderTest, IgnoresDuplicateSuffixes) {
+    SensorBuilder builder;
+    builder.buildSensors(json::array({dummy("a", 1000)}));
+
+    // The first entry for a suffix wins; the later one is neither built nor compared
+    auto diff = builder.rebuildSensors(json::array({dummy("a", 1000), dummy("a", 20), dummy("b"), dummy("b", 30)}));
+    EXPECT_TRUE(diff.removed.empty());
+    EXPECT_TRUE(diff.rescheduled.empty());
+    EXPECT_EQ(diff.unchanged, 1u);
+    ASSERT_EQ(diff.added.size(), 1u);
+    EXPECT_EQ(diff.added[0]->getTopicSuffix(), "b");
+    EXPECT_EQ(diff.added[0]->getPublishInterval(), 1000ms);
+
+    // Non-object and incomplete entries are skipped as well
+    diff = builder.rebuildSensors(json::array({dummy("a", 1000), dummy("b"), 42, json{{"enabled", true}}}));
+    EXPECT_TRUE(diff.empty());
+    EXPECT_EQ(diff.unchanged, 2u);
+}
+
+} // namespace SensorHub::Builder
@@ -2,14 +2,15 @@
 
 #include "Interfaces/isensor.h"
 #include "Interfaces/ii2c_bus.h"
-#include <nlohmann/json_fwd.hpp> // Forward declare json
+#include <nlohmann/json.hpp>
+#include <chrono>
 #include <vector>
 #include <memory> // For shared_ptr
 #include <string>
 #include <map> // For managing bus managers
 
 // Forward declare concrete manager types used by builder
-namespace SensorHub::Components { class LinuxI2C_Manager; }
+namespace SensorHub::Components { class LinuxI2C_Manager; class MetricsRegistry; }
 
 namespace SensorHub::Builder {
 
@@ -19,7 +20,27 @@ namespace SensorHub::Builder {
  */
 class SensorBuilder {
 public:
-    SensorBuilder();
+    /**
+     * @brief What a new "sensors" array changes compared with the running sensors.
+     * Sensors are identified by publish_topic_suffix.
+     */
+    struct SensorDiff {
+        // Topic suffixes of running sensors to stop: gone, disabled, or changed in more than
+        // their interval (those are rebuilt and also in added)
+        std::vector<std::string> removed;
+        std::vector<std::unique_ptr<SensorHub::Interfaces::ISensor>> added;
+        // Running sensors where only the publish interval changed: keep them, with the new interval
+        std::map<std::string, std::chrono::milliseconds> rescheduled;
+        size_t unchanged = 0;
+
+        bool empty() const { return removed.empty() && added.empty() && rescheduled.empty(); }
+    };
+
+    /**
+     * @param metrics Registry the I2C bus managers report their transactions to; may be null.
+     * Must outlive the builder and the sensors it builds.
+     */
+    explicit SensorBuilder(SensorHub::Components::MetricsRegistry* metrics = nullptr);
     ~SensorBuilder(); // Needed for unique_ptr to incomplete types (pimpl idiom without pimpl)
 
     /**
@@ -31,6 +52,26 @@ public:
     std::vector<std::unique_ptr<SensorHub::Interfaces::ISensor>> buildSensors(
         const nlohmann::json& sensor_configs_json);
 
+    /**
+     * @brief Compares a new "sensors" array with the one the running sensors were built
+     * from, and builds only the sensors that are new or changed. Unchanged sensors and
+     * their buses are left alone; bus managers are reused. Afterwards the new array
+     * counts as the running configuration.
+     * Added sensors are not initialized yet, so building them never blocks on the bus: the
+     * caller co_awaits initializeAsync() on each before its first read.
+     * @param sensor_configs_json The new "sensors" array.
+     * @return The changes to apply. A changed sensor that fails to build is removed only.
+     * @throws std::runtime_error if the configuration is not a JSON array.
+     */
+    SensorDiff rebuildSensors(const nlohmann::json& sensor_configs_json);
+
+    /**
+     * @brief Drops a sensor from the running configuration, e.g. one from rebuildSensors()
+     * that then failed to initialize. The next rebuild builds its entry again as new.
+     * @param topic_suffix The sensor's publish_topic_suffix.
+     */
+    void forgetSensor(const std::string& topic_suffix);
+
     // Delete copy/move operations
     SensorBuilder(const SensorBuilder&) = delete;
     SensorBuilder& operator=(const SensorBuilder&) = delete;
@@ -38,6 +79,15 @@ public:
     SensorBuilder& operator=(SensorBuilder&&) = delete;
 
 private:
+    /**
+     * @brief Creates one sensor from its config entry (the entry must be enabled).
+     * @param initialize Run the driver's initialization sequence now (blocking).
+     * @return The sensor, or nullptr if the entry is invalid or creation failed (logged).
+     */
+    std::unique_ptr<SensorHub::Interfaces::ISensor> buildSensor(const nlohmann::json& j_sensor,
+                                                                const SensorHub::Interfaces::SensorConfig& common,
+                                                                bool initialize);
+
     /**
      * @brief Gets or creates an I2C bus manager for the given bus path.
      * @param bus_path The device path (e.g., "/dev/i2c-1").
@@ -49,6 +99,10 @@ private:
     // Map to store and reuse I2C bus managers (key = bus path)
     // Use unique_ptr for ownership management
     std::map<std::string, std::shared_ptr<SensorHub::Interfaces::II2C_Bus>> i2c_managers_;
+    SensorHub::Components::MetricsRegistry* metrics_ = nullptr;
+
+    // Config entries of the running sensors (key = topic suffix), for rebuildSensors()
+    std::map<std::string, nlohmann::json> running_configs_;
 
     // Add maps for other bus types (SPI, 1-Wire) here later if needed
     // std::map<std::string, std::unique_ptr<ISpiBus>> spi_managers_;
@@ -34,7 +34,7 @@ uint8_t parse_hex_address_builder(const std::string& addr_str) {
     }
 }
 
-SensorBuilder::SensorBuilder() = default;
+SensorBuilder::SensorBuilder(MetricsRegistry* metrics) : metrics_(metrics) {}
 // Destructor needs to be defined (even if empty) because unique_ptr needs
 // the complete type definition of II2C_Bus at destruction time.
 SensorBuilder::~SensorBuilder() = default;
@@ -45,7 +45,7 @@ std::shared_ptr<II2C_Bus> SensorBuilder::getI2CManager(const std::string& bus_pa
     if (it == i2c_managers_.end()) {
         std::cout << "SensorBuilder: Creating new I2C Manager for bus: " << bus_path << std::endl;
         // Use make_shared for shared ownership from the start
-        std::shared_ptr<II2C_Bus> new_manager = std::make_shared<I2C_Manager>(bus_path);
+        std::shared_ptr<II2C_Bus> new_manager = std::make_shared<I2C_Manager>(bus_path, metrics_);
         it = i2c_managers_.emplace(bus_path, new_manager).first; // Store shared_ptr
     }
     // Return a copy of the shared_ptr
@@ -75,58 +75,10 @@ std::vector<std::unique_ptr<ISensor>> SensorBuilder::buildSensors(const nlohmann
             continue;
         }
 
-        std::unique_ptr<ISensor> sensor_ptr = nullptr;
-
-        try {
-            // --- Sensor Creation Logic based on Type ---
-            if (config.type == "BME280") {
-                // Parse BME280 specific fields
-                config.i2c_bus = j_sensor.at("i2c_bus").get<std::string>();
-                std::string addr_str = j_sensor.at("i2c_address").get<std::string>();
-                config.i2c_address = parse_hex_address_builder(addr_str); // Use helper
-
-                // Get or create the required I2C bus manager
-                std::shared_ptr<II2C_Bus> i2c_bus_sptr = getI2CManager(config.i2c_bus);
-
-                // Call the static factory method of the sensor implementation
-                sensor_ptr = BME280_Sensor::create(config, i2c_bus_sptr);
-
-            }
-            else if (config.type == "LPS25HB") {
-                config.i2c_bus = j_sensor.at("i2c_bus").get<std::string>();
-                std::string addr_str = j_sensor.at("i2c_address").get<std::string>();
-                config.i2c_address = parse_hex_address_builder(addr_str);
-
-                std::shared_ptr<II2C_Bus> i2c_bus_sptr = getI2CManager(config.i2c_bus);
-                sensor_ptr = SensorLPS25HB::create(config, i2c_bus_sptr); // Call LPS factory
-            }
-            else if (config.type == "Dummy") {
-                // Parse any dummy-specific config fields if needed
-                // config.some_dummy_param = j_sensor.at("dummy_param").get<int>();
-
-                // Call the static factory method
-                sensor_ptr = SensorDummy::create(config); // Doesn't need extra dependencies currently
-            }
-            else {
-                std::cerr << "SensorBuilder Warning: Unknown sensor type '" << config.type << "' defined in config. Skipping." << std::endl;
-            }
-
-            // Add successfully created sensor to the list
-            if (sensor_ptr) {
-                std::cout << "SensorBuilder: Successfully created sensor instance for type '" << config.type << "' with suffix '" << config.publish_topic_suffix << "'." << std::endl;
-                sensors.push_back(std::move(sensor_ptr));
-            } else {
-                 std::cerr << "SensorBuilder Warning: Failed to create sensor instance for type '" << config.type << "' (config suffix: " << config.publish_topic_suffix << ")." << std::endl;
-            }
-
-        } catch (const json::out_of_range& e) {
-            std::cerr << "SensorBuilder Warning: Missing required configuration key for sensor type '" << config.type << "': " << e.what() << ". Skipping sensor." << std::endl;
-        } catch (const json::type_error& e) {
-            std::cerr << "SensorBuilder Warning: Incorrect type for configuration key for sensor type '" << config.type << "': " << e.what() << ". Skipping sensor." << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "SensorBuilder Warning: Error processing configuration for sensor type '" << config.type << "': " << e.what() << ". Skipping sensor." << std::endl;
+        if (auto sensor_ptr = buildSensor(j_sensor, config, true)) {
+            running_configs_[config.publish_topic_suffix] = j_sensor;
+            sensors.push_back(std::move(sensor_ptr));
         }
-
     } // end for loop
 
     if (sensors.empty()) {
@@ -137,4 +89,127 @@ std::vector<std::unique_ptr<ISensor>> SensorBuilder::buildSensors(const nlohmann
     return sensors;
 }
 
+// Builds only what differs from the running configuration
+SensorBuilder::SensorDiff SensorBuilder::rebuildSensors(const nlohmann::json& sensor_configs_json)
+{
+    if (!sensor_configs_json.is_array()) {
+        throw std::runtime_error("SensorBuilder Error: 'sensors' configuration is not a JSON array.");
+    }
+
+    // Enabled entries of the new configuration, by topic suffix
+    std::map<std::string, std::pair<const json*, SensorConfig>> wanted;
+    for (const auto& j_sensor : sensor_configs_json) {
+        if (!j_sensor.is_object()) continue;
+        SensorConfig config;
+        if (!SensorConfig::parseCommon(j_sensor, config)) continue;
+        const std::string suffix = config.publish_topic_suffix;
+        if (!wanted.emplace(suffix, std::make_pair(&j_sensor, std::move(config))).second) {
+            std::cerr << "SensorBuilder Warning: Duplicate publish_topic_suffix '" << suffix << "', keeping the first." << std::endl;
+        }
+    }
+
+    // Everything but the interval decides whether a sensor must be rebuilt
+    const auto withoutInterval = [](json entry) {
+        entry.erase("publish_interval_ms");
+        entry.erase("publish_interval_sec");
+        return entry;
+    };
+
+    SensorDiff diff;
+    for (auto it = running_configs_.begin(); it != running_configs_.end();) {
+        const auto wanted_it = wanted.find(it->first);
+        if (wanted_it == wanted.end()) {
+            diff.removed.push_back(it->first);
+            it = running_configs_.erase(it);
+            continue;
+        }
+        const json& entry = *wanted_it->second.first;
+        if (entry == it->second) {
+            ++diff.unchanged;
+        } else if (withoutInterval(entry) == withoutInterval(it->second)) {
+            diff.rescheduled[it->first] = wanted_it->second.second.publish_interval;
+            it->second = entry;
+        } else {
+            diff.removed.push_back(it->first); // Rebuilt below
+            it = running_configs_.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    for (const auto& [suffix, wanted_entry] : wanted) {
+        if (running_configs_.contains(suffix)) continue;
+        // Initialized by the caller, once the instance it replaces has let go of the chip
+        if (auto sensor_ptr = buildSensor(*wanted_entry.first, wanted_entry.second, false)) {
+            running_configs_[suffix] = *wanted_entry.first;
+            diff.added.push_back(std::move(sensor_ptr));
+        }
+    }
+    return diff;
+}
+
+void SensorBuilder::forgetSensor(const std::string& topic_suffix)
+{
+    running_configs_.erase(topic_suffix);
+}
+
+// Creates one sensor; failures are logged and yield nullptr
+std::unique_ptr<ISensor> SensorBuilder::buildSensor(const nlohmann::json& j_sensor, const SensorConfig& common,
+                                                    bool initialize)
+{
+    SensorConfig config = common;
+    std::unique_ptr<ISensor> sensor_ptr = nullptr;
+
+    try {
+        // --- Sensor Creation Logic based on Type ---
+        if (config.type == "BME280") {
+            // Parse BME280 specific fields
+            config.i2c_bus = j_sensor.at("i2c_bus").get<std::string>();
+            std::string addr_str = j_sensor.at("i2c_address").get<std::string>();
+            config.i2c_address = parse_hex_address_builder(addr_str); // Use helper
+
+            // Get or create the required I2C bus manager
+            std::shared_ptr<II2C_Bus> i2c_bus_sptr = getI2CManager(config.i2c_bus);
+
+            // Call the static factory method of the sensor implementation
+            sensor_ptr = BME280_Sensor::create(config, i2c_bus_sptr, initialize);
+
+        }
+        else if (config.type == "LPS25HB") {
+            config.i2c_bus = j_sensor.at("i2c_bus").get<std::string>();
+            std::string addr_str = j_sensor.at("i2c_address").get<std::string>();
+            config.i2c_address = parse_hex_address_builder(addr_str);
+
+            std::shared_ptr<II2C_Bus> i2c_bus_sptr = getI2CManager(config.i2c_bus);
+            sensor_ptr = SensorLPS25HB::create(config, i2c_bus_sptr, initialize); // Call LPS factory
+        }
+        else if (config.type == "Dummy") {
+            // Parse any dummy-specific config fields if needed
+            // config.some_dummy_param = j_sensor.at("dummy_param").get<int>();
+
+            // Call the static factory method
+            sensor_ptr = SensorDummy::create(config); // Doesn't need extra dependencies currently
+        }
+        else {
+            std::cerr << "SensorBuilder Warning: Unknown sensor type '" << config.type << "' defined in config. Skipping." << std::endl;
+            return nullptr;
+        }
+
+        // Report the outcome of the factory call
+        if (sensor_ptr) {
+            std::cout << "SensorBuilder: Successfully created sensor instance for type '" << config.type << "' with suffix '" << config.publish_topic_suffix << "'." << std::endl;
+        } else {
+             std::cerr << "SensorBuilder Warning: Failed to create sensor instance for type '" << config.type << "' (config suffix: " << config.publish_topic_suffix << ")." << std::endl;
+        }
+
+    } catch (const json::out_of_range& e) {
+        std::cerr << "SensorBuilder Warning: Missing required configuration key for sensor type '" << config.type << "': " << e.what() << ". Skipping sensor." << std::endl;
+    } catch (const json::type_error& e) {
+        std::cerr << "SensorBuilder Warning: Incorrect type for configuration key for sensor type '" << config.type << "': " << e.what() << ". Skipping sensor." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "SensorBuilder Warning: Error processing configuration for sensor type '" << config.type << "': " << e.what() << ". Skipping sensor." << std::endl;
+    }
+    return sensor_ptr;
+}
+
 } // namespace SensorHub::Builder
@@ -38,7 +38,7 @@ public:
     // --- ISensor Interface Implementation ---
     std::string getType() const override;
     bool isEnabled() const override;
-    std::chrono::seconds getPublishInterval() const override;
+    std::chrono::milliseconds getPublishInterval() const override;
     std::string getTopicSuffix() const override;
     nlohmann::json readDataJson() override;
 
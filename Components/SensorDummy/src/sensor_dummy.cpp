@@ -53,7 +53,7 @@ bool SensorDummy::isEnabled() const {
     return config_.enabled;
 }
 
-std::chrono::seconds SensorDummy::getPublishInterval() const {
+std::chrono::milliseconds SensorDummy::getPublishInterval() const {
     // Return specific interval from config, or a default if not set/parsed
     return config_.publish_interval;
 }
@@ -32,5 +32,22 @@ namespace LPS25HB {
     // Auto-increment bit for multi-byte reads (optional, depends on I2C manager implementation)
     constexpr uint8_t AUTO_INCREMENT = 0x80;
 
+    // Pressure in hPa from PRESS_OUT_XL, _L, _H (24-bit two's complement, 4096 LSB/hPa)
+    inline double decodePressure(const uint8_t* raw) {
+        int32_t raw_pressure = static_cast<int32_t>( (static_cast<uint32_t>(raw[2]) << 16) |
+                                                     (static_cast<uint32_t>(raw[1]) << 8)  |
+                                                     (static_cast<uint32_t>(raw[0])) );
+        if (raw[2] & 0x80) {
+            raw_pressure = static_cast<int32_t>(static_cast<int>(raw_pressure << 8) / 256); // Sign extend
+        }
+        return static_cast<double>(raw_pressure) / 4096.0;
+    }
+
+    // Temperature in Celsius from TEMP_OUT_L, _H (16-bit two's complement: 42.5 + raw / 480)
+    inline double decodeTemperature(const uint8_t* raw) {
+        const int16_t raw_temp = static_cast<int16_t>( (static_cast<uint16_t>(raw[1]) << 8) | raw[0] );
+        return 42.5 + (static_cast<double>(raw_temp) / 480.0);
+    }
+
 } // namespace LPS25HB
 } // namespace SensorHub::Components
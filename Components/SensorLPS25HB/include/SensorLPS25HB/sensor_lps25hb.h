@@ -3,6 +3,8 @@
 #include "lps25hb_defs.h"          // Include sensor definitions
 #include "Interfaces/isensor.h"   // Inherit from ISensor
 #include "Interfaces/ii2c_bus.h"  // Depends on I2C Bus interface
+#include "Interfaces/async_i2c_bus.h" // Awaitable bus operations
+#include "Coro/task.h"
 #include "Interfaces/sensor_config.h" // Use SensorConfig
 #include <string>
 #include <chrono>
@@ -21,30 +23,38 @@ public:
      * @brief Factory method to create an LPS25HB sensor instance.
      * @param config The sensor configuration parsed from JSON.
      * @param i2c_bus Shared pointer to the I2C bus manager for communication.
+     * @param initialize Run the initialization sequence now, blocking the calling thread.
+     * If false, the caller must co_await initializeAsync() before the first read.
      * @return std::unique_ptr<ISensor> to the created sensor, or nullptr on failure.
      */
     static std::unique_ptr<SensorHub::Interfaces::ISensor> create(
         const SensorHub::Interfaces::SensorConfig& config,
-        std::shared_ptr<SensorHub::Interfaces::II2C_Bus> i2c_bus); // Takes shared_ptr
+        std::shared_ptr<SensorHub::Interfaces::II2C_Bus> i2c_bus, // Takes shared_ptr
+        bool initialize = true);
 
     /**
      * @brief Constructor (protected, use create factory).
      * Initializes the sensor using specific config and I2C bus.
      * @param config The sensor configuration.
      * @param i2c_bus Shared pointer to the I2C bus manager.
+     * @param initialize Run the initialization sequence now (see create()).
      * @throws std::runtime_error if initialization fails.
      */
     SensorLPS25HB(const SensorHub::Interfaces::SensorConfig& config,
-                  std::shared_ptr<SensorHub::Interfaces::II2C_Bus> i2c_bus); // Takes shared_ptr
+                  std::shared_ptr<SensorHub::Interfaces::II2C_Bus> i2c_bus, // Takes shared_ptr
+                  bool initialize = true);
 
     ~SensorLPS25HB() override = default;
 
     // --- ISensor Interface Implementation ---
     std::string getType() const override;
     bool isEnabled() const override;
-    std::chrono::seconds getPublishInterval() const override;
+    std::chrono::milliseconds getPublishInterval() const override;
     std::string getTopicSuffix() const override;
+    std::string getBusId() const override;
     nlohmann::json readDataJson() override;
+    Coro::Task<void> initializeAsync() override;
+    Coro::Task<nlohmann::json> readDataJsonAsync() override;
 
     // Delete copy/move operations
     SensorLPS25HB(const SensorLPS25HB&) = delete;
@@ -54,13 +64,14 @@ public:
 
 private:
     // Helper methods
-    bool checkDevice();
-    bool configureSensor();
-    std::optional<double> readPressure();   // Returns hPa
-    std::optional<double> readTemperature(); // Returns Celsius
+    Coro::Task<bool> checkDevice();
+    Coro::Task<bool> configureSensor();
+    Coro::Task<std::optional<double>> readPressure();   // Returns hPa
+    Coro::Task<std::optional<double>> readTemperature(); // Returns Celsius
 
     // Member Variables
     std::shared_ptr<SensorHub::Interfaces::II2C_Bus> i2c_bus_sptr_; // Store shared_ptr
+    SensorHub::Interfaces::AsyncI2C_Bus bus_; // Awaitable view of i2c_bus_sptr_
     SensorHub::Interfaces::SensorConfig config_; // Store the config
     bool initialized_ = false;
 };
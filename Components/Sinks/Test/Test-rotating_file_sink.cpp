@@ -0,0 +1,81 @@
+#include "Sinks/rotating_file_sink.h"
+#include "gtest/gtest.h"
+#include <fstream>
+#include <sstream>
+
+namespace SensorHub::Components {
+
+namespace {
+
+class RotatingFileSinkTest : public testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "rotating_file_sink_test";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    static std::string contents(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream out;
+        out << file.rdbuf();
+        return out.str();
+    }
+
+    std::filesystem::path directory_;
+};
+
+} // namespace
+
+TEST_F(RotatingFileSinkTest, AppendsFramedRecords) {
+    RotatingFileSink::Options options;
+    options.path = directory_ / "readings.log";
+    {
+        RotatingFileSink sink(options);
+        PayloadPool pool;
+        Payload payload = pool.acquire();
+        payload.buffer() = "{\"t\":1}";
+        const std::string topic = "hub/temp";
+        EXPECT_EQ(sink.send(SinkMessage{topic, payload}), ISink::Result::Sent);
+        payload.buffer() = std::string("\x01\n\x02", 3); // Binary frames keep their exact length
+        EXPECT_EQ(sink.send(SinkMessage{topic, payload}), ISink::Result::Sent);
+    }
+    RotatingFileSink reopened(options); // Appends, doesn't truncate
+    EXPECT_EQ(contents(options.path), std::string("hub/temp 7\n{\"t\":1}\nhub/temp 3\n\x01\n\x02\n", 34));
+}
+
+TEST_F(RotatingFileSinkTest, RotatesBySizeAndKeepsMaxFiles) {
+    RotatingFileSink::Options options;
+    options.path = directory_ / "readings.log";
+    options.max_bytes = 30; // Two 13-byte records per file
+    options.max_files = 3;
+    RotatingFileSink sink(options);
+
+    PayloadPool pool;
+    Payload payload = pool.acquire();
+    const std::string topic = "t";
+    for (int i = 0; i < 10; ++i) {
+        payload.buffer() = "payload" + std::to_string(i);
+        ASSERT_EQ(sink.send(SinkMessage{topic, payload}), ISink::Result::Sent);
+    }
+    EXPECT_EQ(sink.rotations(), 4u);
+    EXPECT_EQ(contents(options.path), "t 8\npayload8\nt 8\npayload9\n");
+    EXPECT_EQ(contents(directory_ / "readings.log.1"), "t 8\npayload6\nt 8\npayload7\n");
+    EXPECT_EQ(contents(directory_ / "readings.log.2"), "t 8\npayload4\nt 8\npayload5\n");
+    EXPECT_FALSE(std::filesystem::exists(directory_ / "readings.log.3"));
+}
+
+TEST_F(RotatingFileSinkTest, RejectsInvalidOptions) {
+    RotatingFileSink::Options options;
+    EXPECT_THROW(RotatingFileSink{options}, std::invalid_argument);
+    options.path = directory_ / "readings.log";
+    options.max_files = 0;
+    EXPECT_THROW(RotatingFileSink{options}, std::invalid_argument);
+    options.max_files = 1;
+    options.path = directory_ / "missing" / "readings.log";
+    EXPECT_THROW(RotatingFileSink{options}, std::system_error);
+}
+
+} // namespace SensorHub::Components
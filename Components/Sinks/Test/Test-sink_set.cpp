@@ -0,0 +1,53 @@
+#include "Sinks/sink_set.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace SensorHub::Components {
+
+namespace {
+
+class FakeSink : public ISink {
+public:
+    explicit FakeSink(Result result, std::vector<const char*>& seen) : result_(result), seen_(seen) {}
+
+    Result send(const SinkMessage& message) override {
+        seen_.push_back(message.payload.str().data());
+        return result_;
+    }
+    const char* type() const override { return "fake"; }
+    std::string describe() const override { return "fake"; }
+
+private:
+    Result result_;
+    std::vector<const char*>& seen_;
+};
+
+} // namespace
+
+TEST(SinkSetTest, FansOutOneBufferAndCountsOutcomes) {
+    std::vector<const char*> seen;
+    SinkSet sinks;
+    EXPECT_TRUE(sinks.empty());
+    sinks.add(std::make_unique<FakeSink>(ISink::Result::Sent, seen));
+    sinks.add(std::make_unique<FakeSink>(ISink::Result::Busy, seen));
+    sinks.add(std::make_unique<FakeSink>(ISink::Result::Sent, seen));
+
+    PayloadPool pool;
+    Payload payload = pool.acquire();
+    payload.buffer() = "{\"t\":21.5}";
+    const std::string topic = "hub/temp";
+    EXPECT_EQ(sinks.send(SinkMessage{topic, payload}), 2u);
+    EXPECT_EQ(sinks.send(SinkMessage{topic, payload}), 2u);
+
+    // Every sink saw the same bytes, not a copy
+    ASSERT_EQ(seen.size(), 6u);
+    for (const char* data : seen) EXPECT_EQ(data, payload.str().data());
+    EXPECT_EQ(payload.useCount(), 1u);
+
+    EXPECT_EQ(sinks.stats(0).sent, 2u);
+    EXPECT_EQ(sinks.stats(1).busy, 2u);
+    EXPECT_EQ(sinks.stats(1).sent, 0u);
+    EXPECT_STREQ(sinks.sink(2).type(), "fake");
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,65 @@
+#include "Sinks/udp_multicast_sink.h"
+#include "gtest/gtest.h"
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+TEST(UdpMulticastSinkTest, SendsDatagramsToTheGroup) {
+    // Receiver joined to the group on the loopback interface
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(fd, 0);
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    ASSERT_EQ(::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    socklen_t length = sizeof(address);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    ip_mreq membership{};
+    ::inet_pton(AF_INET, "239.255.42.1", &membership.imr_multiaddr);
+    ::inet_pton(AF_INET, "127.0.0.1", &membership.imr_interface);
+    if (::setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0) {
+        ::close(fd);
+        GTEST_SKIP() << "No multicast on the loopback interface here";
+    }
+
+    UdpMulticastSink::Options options;
+    options.group = "239.255.42.1";
+    options.port = ntohs(address.sin_port);
+    options.interface_address = "127.0.0.1";
+    UdpMulticastSink sink(options);
+    EXPECT_EQ(sink.describe(), "239.255.42.1:" + std::to_string(options.port));
+
+    PayloadPool pool;
+    Payload payload = pool.acquire();
+    payload.buffer() = "21.5";
+    const std::string topic = "hub/t";
+    ASSERT_EQ(sink.send(SinkMessage{topic, payload}), ISink::Result::Sent);
+
+    pollfd wait{fd, POLLIN, 0};
+    ASSERT_EQ(::poll(&wait, 1, 2000), 1);
+    char buffer[64];
+    const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+    EXPECT_EQ(std::string(buffer, static_cast<size_t>(std::max<ssize_t>(n, 0))), std::string("hub/t\0" "21.5", 10));
+    ::close(fd);
+}
+
+TEST(UdpMulticastSinkTest, RejectsInvalidOptions) {
+    UdpMulticastSink::Options options;
+    options.group = "192.168.1.1"; // Unicast
+    options.port = 5000;
+    EXPECT_THROW(UdpMulticastSink{options}, std::invalid_argument);
+    options.group = "239.0.0.1";
+    options.port = 0;
+    EXPECT_THROW(UdpMulticastSink{options}, std::invalid_argument);
+    options.port = 5000;
+    options.interface_address = "eth0";
+    EXPECT_THROW(UdpMulticastSink{options}, std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,68 @@
+#include "Sinks/unix_datagram_sink.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <filesystem>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+// The consumer side: a datagram socket bound at the path
+class Receiver {
+public:
+    explicit Receiver(const std::string& path) : path_(path) {
+        fd_ = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        ::bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    }
+    ~Receiver() {
+        ::close(fd_);
+        std::filesystem::remove(path_);
+    }
+
+    std::string receive() {
+        char buffer[2048];
+        const ssize_t n = ::recv(fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+        return n > 0 ? std::string(buffer, static_cast<size_t>(n)) : std::string();
+    }
+
+private:
+    std::string path_;
+    int fd_ = -1;
+};
+
+} // namespace
+
+TEST(UnixDatagramSinkTest, DeliversTopicAndPayloadToALocalReceiver) {
+    const std::string path = std::filesystem::temp_directory_path() / "unix_datagram_sink_test.sock";
+    std::filesystem::remove(path);
+    UnixDatagramSink sink(path);
+    EXPECT_EQ(sink.describe(), path);
+
+    PayloadPool pool;
+    Payload payload = pool.acquire();
+    payload.buffer() = "{\"t\":1}";
+    const std::string topic = "hub/temp";
+    EXPECT_EQ(sink.send(SinkMessage{topic, payload}), ISink::Result::Unavailable); // Nobody bound yet
+
+    Receiver receiver(path);
+    ASSERT_EQ(sink.send(SinkMessage{topic, payload}), ISink::Result::Sent);
+    EXPECT_EQ(receiver.receive(), std::string("hub/temp\0{\"t\":1}", 16));
+
+    // A receiver that doesn't keep up makes the sink report Busy instead of blocking
+    ISink::Result result = ISink::Result::Sent;
+    for (int i = 0; i < 100000 && result == ISink::Result::Sent; ++i) result = sink.send(SinkMessage{topic, payload});
+    EXPECT_EQ(result, ISink::Result::Busy);
+}
+
+TEST(UnixDatagramSinkTest, RejectsUnusablePaths) {
+    EXPECT_THROW(UnixDatagramSink(""), std::invalid_argument);
+    EXPECT_THROW(UnixDatagramSink(std::string(200, 'x')), std::invalid_argument);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "NetworkMQTT/mqtt_publisher.h"
+#include "Sinks/sink.h"
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Sink on an MqttPublisher: the broker connection as one sink among others.
+ *
+ * A full in-flight window is Busy, a lost connection Unavailable. The publisher is not
+ * owned and must outlive the sink.
+ */
+class MqttSink : public ISink {
+public:
+    explicit MqttSink(MqttPublisher& publisher) : publisher_(publisher) {}
+
+    Result send(const SinkMessage& message) override;
+    const char* type() const override { return "mqtt"; }
+    std::string describe() const override { return publisher_.brokerAddress(); }
+
+private:
+    MqttPublisher& publisher_;
+};
+
+} // namespace SensorHub::Components
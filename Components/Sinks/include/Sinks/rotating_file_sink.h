@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Sinks/sink.h"
+#include <cstdint>
+#include <filesystem>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Appends every message to a local file, rotating it by size.
+ *
+ * Record layout: "<topic> <payload bytes>\n<payload>\n", so JSON readings stay readable
+ * line by line and binary frames can still be split exactly. When the next record would
+ * take the file past max_bytes it is renamed to "<path>.1" (older ones shift to .2, ...)
+ * and a new file is started; at most max_files files are kept, the current one included.
+ * Each record is one writev() with O_APPEND, straight from the payload buffer.
+ */
+class RotatingFileSink : public ISink {
+public:
+    struct Options {
+        std::filesystem::path path;
+        uint64_t max_bytes = 16 * 1024 * 1024;
+        unsigned max_files = 4;
+    };
+
+    /**
+     * @throws std::invalid_argument if the path is empty or a limit is zero.
+     * @throws std::system_error if the file cannot be opened.
+     */
+    explicit RotatingFileSink(Options options);
+    ~RotatingFileSink() override;
+
+    Result send(const SinkMessage& message) override;
+    const char* type() const override { return "file"; }
+    std::string describe() const override { return options_.path.string(); }
+
+    /**
+     * @brief Rotations since construction.
+     */
+    uint64_t rotations() const { return rotations_; }
+
+    // Delete copy/move operations (owns the file descriptor)
+    RotatingFileSink(const RotatingFileSink&) = delete;
+    RotatingFileSink& operator=(const RotatingFileSink&) = delete;
+    RotatingFileSink(RotatingFileSink&&) = delete;
+    RotatingFileSink& operator=(RotatingFileSink&&) = delete;
+
+private:
+    void open();
+    void rotate();
+
+    const Options options_;
+    int fd_ = -1;
+    uint64_t size_ = 0;
+    uint64_t rotations_ = 0;
+    bool failing_ = false; // Errors are logged once until a write succeeds again
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Encoding/payload_pool.h"
+#include <chrono>
+#include <string>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief One encoded message on its way to the sinks.
+ *
+ * Every sink gets the same Payload handle, so fanning a reading out to several sinks
+ * never re-encodes or copies it. A sink that sends later keeps a copy of the handle
+ * (one reference count increment), never of the bytes.
+ */
+struct SinkMessage {
+    const std::string& topic;
+    const Payload& payload;
+    int qos = 0;
+    bool retained = false;
+    std::chrono::seconds expiry{0}; // Where the transport supports it (MQTT 5)
+};
+
+/**
+ * @brief Destination for encoded readings: the MQTT broker, a LAN multicast group, a
+ * co-located process, a local file.
+ *
+ * send() must not block on a slow consumer; it reports Busy instead and the message is
+ * not sent to this sink. Sinks are driven from a single thread.
+ */
+class ISink {
+public:
+    enum class Result {
+        Sent,        // Taken by the sink (handed to the transport, written, ...)
+        Busy,        // The consumer is behind; try again with a later message
+        Unavailable, // Nobody to deliver to right now (not connected, no receiver)
+        Failed,      // Error; see the log
+    };
+
+    virtual ~ISink() = default;
+
+    virtual Result send(const SinkMessage& message) = 0;
+
+    /**
+     * @brief Sink type as used in the configuration (e.g. "udp_multicast").
+     */
+    virtual const char* type() const = 0;
+
+    /**
+     * @brief Destination, for logs (e.g. "239.0.0.1:5000").
+     */
+    virtual std::string describe() const = 0;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Sinks/sink.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Fans each message out to several sinks and counts the outcomes per sink.
+ *
+ * Sinks are added during setup; send() is then called from one thread, while stats()
+ * may be read from any thread.
+ */
+class SinkSet {
+public:
+    struct Stats {
+        uint64_t sent = 0;
+        uint64_t busy = 0;
+        uint64_t unavailable = 0;
+        uint64_t failed = 0;
+    };
+
+    void add(std::unique_ptr<ISink> sink);
+
+    bool empty() const { return entries_.empty(); }
+    size_t size() const { return entries_.size(); }
+
+    /**
+     * @brief Sends the message to every sink, in the order they were added.
+     * @return Number of sinks that took it.
+     */
+    size_t send(const SinkMessage& message);
+
+    const ISink& sink(size_t index) const { return *entries_.at(index)->sink; }
+    Stats stats(size_t index) const;
+
+private:
+    struct Entry {
+        std::unique_ptr<ISink> sink;
+        std::array<std::atomic<uint64_t>, 4> results{}; // By ISink::Result
+    };
+
+    std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+} // namespace SensorHub::Components
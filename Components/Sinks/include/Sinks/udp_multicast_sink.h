@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Sinks/sink.h"
+#include <cstdint>
+#include <string>
+
+#include <netinet/in.h>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Sends every message as one UDP datagram to a multicast group, for consumers on
+ * the LAN that don't want a broker in between.
+ *
+ * Datagram layout: topic, a NUL byte, payload. Delivery is best effort; messages larger
+ * than a datagram (about 64 KiB) fail.
+ */
+class UdpMulticastSink : public ISink {
+public:
+    struct Options {
+        std::string group;              // IPv4 multicast address, e.g. "239.0.0.1"
+        uint16_t port = 0;
+        int ttl = 1;                    // 1 = this subnet only
+        std::string interface_address;  // Outgoing interface by its IPv4 address; empty = routing table
+        bool loopback = true;           // Also deliver to receivers on this host
+    };
+
+    /**
+     * @throws std::invalid_argument if the group, port or interface address is not valid.
+     * @throws std::system_error if the socket cannot be set up.
+     */
+    explicit UdpMulticastSink(Options options);
+    ~UdpMulticastSink() override;
+
+    Result send(const SinkMessage& message) override;
+    const char* type() const override { return "udp_multicast"; }
+    std::string describe() const override;
+
+    // Delete copy/move operations (owns the socket)
+    UdpMulticastSink(const UdpMulticastSink&) = delete;
+    UdpMulticastSink& operator=(const UdpMulticastSink&) = delete;
+    UdpMulticastSink(UdpMulticastSink&&) = delete;
+    UdpMulticastSink& operator=(UdpMulticastSink&&) = delete;
+
+private:
+    const Options options_;
+    sockaddr_in destination_{};
+    int fd_ = -1;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Sinks/sink.h"
+#include <string>
+
+#include <sys/un.h>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Sends every message as one datagram to a Unix domain socket, for processes on
+ * the same host (e.g. a control loop) that need readings without a broker round trip.
+ *
+ * The consumer binds a SOCK_DGRAM socket at the path; until it does, messages are
+ * reported Unavailable, and while its receive queue is full, Busy. Datagram layout:
+ * topic, a NUL byte, payload.
+ */
+class UnixDatagramSink : public ISink {
+public:
+    /**
+     * @throws std::invalid_argument if the path is empty or too long for a socket address.
+     * @throws std::system_error if the socket cannot be created.
+     */
+    explicit UnixDatagramSink(std::string path);
+    ~UnixDatagramSink() override;
+
+    Result send(const SinkMessage& message) override;
+    const char* type() const override { return "unix_datagram"; }
+    std::string describe() const override { return path_; }
+
+    // Delete copy/move operations (owns the socket)
+    UnixDatagramSink(const UnixDatagramSink&) = delete;
+    UnixDatagramSink& operator=(const UnixDatagramSink&) = delete;
+    UnixDatagramSink(UnixDatagramSink&&) = delete;
+    UnixDatagramSink& operator=(UnixDatagramSink&&) = delete;
+
+private:
+    const std::string path_;
+    sockaddr_un destination_{};
+    int fd_ = -1;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,43 @@
+#include "datagram.h"
+#include <cerrno>
+
+#include <sys/uio.h>
+
+namespace SensorHub::Components {
+
+ISink::Result sendDatagram(int fd, const sockaddr* address, socklen_t address_size, const SinkMessage& message) {
+    static const char separator = '\0';
+    const auto& payload = message.payload.str();
+    iovec parts[3];
+    parts[0].iov_base = const_cast<char*>(message.topic.data());
+    parts[0].iov_len = message.topic.size();
+    parts[1].iov_base = const_cast<char*>(&separator);
+    parts[1].iov_len = 1;
+    parts[2].iov_base = const_cast<char*>(payload.data());
+    parts[2].iov_len = payload.size();
+
+    msghdr header{};
+    header.msg_name = const_cast<sockaddr*>(address);
+    header.msg_namelen = address_size;
+    header.msg_iov = parts;
+    header.msg_iovlen = 3;
+    while (::sendmsg(fd, &header, MSG_DONTWAIT | MSG_NOSIGNAL) < 0) {
+        switch (errno) {
+            case EINTR:
+                continue;
+            case EAGAIN:
+            case ENOBUFS:
+                return ISink::Result::Busy;
+            case ENOENT:
+            case ECONNREFUSED:
+            case ENETUNREACH:
+            case EHOSTUNREACH:
+                return ISink::Result::Unavailable;
+            default:
+                return ISink::Result::Failed;
+        }
+    }
+    return ISink::Result::Sent;
+}
+
+} // namespace SensorHub::Components
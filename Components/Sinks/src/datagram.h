@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Sinks/sink.h"
+#include <sys/socket.h>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Sends one message as a datagram: topic, a NUL byte, payload. The three parts go
+ * out with one sendmsg() straight from the message buffers, without blocking.
+ * @return Busy when the socket buffer is full, Unavailable when there is no receiver.
+ */
+ISink::Result sendDatagram(int fd, const sockaddr* address, socklen_t address_size, const SinkMessage& message);
+
+} // namespace SensorHub::Components
@@ -0,0 +1,19 @@
+#include "Sinks/mqtt_sink.h"
+
+namespace SensorHub::Components {
+
+ISink::Result MqttSink::send(const SinkMessage& message) {
+    switch (publisher_.tryPublish(message.topic, message.payload.str(), message.qos, message.retained, message.expiry)) {
+        case MqttPublisher::PublishResult::Accepted:
+            return Result::Sent;
+        case MqttPublisher::PublishResult::WindowFull:
+            return Result::Busy;
+        case MqttPublisher::PublishResult::NotConnected:
+            return Result::Unavailable;
+        case MqttPublisher::PublishResult::Failed:
+            break;
+    }
+    return Result::Failed;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,107 @@
+#include "Sinks/rotating_file_sink.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+std::filesystem::path numbered(const std::filesystem::path& path, unsigned index) {
+    std::filesystem::path result = path;
+    result += ".";
+    result += std::to_string(index); // Not "." + to_string(): GCC 12 -O3 reports a bogus -Wrestrict there
+    return result;
+}
+
+} // namespace
+
+RotatingFileSink::RotatingFileSink(Options options) : options_(std::move(options)) {
+    if (options_.path.empty()) throw std::invalid_argument("File sink needs a path");
+    if (options_.max_bytes == 0 || options_.max_files == 0) {
+        throw std::invalid_argument("File sink max_bytes and max_files must be positive");
+    }
+    open();
+}
+
+RotatingFileSink::~RotatingFileSink() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void RotatingFileSink::open() {
+    fd_ = ::open(options_.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) throw std::system_error(errno, std::generic_category(), "Cannot open " + options_.path.string());
+    struct stat info {};
+    size_ = ::fstat(fd_, &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+}
+
+void RotatingFileSink::rotate() {
+    ::close(fd_);
+    fd_ = -1;
+    std::error_code ignored;
+    if (options_.max_files == 1) {
+        std::filesystem::remove(options_.path, ignored);
+    } else {
+        std::filesystem::remove(numbered(options_.path, options_.max_files - 1), ignored);
+        for (unsigned i = options_.max_files - 1; i > 1; --i) {
+            std::filesystem::rename(numbered(options_.path, i - 1), numbered(options_.path, i), ignored);
+        }
+        std::filesystem::rename(options_.path, numbered(options_.path, 1), ignored);
+    }
+    ++rotations_;
+    open();
+}
+
+ISink::Result RotatingFileSink::send(const SinkMessage& message) {
+    const auto& payload = message.payload.str();
+    char length[24];
+    const int length_size = std::snprintf(length, sizeof(length), " %zu\n", payload.size());
+    static const char newline = '\n';
+    iovec parts[4];
+    parts[0].iov_base = const_cast<char*>(message.topic.data());
+    parts[0].iov_len = message.topic.size();
+    parts[1].iov_base = length;
+    parts[1].iov_len = static_cast<size_t>(length_size);
+    parts[2].iov_base = const_cast<char*>(payload.data());
+    parts[2].iov_len = payload.size();
+    parts[3].iov_base = const_cast<char*>(&newline);
+    parts[3].iov_len = 1;
+    const size_t record_size = parts[0].iov_len + parts[1].iov_len + parts[2].iov_len + 1;
+
+    try {
+        if (fd_ < 0) open(); // Reopening failed after the last rotation
+        if (size_ > 0 && size_ + record_size > options_.max_bytes) rotate();
+    } catch (const std::system_error& e) {
+        if (!failing_) std::cerr << "File sink: " << e.what() << std::endl;
+        failing_ = true;
+        return Result::Failed;
+    }
+
+    ssize_t written;
+    do {
+        written = ::writev(fd_, parts, 4);
+    } while (written < 0 && errno == EINTR);
+    if (written < 0 || static_cast<size_t>(written) != record_size) {
+        if (!failing_) {
+            std::cerr << "File sink: write to " << options_.path << " failed: "
+                      << (written < 0 ? std::strerror(errno) : "short write") << std::endl;
+        }
+        failing_ = true;
+        if (written > 0) size_ += static_cast<uint64_t>(written);
+        return Result::Failed;
+    }
+    size_ += record_size;
+    failing_ = false;
+    return Result::Sent;
+}
+
+} // namespace SensorHub::Components
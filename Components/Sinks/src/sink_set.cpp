@@ -0,0 +1,31 @@
+#include "Sinks/sink_set.h"
+
+namespace SensorHub::Components {
+
+void SinkSet::add(std::unique_ptr<ISink> sink) {
+    auto entry = std::make_unique<Entry>();
+    entry->sink = std::move(sink);
+    entries_.push_back(std::move(entry));
+}
+
+size_t SinkSet::send(const SinkMessage& message) {
+    size_t sent = 0;
+    for (const auto& entry : entries_) {
+        const auto result = entry->sink->send(message);
+        entry->results[static_cast<size_t>(result)].fetch_add(1, std::memory_order_relaxed);
+        if (result == ISink::Result::Sent) ++sent;
+    }
+    return sent;
+}
+
+SinkSet::Stats SinkSet::stats(size_t index) const {
+    const auto& results = entries_.at(index)->results;
+    Stats stats;
+    stats.sent = results[static_cast<size_t>(ISink::Result::Sent)].load(std::memory_order_relaxed);
+    stats.busy = results[static_cast<size_t>(ISink::Result::Busy)].load(std::memory_order_relaxed);
+    stats.unavailable = results[static_cast<size_t>(ISink::Result::Unavailable)].load(std::memory_order_relaxed);
+    stats.failed = results[static_cast<size_t>(ISink::Result::Failed)].load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,53 @@
+#include "Sinks/udp_multicast_sink.h"
+#include "datagram.h"
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+UdpMulticastSink::UdpMulticastSink(Options options) : options_(std::move(options)) {
+    destination_.sin_family = AF_INET;
+    destination_.sin_port = htons(options_.port);
+    if (::inet_pton(AF_INET, options_.group.c_str(), &destination_.sin_addr) != 1 ||
+        (ntohl(destination_.sin_addr.s_addr) & 0xF0000000u) != 0xE0000000u) { // 224.0.0.0/4
+        throw std::invalid_argument("Not an IPv4 multicast group: '" + options_.group + "'");
+    }
+    if (options_.port == 0) throw std::invalid_argument("UDP multicast sink needs a port");
+    if (options_.ttl < 0 || options_.ttl > 255) throw std::invalid_argument("Multicast TTL must be 0-255");
+    in_addr interface_address{};
+    if (!options_.interface_address.empty() &&
+        ::inet_pton(AF_INET, options_.interface_address.c_str(), &interface_address) != 1) {
+        throw std::invalid_argument("Not an IPv4 interface address: '" + options_.interface_address + "'");
+    }
+
+    fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) throw std::system_error(errno, std::generic_category(), "UDP multicast socket");
+    const unsigned char ttl = static_cast<unsigned char>(options_.ttl);
+    const unsigned char loop = options_.loopback ? 1 : 0;
+    if (::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0 ||
+        ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0 ||
+        (!options_.interface_address.empty() &&
+         ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &interface_address, sizeof(interface_address)) < 0)) {
+        const int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(), "UDP multicast socket options");
+    }
+}
+
+UdpMulticastSink::~UdpMulticastSink() {
+    ::close(fd_);
+}
+
+ISink::Result UdpMulticastSink::send(const SinkMessage& message) {
+    return sendDatagram(fd_, reinterpret_cast<const sockaddr*>(&destination_), sizeof(destination_), message);
+}
+
+std::string UdpMulticastSink::describe() const {
+    return options_.group + ":" + std::to_string(options_.port);
+}
+
+} // namespace SensorHub::Components
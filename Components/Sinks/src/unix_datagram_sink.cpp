@@ -0,0 +1,31 @@
+#include "Sinks/unix_datagram_sink.h"
+#include "datagram.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+UnixDatagramSink::UnixDatagramSink(std::string path) : path_(std::move(path)) {
+    if (path_.empty() || path_.size() >= sizeof(destination_.sun_path)) {
+        throw std::invalid_argument("Unix socket path must be 1-" + std::to_string(sizeof(destination_.sun_path) - 1) +
+                                    " characters: '" + path_ + "'");
+    }
+    destination_.sun_family = AF_UNIX;
+    std::memcpy(destination_.sun_path, path_.data(), path_.size());
+    fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) throw std::system_error(errno, std::generic_category(), "Unix datagram socket");
+}
+
+UnixDatagramSink::~UnixDatagramSink() {
+    ::close(fd_);
+}
+
+ISink::Result UnixDatagramSink::send(const SinkMessage& message) {
+    return sendDatagram(fd_, reinterpret_cast<const sockaddr*>(&destination_), sizeof(destination_), message);
+}
+
+} // namespace SensorHub::Components
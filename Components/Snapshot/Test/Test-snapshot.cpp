@@ -0,0 +1,123 @@
+#include "Snapshot/snapshot_reader.h"
+#include "Snapshot/snapshot_writer.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+SnapshotWriter::Options testOptions() {
+    SnapshotWriter::Options options;
+    options.name = "/sensorhub_test_" + std::to_string(::getpid());
+    options.slots = 4;
+    return options;
+}
+
+} // namespace
+
+TEST(SnapshotTest, ReaderSeesTheLatestReadingOfEachChannel) {
+    SnapshotWriter writer(testOptions());
+    const auto bme = writer.addChannel("bme280_living_room");
+    const auto dummy = writer.addChannel(std::string(100, 'd')); // Truncated
+    ASSERT_TRUE(bme && dummy);
+
+    SnapshotReader reader(writer.name());
+    EXPECT_EQ(reader.channelCount(), 2u);
+    EXPECT_EQ(reader.find("bme280_living_room"), bme);
+    EXPECT_EQ(reader.find(std::string(SnapshotLayout::CHANNEL_NAME_SIZE - 1, 'd')), dummy);
+    EXPECT_FALSE(reader.find("missing"));
+
+    SnapshotReader::Reading reading;
+    ASSERT_TRUE(reader.read(*bme, reading));
+    EXPECT_EQ(reading.timestamp_ns, 0); // Not updated yet
+
+    const auto now = std::chrono::system_clock::now();
+    const SnapshotWriter::Value first[] = {{"temperature", 21.5}, {"humidity", 40.0}};
+    writer.update(*bme, now, first);
+    const SnapshotWriter::Value second[] = {{"temperature", 22.0}, {"pressure", 1013.2}};
+    writer.update(*bme, now + std::chrono::seconds(1), second);
+
+    ASSERT_TRUE(reader.read(*bme, reading));
+    EXPECT_EQ(reading.updates, 2u);
+    EXPECT_EQ(reading.field("temperature"), 22.0);
+    EXPECT_EQ(reading.field("pressure"), 1013.2);
+    EXPECT_FALSE(reading.field("humidity")); // Replaced, not merged
+    EXPECT_EQ(reading.timestamp_ns,
+              std::chrono::duration_cast<std::chrono::nanoseconds>((now + std::chrono::seconds(1)).time_since_epoch()).count());
+    EXPECT_STREQ(reading.channel, "bme280_living_room");
+    EXPECT_FALSE(reader.read(7, reading)); // Out of range
+}
+
+TEST(SnapshotTest, LimitsSlotsAndFields) {
+    SnapshotWriter writer(testOptions());
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(writer.addChannel("c" + std::to_string(i)));
+    EXPECT_FALSE(writer.addChannel("c4"));
+
+    std::vector<std::string> names;
+    std::vector<SnapshotWriter::Value> values;
+    for (size_t i = 0; i < SnapshotLayout::MAX_FIELDS + 3; ++i) names.push_back("field_" + std::to_string(i));
+    for (size_t i = 0; i < names.size(); ++i) values.push_back({names[i], static_cast<double>(i)});
+    writer.update(0, std::chrono::system_clock::now(), values);
+
+    SnapshotReader reader(writer.name());
+    SnapshotReader::Reading reading;
+    ASSERT_TRUE(reader.read(0, reading));
+    EXPECT_EQ(reading.field_count, SnapshotLayout::MAX_FIELDS);
+    EXPECT_FALSE(reading.field("field_" + std::to_string(SnapshotLayout::MAX_FIELDS)));
+}
+
+TEST(SnapshotTest, ReadersNeverSeeATornReading) {
+    SnapshotWriter writer(testOptions());
+    const auto slot = writer.addChannel("fast");
+    SnapshotReader reader(writer.name());
+
+    std::atomic<bool> done{false};
+    std::thread writer_thread([&] {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < SnapshotLayout::MAX_FIELDS; ++i) names.push_back("f" + std::to_string(i));
+        std::vector<SnapshotWriter::Value> values(SnapshotLayout::MAX_FIELDS);
+        for (int n = 1; n <= 200000; ++n) {
+            for (size_t i = 0; i < values.size(); ++i) values[i] = {names[i], static_cast<double>(n)};
+            writer.update(*slot, std::chrono::system_clock::time_point(std::chrono::nanoseconds(n)), values);
+        }
+        done.store(true);
+    });
+
+    uint64_t reads = 0;
+    SnapshotReader::Reading reading;
+    while (!done.load()) {
+        if (!reader.read(*slot, reading) || reading.updates == 0) continue;
+        ++reads;
+        // Every member of one update carries the same number
+        ASSERT_EQ(reading.timestamp_ns, static_cast<int64_t>(reading.updates));
+        for (uint32_t i = 0; i < reading.field_count; ++i) {
+            ASSERT_EQ(reading.fields[i].value, static_cast<double>(reading.updates));
+        }
+    }
+    writer_thread.join();
+    EXPECT_GT(reads, 0u);
+}
+
+TEST(SnapshotTest, RejectsMissingRegionsAndBadOptions) {
+    EXPECT_THROW(SnapshotReader("/sensorhub_test_missing"), std::system_error);
+    SnapshotWriter::Options options = testOptions();
+    options.name = "no_slash";
+    EXPECT_THROW(SnapshotWriter{options}, std::invalid_argument);
+    options = testOptions();
+    options.slots = 0;
+    EXPECT_THROW(SnapshotWriter{options}, std::invalid_argument);
+
+    std::string name;
+    {
+        SnapshotWriter writer(testOptions());
+        name = writer.name();
+    }
+    EXPECT_THROW(SnapshotReader{name}, std::system_error); // Unlinked when the hub stops
+}
+
+} // namespace SensorHub::Components
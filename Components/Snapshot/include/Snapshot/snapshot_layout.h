@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SensorHub::Components::SnapshotLayout {
+
+/**
+ * @brief Binary layout of the shared-memory snapshot of latest readings.
+ *
+ * The region (POSIX shared memory, default name "/sensorhub") is a Header followed by
+ * Header::slot_count Slots. Each sensor channel owns one slot for the life of the writer.
+ * A slot is guarded by a seqlock: the writer makes Slot::sequence odd, writes the slot,
+ * then makes it even again. A reader copies the slot between two loads of the sequence
+ * and keeps the copy only if both loads saw the same even value. Readers never write to
+ * the region, so any number of processes can read without slowing the writer down.
+ *
+ * Everything is in host byte order; readers must run on the same machine. The layout is
+ * versioned: readers reject a region whose magic, version or slot size they don't know.
+ */
+
+constexpr uint32_t MAGIC = 0x4E534853; // "SHSN"
+constexpr uint16_t VERSION = 1;
+constexpr size_t CHANNEL_NAME_SIZE = 48; // NUL-terminated topic suffix
+constexpr size_t FIELD_NAME_SIZE = 24;   // NUL-terminated JSON member name
+constexpr size_t MAX_FIELDS = 12;        // Numeric members kept per reading; later ones are dropped
+
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t slot_size;               // sizeof(Slot)
+    uint32_t slot_count;
+    std::atomic<uint32_t> channels;   // Slots in use; only grows
+    int64_t created_ns;               // Writer start, ns since the Unix epoch
+    uint8_t reserved[40];
+};
+
+struct Field {
+    char name[FIELD_NAME_SIZE];
+    double value;
+};
+
+struct alignas(64) Slot {
+    std::atomic<uint32_t> sequence; // Odd while the writer is updating the slot
+    uint32_t field_count;
+    int64_t timestamp_ns;           // Reading time, ns since the Unix epoch (0 = never updated)
+    uint64_t updates;               // Readings written to this slot
+    char channel[CHANNEL_NAME_SIZE];
+    Field fields[MAX_FIELDS];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "The seqlock needs lock-free atomics in shared memory");
+static_assert(sizeof(Header) == 64);
+static_assert(sizeof(Slot) % 64 == 0, "Slots are cache-line aligned so writers of different slots don't collide");
+
+/**
+ * @brief Size of a region holding slot_count slots.
+ */
+constexpr size_t regionSize(uint32_t slot_count) {
+    return sizeof(Header) + static_cast<size_t>(slot_count) * sizeof(Slot);
+}
+
+} // namespace SensorHub::Components::SnapshotLayout
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Snapshot/snapshot_layout.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Reads the hub's shared-memory snapshot of latest readings (see SnapshotLayout).
+ *
+ * Meant for other processes on the same machine (e.g. a controller): link this library
+ * or copy snapshot_layout.h, snapshot_reader.h and snapshot_reader.cpp, which only need
+ * libc. Reading never blocks and never makes a syscall. It takes no lock and never
+ * writes to the region, so readers cannot slow down the hub. tryRead() makes a single
+ * attempt and is wait-free. read() retries while the writer is mid-update; the writer
+ * holds a slot for well under a microsecond, so it rarely needs a second attempt.
+ */
+class SnapshotReader {
+public:
+    /**
+     * @brief A consistent copy of one slot.
+     */
+    struct Reading {
+        uint32_t field_count = 0;
+        int64_t timestamp_ns = 0; // 0 = no reading yet
+        uint64_t updates = 0;
+        char channel[SnapshotLayout::CHANNEL_NAME_SIZE] = {};
+        SnapshotLayout::Field fields[SnapshotLayout::MAX_FIELDS] = {};
+
+        /**
+         * @brief Value of the named field, if the reading has it.
+         */
+        std::optional<double> field(std::string_view name) const;
+    };
+
+    /**
+     * @throws std::system_error if the region does not exist or cannot be mapped.
+     * @throws std::runtime_error if it is not a snapshot region of a known layout version.
+     */
+    explicit SnapshotReader(const std::string& name = "/sensorhub");
+    ~SnapshotReader();
+
+    /**
+     * @brief Channels published so far (slot indices 0 to channelCount() - 1).
+     */
+    uint32_t channelCount() const;
+
+    /**
+     * @brief Slot of a channel by name (the sensor's topic suffix).
+     */
+    std::optional<uint32_t> find(std::string_view channel) const;
+
+    /**
+     * @brief One attempt to copy the slot.
+     * @return false if the slot is out of range or the writer was updating it at that
+     * moment (out is then unusable).
+     */
+    bool tryRead(uint32_t slot, Reading& out) const;
+
+    /**
+     * @brief Copies the slot, retrying while the writer updates it.
+     * @return false only if the slot is out of range or every attempt collided with a write.
+     */
+    bool read(uint32_t slot, Reading& out, unsigned max_attempts = 1000) const;
+
+    // Delete copy/move operations (owns the mapping)
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+    SnapshotReader(SnapshotReader&&) = delete;
+    SnapshotReader& operator=(SnapshotReader&&) = delete;
+
+private:
+    size_t size_ = 0;
+    const SnapshotLayout::Header* header_ = nullptr;
+    const SnapshotLayout::Slot* slots_ = nullptr;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Snapshot/snapshot_layout.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Publishes the latest reading of each sensor channel into POSIX shared memory
+ * (see SnapshotLayout), for co-located processes that want the current value without
+ * MQTT.
+ *
+ * update() is wait-free: a handful of stores into the mapped slot, no syscall, no lock.
+ * Each slot must have a single writer thread at a time; different slots may be updated
+ * from different threads. The region is created (or taken over) at construction and
+ * unlinked at destruction, so readers of a stopped hub get an error instead of stale data.
+ */
+class SnapshotWriter {
+public:
+    struct Options {
+        std::string name = "/sensorhub"; // shm_open() name
+        uint32_t slots = 32;             // Most channels the region can hold
+    };
+
+    /**
+     * @brief One numeric member of a reading.
+     */
+    struct Value {
+        std::string_view name;
+        double value = 0.0;
+    };
+
+    /**
+     * @throws std::invalid_argument if the name or slot count is not usable.
+     * @throws std::system_error if the region cannot be created or mapped.
+     */
+    explicit SnapshotWriter(Options options);
+    ~SnapshotWriter();
+
+    /**
+     * @brief Claims the next free slot for a channel. Names longer than the layout allows
+     * are truncated.
+     * @return The slot index, or std::nullopt if all slots are taken.
+     */
+    std::optional<uint32_t> addChannel(std::string_view channel);
+
+    /**
+     * @brief Replaces the slot's reading. Values beyond SnapshotLayout::MAX_FIELDS are
+     * dropped; names longer than the layout allows are truncated.
+     */
+    void update(uint32_t slot, std::chrono::system_clock::time_point timestamp, std::span<const Value> values);
+
+    const std::string& name() const { return options_.name; }
+    uint32_t channelCount() const { return header_->channels.load(std::memory_order_relaxed); }
+
+    // Delete copy/move operations (owns the mapping)
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+    SnapshotWriter(SnapshotWriter&&) = delete;
+    SnapshotWriter& operator=(SnapshotWriter&&) = delete;
+
+private:
+    const Options options_;
+    size_t size_ = 0;
+    SnapshotLayout::Header* header_ = nullptr;
+    SnapshotLayout::Slot* slots_ = nullptr;
+};
+
+} // namespace SensorHub::Components
@@ -0,0 +1,91 @@
+#include "Snapshot/snapshot_reader.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+std::optional<double> SnapshotReader::Reading::field(std::string_view name) const {
+    for (uint32_t i = 0; i < field_count && i < SnapshotLayout::MAX_FIELDS; ++i) {
+        if (name == fields[i].name) return fields[i].value;
+    }
+    return std::nullopt;
+}
+
+SnapshotReader::SnapshotReader(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+    struct stat info {};
+    if (::fstat(fd, &info) < 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat " + name);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ < sizeof(SnapshotLayout::Header)) {
+        ::close(fd);
+        throw std::runtime_error("Snapshot region " + name + " is not initialised");
+    }
+    void* region = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (region == MAP_FAILED) throw std::system_error(errno, std::generic_category(), "mmap " + name);
+
+    header_ = static_cast<const SnapshotLayout::Header*>(region);
+    slots_ = reinterpret_cast<const SnapshotLayout::Slot*>(static_cast<const char*>(region) +
+                                                           sizeof(SnapshotLayout::Header));
+    // The writer stores the magic last, once the header is complete
+    const uint32_t magic = std::atomic_ref<uint32_t>(const_cast<uint32_t&>(header_->magic)).load(std::memory_order_acquire);
+    if (magic != SnapshotLayout::MAGIC || header_->version != SnapshotLayout::VERSION ||
+        header_->slot_size != sizeof(SnapshotLayout::Slot) ||
+        SnapshotLayout::regionSize(header_->slot_count) > size_) {
+        ::munmap(region, size_);
+        throw std::runtime_error("Snapshot region " + name + " has an unknown layout");
+    }
+}
+
+SnapshotReader::~SnapshotReader() {
+    ::munmap(const_cast<SnapshotLayout::Header*>(header_), size_);
+}
+
+uint32_t SnapshotReader::channelCount() const {
+    return header_->channels.load(std::memory_order_acquire);
+}
+
+std::optional<uint32_t> SnapshotReader::find(std::string_view channel) const {
+    const uint32_t count = channelCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (channel == slots_[i].channel) return i;
+    }
+    return std::nullopt;
+}
+
+bool SnapshotReader::tryRead(uint32_t slot, Reading& out) const {
+    if (slot >= header_->slot_count) return false;
+    const auto& source = slots_[slot];
+    const uint32_t before = source.sequence.load(std::memory_order_acquire);
+    if (before & 1) return false;
+    out.field_count = source.field_count;
+    out.timestamp_ns = source.timestamp_ns;
+    out.updates = source.updates;
+    std::memcpy(out.channel, source.channel, sizeof(out.channel));
+    std::memcpy(out.fields, source.fields, sizeof(out.fields));
+    std::atomic_thread_fence(std::memory_order_acquire); // The copy completes before the sequence is checked again
+    if (source.sequence.load(std::memory_order_relaxed) != before) return false;
+    out.channel[sizeof(out.channel) - 1] = '\0';
+    return true;
+}
+
+bool SnapshotReader::read(uint32_t slot, Reading& out, unsigned max_attempts) const {
+    for (unsigned attempt = 0; attempt < max_attempts; ++attempt) {
+        if (tryRead(slot, out)) return true;
+    }
+    return false;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,100 @@
+#include "Snapshot/snapshot_writer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+void copyName(char* out, size_t size, std::string_view name) {
+    const size_t length = std::min(name.size(), size - 1);
+    std::memcpy(out, name.data(), length);
+    std::memset(out + length, 0, size - length);
+}
+
+int64_t nanosSinceEpoch(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+} // namespace
+
+SnapshotWriter::SnapshotWriter(Options options) : options_(std::move(options)) {
+    if (options_.name.size() < 2 || options_.name[0] != '/' || options_.name.find('/', 1) != std::string::npos) {
+        throw std::invalid_argument("Shared memory name must look like \"/name\": '" + options_.name + "'");
+    }
+    if (options_.slots == 0 || options_.slots > 65536) {
+        throw std::invalid_argument("Snapshot slot count must be 1-65536");
+    }
+    size_ = SnapshotLayout::regionSize(options_.slots);
+
+    // Start from an empty region even if a previous writer crashed without unlinking
+    ::shm_unlink(options_.name.c_str());
+    const int fd = ::shm_open(options_.name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open " + options_.name);
+    if (::ftruncate(fd, static_cast<off_t>(size_)) < 0) {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(options_.name.c_str());
+        throw std::system_error(error, std::generic_category(), "ftruncate " + options_.name);
+    }
+    void* region = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        const int error = errno;
+        ::shm_unlink(options_.name.c_str());
+        throw std::system_error(error, std::generic_category(), "mmap " + options_.name);
+    }
+
+    // The region is zero-filled; construct the atomics in place, the header last
+    slots_ = reinterpret_cast<SnapshotLayout::Slot*>(static_cast<char*>(region) + sizeof(SnapshotLayout::Header));
+    for (uint32_t i = 0; i < options_.slots; ++i) new (&slots_[i]) SnapshotLayout::Slot{};
+    header_ = new (region) SnapshotLayout::Header{};
+    header_->version = SnapshotLayout::VERSION;
+    header_->slot_size = sizeof(SnapshotLayout::Slot);
+    header_->slot_count = options_.slots;
+    header_->created_ns = nanosSinceEpoch(std::chrono::system_clock::now());
+    std::atomic_ref<uint32_t>(header_->magic).store(SnapshotLayout::MAGIC, std::memory_order_release);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    ::munmap(header_, size_);
+    ::shm_unlink(options_.name.c_str());
+}
+
+std::optional<uint32_t> SnapshotWriter::addChannel(std::string_view channel) {
+    const uint32_t slot = header_->channels.load(std::memory_order_relaxed);
+    if (slot >= options_.slots) return std::nullopt;
+    copyName(slots_[slot].channel, sizeof(slots_[slot].channel), channel);
+    // Publishes the name together with the count
+    header_->channels.store(slot + 1, std::memory_order_release);
+    return slot;
+}
+
+void SnapshotWriter::update(uint32_t slot, std::chrono::system_clock::time_point timestamp,
+                            std::span<const Value> values) {
+    auto& target = slots_[slot];
+    const uint32_t sequence = target.sequence.load(std::memory_order_relaxed);
+    target.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); // The odd sequence is visible before any data
+
+    const size_t count = std::min(values.size(), SnapshotLayout::MAX_FIELDS);
+    for (size_t i = 0; i < count; ++i) {
+        copyName(target.fields[i].name, sizeof(target.fields[i].name), values[i].name);
+        target.fields[i].value = values[i].value;
+    }
+    target.field_count = static_cast<uint32_t>(count);
+    target.timestamp_ns = nanosSinceEpoch(timestamp);
+    ++target.updates;
+
+    target.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,15 @@
+#include "StoreForward/crc32.h"
+#include "gtest/gtest.h"
+
+namespace SensorHub::Components {
+
+TEST(Crc32Test, MatchesTheStandardCheckValue) {
+    EXPECT_EQ(crc32("123456789"), 0xCBF43926u);
+    EXPECT_EQ(crc32(""), 0u);
+}
+
+TEST(Crc32Test, CanBeComputedInPieces) {
+    EXPECT_EQ(crc32("56789", crc32("1234")), crc32("123456789"));
+}
+
+} // namespace SensorHub::Components
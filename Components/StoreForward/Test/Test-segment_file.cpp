@@ -0,0 +1,83 @@
+#include "StoreForward/segment_file.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace SensorHub::Components {
+
+namespace {
+
+class SegmentFileTest : public testing::Test {
+protected:
+    void SetUp() override {
+        const auto* test = testing::UnitTest::GetInstance()->current_test_info();
+        directory_ = std::filesystem::temp_directory_path() / ("segment_file_" + std::string(test->name()));
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    std::filesystem::path directory_;
+};
+
+} // namespace
+
+TEST_F(SegmentFileTest, NamesAndListsSegmentsBySequence) {
+    EXPECT_EQ(SegmentFile::pathFor(directory_, 0x1a2b, ".seg"), directory_ / "0000000000001a2b.seg");
+    for (const char* name : {"0000000000000010.seg", "0000000000000002.seg", "0000000000000003.tss",
+                             "000000000000000g.seg", "0000000000000001.seg.tmp", "cursor"}) {
+        std::ofstream(directory_ / name) << "x";
+    }
+    EXPECT_EQ(SegmentFile::list(directory_, ".seg"), (std::vector<uint64_t>{2, 16}));
+    EXPECT_EQ(SegmentFile::list(directory_, ".tss"), (std::vector<uint64_t>{3}));
+    EXPECT_TRUE(SegmentFile::list(directory_ / "missing", ".seg").empty());
+}
+
+TEST_F(SegmentFileTest, CreatesMapsAndShrinksFiles) {
+    const auto path = SegmentFile::pathFor(directory_, 1, ".seg");
+    std::string error;
+    auto file = SegmentFile::create(path, 8192, error);
+    ASSERT_TRUE(file) << error;
+    EXPECT_EQ(file->size(), 8192u);
+    EXPECT_EQ(std::filesystem::file_size(path), 8192u);
+    std::memcpy(file->data(), "records", 7);
+    EXPECT_TRUE(file->sync(7));
+
+    // Truncating keeps the mapping of the data in front
+    EXPECT_TRUE(file->truncate(7));
+    EXPECT_EQ(std::filesystem::file_size(path), 7u);
+    EXPECT_EQ(std::string(file->data(), 7), "records");
+
+    SegmentFile moved = std::move(*file);
+    EXPECT_EQ(file->data(), nullptr);
+    const SegmentFile reopened = SegmentFile::open(path, false);
+    EXPECT_EQ(reopened.size(), 7u);
+    EXPECT_EQ(std::string(reopened.data(), 7), "records");
+
+    moved.remove();
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_EQ(std::string(reopened.data(), 7), "records"); // Mapped until destroyed
+    SegmentFile::syncDirectory(directory_);
+
+    EXPECT_FALSE(SegmentFile::create(directory_ / "missing" / "x.seg", 4096, error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_THROW(SegmentFile::open(directory_ / "missing.seg", false), std::runtime_error);
+    std::ofstream(directory_ / "empty.seg").flush();
+    const SegmentFile empty = SegmentFile::open(directory_ / "empty.seg", true);
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_EQ(empty.data(), nullptr);
+}
+
+TEST_F(SegmentFileTest, ScansRecordsUpToTheFirstInvalidOne) {
+    // Length-prefixed records; a zero length ends the data
+    const std::string data = std::string("\x03xy\x02z\x00\x04", 7);
+    const auto end = SegmentFile::scanRecords(0, [&](size_t offset) -> size_t {
+        return offset < data.size() ? static_cast<size_t>(data[offset]) : 0;
+    });
+    EXPECT_EQ(end, 5u);
+    EXPECT_EQ(SegmentFile::scanRecords(5, [](size_t) -> size_t { return 0; }), 5u);
+}
+
+} // namespace SensorHub::Components
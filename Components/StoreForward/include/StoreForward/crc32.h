@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as in zlib and PNG) of a byte range.
+ * @param data Bytes to checksum.
+ * @param crc Result for the preceding bytes, to checksum a record in pieces.
+ */
+uint32_t crc32(std::string_view data, uint32_t crc = 0);
+
+} // namespace SensorHub::Components
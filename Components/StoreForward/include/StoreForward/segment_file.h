@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief One memory-mapped segment file: the storage under SegmentQueue and TimeSeriesStore.
+ *
+ * Both keep their data in preallocated files named <sequence><extension> (16 hex digits),
+ * write records into the mapping, and find the end of data after a crash by walking
+ * records until one does not check out. This class holds what they share: creating,
+ * mapping, shrinking and syncing a file, and naming and listing the files of a directory.
+ *
+ * The file descriptor is closed as soon as the file is mapped (the mapping keeps the
+ * file's pages), so a store holds one mapping per segment but no open files. Move-only;
+ * the destructor unmaps.
+ */
+class SegmentFile {
+public:
+    SegmentFile() = default;
+    ~SegmentFile();
+
+    SegmentFile(SegmentFile&& other) noexcept;
+    SegmentFile& operator=(SegmentFile&& other) noexcept;
+
+    // Delete copy operations
+    SegmentFile(const SegmentFile&) = delete;
+    SegmentFile& operator=(const SegmentFile&) = delete;
+
+    /**
+     * @brief Creates the file (replacing one of the same name), reserves size bytes on
+     * disk and maps them for reading and writing.
+     * @param error Set to the reason if it fails; the file is removed then.
+     * @return The mapped file, or std::nullopt.
+     */
+    static std::optional<SegmentFile> create(const std::filesystem::path& path, size_t size, std::string& error);
+
+    /**
+     * @brief Maps an existing file whole. An empty file is opened but not mapped.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    static SegmentFile open(const std::filesystem::path& path, bool writable);
+
+    /**
+     * @brief <directory>/<sequence as 16 hex digits><extension>.
+     */
+    static std::filesystem::path pathFor(const std::filesystem::path& directory, uint64_t sequence,
+                                         std::string_view extension);
+
+    /**
+     * @brief Sequences of the directory's files named like pathFor() with this extension, ascending.
+     */
+    static std::vector<uint64_t> list(const std::filesystem::path& directory, std::string_view extension);
+
+    /**
+     * @brief Forces the directory entry changes (files created or removed) to storage.
+     */
+    static void syncDirectory(const std::filesystem::path& directory);
+
+    /**
+     * @brief Walks records from offset: record(offset) returns the size of the valid
+     * record there, or 0 at the end of data. A record torn by a power cut fails its
+     * check, so it reads as the end of data.
+     * @return Offset past the last valid record.
+     */
+    template <typename RecordSize>
+    static size_t scanRecords(size_t offset, RecordSize&& record) {
+        while (const size_t bytes = record(offset)) offset += bytes;
+        return offset;
+    }
+
+    char* data() const { return data_; }
+
+    /**
+     * @brief Mapped size: the file's size when it was mapped.
+     */
+    size_t size() const { return size_; }
+
+    const std::filesystem::path& path() const { return path_; }
+
+    /**
+     * @brief Shrinks the file to bytes. The mapping keeps its size, so only the first
+     * bytes may be touched afterwards.
+     */
+    bool truncate(size_t bytes);
+
+    /**
+     * @brief Forces the first bytes of the mapping (rounded up to pages) to storage.
+     */
+    bool sync(size_t bytes) const;
+
+    /**
+     * @brief Unmaps and removes the file.
+     */
+    void remove();
+
+private:
+    void unmap();
+
+    std::filesystem::path path_;
+    char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace SensorHub::Components
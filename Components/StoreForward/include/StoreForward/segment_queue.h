@@ -0,0 +1,145 @@
+#pragma once
+
+#include "StoreForward/segment_file.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SensorHub::Components {
+
+/**
+ * @brief Persistent FIFO of MQTT messages: an append-only log of memory-mapped segment files.
+ *
+ * Messages that cannot be published go in with push() and come back out, oldest first,
+ * through front()/pop() once the broker is reachable again. Each segment is a preallocated
+ * file named <sequence>.seg (16 hex digits) holding records back to back:
+ *
+ *   u32 LE body length (0 = end of data) | u32 LE CRC-32 of body |
+ *   body: u8 flags (bits 0-1 QoS, bit 2 retained) | u16 LE topic length | topic | payload
+ *
+ * The length goes in last, so a record torn by a power cut reads as the end of its
+ * segment; reopening scans every segment and stops at the first record whose CRC does not
+ * match. Reopened segments are never appended to: new records start a fresh segment.
+ *
+ * The read position lives in a small "cursor" file next to the segments. Segments are
+ * deleted once fully read, and when the queue would outgrow max_bytes the oldest segment
+ * is dropped with its unread records (counted in dropped()).
+ *
+ * Appends only touch the page cache. Nothing is forced to storage until flush(), so
+ * calling it on an interval batches many records into each write of an SD card's pages;
+ * what is not flushed survives a crash of the process but not a power cut. Delivery is
+ * at least once: records popped after the last flush() come back after a restart.
+ * Thread-safe.
+ */
+class SegmentQueue {
+public:
+    struct Options {
+        std::filesystem::path directory{"spool"};
+        size_t segment_bytes = 1 << 20; // Size of each segment file (also the largest record)
+        size_t max_bytes = 64 << 20;    // Bound on all segments together, at least two segments
+    };
+
+    struct Record {
+        std::string topic;
+        std::string payload;
+        int qos = 0;
+        bool retained = false;
+    };
+
+    /**
+     * @brief Opens the queue in options.directory (created if missing) and recovers its records.
+     * @throws std::invalid_argument if segment_bytes is below 4 KiB or max_bytes holds fewer than two segments.
+     * @throws std::runtime_error if the directory or a segment cannot be opened.
+     */
+    explicit SegmentQueue(Options options);
+
+    /**
+     * @brief Unmaps the segments. Records not yet flushed are left to the kernel's writeback.
+     */
+    ~SegmentQueue();
+
+    // Delete copy/move operations
+    SegmentQueue(const SegmentQueue&) = delete;
+    SegmentQueue& operator=(const SegmentQueue&) = delete;
+    SegmentQueue(SegmentQueue&&) = delete;
+    SegmentQueue& operator=(SegmentQueue&&) = delete;
+
+    /**
+     * @brief Appends a message; drops the oldest segment first if the queue is full.
+     * @return false if the record is larger than a segment or no segment could be created.
+     */
+    bool push(std::string_view topic, std::string_view payload, int qos = 0, bool retained = false);
+
+    /**
+     * @brief The oldest unread message, or std::nullopt if the queue is empty.
+     */
+    std::optional<Record> front();
+
+    /**
+     * @brief Marks the message returned by front() as delivered.
+     */
+    void pop();
+
+    /**
+     * @brief Forces appended records and the read position to storage.
+     * @param deadline Segments still dirty when it passes are left for the next flush.
+     * @return true if everything was written before the deadline.
+     */
+    bool flush(std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    /**
+     * @brief Number of unread messages.
+     */
+    size_t size() const;
+
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Unread messages discarded with full segments since the queue was opened.
+     */
+    uint64_t dropped() const;
+
+    /**
+     * @brief Bytes of segment files on disk.
+     */
+    size_t diskBytes() const;
+
+    const Options& options() const { return options_; }
+
+private:
+    struct Segment {
+        uint64_t sequence = 0;
+        SegmentFile file;
+        size_t write_offset = 0;  // End of the last complete record
+        size_t records = 0;
+        bool sealed = false;      // Recovered at open: read-only from then on
+        bool dirty = false;       // Appended to since the last flush
+    };
+
+    void recover();
+    void loadCursor(uint64_t& sequence, size_t& offset) const;
+    bool openSegment();
+    void retireFront(bool delivered);
+    void skipConsumedSegments();
+    std::filesystem::path segmentPath(uint64_t sequence) const;
+
+    Options options_;
+    size_t max_segments_;
+    std::deque<Segment> segments_; // Oldest first; the read position is always in front()
+    size_t read_offset_ = 0;       // In the front segment
+    size_t read_records_ = 0;      // Records of the front segment already popped
+    size_t pending_ = 0;
+    uint64_t next_sequence_ = 0;
+    uint64_t dropped_ = 0;
+    int cursor_fd_ = -1;
+    bool cursor_dirty_ = false;
+    bool directory_dirty_ = false;
+    mutable std::mutex mutex_;
+};
+
+} // namespace SensorHub::Components
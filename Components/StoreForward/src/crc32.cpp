@@ -0,0 +1,28 @@
+#include "StoreForward/crc32.h"
+#include <array>
+
+namespace SensorHub::Components {
+
+namespace {
+
+constexpr std::array<uint32_t, 256> makeTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit) value = (value & 1u) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+        table[i] = value;
+    }
+    return table;
+}
+
+constexpr auto TABLE = makeTable();
+
+} // namespace
+
+uint32_t crc32(std::string_view data, uint32_t crc) {
+    crc = ~crc;
+    for (const char c : data) crc = TABLE[(crc ^ static_cast<uint8_t>(c)) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+} // namespace SensorHub::Components
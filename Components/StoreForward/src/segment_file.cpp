@@ -0,0 +1,134 @@
+#include "StoreForward/segment_file.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+std::string errorText() { return std::strerror(errno); }
+
+} // namespace
+
+SegmentFile::~SegmentFile() { unmap(); }
+
+SegmentFile::SegmentFile(SegmentFile&& other) noexcept
+    : path_(std::move(other.path_)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+SegmentFile& SegmentFile::operator=(SegmentFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        path_ = std::move(other.path_);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+std::optional<SegmentFile> SegmentFile::create(const std::filesystem::path& path, size_t size, std::string& error) {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        error = errorText();
+        return std::nullopt;
+    }
+    // Reserve the blocks now: a write into a sparse mapping on a full disk would be a SIGBUS
+    const int allocated = ::posix_fallocate(fd, 0, static_cast<off_t>(size));
+    void* data = allocated == 0 ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (data == MAP_FAILED) error = allocated != 0 ? std::strerror(allocated) : errorText();
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        ::unlink(path.c_str());
+        return std::nullopt;
+    }
+    SegmentFile file;
+    file.path_ = path;
+    file.data_ = static_cast<char*>(data);
+    file.size_ = size;
+    return file;
+}
+
+SegmentFile SegmentFile::open(const std::filesystem::path& path, bool writable) {
+    const int fd = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+    struct stat info{};
+    if (fd < 0 || ::fstat(fd, &info) != 0) {
+        const std::string error = errorText();
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("Cannot open segment " + path.string() + ": " + error);
+    }
+    SegmentFile file;
+    file.path_ = path;
+    file.size_ = static_cast<size_t>(info.st_size);
+    if (file.size_ > 0) {
+        void* data = ::mmap(nullptr, file.size_, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            const std::string error = errorText();
+            ::close(fd);
+            throw std::runtime_error("Cannot map segment " + path.string() + ": " + error);
+        }
+        file.data_ = static_cast<char*>(data);
+    }
+    ::close(fd);
+    return file;
+}
+
+std::filesystem::path SegmentFile::pathFor(const std::filesystem::path& directory, uint64_t sequence,
+                                           std::string_view extension) {
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; --i, sequence >>= 4) name[static_cast<size_t>(i)] = "0123456789abcdef"[sequence & 0xFu];
+    name += extension;
+    return directory / name;
+}
+
+std::vector<uint64_t> SegmentFile::list(const std::filesystem::path& directory, std::string_view extension) {
+    std::vector<uint64_t> sequences;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        const auto name = entry.path().filename().string();
+        uint64_t sequence = 0;
+        if (name.size() != 16 + extension.size() || !name.ends_with(extension)) continue;
+        const auto [end, error] = std::from_chars(name.data(), name.data() + 16, sequence, 16);
+        if (error == std::errc() && end == name.data() + 16) sequences.push_back(sequence);
+    }
+    std::sort(sequences.begin(), sequences.end());
+    return sequences;
+}
+
+void SegmentFile::syncDirectory(const std::filesystem::path& directory) {
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+bool SegmentFile::truncate(size_t bytes) {
+    return ::truncate(path_.c_str(), static_cast<off_t>(bytes)) == 0;
+}
+
+bool SegmentFile::sync(size_t bytes) const {
+    const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t length = std::min(size_, (bytes + page - 1) / page * page);
+    return length == 0 || ::msync(data_, length, MS_SYNC) == 0;
+}
+
+void SegmentFile::remove() {
+    unmap();
+    if (!path_.empty()) ::unlink(path_.c_str());
+}
+
+void SegmentFile::unmap() {
+    if (data_) ::munmap(data_, size_);
+    data_ = nullptr;
+}
+
+} // namespace SensorHub::Components
@@ -0,0 +1,298 @@
+#include "StoreForward/segment_queue.h"
+#include "StoreForward/crc32.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace SensorHub::Components {
+
+namespace {
+
+constexpr size_t RECORD_HEADER = 8; // Length and CRC
+constexpr size_t BODY_HEADER = 3;   // Flags and topic length
+constexpr size_t CURSOR_SIZE = 24;  // u64 sequence | u64 offset | u32 CRC of both | u32 zero
+constexpr size_t MIN_SEGMENT_BYTES = 4096;
+constexpr uint8_t RETAINED_FLAG = 0x04;
+constexpr std::string_view EXTENSION = ".seg";
+
+void putLE(char* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) out[i] = static_cast<char>((value >> (8 * i)) & 0xFFu);
+}
+
+uint64_t getLE(const char* in, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+    return value;
+}
+
+/**
+ * @brief Body length of the valid record at offset, or 0 at the end of data (or a torn record).
+ */
+size_t recordAt(const char* data, size_t size, size_t offset) {
+    if (size - offset < RECORD_HEADER) return 0;
+    const size_t length = getLE(data + offset, 4);
+    if (length < BODY_HEADER || length > size - offset - RECORD_HEADER) return 0;
+    const char* body = data + offset + RECORD_HEADER;
+    if (crc32(std::string_view(body, length)) != getLE(data + offset + 4, 4)) return 0;
+    if (BODY_HEADER + getLE(body + 1, 2) > length) return 0;
+    return length;
+}
+
+std::string errorText() { return std::strerror(errno); }
+
+} // namespace
+
+SegmentQueue::SegmentQueue(Options options)
+    : options_(std::move(options)), max_segments_(options_.max_bytes / std::max<size_t>(1, options_.segment_bytes)) {
+    if (options_.segment_bytes < MIN_SEGMENT_BYTES) {
+        throw std::invalid_argument("Store-and-forward segment_bytes must be at least 4096");
+    }
+    if (max_segments_ < 2) {
+        throw std::invalid_argument("Store-and-forward max_bytes must hold at least two segments");
+    }
+    recover();
+}
+
+SegmentQueue::~SegmentQueue() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    segments_.clear();
+    if (cursor_fd_ >= 0) ::close(cursor_fd_);
+}
+
+void SegmentQueue::recover() {
+    std::error_code ec;
+    std::filesystem::create_directories(options_.directory, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot create store-and-forward directory " + options_.directory.string() + ": " +
+                                 ec.message());
+    }
+    cursor_fd_ = ::open((options_.directory / "cursor").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (cursor_fd_ < 0) {
+        throw std::runtime_error("Cannot open store-and-forward cursor in " + options_.directory.string() + ": " +
+                                 errorText());
+    }
+
+    const std::vector<uint64_t> sequences = SegmentFile::list(options_.directory, EXTENSION);
+
+    uint64_t cursor_sequence = 0;
+    size_t cursor_offset = 0;
+    loadCursor(cursor_sequence, cursor_offset);
+    // A cursor past every segment means all of them were delivered; never reuse its number
+    next_sequence_ = std::max(cursor_sequence + 1, sequences.empty() ? 0 : sequences.back() + 1);
+
+    for (const uint64_t sequence : sequences) {
+        const auto path = segmentPath(sequence);
+        if (sequence < cursor_sequence) { // Read completely before the last flush
+            std::filesystem::remove(path, ec);
+            continue;
+        }
+        Segment segment;
+        segment.sequence = sequence;
+        segment.sealed = true;
+        try {
+            segment.file = SegmentFile::open(path, true);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error(std::string("Store-and-forward: ") + e.what());
+        }
+        if (segment.file.size() < RECORD_HEADER) { // Created but never preallocated
+            segment.file.remove();
+            continue;
+        }
+        const char* data = segment.file.data();
+        const size_t size = segment.file.size();
+        segment.write_offset = SegmentFile::scanRecords(0, [&](size_t offset) -> size_t {
+            const size_t length = recordAt(data, size, offset);
+            if (length == 0) return 0;
+            ++segment.records;
+            return RECORD_HEADER + length;
+        });
+        pending_ += segment.records;
+        segments_.push_back(std::move(segment));
+    }
+
+    // Resume inside the cursor's segment only at a record boundary; otherwise re-read it whole
+    if (!segments_.empty() && segments_.front().sequence == cursor_sequence) {
+        const Segment& front = segments_.front();
+        size_t offset = 0;
+        size_t records = 0;
+        while (offset < cursor_offset && offset < front.write_offset) {
+            offset += RECORD_HEADER + getLE(front.file.data() + offset, 4);
+            ++records;
+        }
+        if (offset == cursor_offset) {
+            read_offset_ = offset;
+            read_records_ = records;
+            pending_ -= records;
+        }
+    }
+    cursor_dirty_ = true;
+    skipConsumedSegments();
+
+    if (pending_ > 0) {
+        std::cout << "Store-and-forward queue in " << options_.directory.string() << " holds " << pending_
+                  << " undelivered messages in " << segments_.size() << " segments." << std::endl;
+    }
+}
+
+void SegmentQueue::loadCursor(uint64_t& sequence, size_t& offset) const {
+    char buffer[CURSOR_SIZE];
+    if (::pread(cursor_fd_, buffer, CURSOR_SIZE, 0) != static_cast<ssize_t>(CURSOR_SIZE)) return;
+    if (crc32(std::string_view(buffer, 16)) != getLE(buffer + 16, 4)) return;
+    sequence = getLE(buffer, 8);
+    offset = static_cast<size_t>(getLE(buffer + 8, 8));
+}
+
+bool SegmentQueue::openSegment() {
+    if (segments_.size() >= max_segments_) retireFront(false);
+
+    Segment segment;
+    segment.sequence = next_sequence_++;
+    const auto path = segmentPath(segment.sequence);
+    std::string error;
+    auto file = SegmentFile::create(path, options_.segment_bytes, error);
+    if (!file) {
+        std::cerr << "Cannot create store-and-forward segment " << path.string() << ": " << error << std::endl;
+        return false;
+    }
+    segment.file = std::move(*file);
+    segments_.push_back(std::move(segment));
+    directory_dirty_ = true;
+    return true;
+}
+
+void SegmentQueue::retireFront(bool delivered) {
+    Segment& front = segments_.front();
+    if (!delivered) {
+        const size_t unread = front.records - read_records_;
+        pending_ -= unread;
+        dropped_ += unread;
+        if (unread > 0) {
+            std::cerr << "Store-and-forward queue full: dropped " << unread << " oldest messages." << std::endl;
+        }
+    }
+    front.file.remove();
+    segments_.pop_front();
+    read_offset_ = 0;
+    read_records_ = 0;
+    cursor_dirty_ = true;
+    directory_dirty_ = true;
+}
+
+void SegmentQueue::skipConsumedSegments() {
+    // The last segment stays even when read to its end: it is still being appended to
+    while (segments_.size() > 1 && read_records_ == segments_.front().records) retireFront(true);
+}
+
+std::filesystem::path SegmentQueue::segmentPath(uint64_t sequence) const {
+    return SegmentFile::pathFor(options_.directory, sequence, EXTENSION);
+}
+
+bool SegmentQueue::push(std::string_view topic, std::string_view payload, int qos, bool retained) {
+    const size_t length = BODY_HEADER + topic.size() + payload.size();
+    if (topic.size() > 0xFFFF || RECORD_HEADER + length > options_.segment_bytes) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (segments_.empty() || segments_.back().sealed ||
+        segments_.back().file.size() - segments_.back().write_offset < RECORD_HEADER + length) {
+        if (!openSegment()) return false;
+        skipConsumedSegments();
+    }
+    Segment& segment = segments_.back();
+    char* record = segment.file.data() + segment.write_offset;
+    char* body = record + RECORD_HEADER;
+    body[0] = static_cast<char>((qos & 0x03) | (retained ? RETAINED_FLAG : 0));
+    putLE(body + 1, topic.size(), 2);
+    std::memcpy(body + BODY_HEADER, topic.data(), topic.size());
+    std::memcpy(body + BODY_HEADER + topic.size(), payload.data(), payload.size());
+    putLE(record + 4, crc32(std::string_view(body, length)), 4);
+    putLE(record, length, 4); // Last: until it is written the record reads as the end of data
+
+    segment.write_offset += RECORD_HEADER + length;
+    ++segment.records;
+    segment.dirty = true;
+    ++pending_;
+    return true;
+}
+
+std::optional<SegmentQueue::Record> SegmentQueue::front() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    skipConsumedSegments();
+    if (pending_ == 0) return std::nullopt;
+
+    const char* record = segments_.front().file.data() + read_offset_;
+    const size_t length = getLE(record, 4);
+    const char* body = record + RECORD_HEADER;
+    const size_t topic_length = getLE(body + 1, 2);
+    Record result;
+    result.qos = body[0] & 0x03;
+    result.retained = (static_cast<uint8_t>(body[0]) & RETAINED_FLAG) != 0;
+    result.topic.assign(body + BODY_HEADER, topic_length);
+    result.payload.assign(body + BODY_HEADER + topic_length, length - BODY_HEADER - topic_length);
+    return result;
+}
+
+void SegmentQueue::pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    skipConsumedSegments();
+    if (pending_ == 0) return;
+    read_offset_ += RECORD_HEADER + getLE(segments_.front().file.data() + read_offset_, 4);
+    ++read_records_;
+    --pending_;
+    cursor_dirty_ = true;
+    skipConsumedSegments();
+}
+
+bool SegmentQueue::flush(std::chrono::steady_clock::time_point deadline) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Records first: a cursor may run ahead of the data after a power cut, which only re-reads a segment
+    for (auto& segment : segments_) {
+        if (!segment.dirty) continue;
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        if (!segment.file.sync(segment.write_offset)) {
+            std::cerr << "Store-and-forward sync failed: " << errorText() << std::endl;
+            return false;
+        }
+        segment.dirty = false;
+    }
+    if (directory_dirty_) { // Segment files created or deleted since the last flush
+        SegmentFile::syncDirectory(options_.directory);
+        directory_dirty_ = false;
+    }
+    if (!cursor_dirty_) return true;
+    if (std::chrono::steady_clock::now() > deadline) return false;
+
+    char buffer[CURSOR_SIZE] = {};
+    putLE(buffer, segments_.empty() ? next_sequence_ : segments_.front().sequence, 8);
+    putLE(buffer + 8, read_offset_, 8);
+    putLE(buffer + 16, crc32(std::string_view(buffer, 16)), 4);
+    if (::pwrite(cursor_fd_, buffer, CURSOR_SIZE, 0) != static_cast<ssize_t>(CURSOR_SIZE) || ::fdatasync(cursor_fd_) != 0) {
+        std::cerr << "Store-and-forward cursor write failed: " << errorText() << std::endl;
+        return false;
+    }
+    cursor_dirty_ = false;
+    return true;
+}
+
+size_t SegmentQueue::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+uint64_t SegmentQueue::dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+size_t SegmentQueue::diskBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& segment : segments_) bytes += segment.file.size();
+    return bytes;
+}
+
+} // namespace SensorHub::Components